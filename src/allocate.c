@@ -9,6 +9,7 @@
 #include "allocate.h"
 #include "interface.h"
 #include "frontend.h"
+#include "m_seq_bp.h"
 
 // signal for allocator shutting down state
 static bool allocate_shutting_down = false;
@@ -74,6 +75,12 @@ static int last_allocated_worker = -1;
  */
 static char worker_scan_bin_fn[MAX_FILENAME_LENGTH + 1];
 
+/*
+ * name of the shared seq_bp store of the scan workers (see get_seq_bp_shm_name),
+ * which is removed when allocation starts and ends
+ */
+static char worker_seq_bp_shm_name[SEQ_BP_SHM_MAX_NAME_LEN + 1];
+
 /*
  * static, inline replacement for memcpy - silences google sanitizers
  */
@@ -123,6 +130,7 @@ static inline bool launch_worker (MPI_Comm *new_worker_comm,
 	size_t port_name_len = strlen (port_name);
 	g_memcpy (mpi_wn_job.mpi_port_name, port_name, port_name_len);
 	mpi_wn_job.mpi_port_name[port_name_len] = '\0';
+	strcpy (mpi_wn_job.seq_bp_shm_name, worker_seq_bp_shm_name);
 	
 	if (!js_execute (JS_CMD_SUBMIT_JOB, &mpi_wn_job, sizeof (mpi_wn_job),
 	                 worker_scan_bin_fn, &server_response) || (server_response == NULL)) {
@@ -1139,7 +1147,7 @@ bool allocate_scan_job (cp_job job, char *ss_strn, char *pos_var_strn,
 }
 
 bool initialize_allocate (char *si_server, unsigned short si_port,
-                          const char *scan_bin_fn) {
+                          const char *scan_bin_fn, const char *seq_bp_shm_name) {
 	if (!scan_bin_fn) {
 		DEBUG_NOW (REPORT_ERRORS, ALLOCATE,
 		           "NULL scan binary filename supplied");
@@ -1164,6 +1172,17 @@ bool initialize_allocate (char *si_server, unsigned short si_port,
 		
 	g_memcpy (worker_scan_bin_fn, scan_bin_fn, sbf_len);
 	worker_scan_bin_fn[sbf_len] = '\0';
+	
+	if (strlen (seq_bp_shm_name) > SEQ_BP_SHM_MAX_NAME_LEN) {
+		DEBUG_NOW1 (REPORT_ERRORS, ALLOCATE,
+		            "shared seq_bp store name exceeds SEQ_BP_SHM_MAX_NAME_LEN (%d)",
+		            SEQ_BP_SHM_MAX_NAME_LEN);
+		return false;
+	}
+	
+	strcpy (worker_seq_bp_shm_name, seq_bp_shm_name);
+	// a store left behind by an earlier run may be outdated or full
+	remove_seq_bp_shm_store (worker_seq_bp_shm_name);
 	num_available_workers = 0;
 	num_active_workers = 0;
 	last_allocated_worker = -1;
@@ -1266,6 +1285,9 @@ void finalize_allocate() {
 	ALLOCATE_LOCK_E
 	pthread_join (update_thread, NULL);
 	pthread_join (allocate_thread, NULL);
+	DEBUG_NOW (REPORT_INFO, ALLOCATE,
+	           "removing shared seq_bp store");
+	remove_seq_bp_shm_store (worker_seq_bp_shm_name);
 	DEBUG_NOW (REPORT_INFO, ALLOCATE,
 	           "finalizing allocation spinlock");
 	pthread_spin_destroy (&allocate_spinlock);
@@ -25,7 +25,7 @@
 #define MPI_TEST_WORK_SLEEP_MS 			1	    // sleep duration in ms, between subsequent MPI_Test calls after MPI_Isend or MPI_Irecv
 
 bool initialize_allocate (char *si_server, unsigned short si_port,
-                          const char *scan_bin_fn);
+                          const char *scan_bin_fn, const char *seq_bp_shm_name);
 bool allocate_scan_job (cp_job job, char *ss_strn, char *pos_var_strn,
                         char *seq_strn, ds_int32_field ref_id);
 void finalize_allocate();
@@ -271,15 +271,17 @@ bool initialize_jobsched_server (char *headnode_server) {
 	           "initializing TORQUE/PBS job scheduling interface");
 	/*
 	 * scan_job_args to include:
-	 * %s=%s, %s=--%s, %s=--%s --%s="%s", where string format specifiers are for
+	 * %s=%s, %s=--%s, %s=--%s --%s="%s" --%s="%s", where string format specifiers are for
 	 * JS_JOBSCHED_JOB_SUBMIT_BEP_ENV, job_bin_fn (MAX_FILENAME_LENGTH), JS_JOBSCHED_JOB_ID_ENV, SCHED_JOB_ID_ARG_LONG,
-	 * JS_JOBSCHED_JOB_SUBMIT_ARGS_ENV, SCAN_MODE_ARG_LONG, MPI_PORT_NAME_ARG_LONG, job->mpi_port_name (MPI_MAX_PORT_NAME)
+	 * JS_JOBSCHED_JOB_SUBMIT_ARGS_ENV, SCAN_MODE_ARG_LONG, MPI_PORT_NAME_ARG_LONG, job->mpi_port_name (MPI_MAX_PORT_NAME),
+	 * SEQ_BP_STORE_ARG_LONG, job->seq_bp_shm_name (SEQ_BP_SHM_MAX_NAME_LEN)
 	 */
 	scan_job_args = malloc (strlen (JS_JOBSCHED_JOB_SUBMIT_BEP_ENV) + 1 +
 	                        MAX_FILENAME_LENGTH + 1 + strlen (JS_JOBSCHED_JOB_ID_ENV) + 1 +
 	                        strlen (SCHED_JOB_ID_ARG_LONG) + 1 + strlen (JS_JOBSCHED_JOB_SUBMIT_ARGS_ENV) +
 	                        1 + strlen (SCAN_MODE_ARG_LONG) + 1 +
-	                        MPI_MAX_PORT_NAME + 1 + 17);
+	                        MPI_MAX_PORT_NAME + 1 + strlen (SEQ_BP_STORE_ARG_LONG) +
+	                        SEQ_BP_SHM_MAX_NAME_LEN + 23);
 	                        
 	if (!scan_job_args) {
 		DEBUG_NOW (REPORT_ERRORS, SCHED,
@@ -315,15 +317,17 @@ bool initialize_jobsched_server() {
 	           "initializing SLURM job scheduler interface");
 	/*
 	 * scan_job_args to include:
-	 * %s=%s, %s=--%s, %s=--%s --%s="%s", where string format specifiers are for
+	 * %s=%s, %s=--%s, %s=--%s --%s="%s" --%s="%s", where string format specifiers are for
 	 * JS_JOBSCHED_JOB_SUBMIT_BEP_ENV, job_bin_fn (MAX_FILENAME_LENGTH), JS_JOBSCHED_JOB_ID_ENV, SCHED_JOB_ID_ARG_LONG,
-	 * JS_JOBSCHED_JOB_SUBMIT_ARGS_ENV, SCAN_MODE_ARG_LONG, MPI_PORT_NAME_ARG_LONG, job->mpi_port_name (MPI_MAX_PORT_NAME)
+	 * JS_JOBSCHED_JOB_SUBMIT_ARGS_ENV, SCAN_MODE_ARG_LONG, MPI_PORT_NAME_ARG_LONG, job->mpi_port_name (MPI_MAX_PORT_NAME),
+	 * SEQ_BP_STORE_ARG_LONG, job->seq_bp_shm_name (SEQ_BP_SHM_MAX_NAME_LEN)
 	 */
 	scan_job_args = malloc (strlen (JS_JOBSCHED_JOB_SUBMIT_BEP_ENV) + 1 +
 	                        MAX_FILENAME_LENGTH + 1 + strlen (JS_JOBSCHED_JOB_ID_ENV) + 1 +
 	                        strlen (SCHED_JOB_ID_ARG_LONG) + 1 + strlen (JS_JOBSCHED_JOB_SUBMIT_ARGS_ENV) +
 	                        1 + strlen (SCAN_MODE_ARG_LONG) + 1 +
-	                        MPI_MAX_PORT_NAME + 1 + 17);
+	                        MPI_MAX_PORT_NAME + 1 + strlen (SEQ_BP_STORE_ARG_LONG) +
+	                        SEQ_BP_SHM_MAX_NAME_LEN + 23);
 	                        
 	if (!scan_job_args) {
 		DEBUG_NOW (REPORT_ERRORS, SCHED,
@@ -733,14 +737,15 @@ bool submit_job (wnp_job job, const char *job_bin_fn,
 	a[1].name = ATTR_v;
 	a[1].resource = NULL;
 	// note: scheduler job ID not provided in scan_job_args, and needs to be supplied with submission script (via $PBS_JOBID, $SLURM_JOBID)
-	sprintf (scan_job_args, "%s=%s, %s=--%s, %s=--%s --%s=\"%s\"",
+	sprintf (scan_job_args, "%s=%s, %s=--%s, %s=--%s --%s=\"%s\" --%s=\"%s\"",
 	         JS_JOBSCHED_JOB_SUBMIT_BEP_ENV,
 	         job_bin_fn,
 	         JS_JOBSCHED_JOB_ID_ENV,
 	         SCHED_JOB_ID_ARG_LONG,
 	         JS_JOBSCHED_JOB_SUBMIT_ARGS_ENV,
 	         SCAN_MODE_ARG_LONG,
-	         MPI_PORT_NAME_ARG_LONG, job->mpi_port_name);
+	         MPI_PORT_NAME_ARG_LONG, job->mpi_port_name,
+	         SEQ_BP_STORE_ARG_LONG, job->seq_bp_shm_name);
 	a[1].value = scan_job_args;
 	a[1].next = & (a[2]);
 	a[2].name = ATTR_l;
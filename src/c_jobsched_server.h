@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <mpi.h>
 #include "util.h"
+#include "m_seq_bp.h"
 #if JS_JOBSCHED_TYPE==JS_TORQUE
 	#include <pbs_error.h>
 	#include <pbs_ifl.h>
@@ -14,6 +15,7 @@
 
 typedef struct {
 	char mpi_port_name[MPI_MAX_PORT_NAME];
+	char seq_bp_shm_name[SEQ_BP_SHM_MAX_NAME_LEN + 1];
 } wn_job, *wnp_job;
 
 // PBS does not seem to have constants/macros/enums for job status, so need common enum for PBS/SLURM
@@ -32,7 +34,7 @@ typedef enum {
 #define JS_CMD_DATA                         "JSDATA"
 #define JS_CMD_BIN_EXE_FPATH                "JSBEFPATH"
 #define JS_NUM_CMDS                         4
-#define JS_MSG_SIZE                         1080
+#define JS_MSG_SIZE                         (1080 + SEQ_BP_SHM_MAX_NAME_LEN + 1)
 
 // GET_NODE_INFO command
 #define JS_CMD_GET_NODE_INFO                "GET_NODE_INFO"
@@ -20,6 +20,7 @@
 #include "allocate.h"
 #include "interface.h"
 #include "c_jobsched_server.h"
+#include "m_seq_bp.h"
 #include "distribute.h"
 
 #define D_Q_DEQUEUE_SLEEP_S             1
@@ -27,7 +28,7 @@
 #define D_Q_HEARTBEAT                   NULL
 #define D_Q_HEARTBEAT_MS                1000
 #define D_Q_HEARTBEAT_MAX_MISSES        2
-#define D_Q_SOCKET_BACKLOG_LIMIT        5
+#define D_Q_SOCKET_BACKLOG_LIMIT        SOMAXCONN                   // each filter worker opens its own connection
 #define D_Q_CLIENT_SOCKET_SLEEP_MS      10
 
 #define R_Q_SLEEP_MS                    10
@@ -387,47 +388,60 @@ static void finalize_qs() {
 	r_q_head_posn = 0;
 	r_q_tail_posn = 0;
 }
+/*
+ * unpacks and enqueues (under a single lock) all num_msgs messages in the batch
+ */
 static inline void d_q_process_msg (const uchar *q_socket_recv_buf,
-                                    const ushort thread_id) {
-	cp_job new_job = malloc (sizeof (c_job));
-	
-	if (new_job == NULL) {
-		DEBUG_NOW1 (REPORT_ERRORS, DISPATCH,
-		            "could not allocate job to enqueue in thread #%d", thread_id);
-		return;
-	}
-	
-	/*
-	 * unpacking data order from (32) bytes : [NUM_RT_BYTES x job_id][4 x start_posn][4 x end_posn]
-	 */
-	new_job->start_posn = 0;
-	new_job->end_posn = 0;
-	
-	for (uchar j = 0; j < 4; j++) {
-		new_job->start_posn += (q_socket_recv_buf[NUM_RT_BYTES + 0 + j] << ((
-		                                        3 - j) * 8));
-		new_job->end_posn  += (q_socket_recv_buf[NUM_RT_BYTES + 4 + j] << ((
-		                                        3 - j) * 8));
-	}
+                                    const uint32_t num_msgs, const ushort thread_id) {
+	cp_job new_jobs[FILTER_BATCH_MAX_NUM_MSGS];
 	
-	for (uchar j = 0; j < NUM_RT_BYTES; j++) {
-		new_job->job_id[j] = q_socket_recv_buf[j];
+	for (REGISTER uint32_t i = 0; i < num_msgs; i++) {
+		new_jobs[i] = malloc (sizeof (c_job));
+		
+		if (new_jobs[i] == NULL) {
+			DEBUG_NOW1 (REPORT_ERRORS, DISPATCH,
+			            "could not allocate job to enqueue in thread #%d", thread_id);
+			            
+			for (uint32_t j = 0; j < i; j++) {
+				free (new_jobs[j]);
+			}
+			
+			return;
+		}
+		
+		/*
+		 * unpacking data order from (32) bytes : [NUM_RT_BYTES x job_id][4 x start_posn][4 x end_posn]
+		 */
+		const uchar *msg = q_socket_recv_buf + (i * FILTER_MSG_SIZE);
+		new_jobs[i]->start_posn = 0;
+		new_jobs[i]->end_posn = 0;
+		
+		for (uchar j = 0; j < 4; j++) {
+			new_jobs[i]->start_posn += (msg[NUM_RT_BYTES + 0 + j] << ((3 - j) * 8));
+			new_jobs[i]->end_posn  += (msg[NUM_RT_BYTES + 4 + j] << ((3 - j) * 8));
+		}
+		
+		for (uchar j = 0; j < NUM_RT_BYTES; j++) {
+			new_jobs[i]->job_id[j] = msg[j];
+		}
 	}
 	
 	D_Q_LOCK_S
 	
-	if (!enq_d (new_job)) {
-		DEBUG_NOW1 (REPORT_ERRORS, DISPATCH, "could not enqueue job in thread #%d",
-		            thread_id);
-		free (new_job);
+	for (REGISTER uint32_t i = 0; i < num_msgs; i++) {
+		if (!enq_d (new_jobs[i])) {
+			DEBUG_NOW1 (REPORT_ERRORS, DISPATCH, "could not enqueue job in thread #%d",
+			            thread_id);
+			free (new_jobs[i]);
+		}
 	}
 	
 	D_Q_LOCK_E
 }
 static void *socket_client_thread_start (void *arg) {
 	ushort this_thread_num = * (ushort *)arg;
-	uchar d_q_socket_recv_buf[FILTER_MSG_SIZE],
-	      q_socket_pending_buf[FILTER_MSG_SIZE];
+	// bytes of (possibly partial) batches received and not yet processed
+	uchar d_q_socket_recv_buf[FILTER_BATCH_MAX_SIZE];
 	int num_bytes_read;
 	REGISTER bool received_shutdown_signal = false;
 	#ifdef _WIN32
@@ -496,17 +510,20 @@ static void *socket_client_thread_start (void *arg) {
 		/*
 		 * process incoming connection
 		 */
-		REGISTER bool have_part_message = false;
 		REGISTER int previous_size = 0, j;
+		REGISTER uint32_t num_msgs;
+		REGISTER bool received_malformed_batch = false;
 		
 		while (1) {
 			REGISTER bool nonblocking_retry;
 			#ifdef _WIN32
 			
-			if ((num_bytes_read = recv (win_client_socket, d_q_socket_recv_buf,
-			                            FILTER_MSG_SIZE, 0)) <= 0) {
+			if ((num_bytes_read = recv (win_client_socket,
+			                            (char *) d_q_socket_recv_buf + previous_size,
+			                            FILTER_BATCH_MAX_SIZE - previous_size, 0)) <= 0) {
 				if (WSAGetLastError() != WSAEWOULDBLOCK) {
 					shutdown (win_client_socket, SD_BOTH);
+					closesocket (win_client_socket);
 					break;  // client disconnected - restart
 				}
 				
@@ -529,15 +546,18 @@ static void *socket_client_thread_start (void *arg) {
 				DEBUG_NOW1 (REPORT_ERRORS, DISPATCH, "error with select() in thread #%u",
 				            this_thread_num);
 				shutdown (unix_client_socket, SHUT_RDWR);
+				close (unix_client_socket);
 				pthread_exit (NULL);
 				return NULL;
 			}
 			
 			else
 				if (select_retval) {
-					if ((num_bytes_read = read (unix_client_socket, d_q_socket_recv_buf,
-					                            FILTER_MSG_SIZE)) <= 0) {
+					if ((num_bytes_read = read (unix_client_socket,
+					                            d_q_socket_recv_buf + previous_size,
+					                            FILTER_BATCH_MAX_SIZE - previous_size)) <= 0) {
 						shutdown (unix_client_socket, SHUT_RDWR);
+						close (unix_client_socket);
 						break;  // client disconnected - restart
 					}
 			
@@ -558,8 +578,10 @@ static void *socket_client_thread_start (void *arg) {
 				if (received_shutdown_signal) {
 					#ifdef _WIN32
 					shutdown (win_client_socket, SD_BOTH);
+					closesocket (win_client_socket);
 					#else
 					shutdown (unix_client_socket, SHUT_RDWR);
+					close (unix_client_socket);
 					#endif
 					pthread_exit (NULL);
 					return NULL;
@@ -569,51 +591,51 @@ static void *socket_client_thread_start (void *arg) {
 			}
 			
 			else {
-				if (have_part_message) {
-					if (previous_size + num_bytes_read <= FILTER_MSG_SIZE) {
-						for (j = previous_size; j < previous_size + num_bytes_read; j++) {
-							q_socket_pending_buf[j] = d_q_socket_recv_buf[j - previous_size];
-						}
-						
-						if (previous_size + num_bytes_read == FILTER_MSG_SIZE) {
-							d_q_process_msg (q_socket_pending_buf, this_thread_num);
-							have_part_message = false;
-						}
-						
-						else {
-							previous_size += num_bytes_read;
-						}
+				previous_size += num_bytes_read;
+				
+				/*
+				 * process all complete batches: [4 x num_msgs][num_msgs x FILTER_MSG_SIZE]
+				 */
+				while (previous_size >= FILTER_BATCH_HEADER_SIZE) {
+					num_msgs = 0;
+					
+					for (j = 0; j < FILTER_BATCH_HEADER_SIZE; j++) {
+						num_msgs = (num_msgs << 8) | d_q_socket_recv_buf[j];
 					}
 					
-					else {
-						for (j = previous_size; j < FILTER_MSG_SIZE; j++) {
-							q_socket_pending_buf[j] = d_q_socket_recv_buf[j - previous_size];
-						}
-						
-						d_q_process_msg (q_socket_pending_buf, this_thread_num);
-						
-						for (j = FILTER_MSG_SIZE - previous_size; j < num_bytes_read; j++) {
-							q_socket_pending_buf[j - (FILTER_MSG_SIZE - previous_size)] =
-							                    d_q_socket_recv_buf[j];
-						}
-						
-						previous_size = num_bytes_read - (FILTER_MSG_SIZE - previous_size);
+					if (!num_msgs || num_msgs > FILTER_BATCH_MAX_NUM_MSGS) {
+						received_malformed_batch = true;
+						break;
 					}
 					
-					continue;
-				}
-				
-				if (num_bytes_read == FILTER_MSG_SIZE) {
-					d_q_process_msg (d_q_socket_recv_buf, this_thread_num);
-				}
-				
-				else {
-					for (j = 0; j < num_bytes_read; j++) {
-						q_socket_pending_buf[j] = d_q_socket_recv_buf[j];
+					const int batch_size = FILTER_BATCH_HEADER_SIZE + (num_msgs * FILTER_MSG_SIZE);
+					
+					if (previous_size < batch_size) {
+						break;  // wait for remainder of batch
 					}
 					
-					previous_size = num_bytes_read;
-					have_part_message = true;
+					d_q_process_msg (d_q_socket_recv_buf + FILTER_BATCH_HEADER_SIZE, num_msgs,
+					                 this_thread_num);
+					                 
+					for (j = batch_size; j < previous_size; j++) {
+						d_q_socket_recv_buf[j - batch_size] = d_q_socket_recv_buf[j];
+					}
+					
+					previous_size -= batch_size;
+				}
+				
+				if (received_malformed_batch) {
+					DEBUG_NOW2 (REPORT_ERRORS, DISPATCH,
+					            "received malformed batch (%u messages) in thread #%u. disconnecting client",
+					            num_msgs, this_thread_num);
+					#ifdef _WIN32
+					shutdown (win_client_socket, SD_BOTH);
+					closesocket (win_client_socket);
+					#else
+					shutdown (unix_client_socket, SHUT_RDWR);
+					close (unix_client_socket);
+					#endif
+					break;
 				}
 			}
 		}
@@ -1441,8 +1463,11 @@ bool dispatch (ushort port, char *ds_server, ushort ds_port, char *scan_bin_fn)
 	}
 	
 	DEBUG_NOW (REPORT_INFO, DISPATCH, "initializing allocator");
+	// scan workers of this dispatch instance share seq_bps by node, and not with those of other instances
+	char seq_bp_shm_name[SEQ_BP_SHM_MAX_NAME_LEN + 1];
+	get_seq_bp_shm_name (port, seq_bp_shm_name);
 	
-	if (!initialize_allocate (si_server, si_port, scan_bin_fn)) {
+	if (!initialize_allocate (si_server, si_port, scan_bin_fn, seq_bp_shm_name)) {
 		DEBUG_NOW (REPORT_ERRORS, DISPATCH, "failed to initialize allocator");
 		DEBUG_NOW (REPORT_INFO, DISPATCH, "finalizing sockets for queue");
 		finalize_sockets();
@@ -4,12 +4,20 @@
 #include <sched.h>
 #include <unistd.h>
 #include <math.h>
+#include <time.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
 #ifdef _WIN32
 	#include <winsock2.h>
 	#include <ws2tcpip.h>
 #else
 	#include <netdb.h>
 #endif
+#if defined(__AVX2__) || defined(__SSE2__)
+	#include <immintrin.h>
+#endif
 #include "filter.h"
 #include "util.h"
 #include "distribute.h"
@@ -22,15 +30,32 @@
 #define is_valid_nt_char(c) (((c)=='c' || (c)=='g' || (c)=='u' || (c)=='a'))
 
 #define MIN_NUM_FILTER_THREADS          1U
-#define MAX_NUM_FILTER_THREADS          254U                        // currently use 1 byte for transferring thread id+1, so max value here is 254
+#define FILTER_CHUNK_SPAN               1024U                       // number of (5') start positions per unit of filter work
+
+#define FILTER_SOCKET_CLOSE_TIMEOUT_S   60                          // s to wait for dispatch to drain a connection being closed, before failing the job
+
+/*
+ * one-hot (nibble) nucleotide codes used when testing candidate stacks; a bp is
+ * valid whenever the pairing mask of its 5' nt shares a bit with the code of its 3' nt
+ */
+#define FILTER_NT_A                     0x01
+#define FILTER_NT_C                     0x02
+#define FILTER_NT_G                     0x04
+#define FILTER_NT_U                     0x08
+#define FILTER_NT_PADDING               32                          // trailing bytes, such that (vector) loads never exceed buffers
+
+#define FILTER_CONSTRAINT_TIME_SAMPLING 16                          // 1 in every # seed batches is timed for the filter stats
 
-#define FILTER_NUM_SOCKET_CONNECTIONS   D_Q_NUM_SOCKET_THREADS      // match # socket connections with # q socket (threads)
+#define FILTER_BITSET_WORD_BITS         64                          // bits per (uint64_t) word of the is_done/is_seed_matched bitsets
 
-#define FILTER_SOCKET_CONNECT_WAIT      1                           // ms to wait if all sockets are busy
+// coalesced ROIs must fit the (worker) search window, which is bounded by in-window positions (see WIDE_POSITIONS)
+#define FILTER_MAX_ROI_SPAN             (MAX_SEQ_LEN < MAX_REL_SEQ_LEN ? MAX_SEQ_LEN : MAX_REL_SEQ_LEN)
+
+#define FILTER_CACHE_NUM_ENTRIES        64                          // # of ROI lists held in memory
+#define FILTER_CACHE_MAX_NUM_ROIS       (1U << 18)                  // ROI lists beyond this size are not cached
+#define FILTER_CACHE_MIN_NUM_ROIS       64                          // initial allocation (# of ROIs) of a ROI list
 
 static pthread_spinlock_t filter_spinlock;
-static bool
-sockets_used[FILTER_NUM_SOCKET_CONNECTIONS];            // which socket
 
 #ifdef _WIN32
 // documented bug in MINGW - need to manually add forward declarations
@@ -39,26 +64,32 @@ int WSAAPI getaddrinfo (const char *, const char *, const struct addrinfo *,
                         struct addrinfo **);
 // documented bug in MINGW - need to manually add forward declarations
 
-static SOCKET win_client_socket[FILTER_NUM_SOCKET_CONNECTIONS];
+static struct addrinfo *win_server_addr = NULL;     // dispatch server address, resolved once in initialize_filter
 #else
-static int unix_client_socket[FILTER_NUM_SOCKET_CONNECTIONS];
+static struct sockaddr_in unix_server_addr;         // dispatch server address, resolved once in initialize_filter
 #endif
 
 #define FILTER_LOCK_S    if (pthread_spin_lock (&filter_spinlock)) { DEBUG_NOW (REPORT_ERRORS, FILTER, "could not acquire filter spinlock"); } else {
 #define FILTER_LOCK_E    if (pthread_spin_unlock (&filter_spinlock)) { DEBUG_NOW (REPORT_ERRORS, FILTER, "could not release filter spinlock"); pthread_exit (NULL); } }
 
+/*
+ * filter jobs are split into chunks of FILTER_CHUNK_SPAN (5') start positions; each chunk additionally
+ * spans the largest model length (less 1), such that any model starting within its own positions
+ * is fully contained. chunk indices are initially divided in contiguous ranges over workers;
+ * workers take chunks from the front of their own range, and steal from the back of other ranges
+ */
+typedef struct {
+	pthread_spinlock_t lock;
+	nt_abs_count next_chunk, end_chunk;  // [next_chunk, end_chunk) not yet taken
+} filter_chunk_range;
+
 typedef struct {
-	const char     *seq_seg;
-	// number of nt this seq seg spans;
-	// though relative, uses absolute positioning for data-type range reasons
+	const char     *seq;
+	nt_abs_count    seq_size;
 	nt_abs_count
-	seq_seg_span;
-	nt_abs_seq_posn
-	// (0-indexed) absolute posn of the 1st nt in this segment, in relation to the entire sequence
-	seq_seg_abs_posn,
-	// (0-indexed) relative posn of the 1st unvisited nt within this segment;
-	// though relative, uses absolute positioning for data-type range reasons
-	seq_seg_extra_nt_rel_posn;
+	chunk_span,                      // number of (5') start positions owned by each chunk
+	chunk_overlap,                   // number of trailing nt shared with the next chunk
+	num_chunks;
 	nt_stack_size
 	stack_min_size;                  // minimum number of bps in (largest found) stack
 	nt_stack_size
@@ -75,11 +106,72 @@ typedef struct {
 	tp_trail_min_span;               // minimum number of trailing (tp) nts after end of stack
 	nt_rel_count
 	tp_trail_max_span;               // maximum number of trailing (tp) nts after end of stack
+	ushort num_constraints;
+	int64_t constraints_offset_and_dist[MAX_CONSTRAINT_MATCHES][4][3];
 	nt_rt_bytes job_id;
-	ntp_model model;
-	ntp_element el_with_largest_stack;
-	uchar thread_id;
-} seq_seg_arg;
+	ushort num_workers;
+	filter_chunk_range *chunk_ranges;    // one per worker
+} filter_job;
+
+/*
+ * (position, stack size, stack idist) triple considered by filter_seq_segment
+ */
+typedef struct {
+	nt_abs_seq_posn fp_posn;         // (0-indexed, within segment) 5' position of the stack
+	nt_stack_size stack_size;
+	nt_stack_idist stack_idist;
+} filter_seed;
+
+/*
+ * ROIs identified by a filter thread, kept for the filter result cache
+ */
+typedef struct {
+	nt_abs_seq_posn *posns;          // (start, end) posn pairs
+	nt_abs_count num_rois, max_num_rois;
+	bool overflow;                   // set when exceeding FILTER_CACHE_MAX_NUM_ROIS or out of memory
+} filter_roi_list;
+
+typedef struct {
+	filter_job *job;
+	ushort worker_id;
+	bool connected;                  // set once the worker's own dispatch connection is open
+	bool acknowledged;               // set once dispatch has processed all of the worker's ROIs
+	bool have_one_extent;
+	filter_roi_list rois;
+	filter_thread_stats stats;
+} filter_worker_arg;
+
+/*
+ * the filter result for a given sequence depends only on the sequence and the model limits and
+ * constraint offsets (see filter_seq_segment); the key is zeroed before being set, so that
+ * keys can be compared (and spilled to disk) bytewise
+ */
+typedef struct {
+	nt_seq_hash seq_hash;
+	nt_abs_count seq_size;
+	nt_rel_count fp_lead_min_span, fp_lead_max_span, tp_trail_min_span,
+	             tp_trail_max_span;
+	nt_stack_size stack_min_size, stack_max_size;
+	nt_stack_idist stack_min_idist, stack_max_idist;
+	ushort num_constraints;
+	int64_t constraints_offset_and_dist[MAX_CONSTRAINT_MATCHES][4][3];
+} filter_cache_key;
+
+typedef struct {
+	filter_cache_key key;
+	nt_abs_seq_posn *posns;
+	nt_abs_count num_rois;
+	unsigned long long last_used;    // filter_cache_clock at last lookup/insert; 0 when entry is unused
+} filter_cache_entry;
+
+static filter_cache_entry filter_cache[FILTER_CACHE_NUM_ENTRIES];
+static unsigned long long filter_cache_clock = 0;
+
+// ring buffer of the FILTER_STATS_NUM_JOBS most recent job stats
+static filter_job_stats filter_stats[FILTER_STATS_NUM_JOBS];
+static ushort filter_stats_next = 0, filter_stats_num_jobs = 0;
+// number of job stats recorded, to detect those recorded while reading the ring buffer
+static unsigned long long filter_stats_num_puts = 0;
 
 /*
  * static, inline replacements for memset/memcpy - silences google sanitizers
@@ -102,50 +194,523 @@ static inline void g_memcpy (void *p, const void *r, const int len) {
 	}
 }
 
-static void filter_submit_null_job (const nt_rt_bytes job_id) {
+/*
+ * monotonic time (ns) used for filter instrumentation; get_real_time is not monotonic
+ */
+static inline unsigned long long get_filter_time_ns() {
+	#ifdef _WIN32
+	return GetTickCount64() * 1000000ULL;
+	#else
+	struct timespec time_spec;
+	clock_gettime (CLOCK_MONOTONIC, &time_spec);
+	return ((unsigned long long) time_spec.tv_sec * 1000000000ULL) +
+	       (unsigned long long) time_spec.tv_nsec;
+	#endif
+}
+
+static inline void add_to_roi_list (filter_roi_list *list,
+                                    const nt_abs_seq_posn start_posn, const nt_abs_seq_posn end_posn) {
+	if (list->overflow) {
+		return;
+	}
+	
+	if (list->num_rois == list->max_num_rois) {
+		nt_abs_count new_max_num_rois = list->max_num_rois ? list->max_num_rois * 2 :
+		                                FILTER_CACHE_MIN_NUM_ROIS;
+		nt_abs_seq_posn *new_posns = NULL;
+		
+		if (new_max_num_rois <= FILTER_CACHE_MAX_NUM_ROIS) {
+			new_posns = realloc (list->posns, sizeof (nt_abs_seq_posn) * 2 * new_max_num_rois);
+		}
+		
+		if (!new_posns) {
+			free (list->posns);
+			list->posns = NULL;
+			list->overflow = true;
+			return;
+		}
+		
+		list->posns = new_posns;
+		list->max_num_rois = new_max_num_rois;
+	}
+	
+	list->posns[list->num_rois * 2] = start_posn;
+	list->posns[ (list->num_rois * 2) + 1] = end_posn;
+	list->num_rois++;
+}
+
+/*
+ * a filter_batch holds the dispatch connection opened by one filter thread, for the lifetime
+ * of that thread, and the messages pending to be sent over it
+ */
+typedef struct {
+	#ifdef _WIN32
+	SOCKET socket;
+	#else
+	int socket;
+	#endif
+	ushort num_msgs;
+	bool send_failed;
+	filter_roi_list *rois;           // when not NULL, ROIs submitted are also recorded here
+	filter_thread_stats *stats;      // when not NULL, send time is accounted for here
+	uchar buf[FILTER_BATCH_MAX_SIZE];
+} filter_batch;
+
+/*
+ * open_filter_socket:
+ *          connect a (new) socket to the dispatch server; connections beyond those being served
+ *          by dispatch wait in its listen backlog, such that workers block rather than spin
+ */
+static bool open_filter_socket (filter_batch *batch) {
+	batch->num_msgs = 0;
+	batch->send_failed = false;
+	batch->rois = NULL;
+	batch->stats = NULL;
+	#ifdef _WIN32
+	
+	if ((batch->socket = socket (win_server_addr->ai_family,
+	                             win_server_addr->ai_socktype,
+	                             win_server_addr->ai_protocol)) == INVALID_SOCKET) {
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER,
+		            "failed to create socket (error code %d)", WSAGetLastError());
+		return false;
+	}
+	
+	if (connect (batch->socket, win_server_addr->ai_addr,
+	             (int) win_server_addr->ai_addrlen) == SOCKET_ERROR) {
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER,
+		            "failed to connect to dispatch server (error code %d)", WSAGetLastError());
+		closesocket (batch->socket);
+		return false;
+	}
+	
+	#else
+	
+	if ((batch->socket = socket (AF_INET, SOCK_STREAM, 0)) < 0) {
+		DEBUG_NOW (REPORT_ERRORS, FILTER, "failed to create socket");
+		return false;
+	}
+	
+	#if Q_DISABLE_NAGLE
+	int flag = 1;
+	
+	if (setsockopt (batch->socket, IPPROTO_TCP, TCP_NODELAY, (char *)&flag,
+	                sizeof (int)) < 0) {
+		DEBUG_NOW (REPORT_ERRORS, FILTER, "failed to disable Nagle on socket");
+		close (batch->socket);
+		return false;
+	}
+	
+	#endif
+	
+	if (connect (batch->socket, (struct sockaddr *)&unix_server_addr,
+	             sizeof (unix_server_addr)) < 0) {
+		DEBUG_NOW (REPORT_ERRORS, FILTER, "failed to connect to dispatch server");
+		close (batch->socket);
+		return false;
+	}
+	
+	#endif
+	return true;
+}
+
+/*
+ * sends any pending messages as a single batch: [4 x num_msgs][num_msgs x FILTER_MSG_SIZE]
+ */
+static void flush_filter_batch (filter_batch *batch) {
+	if (!batch->num_msgs) {
+		return;
+	}
+	
+	for (uchar j = 0; j < FILTER_BATCH_HEADER_SIZE; j++) {
+		batch->buf[j] = (uchar) ((batch->num_msgs >> ((FILTER_BATCH_HEADER_SIZE - 1 - j)
+		                                        * 8)) & 0xff);
+	}
+	
+	const int batch_size = FILTER_BATCH_HEADER_SIZE + (batch->num_msgs *
+	                                        FILTER_MSG_SIZE);
+	const unsigned long long send_start_time = get_filter_time_ns();
 	REGISTER
-	uchar i = 0, this_socket = 0;
-	FILTER_LOCK_S
+	int num_bytes_sent = 0, this_num_bytes_sent;
 	
-	do {
-		if (!sockets_used[i]) {
-			sockets_used[i] = true;
-			this_socket = i;
+	while (num_bytes_sent < batch_size) {
+		#ifdef _WIN32
+		this_num_bytes_sent = send (batch->socket,
+		                            (char *) batch->buf + num_bytes_sent, batch_size - num_bytes_sent, 0);
+		#else
+		this_num_bytes_sent = send (batch->socket,
+		                            batch->buf + num_bytes_sent, batch_size - num_bytes_sent, 0);
+		#endif
+		                            
+		if (this_num_bytes_sent <= 0) {
+			DEBUG_NOW1 (REPORT_ERRORS, FILTER,
+			            "failed to send batch of %d messages", batch->num_msgs);
+			batch->send_failed = true;
 			break;
 		}
 		
-		else {
-			i++;
-			
-			if (i == FILTER_NUM_SOCKET_CONNECTIONS) {
-				sleep_ms (FILTER_SOCKET_CONNECT_WAIT);
-				i = 0;
-			}
-		}
+		num_bytes_sent += this_num_bytes_sent;
 	}
-	while (1);
 	
-	FILTER_LOCK_E
-	uchar buf[FILTER_MSG_SIZE];
+	if (batch->stats) {
+		batch->stats->send_time_ns += get_filter_time_ns() - send_start_time;
+	}
 	
+	batch->num_msgs = 0;
+}
+
+/*
+ * close_filter_socket:
+ *          flush any pending messages and close the connection; dispatch only closes its end
+ *          after having processed all batches received, so waiting for it to do so ensures that
+ *          ROIs are queued before any end of job signal subsequently sent over another connection
+ *
+ * returns: true if all messages were sent and dispatch closed its end (acknowledging them)
+ *          within FILTER_SOCKET_CLOSE_TIMEOUT_S; false otherwise, in which case the end of
+ *          job signal must not be sent
+ */
+static bool close_filter_socket (filter_batch *batch) {
+	flush_filter_batch (batch);
+	char drain_buf[16];
+	REGISTER
+	int num_bytes_read = -1;
+	#ifdef _WIN32
+	DWORD timeout_ms = FILTER_SOCKET_CLOSE_TIMEOUT_S * 1000;
+	
+	if (shutdown (batch->socket, SD_SEND) != SOCKET_ERROR) {
+		setsockopt (batch->socket, SOL_SOCKET, SO_RCVTIMEO, (char *)&timeout_ms,
+		            sizeof (timeout_ms));
+		            
+		while ((num_bytes_read = recv (batch->socket, drain_buf, sizeof (drain_buf),
+		                               0)) > 0);
+	}
+	
+	closesocket (batch->socket);
+	#else
+	struct timeval timeout_tv;
+	timeout_tv.tv_sec = FILTER_SOCKET_CLOSE_TIMEOUT_S;
+	timeout_tv.tv_usec = 0;
+	
+	if (!shutdown (batch->socket, SHUT_WR)) {
+		setsockopt (batch->socket, SOL_SOCKET, SO_RCVTIMEO, (char *)&timeout_tv,
+		            sizeof (timeout_tv));
+		            
+		while ((num_bytes_read = (int) read (batch->socket, drain_buf,
+		                                     sizeof (drain_buf))) > 0);
+	}
+	
+	close (batch->socket);
+	#endif
+	
+	if (num_bytes_read) {
+		DEBUG_NOW (REPORT_ERRORS, FILTER,
+		           "dispatch did not acknowledge connection being closed");
+	}
+	
+	return !batch->send_failed && !num_bytes_read;
+}
+
+/*
+ * packing data order in (32) bytes : [NUM_RT_BYTES x job_id][4 x start_posn][4 x end_posn]
+ */
+static void filter_submit_job (filter_batch *batch, const nt_rt_bytes job_id,
+                               const nt_abs_seq_posn start_posn, const nt_abs_seq_posn end_posn) {
+	uchar *buf = batch->buf + FILTER_BATCH_HEADER_SIZE + (batch->num_msgs *
+	                                        FILTER_MSG_SIZE);
+	                                        
 	for (uchar j = 0; j < 4; j++) {
-		buf[  NUM_RT_BYTES + j] = (uchar) ((DISPATCH_NULL_JOB_POSN >> ((
-		                                        3 - j) * 8)) & 0xff);
-		buf[4 + NUM_RT_BYTES + j] = (uchar) ((DISPATCH_NULL_JOB_POSN >> ((
-		                                        3 - j) * 8)) & 0xff);
+		buf[  NUM_RT_BYTES + j] = (uchar) ((start_posn >> ((3 - j) * 8)) & 0xff);
+		buf[4 + NUM_RT_BYTES + j] = (uchar) ((end_posn   >> ((3 - j) * 8)) & 0xff);
 	}
 	
 	for (uchar j = 0; j < NUM_RT_BYTES; j++) {
 		buf[j] = (uchar) (job_id[j]);
 	}
 	
+	if (batch->rois) {
+		add_to_roi_list (batch->rois, start_posn, end_posn);
+	}
+	
+	batch->num_msgs++;
+	
+	if (FILTER_BATCH_MAX_NUM_MSGS == batch->num_msgs) {
+		flush_filter_batch (batch);
+	}
+}
+
+static void get_filter_cache_key (const filter_job *job,
+                                  filter_cache_key *key) {
+	g_memset (key, 0, sizeof (filter_cache_key));
+	// same crc as get_seq_hash, but sequence buffers (e.g. from file) need not be null-terminated
+	key->seq_hash = crc32buf ((char *) job->seq, job->seq_size);
+	key->seq_size = job->seq_size;
+	key->fp_lead_min_span = job->fp_lead_min_span;
+	key->fp_lead_max_span = job->fp_lead_max_span;
+	key->tp_trail_min_span = job->tp_trail_min_span;
+	key->tp_trail_max_span = job->tp_trail_max_span;
+	key->stack_min_size = job->stack_min_size;
+	key->stack_max_size = job->stack_max_size;
+	key->stack_min_idist = job->stack_min_idist;
+	key->stack_max_idist = job->stack_max_idist;
+	key->num_constraints = job->num_constraints;
+	g_memcpy (key->constraints_offset_and_dist, job->constraints_offset_and_dist,
+	          sizeof (int64_t) * 4 * 3 * job->num_constraints);
+}
+
+#if FILTER_CACHE_SPILL
+static inline void get_filter_cache_spill_fn (const filter_cache_key *key,
+                                              char *fn) {
+	sprintf (fn, "%s/%08x-%08x", FILTER_CACHE_SPILL_DIR, (unsigned int) key->seq_hash,
+	         (unsigned int) crc32buf ((char *) key, sizeof (filter_cache_key)));
+}
+
+static void spill_filter_cache_entry (const filter_cache_key *key,
+                                      const nt_abs_seq_posn *posns, const nt_abs_count num_rois) {
+	char fn[sizeof (FILTER_CACHE_SPILL_DIR) + 20];
+	get_filter_cache_spill_fn (key, fn);
 	#ifdef _WIN32
-	send (win_client_socket[this_socket], buf, FILTER_MSG_SIZE, 0);
+	
+	if (mkdir (FILTER_CACHE_SPILL_DIR) && errno != EEXIST) {
 	#else
-	send (unix_client_socket[this_socket], buf, FILTER_MSG_SIZE, 0);
+	
+	if (mkdir (FILTER_CACHE_SPILL_DIR, 0755) && errno != EEXIST) {
 	#endif
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER, "could not create filter cache folder '%s'",
+		            FILTER_CACHE_SPILL_DIR);
+		return;
+	}
+	
+	FILE *f = fopen (fn, "wb");
+	
+	if (!f) {
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER, "could not open filter cache file '%s'", fn);
+		return;
+	}
+	
+	if (fwrite (key, sizeof (filter_cache_key), 1, f) != 1 ||
+	    fwrite (&num_rois, sizeof (nt_abs_count), 1, f) != 1 ||
+	    (num_rois &&
+	     fwrite (posns, sizeof (nt_abs_seq_posn) * 2, num_rois, f) != num_rois)) {
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER, "could not write filter cache file '%s'", fn);
+		fclose (f);
+		remove (fn);
+		return;
+	}
+	
+	fclose (f);
+}
+
+static bool read_filter_cache_spill (const filter_cache_key *key,
+                                     nt_abs_seq_posn **posns, nt_abs_count *num_rois) {
+	char fn[sizeof (FILTER_CACHE_SPILL_DIR) + 20];
+	get_filter_cache_spill_fn (key, fn);
+	FILE *f = fopen (fn, "rb");
+	
+	if (!f) {
+		return false;   // not spilled
+	}
+	
+	filter_cache_key *spilled_key = malloc (sizeof (filter_cache_key));
+	bool success = false;
+	*posns = NULL;
+	
+	if (spilled_key &&
+	    fread (spilled_key, sizeof (filter_cache_key), 1, f) == 1 &&
+	    !memcmp (spilled_key, key, sizeof (filter_cache_key)) &&
+	    fread (num_rois, sizeof (nt_abs_count), 1, f) == 1 &&
+	    *num_rois <= FILTER_CACHE_MAX_NUM_ROIS) {
+		if (!*num_rois) {
+			success = true;
+		}
+		
+		else {
+			*posns = malloc (sizeof (nt_abs_seq_posn) * 2 * *num_rois);
+			success = *posns && fread (*posns, sizeof (nt_abs_seq_posn) * 2, *num_rois,
+			                           f) == *num_rois;
+		}
+	}
+	
+	if (!success) {
+		DEBUG_NOW1 (REPORT_WARNINGS, FILTER, "ignoring invalid filter cache file '%s'",
+		            fn);
+		free (*posns);
+		*posns = NULL;
+	}
+	
+	free (spilled_key);
+	fclose (f);
+	return success;
+}
+#endif
+
+/*
+ * put_cached_rois:
+ *          add the ROI list for the given key to the filter result cache, taking ownership
+ *          of posns; the least recently used entry is evicted (and spilled) if the cache is full
+ */
+static void put_cached_rois (const filter_cache_key *key,
+                             nt_abs_seq_posn *posns, const nt_abs_count num_rois) {
+	filter_cache_entry *evicted = malloc (sizeof (filter_cache_entry));
+	
+	if (!evicted) {
+		free (posns);
+		return;
+	}
+	
+	evicted->last_used = 0;
+	FILTER_LOCK_S
+	REGISTER
+	ushort lru = 0;
+	
+	for (REGISTER ushort i = 0; i < FILTER_CACHE_NUM_ENTRIES; i++) {
+		if (filter_cache[i].last_used &&
+		    !memcmp (&filter_cache[i].key, key, sizeof (filter_cache_key))) {
+			lru = i;    // already (re-)cached by a concurrent job; replace
+			break;
+		}
+		
+		if (filter_cache[i].last_used < filter_cache[lru].last_used) {
+			lru = i;
+		}
+	}
+	
+	if (filter_cache[lru].last_used) {
+		g_memcpy (evicted, &filter_cache[lru], sizeof (filter_cache_entry));
+	}
+	
+	g_memcpy (&filter_cache[lru].key, key, sizeof (filter_cache_key));
+	filter_cache[lru].posns = posns;
+	filter_cache[lru].num_rois = num_rois;
+	filter_cache[lru].last_used = ++filter_cache_clock;
+	FILTER_LOCK_E
+	
+	if (evicted->last_used) {
+		#if FILTER_CACHE_SPILL
+	
+		if (memcmp (&evicted->key, key, sizeof (filter_cache_key))) {
+			spill_filter_cache_entry (&evicted->key, evicted->posns, evicted->num_rois);
+		}
+		
+		#endif
+		free (evicted->posns);
+	}
+	
+	free (evicted);
+}
+
+/*
+ * get_cached_rois:
+ *          look up the ROI list for the given key, in memory or else (when enabled) on disk
+ *
+ * returns: true on a cache hit, with posns set to a copy of the (start, end) pairs (or NULL if none)
+ */
+static bool get_cached_rois (const filter_cache_key *key,
+                             nt_abs_seq_posn **posns, nt_abs_count *num_rois) {
+	bool found = false, copied = true;
+	*posns = NULL;
+	*num_rois = 0;
 	FILTER_LOCK_S
-	sockets_used[this_socket] = false;
+	
+	for (REGISTER ushort i = 0; i < FILTER_CACHE_NUM_ENTRIES; i++) {
+		if (filter_cache[i].last_used &&
+		    !memcmp (&filter_cache[i].key, key, sizeof (filter_cache_key))) {
+			found = true;
+			filter_cache[i].last_used = ++filter_cache_clock;
+			*num_rois = filter_cache[i].num_rois;
+			
+			if (*num_rois) {
+				*posns = malloc (sizeof (nt_abs_seq_posn) * 2 * *num_rois);
+				
+				if (*posns) {
+					g_memcpy (*posns, filter_cache[i].posns,
+					          sizeof (nt_abs_seq_posn) * 2 * *num_rois);
+				}
+				
+				else {
+					copied = false;
+				}
+			}
+			
+			break;
+		}
+	}
+	
+	FILTER_LOCK_E
+	
+	if (found) {
+		return copied;
+	}
+	
+	#if FILTER_CACHE_SPILL
+	nt_abs_seq_posn *spilled_posns = NULL;
+	
+	if (read_filter_cache_spill (key, &spilled_posns, num_rois)) {
+		if (*num_rois) {
+			*posns = malloc (sizeof (nt_abs_seq_posn) * 2 * *num_rois);
+			
+			if (!*posns) {
+				free (spilled_posns);
+				return false;
+			}
+			
+			g_memcpy (*posns, spilled_posns, sizeof (nt_abs_seq_posn) * 2 * *num_rois);
+		}
+		
+		put_cached_rois (key, spilled_posns, *num_rois);
+		return true;
+	}
+	
+	#endif
+	return false;
+}
+
+/*
+ * submit_job_end:
+ *          submit any given (cached) ROIs, followed by the end of job signal;
+ *          a 'null' job is submitted first if the job has no ROIs at all
+ *
+ * returns: true if dispatch acknowledged the end of job (see close_filter_socket)
+ */
+static bool submit_job_end (const nt_rt_bytes job_id, const bool have_one_extent,
+                            const nt_abs_seq_posn *posns, const nt_abs_count num_rois) {
+	filter_batch batch;
+	
+	if (!open_filter_socket (&batch)) {
+		DEBUG_NOW (REPORT_ERRORS, FILTER, "could not submit end of job");
+		return false;
+	}
+	
+	for (REGISTER nt_abs_count i = 0; i < num_rois; i++) {
+		filter_submit_job (&batch, job_id, posns[i * 2], posns[ (i * 2) + 1]);
+	}
+	
+	if (!have_one_extent && !num_rois) {
+		// in case not a single extent has been identified, send anyhow a 'null' search
+		// job request (i.e. a regular job message with start/end posn equal to 0)
+		filter_submit_job (&batch, job_id, 0, 0);
+	}
+	
+	filter_submit_job (&batch, job_id, DISPATCH_NULL_JOB_POSN,
+	                   DISPATCH_NULL_JOB_POSN); // only signal end of job after all threads are finished
+	return close_filter_socket (&batch);
+}
+
+/*
+ * put_filter_stats:
+ *          record the stats of a completed job, replacing those of the oldest job if full;
+ *          the per-thread stats (if any) are taken over and freed once replaced
+ */
+static void put_filter_stats (const filter_job_stats *stats) {
+	FILTER_LOCK_S
+	free (filter_stats[filter_stats_next].threads);
+	g_memcpy (&filter_stats[filter_stats_next], stats, sizeof (filter_job_stats));
+	filter_stats_next = (ushort) ((filter_stats_next + 1) % FILTER_STATS_NUM_JOBS);
+	
+	if (filter_stats_num_jobs < FILTER_STATS_NUM_JOBS) {
+		filter_stats_num_jobs++;
+	}
+	
+	filter_stats_num_puts++;
 	FILTER_LOCK_E
 }
 
@@ -171,7 +736,7 @@ bool initialize_filter (const char *server, const unsigned short port) {
 		return false;
 	}
 	
-	struct addrinfo hints, *addr_result;
+	struct addrinfo hints;
 	
 	g_memset (&hints, 0, sizeof (hints));
 	
@@ -187,45 +752,17 @@ bool initialize_filter (const char *server, const unsigned short port) {
 	
 	sprintf (port_strn, "%d", port);
 	
-	if (getaddrinfo (server, port_strn, &hints, &addr_result) != 0) {
+	if (getaddrinfo (server, port_strn, &hints, &win_server_addr) != 0) {
 		DEBUG_NOW1 (REPORT_ERRORS, FILTER,
 		            "failed to resolve dispatch server address ('%s')", server);
 		DEBUG_NOW (REPORT_INFO, FILTER, "finalizing sockets");
+		win_server_addr = NULL;
 		WSACleanup();
 		DEBUG_NOW (REPORT_INFO, FILTER, "finalizing spinlock");
 		pthread_spin_destroy (&filter_spinlock);
 		return false;
 	}
 	
-	for (uchar i = 0; i < FILTER_NUM_SOCKET_CONNECTIONS; i++) {
-		win_client_socket[i] = socket (hints.ai_family, hints.ai_socktype,
-		                               hints.ai_protocol);
-		                               
-		if (win_client_socket[i] == INVALID_SOCKET ||
-		    connect (win_client_socket[i], addr_result->ai_addr,
-		             (int) addr_result->ai_addrlen) == SOCKET_ERROR) {
-			DEBUG_NOW2 (REPORT_ERRORS, FILTER,
-			            "failed to set up socket connection #%d (error code %d)", i + 1,
-			            WSAGetLastError());
-			DEBUG_NOW (REPORT_INFO, FILTER, "finalizing sockets");
-			
-			if (win_client_socket[i] != INVALID_SOCKET) {
-				closesocket (win_client_socket[i]);
-			}
-			
-			for (uchar j = 0; j < FILTER_NUM_SOCKET_CONNECTIONS; j++) {
-				closesocket (win_client_socket[j]);
-			}
-			
-			freeaddrinfo (addr_result);
-			WSACleanup();
-			DEBUG_NOW (REPORT_INFO, FILTER, "finalizing spinlock");
-			pthread_spin_destroy (&filter_spinlock);
-			return false;
-		}
-	}
-	
-	freeaddrinfo (addr_result);
 	#else
 	struct hostent *server_ent = gethostbyname (server);
 	
@@ -237,96 +774,259 @@ bool initialize_filter (const char *server, const unsigned short port) {
 		return false;
 	}
 	
-	struct sockaddr_in serv_addr;
-	
-	g_memset (&serv_addr, 0, sizeof (serv_addr));
+	g_memset (&unix_server_addr, 0, sizeof (unix_server_addr));
 	
-	serv_addr.sin_family = AF_INET;
+	unix_server_addr.sin_family = AF_INET;
 	
-	g_memcpy ((char *)&serv_addr.sin_addr.s_addr, (char *)server_ent->h_addr,
+	g_memcpy ((char *)&unix_server_addr.sin_addr.s_addr, (char *)server_ent->h_addr,
 	          server_ent->h_length);
+	          
+	unix_server_addr.sin_port = htons (port);
 	
-	serv_addr.sin_port = htons (port);
+	#endif
+	/*
+	 * each filter thread opens its own connection; check once that dispatch can be reached
+	 */
+	filter_batch batch;
 	
-	#if Q_DISABLE_NAGLE
-	int flag = 1;
+	if (!open_filter_socket (&batch)) {
+		DEBUG_NOW (REPORT_ERRORS, FILTER, "failed to set up socket connection");
+		DEBUG_NOW (REPORT_INFO, FILTER, "finalizing sockets");
+		#ifdef _WIN32
+		freeaddrinfo (win_server_addr);
+		win_server_addr = NULL;
+		WSACleanup();
+		#endif
+		DEBUG_NOW (REPORT_INFO, FILTER, "finalizing spinlock");
+		pthread_spin_destroy (&filter_spinlock);
+		return false;
+	}
 	
+	close_filter_socket (&batch);
+	return true;
+}
+
+void finalize_filter() {
+	DEBUG_NOW (REPORT_INFO, FILTER, "finalizing filter");
+	DEBUG_NOW (REPORT_INFO, FILTER, "finalizing sockets");
+	#ifdef _WIN32
+	freeaddrinfo (win_server_addr);
+	win_server_addr = NULL;
+	WSACleanup();
 	#endif
-	for (ushort i = 0; i < FILTER_NUM_SOCKET_CONNECTIONS; i++) {
-		if (((unix_client_socket[i] = socket (AF_INET, SOCK_STREAM, 0)) < 0) ||
-	    #if Q_DISABLE_NAGLE
-		    (setsockopt (unix_client_socket[i], IPPROTO_TCP, TCP_NODELAY, (char *)&flag,
-		                 sizeof (int)) < 0) ||
-	    #endif
-		    (connect (unix_client_socket[i], (struct sockaddr *)&serv_addr,
-		              sizeof (serv_addr)) < 0)) {
-			DEBUG_NOW1 (REPORT_ERRORS, FILTER,
-			            "failed to set up socket connection #%d", i + 1);
-			DEBUG_NOW (REPORT_INFO, FILTER, "finalizing sockets");
+	DEBUG_NOW (REPORT_INFO, FILTER, "finalizing filter stats");
 	
-			if (unix_client_socket[i] >= 0) {
-				close (unix_client_socket[i]);
-			}
+	for (ushort i = 0; i < FILTER_STATS_NUM_JOBS; i++) {
+		free (filter_stats[i].threads);
+		filter_stats[i].threads = NULL;
+	}
 	
-			for (ushort j = 0; j < FILTER_NUM_SOCKET_CONNECTIONS; j++) {
-				close (unix_client_socket[j]);
-			}
+	filter_stats_next = 0;
+	filter_stats_num_jobs = 0;
+	filter_stats_num_puts++;
+	DEBUG_NOW (REPORT_INFO, FILTER, "finalizing filter cache");
 	
-			DEBUG_NOW (REPORT_INFO, FILTER, "finalizing spinlock");
-			pthread_spin_destroy (&filter_spinlock);
-			return false;
+	for (ushort i = 0; i < FILTER_CACHE_NUM_ENTRIES; i++) {
+		if (filter_cache[i].last_used) {
+			#if FILTER_CACHE_SPILL
+			spill_filter_cache_entry (&filter_cache[i].key, filter_cache[i].posns,
+			                          filter_cache[i].num_rois);
+			#endif
+			free (filter_cache[i].posns);
+			filter_cache[i].posns = NULL;
+			filter_cache[i].last_used = 0;
 		}
 	}
 	
-	#endif
+	DEBUG_NOW (REPORT_INFO, FILTER, "finalizing spinlock");
+	
+	if (pthread_spin_destroy (&filter_spinlock)) {
+		DEBUG_NOW (REPORT_ERRORS, FILTER, "could not destroy spinlock");
+	}
+}
+
+static inline bool is_bit_set (const uint64_t *bitset, const unsigned long bit) {
+	return (bitset[bit / FILTER_BITSET_WORD_BITS] >> (bit % FILTER_BITSET_WORD_BITS)) &
+	       1;
+}
+
+static inline void set_bit (uint64_t *bitset, const unsigned long bit) {
+	bitset[bit / FILTER_BITSET_WORD_BITS] |= (uint64_t) 1 << (bit %
+	                                        FILTER_BITSET_WORD_BITS);
+}
+
+static inline uchar get_nt_code (const char c) {
+	switch (c) {
+		case 'a':
+			return FILTER_NT_A;
+			
+		case 'c':
+			return FILTER_NT_C;
+			
+		case 'g':
+			return FILTER_NT_G;
+			
+		case 'u':
+			return FILTER_NT_U;
+			
+		default:
+			return 0;
+	}
+}
+
+static inline uchar get_nt_pair_mask (const char c) {
+	switch (c) {
+		case 'a':
+			return FILTER_NT_U;
+			
+		case 'c':
+			return FILTER_NT_G;
+			
+		case 'g':
+			return FILTER_NT_C | FILTER_NT_U;
+			
+		case 'u':
+			return FILTER_NT_A | FILTER_NT_G;
+			
+		default:
+			return 0;
+	}
+}
+
+/*
+ * encode_seq_for_stacks:
+ *          convert a sequence, once, into per-position pairing masks (5' side)
+ *          and into nt codes in reverse order (3' side), such that the 3' arm
+ *          of any stack is contiguous and runs in the same direction as its 5' arm
+ *
+ * args:    sequence, sequence length,
+ *          pointers to (unallocated) fp_pair_mask and tp_rev_code buffers
+ *
+ * returns: true on success; in which case both buffers must be freed by the caller
+ */
+static bool encode_seq_for_stacks (const char *seq, const nt_abs_seq_len seq_len,
+                                   uchar **fp_pair_mask, uchar **tp_rev_code) {
+	*fp_pair_mask = calloc (seq_len + FILTER_NT_PADDING, sizeof (uchar));
+	*tp_rev_code = calloc (seq_len + FILTER_NT_PADDING, sizeof (uchar));
+	
+	if (!*fp_pair_mask || !*tp_rev_code) {
+		free (*fp_pair_mask);
+		free (*tp_rev_code);
+		return false;
+	}
 	
-	for (uchar i = 0; i < FILTER_NUM_SOCKET_CONNECTIONS; i++) {
-		sockets_used[i] = false;
+	for (REGISTER nt_abs_seq_posn p = 0; p < seq_len; p++) {
+		(*fp_pair_mask)[p] = get_nt_pair_mask (seq[p]);
+		(*tp_rev_code)[seq_len - 1 - p] = get_nt_code (seq[p]);
 	}
 	
 	return true;
 }
 
-void finalize_filter() {
-	DEBUG_NOW (REPORT_INFO, FILTER, "finalizing filter");
-	DEBUG_NOW (REPORT_INFO, FILTER, "finalizing sockets");
-	#ifdef _WIN32
+/*
+ * is_valid_pairing:
+ *          test all bps between the len nt 5' arm starting at fp_posn, and the 3' arm whose
+ *          reverse (see encode_seq_for_stacks) starts at tp_rev_posn, at once; AVX2 or SSE2
+ *          when available, with a scalar fallback
+ */
+static inline bool is_valid_pairing (const uchar *fp_pair_mask,
+                                     const uchar *tp_rev_code,
+                                     const nt_abs_seq_posn fp_posn,
+                                     const nt_abs_seq_posn tp_rev_posn,
+                                     const nt_stack_size len) {
+	REGISTER
+	const uchar *fp = fp_pair_mask + fp_posn, *tp = tp_rev_code + tp_rev_posn;
+	#if defined(__AVX2__)
 	
-	for (uchar i = 0; i < FILTER_NUM_SOCKET_CONNECTIONS; i++) {
-		closesocket (win_client_socket[i]);
+	for (REGISTER nt_stack_size s = 0; s < len; s += 32) {
+		REGISTER
+		uint32_t unpaired = (uint32_t) _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (
+		                                        _mm256_and_si256 (_mm256_loadu_si256 ((const __m256i *) (fp + s)),
+		                                                _mm256_loadu_si256 ((const __m256i *) (tp + s))),
+		                                        _mm256_setzero_si256()));
+		                                        
+		if (len - s < 32) {
+			unpaired &= (1U << (len - s)) - 1;
+		}
+		
+		if (unpaired) {
+			return false;
+		}
 	}
 	
-	WSACleanup();
+	return true;
+	#elif defined(__SSE2__)
+	
+	for (REGISTER nt_stack_size s = 0; s < len; s += 16) {
+		REGISTER
+		uint32_t unpaired = (uint32_t) _mm_movemask_epi8 (_mm_cmpeq_epi8 (
+		                                        _mm_and_si128 (_mm_loadu_si128 ((const __m128i *) (fp + s)),
+		                                                _mm_loadu_si128 ((const __m128i *) (tp + s))),
+		                                        _mm_setzero_si128()));
+		                                        
+		if (len - s < 16) {
+			unpaired &= (1U << (len - s)) - 1;
+		}
+		
+		if (unpaired) {
+			return false;
+		}
+	}
+	
+	return true;
 	#else
 	
-	for (ushort i = 0; i < FILTER_NUM_SOCKET_CONNECTIONS; i++) {
-		close (unix_client_socket[i]);
+	for (REGISTER nt_stack_size s = 0; s < len; s++) {
+		if (! (fp[s] & tp[s])) {
+			return false;
+		}
 	}
 	
+	return true;
 	#endif
-	DEBUG_NOW (REPORT_INFO, FILTER, "finalizing spinlock");
+}
+
+/*
+ * is_valid_stack:
+ *          test all bps of the stack starting at fp_posn, using the encodings from encode_seq_for_stacks
+ */
+static inline bool is_valid_stack (const uchar *fp_pair_mask,
+                                   const uchar *tp_rev_code,
+                                   const nt_abs_seq_len seq_len,
+                                   const nt_abs_seq_posn fp_posn,
+                                   const nt_stack_size stack_size,
+                                   const nt_stack_idist stack_idist) {
+	REGISTER
+	const nt_abs_seq_posn tp_posn = fp_posn + (stack_size * 2) + stack_idist - 1;
 	
-	if (pthread_spin_destroy (&filter_spinlock)) {
-		DEBUG_NOW (REPORT_ERRORS, FILTER, "could not destroy spinlock");
+	if (tp_posn >= seq_len) {  // exceeds most 3'
+		return false;
 	}
+	
+	return is_valid_pairing (fp_pair_mask, tp_rev_code, fp_posn, seq_len - 1 - tp_posn,
+	                         stack_size);
 }
 
-static inline bool is_valid_bp (const char fp_char, const char tp_char) {
-	return ((fp_char == 'g' && (tp_char == 'c' || tp_char == 'u')) ||
-	        (fp_char == 'a' && tp_char == 'u') ||
-	        (tp_char == 'g' && (fp_char == 'c' || fp_char == 'u')) ||
-	        (tp_char == 'a' && fp_char == 'u'));
+static inline uchar get_seq_nt_code (const uchar *tp_rev_code,
+                                     const nt_abs_seq_len seq_len, const nt_abs_seq_posn posn) {
+	return tp_rev_code[seq_len - 1 - posn];
 }
 
-static inline bool get_fp_constraint_string (const char *seq,
-                                        const nt_abs_seq_len seq_len,
-                                        const bool fp_overlaps,
-                                        const nt_abs_seq_posn curr_fp_posn_with_lead,
-                                        const nt_s_rel_count curr_constraint_fp_offset,
-                                        const nt_stack_size curr_constraint_stack_size,
-                                        const nt_stack_size curr_stack_size,
-                                        const nt_stack_idist curr_stack_idist,
-                                        char *fp_strn) {
+/*
+ * get_fp_constraint_posn:
+ *          (0-indexed) position of the first nt of a constraint's fp element, relative to the
+ *          reference stack at curr_fp_posn_with_lead
+ *
+ * returns: false if the fp element does not fit the sequence or the reference stack
+ */
+static inline bool get_fp_constraint_posn (const nt_abs_seq_len seq_len,
+                                           const bool fp_overlaps,
+                                           const nt_abs_seq_posn curr_fp_posn_with_lead,
+                                           const nt_s_rel_count curr_constraint_fp_offset,
+                                           const nt_stack_size curr_constraint_stack_size,
+                                           const nt_stack_size curr_stack_size,
+                                           const nt_stack_idist curr_stack_idist,
+                                           nt_abs_seq_posn *fp_strn_posn) {
 	if (fp_overlaps) {
 		if ((nt_int)curr_constraint_fp_offset + (nt_int)curr_constraint_stack_size >
 		    (nt_int)curr_stack_idist) {
@@ -341,12 +1041,7 @@ static inline bool get_fp_constraint_string (const char *seq,
 			return false;
 		}
 		
-		for (REGISTER
-		     nt_abs_seq_posn p = curr_fp_posn_inside_stack + curr_constraint_fp_offset;
-		     p < curr_fp_posn_inside_stack + curr_constraint_fp_offset +
-		     curr_constraint_stack_size; p++) {
-			fp_strn[p - (curr_fp_posn_inside_stack + curr_constraint_fp_offset)] = seq[p];
-		}
+		*fp_strn_posn = curr_fp_posn_inside_stack + curr_constraint_fp_offset;
 	}
 	
 	else {
@@ -356,15 +1051,8 @@ static inline bool get_fp_constraint_string (const char *seq,
 				return false;
 			}
 			
-			REGISTER
-			nt_stack_size constraint_stack_size = 0;
-			
-			for (REGISTER
-			     nt_abs_seq_posn p = curr_fp_posn_with_lead + curr_constraint_fp_offset -
-			                         curr_constraint_stack_size;
-			     p < curr_fp_posn_with_lead + curr_constraint_fp_offset; p++) {
-				fp_strn[constraint_stack_size++] = seq[p];
-			}
+			*fp_strn_posn = curr_fp_posn_with_lead + curr_constraint_fp_offset -
+			                curr_constraint_stack_size;
 		}
 		
 		else {
@@ -378,28 +1066,30 @@ static inline bool get_fp_constraint_string (const char *seq,
 				return false;
 			}
 			
-			for (REGISTER
-			     nt_abs_seq_posn p = curr_fp_posn_after_stack + curr_constraint_fp_offset;
-			     p <= curr_fp_posn_after_stack + curr_constraint_fp_offset +
-			     curr_constraint_stack_size; p++) {
-				fp_strn[p - (curr_fp_posn_after_stack + curr_constraint_fp_offset)] = seq[p];
-			}
+			*fp_strn_posn = curr_fp_posn_after_stack + curr_constraint_fp_offset;
 		}
 	}
 	
 	return true;
 }
 
-static inline bool get_constraint_string_relative_to_fp_posn (const char *seq,
-                                        const nt_abs_seq_len seq_len,
-                                        const bool el_overlaps,
-                                        const nt_abs_seq_posn curr_fp_posn_with_lead,
-                                        const nt_abs_seq_posn curr_constraint_fp_posn,
-                                        const nt_s_rel_count curr_constraint_dist,
-                                        const nt_stack_size curr_constraint_stack_size,
-                                        const nt_stack_size curr_stack_size,
-                                        const nt_stack_idist curr_stack_idist,
-                                        char *el_strn) {
+/*
+ * get_constraint_posn_relative_to_fp_posn:
+ *          (0-indexed) position of the first nt of a constraint's tp (or single) element,
+ *          at curr_constraint_dist from the constraint's fp element at curr_constraint_fp_posn
+ *
+ * returns: false if the element does not fit the sequence or the containing element
+ */
+static inline bool get_constraint_posn_relative_to_fp_posn (
+                    const nt_abs_seq_len seq_len,
+                    const bool el_overlaps,
+                    const nt_abs_seq_posn curr_fp_posn_with_lead,
+                    const nt_abs_seq_posn curr_constraint_fp_posn,
+                    const nt_s_rel_count curr_constraint_dist,
+                    const nt_stack_size curr_constraint_stack_size,
+                    const nt_stack_size curr_stack_size,
+                    const nt_stack_idist curr_stack_idist,
+                    nt_abs_seq_posn *el_strn_posn) {
 	if (el_overlaps) {
 		/*
 		 * when a constraint overlaps with a containing element, we must check that
@@ -428,13 +1118,7 @@ static inline bool get_constraint_string_relative_to_fp_posn (const char *seq,
 			return false;
 		}
 		
-		REGISTER
-		nt_stack_size constraint_stack_size = 0;
-		
-		for (REGISTER nt_abs_seq_posn p = constraint_start_fp;
-		     p < curr_constraint_fp_posn + curr_constraint_dist; p++) {
-			el_strn[constraint_stack_size++] = seq[p];
-		}
+		*el_strn_posn = (nt_abs_seq_posn) constraint_start_fp;
 	}
 	
 	else {
@@ -446,184 +1130,226 @@ static inline bool get_constraint_string_relative_to_fp_posn (const char *seq,
 			return false;
 		}
 		
-		REGISTER
-		nt_stack_size constraint_stack_size = 0;
-		
-		for (REGISTER
-		     nt_abs_seq_posn p = curr_constraint_fp_posn + curr_constraint_stack_size +
-		                         curr_constraint_dist;
-		     p < curr_constraint_fp_posn + (curr_constraint_stack_size * 2) +
-		     curr_constraint_dist; p++) {
-			el_strn[constraint_stack_size++] = seq[p];
-		}
+		*el_strn_posn = curr_constraint_fp_posn + curr_constraint_stack_size +
+		                curr_constraint_dist;
 	}
 	
 	return true;
 }
 
+/*
+ * test using "right-handedness" base triple assumption
+ *
+ * as per email of Rene C.L. Olsthoorn to A.P. Goultiaev on 13 Nov 2019:
+ * "Anything can form a triple but U.AU and C.GC are isosteric and different from the rest…"
+ *
+ * so the valid single nt codes, indexed by the nt codes of the (right-handed) fp and tp nts
+ */
+static const uchar filter_base_triple_single_mask[FILTER_NT_U + 1][FILTER_NT_U + 1] = {
+	[FILTER_NT_C][FILTER_NT_G] = FILTER_NT_C,
+	[FILTER_NT_U][FILTER_NT_G] = FILTER_NT_C,
+	[FILTER_NT_U][FILTER_NT_A] = FILTER_NT_U
+};
+
 static inline bool has_matching_constraint (
-                    const char *seq,
+                    const uchar *fp_pair_mask,
+                    const uchar *tp_rev_code,
                     const nt_abs_seq_len seq_len,
                     const nt_abs_seq_posn curr_fp_posn_with_lead,
                     const nt_stack_size curr_stack_size, const nt_stack_idist curr_stack_idist,
-                    const nt_s_rel_count constraint_fp_offset_min,
-                    const nt_s_rel_count constraint_fp_offset_max, const bool fp_overlaps,
-                    const nt_s_rel_count constraint_tp_dist_min,
-                    const nt_s_rel_count constraint_tp_dist_max, const bool tp_overlaps,
-                    const nt_s_rel_count constraint_stack_min,
-                    const nt_s_rel_count constraint_single_dist_min,
-                    const nt_s_rel_count constraint_single_dist_max,
+                    const nt_s_rel_count fp_min, const nt_s_rel_count fp_max, const bool fp_overlaps,
+                    const nt_s_rel_count tp_dist_min, const nt_s_rel_count tp_dist_max,
+                    const bool tp_overlaps,
+                    const nt_stack_size constraint_stack_min,
+                    const nt_s_rel_count single_dist_min, const nt_s_rel_count single_dist_max,
                     const bool has_single, const bool single_overlaps) {
-	char fp_strn[MAX_STACK_LEN], tp_strn[MAX_STACK_LEN], single_strn[1];
-	REGISTER
-	nt_s_rel_count fp_min, fp_max, tp_dist_min, tp_dist_max, single_dist_min,
-	               single_dist_max;
-	               
-	// swap constraint min/max when -ve
-	if (constraint_fp_offset_min < constraint_fp_offset_max) {
-		fp_min = constraint_fp_offset_min;
-		fp_max = constraint_fp_offset_max;
-	}
-	
-	else {
-		fp_min = constraint_fp_offset_max;
-		fp_max = constraint_fp_offset_min;
-	}
-	
-	if (constraint_tp_dist_min < constraint_tp_dist_max) {
-		tp_dist_min = constraint_tp_dist_min;
-		tp_dist_max = constraint_tp_dist_max;
-	}
-	
-	else {
-		tp_dist_min = constraint_tp_dist_max;
-		tp_dist_max = constraint_tp_dist_min;
-	}
-	
-	if (constraint_single_dist_min < constraint_single_dist_max) {
-		single_dist_min = constraint_single_dist_min;
-		single_dist_max = constraint_single_dist_max;
-	}
-	
-	else {
-		single_dist_min = constraint_single_dist_max;
-		single_dist_max = constraint_single_dist_min;
-	}
-	
 	// iterate over all fp offset values
 	for (REGISTER nt_s_rel_count constraint_fp_offset = fp_min;
-	     constraint_fp_offset <= fp_max; constraint_fp_offset++)
-	     
+	     constraint_fp_offset <= fp_max; constraint_fp_offset++) {
+		nt_abs_seq_posn fp_strn_posn, tp_strn_posn, single_strn_posn;
+		
+		if (!get_fp_constraint_posn (seq_len, fp_overlaps, curr_fp_posn_with_lead,
+		                             constraint_fp_offset, constraint_stack_min,
+		                             curr_stack_size, curr_stack_idist, &fp_strn_posn)) {
+			continue;
+		}
+		
+		REGISTER
+		nt_abs_seq_posn curr_constraint_fp_posn = 0;
+		
+		if (constraint_fp_offset > 0) {
+			if (fp_overlaps) {
+				curr_constraint_fp_posn = curr_fp_posn_with_lead + curr_stack_size +
+				                          constraint_fp_offset;
+			}
+			
+			else {
+				curr_constraint_fp_posn = curr_fp_posn_with_lead + (curr_stack_size * 2) +
+				                          curr_stack_idist + constraint_fp_offset;
+			}
+		}
+		
+		else {
+			if ((nt_int)curr_fp_posn_with_lead + (nt_int)constraint_fp_offset -
+			    (nt_int)constraint_stack_min < 0) {
+				continue;
+			}
+			
+			curr_constraint_fp_posn = curr_fp_posn_with_lead + constraint_fp_offset -
+			                          constraint_stack_min;
+		}
+		
 		// iterate over all tp dist values
 		for (REGISTER nt_s_rel_count constraint_tp_dist = tp_dist_min;
-		     constraint_tp_dist <= tp_dist_max; constraint_tp_dist++)
-		     
-			// iterate over all single dist values (when element present/dist initialized)
-			for (REGISTER nt_s_rel_count constraint_single_dist = single_dist_min;
-			     constraint_single_dist <= single_dist_max; constraint_single_dist++) {
-				if (get_fp_constraint_string (seq, seq_len,
-				                              fp_overlaps,
-				                              curr_fp_posn_with_lead,
-				                              constraint_fp_offset, constraint_stack_min,
-				                              curr_stack_size, curr_stack_idist,
-				                              fp_strn)) {
-					REGISTER
-					nt_abs_seq_posn curr_constraint_fp_posn = 0;
-					
-					if (constraint_fp_offset > 0) {
-						if (fp_overlaps) {
-							curr_constraint_fp_posn = curr_fp_posn_with_lead + curr_stack_size +
-							                          constraint_fp_offset;
-						}
-						
-						else {
-							curr_constraint_fp_posn = curr_fp_posn_with_lead + (curr_stack_size * 2) +
-							                          curr_stack_idist + constraint_fp_offset;
-						}
-					}
-					
-					else {
-						if ((nt_int)curr_fp_posn_with_lead + (nt_int)constraint_fp_offset -
-						    (nt_int)constraint_stack_min < 0) {
-							continue;
-						}
-						
-						curr_constraint_fp_posn = curr_fp_posn_with_lead + constraint_fp_offset -
-						                          constraint_stack_min;
-					}
-					
-					if (get_constraint_string_relative_to_fp_posn (seq, seq_len,
-					                                        tp_overlaps,
+		     constraint_tp_dist <= tp_dist_max; constraint_tp_dist++) {
+			if (!get_constraint_posn_relative_to_fp_posn (seq_len, tp_overlaps,
+			                                        curr_fp_posn_with_lead,
+			                                        curr_constraint_fp_posn,
+			                                        constraint_tp_dist,
+			                                        constraint_stack_min,
+			                                        curr_stack_size, curr_stack_idist,
+			                                        &tp_strn_posn)) {
+				continue;
+			}
+			
+			if (has_single) {
+				REGISTER
+				const uchar fp_code = get_seq_nt_code (tp_rev_code, seq_len, fp_strn_posn),
+				            tp_code = get_seq_nt_code (tp_rev_code, seq_len, tp_strn_posn);
+				            
+				// iterate over all single dist values
+				for (REGISTER nt_s_rel_count constraint_single_dist = single_dist_min;
+				     constraint_single_dist <= single_dist_max; constraint_single_dist++) {
+					if (get_constraint_posn_relative_to_fp_posn (seq_len, single_overlaps,
 					                                        curr_fp_posn_with_lead,
 					                                        curr_constraint_fp_posn,
-					                                        constraint_tp_dist,
-					                                        constraint_stack_min,
-					                                        curr_stack_size,
-					                                        curr_stack_idist,
-					                                        tp_strn)) {
-						if (!has_single ||
-						    get_constraint_string_relative_to_fp_posn (seq, seq_len,
-						                                            single_overlaps,
-						                                            curr_fp_posn_with_lead,
-						                                            curr_constraint_fp_posn,
-						                                            constraint_single_dist,
-						                                            1,
-						                                            curr_stack_size,
-						                                            curr_stack_idist,
-						                                            single_strn)) {
-							if (has_single) {
-								REGISTER
-								char fp_nt, tp_nt, single_nt = single_strn[0];
-								
-								if (constraint_single_dist > constraint_tp_dist) {
-									// "right-handed" base-triple check
-									fp_nt = fp_strn[0];
-									tp_nt = tp_strn[0];
-								}
-								
-								else {
-									// "left-handed" base-triple check;
-									// swap fp and tp, and then apply same test as "right-handed" bt
-									fp_nt = tp_strn[0];
-									tp_nt = fp_strn[0];
-								}
-								
-								// test using "right-handedness" base triple assumption
-								//
-								// as per email of Rene C.L. Olsthoorn to A.P. Goultiaev on 13 Nov 2019:
-								// "Anything can form a triple but U.AU and C.GC are isosteric and different from the rest…"
-								//
-								if ((fp_nt == 'c' && tp_nt == 'g' && single_nt == 'c') ||
-								    (fp_nt == 'u' && tp_nt == 'g' && single_nt == 'c') ||
-								    (fp_nt == 'u' && tp_nt == 'a' && single_nt == 'u')) {
-									return true;
-								}
-							}
-							
-							else {
-								REGISTER
-								nt_stack_size s = 0;
-								
-								for (; s < constraint_stack_min; s++) {
-									if (!is_valid_bp (fp_strn[s], tp_strn[constraint_stack_min - s - 1])) {
-										break;
-									}
-								}
-								
-								if (s == constraint_stack_min) {
-									return true;
-								}
-							}
-						}
+					                                        constraint_single_dist,
+					                                        1,
+					                                        curr_stack_size, curr_stack_idist,
+					                                        &single_strn_posn) &&
+					    // "right-handed" base-triple check; when "left-handed", swap fp and tp
+					    (get_seq_nt_code (tp_rev_code, seq_len, single_strn_posn) &
+					     (constraint_single_dist > constraint_tp_dist ?
+					      filter_base_triple_single_mask[fp_code][tp_code] :
+					      filter_base_triple_single_mask[tp_code][fp_code]))) {
+						return true;
 					}
 				}
 			}
 			
+			else
+				if (is_valid_pairing (fp_pair_mask, tp_rev_code, fp_strn_posn,
+				                      seq_len - tp_strn_posn - constraint_stack_min, constraint_stack_min)) {
+					return true;
+				}
+		}
+	}
+	
 	return false;
 }
 
-static inline void filter_seq_segment (const uchar thread_id,
+/*
+ * add_filter_seed:
+ *          append a (position, stack size, stack idist) triple to a (growable) seed array
+ */
+static inline bool add_filter_seed (filter_seed **seeds, nt_abs_count *num_seeds,
+                                    nt_abs_count *max_num_seeds, const nt_abs_seq_posn fp_posn,
+                                    const nt_stack_size stack_size, const nt_stack_idist stack_idist) {
+	if (*num_seeds == *max_num_seeds) {
+		const nt_abs_count new_max_num_seeds = *max_num_seeds ? *max_num_seeds * 2 :
+		                                       FILTER_CHUNK_SPAN;
+		filter_seed *more_seeds = realloc (*seeds, sizeof (filter_seed) * new_max_num_seeds);
+		
+		if (!more_seeds) {
+			return false;
+		}
+		
+		*seeds = more_seeds;
+		*max_num_seeds = new_max_num_seeds;
+	}
+	
+	(*seeds)[*num_seeds].fp_posn = fp_posn;
+	(*seeds)[*num_seeds].stack_size = stack_size;
+	(*seeds)[*num_seeds].stack_idist = stack_idist;
+	(*num_seeds)++;
+	return true;
+}
+
+/*
+ * verify_filter_seeds:
+ *          second (verification) phase of filter_seq_segment; each constraint in turn is evaluated
+ *          over all seeds that matched the preceeding constraints, and only seeds that match all
+ *          constraints are retained
+ */
+static void verify_filter_seeds (const uchar *fp_pair_mask,
+                                 const uchar *tp_rev_code,
+                                 const nt_abs_seq_len seq_len,
+                                 const ushort num_constraints,
+                                 const int64_t constraints_offset_and_dist[MAX_CONSTRAINT_MATCHES][4][3],
+                                 filter_seed *seeds, nt_abs_count *num_seeds) {
+	for (REGISTER ushort c = 0; c < num_constraints && *num_seeds; c++) {
+		/*
+		 * for each constraint in the given model, iterate over type of
+		 * detail (min/max offsets from the reference stack's fp position
+		 * for the constraint's fp element and the dist relative to fp
+		 * element for tp/single; for each type of detail an indicator
+		 * is available for whether the element 'overlaps' with the
+		 * reference stack)
+		 *
+		 * notes:
+		 *
+		 * if no single element is present (i.e. not base triple),
+		 * then expect to see 0-valued details
+		 *
+		 * when a constraint fp element 'overlaps' with the reference
+		 * stack, then +ve (relative) distances are wrt to the reference
+		 * stack's 5' position. if the fp element does not 'overlap'
+		 * then (relative) distances are wrt to the reference stack's 3'
+		 * position. -ve (relative) distances are always wrt to the
+		 * reference stack's 5' element (and in the direction 5'->3')
+		 */
+		const bool fp_overlaps = constraints_offset_and_dist[c][0][2],
+		           tp_overlaps = constraints_offset_and_dist[c][1][2],
+		           has_single = constraints_offset_and_dist[c][3][0] &&
+		                        constraints_offset_and_dist[c][3][1],
+		           single_overlaps = has_single && constraints_offset_and_dist[c][3][2];
+		// fp/tp element stack min size
+		const nt_stack_size constraint_stack_min = constraints_offset_and_dist[c][2][0];
+		// swap constraint min/max when -ve; note that single dists are 0-valued whenever
+		// single constraint elements are not present, so that only one iteration is done over them
+		const nt_s_rel_count
+		fp_min = SAFE_MIN (constraints_offset_and_dist[c][0][0], constraints_offset_and_dist[c][0][1]),
+		fp_max = SAFE_MAX (constraints_offset_and_dist[c][0][0], constraints_offset_and_dist[c][0][1]),
+		tp_dist_min = SAFE_MIN (constraints_offset_and_dist[c][1][0], constraints_offset_and_dist[c][1][1]),
+		tp_dist_max = SAFE_MAX (constraints_offset_and_dist[c][1][0], constraints_offset_and_dist[c][1][1]),
+		single_dist_min = has_single ? SAFE_MIN (constraints_offset_and_dist[c][3][0],
+		                                        constraints_offset_and_dist[c][3][1]) : 0,
+		single_dist_max = has_single ? SAFE_MAX (constraints_offset_and_dist[c][3][0],
+		                                        constraints_offset_and_dist[c][3][1]) : 0;
+		REGISTER
+		nt_abs_count num_matched = 0;
+		
+		for (REGISTER nt_abs_count i = 0; i < *num_seeds; i++) {
+			if (has_matching_constraint (fp_pair_mask, tp_rev_code, seq_len,
+			                             seeds[i].fp_posn, seeds[i].stack_size, seeds[i].stack_idist,
+			                             fp_min, fp_max, fp_overlaps,
+			                             tp_dist_min, tp_dist_max, tp_overlaps,
+			                             constraint_stack_min,
+			                             single_dist_min, single_dist_max, has_single, single_overlaps)) {
+				seeds[num_matched++] = seeds[i];
+			}
+		}
+		
+		*num_seeds = num_matched;
+	}
+}
+
+static inline bool filter_seq_segment (const ushort thread_id,
+                                       filter_batch *batch,
+                                       filter_thread_stats *stats,
                                        char *seq,
+                                       const nt_abs_seq_posn seq_seg_abs_posn,
+                                       const nt_abs_count seq_seg_own_span,
                                        const nt_rel_count fp_lead_min_span,
                                        const nt_rel_count fp_lead_max_span,
                                        const nt_stack_size stack_min_size,
@@ -648,25 +1374,57 @@ static inline void filter_seq_segment (const uchar thread_id,
 	if (seq_len >= (fp_lead_min_span + (stack_min_size * 2) + stack_min_idist +
 	                tp_trail_min_span)) {
 		REGISTER
-		nt_abs_seq_posn curr_fp_posn = 0;
-		const unsigned long is_done_size = (seq_len) * (stack_max_size - stack_min_size
-		                                        + 1) * (stack_max_idist - stack_min_idist + 1);
+		nt_abs_seq_posn curr_fp_posn = 0;
+		/*
+		 * is_done tracks visited (position, stack size, stack idist) triples as a rolling window
+		 * bitset; only positions curr_fp_posn+fp_lead_min_span..curr_fp_posn+fp_lead_max_span
+		 * are reachable at any time, so the window spans fp_lead_max_span-fp_lead_min_span+1
+		 * positions, and is indexed by absolute position modulo that span
+		 */
+		const nt_abs_count is_done_num_posns = fp_lead_max_span - fp_lead_min_span + 1;
+		const unsigned long is_done_words_per_posn = (((stack_max_size - stack_min_size + 1) *
+		                                        (stack_max_idist - stack_min_idist + 1)) + FILTER_BITSET_WORD_BITS - 1) /
+		                                        FILTER_BITSET_WORD_BITS;
+		REGISTER
+		uint64_t *is_done = calloc (is_done_num_posns * is_done_words_per_posn,
+		                            sizeof (uint64_t));
+		/*
+		 * is_seed_matched is laid out as for is_done, and rolls along with it; for the triples
+		 * visited from curr_fp_posn, it has the bits set of those that match both stack and all
+		 * constraints (see verify_filter_seeds)
+		 */
 		REGISTER
-		bool *is_done = malloc (is_done_size * sizeof (bool));
+		uint64_t *is_seed_matched = calloc (is_done_num_posns * is_done_words_per_posn,
+		                                    sizeof (uint64_t));
 		bool is_fp_posn_matched[seq_len];
 		nt_rel_count    curr_matched_fp_lead[seq_len];
 		nt_abs_seq_posn curr_matched_fp_tp_extents[seq_len];
 		nt_stack_size   curr_matched_stack_size[seq_len];
 		nt_stack_idist  curr_matched_stack_idist[seq_len];
 		
-		if (!is_done) {
+		uchar *fp_pair_mask = NULL, *tp_rev_code = NULL;
+		/*
+		 * triples still to be visited from curr_fp_posn (i.e. not skipped, nor already visited), and those
+		 * of them that are valid stacks (seeds); both are reused across start positions
+		 */
+		filter_seed *to_visit = NULL, *seeds = NULL;
+		nt_abs_count num_to_visit = 0, max_num_to_visit = 0, num_seeds = 0, max_num_seeds = 0;
+		const nt_abs_count num_fp_posns = SAFE_MIN (seq_seg_own_span,
+		                                        seq_len - (fp_lead_min_span + (stack_min_size * 2) +
+		                                                stack_min_idist + tp_trail_min_span) + 1);
+		unsigned long long start_time = get_real_time(),
+		                   seg_start_time_ns = get_filter_time_ns(), constraint_time_ns = 0;
+		nt_abs_count num_constraint_batches = 0;
+		                   
+		if (!is_done || !is_seed_matched ||
+		    !encode_seq_for_stacks (seq, seq_len, &fp_pair_mask, &tp_rev_code)) {
 			DEBUG_NOW (REPORT_ERRORS, FILTER,
 			           "failed to allocate memory to filter segment");
-			return;
+			free (is_done);
+			free (is_seed_matched);
+			return false;
 		}
 		
-		unsigned long long start_time = get_real_time();
-		memset (is_done, false, is_done_size * sizeof (bool));
 		memset (is_fp_posn_matched, false, seq_len * sizeof (bool));
 		memset (curr_matched_fp_lead, 0, seq_len * sizeof (nt_rel_count));
 		// store curr_matched_fp_tp_extents for convenience, though it is re-calculable
@@ -685,13 +1443,23 @@ static inline void filter_seq_segment (const uchar thread_id,
 		 * curr_fp_posn marks the (0-indexed) most 5' position for the region of interest currently
 		 * under consideration; it ranges between 0 and the most 3' position that might still allow
 		 * for the (shortest possible) match against the model
-		 * (i.e. seq_len-(fp_lead_min_span+(stack_min_size*2)+stack_min_idist+tp_trail_min_span)+1)
+		 * (i.e. seq_len-(fp_lead_min_span+(stack_min_size*2)+stack_min_idist+tp_trail_min_span)+1),
+		 * but never beyond seq_seg_own_span; positions after that are owned by the next segment, and
+		 * are only part of this segment to accomodate models that start within its own span
 		 */
 		for (REGISTER
-		     nt_abs_seq_posn curr_fp_posn = 0;
-		     curr_fp_posn < seq_len - (fp_lead_min_span + (stack_min_size * 2) +
-		                               stack_min_idist + tp_trail_min_span) + 1;
-		     curr_fp_posn++) {
+		     nt_abs_seq_posn curr_fp_posn = 0; curr_fp_posn < num_fp_posns; curr_fp_posn++) {
+			if (curr_fp_posn) {
+				// most 3' reachable position enters the window, reusing the slot of the position just left behind
+				memset (is_done + ((curr_fp_posn + fp_lead_max_span) % is_done_num_posns) *
+				        is_done_words_per_posn, 0, is_done_words_per_posn * sizeof (uint64_t));
+				memset (is_seed_matched + ((curr_fp_posn + fp_lead_max_span) % is_done_num_posns) *
+				        is_done_words_per_posn, 0, is_done_words_per_posn * sizeof (uint64_t));
+			}
+			
+			num_to_visit = 0;
+			num_seeds = 0;
+			
 			/*
 			 * starting from curr_fp_posn, iterate over ranges of fp_lead_span, stack_size, and stack_idist;
 			 * such that we prefer the longest (and most 5') possible matching span, that is, relative to
@@ -706,6 +1474,11 @@ static inline void filter_seq_segment (const uchar thread_id,
 			 *
 			 * also, tp_trail_max_span is assumed throughout, since this minimizes iterations (and memory alloc)
 			 * without incurring much of an 'extra span' penalty
+			 *
+			 * the triples are considered in three phases: first, those not skipped are collected, and of those
+			 * the valid stacks are retained as seeds; then, the seeds are verified against all constraints in
+			 * one batch; finally, the triples collected are visited in order, such that any extents matched
+			 * from curr_fp_posn itself may still skip the remaining (shorter) ones
 			 */
 			
 			/*
@@ -724,13 +1497,15 @@ static inline void filter_seq_segment (const uchar thread_id,
 					 */
 					for (REGISTER nt_s_stack_idist curr_stack_idist = stack_max_idist;
 					     curr_stack_idist >= stack_min_idist; curr_stack_idist--) {
-						if (((curr_fp_posn + curr_fp_lead) * (stack_max_size - stack_min_size + 1) *
-						     (stack_max_idist - stack_min_idist + 1))
-						    + ((curr_stack_size - stack_min_size) * (stack_max_idist - stack_min_idist + 1))
-						    + (curr_stack_idist - stack_min_idist) >= is_done_size) {
+						if (curr_fp_posn + curr_fp_lead >= seq_len) {
 							continue;
 						}
 						
+						const unsigned long is_done_bit = (((curr_fp_posn + curr_fp_lead) %
+						                                        is_done_num_posns) * is_done_words_per_posn * FILTER_BITSET_WORD_BITS)
+						                                  + ((curr_stack_size - stack_min_size) * (stack_max_idist - stack_min_idist + 1))
+						                                  + (curr_stack_idist - stack_min_idist);
+						                                  
 						/*
 						 * avoid making redundant checks by tracking which absolute position (curr_fp_posn+curr_fp_lead),
 						 * relative stack size (curr_stack_size-stack_min_size), and stack idist (curr_stack_idist-stack_min_idist),
@@ -739,7 +1514,7 @@ static inline void filter_seq_segment (const uchar thread_id,
 						 * also if the current "extent" (i.e. relative to the curr_fp_posn and any valid preceeding position, the current
 						 * value stored for the longest match) is greater than or equal to
 						 * curr_fp_posn+curr_fp_lead+(curr_stack_size*2)+curr_stack_idist-1,
-						 * then skip
+						 * then skip; extents are only registered for curr_fp_posn itself in the last phase, below
 						 */
 						bool to_skip = false;
 						nt_abs_seq_posn most_fp_and_valid_position = 0;
@@ -766,145 +1541,135 @@ static inline void filter_seq_segment (const uchar thread_id,
 							}
 						}
 						
-						if (to_skip ||
-						    * (is_done + ((curr_fp_posn + curr_fp_lead) * (stack_max_size - stack_min_size +
-						                                            1) * (stack_max_idist - stack_min_idist + 1))
-						       + ((curr_stack_size - stack_min_size) * (stack_max_idist - stack_min_idist + 1))
-						       + (curr_stack_idist - stack_min_idist))) {
+						if (to_skip || is_bit_set (is_done, is_done_bit)) {
 							skipped++;
 						}
 						
-						else {
-							/*
-							 * have not yet visited this position/stack size/idist; visit and mark it as done
-							 */
-							* (is_done + ((curr_fp_posn + curr_fp_lead) * (stack_max_size - stack_min_size +
-							                                        1) * (stack_max_idist - stack_min_idist + 1))
-							   + ((curr_stack_size - stack_min_size) * (stack_max_idist - stack_min_idist + 1))
-							   + (curr_stack_idist - stack_min_idist)) = true;
-							REGISTER
-							nt_stack_size s = 0;
-							
-							for (; s < curr_stack_size; s++) {
-								if (curr_fp_posn + curr_fp_lead + (curr_stack_size * 2) + curr_stack_idist - s -
-								    1 >= seq_len || 			// exceeds most 3'
-								    !is_valid_bp (seq[curr_fp_posn + curr_fp_lead + s],
-								                  seq[curr_fp_posn + curr_fp_lead + (curr_stack_size * 2) + curr_stack_idist - s -
-								                                   1])) {
-									break;
-								}
-							}
-							
-							if (s == curr_stack_size) {
-								ushort c = 0;
-								
-								for (; c < num_constraints; c++) {
-									/*
-									 * for each constraint in the given model, iterate over type of
-									 * detail (min/max offsets from the reference stack's fp position
-									 * for the constraint's fp element and the dist relative to fp
-									 * element for tp/single; for each type of detail an indicator
-									 * is available for whether the element 'overlaps' with the
-									 * reference stack)
-									 *
-									 * notes:
-									 *
-									 * if no single element is present (i.e. not base triple),
-									 * then expect to see 0-valued details
-									 *
-									 * when a constraint fp element 'overlaps' with the reference
-									 * stack, then +ve (relative) distances are wrt to the reference
-									 * stack's 5' position. if the fp element does not 'overlap'
-									 * then (relative) distances are wrt to the reference stack's 3'
-									 * position. -ve (relative) distances are always wrt to the
-									 * reference stack's 5' element (and in the direction 5'->3')
-									 */
-									REGISTER
-									bool fp_overlaps = false, tp_overlaps = false, single_overlaps = false,
-									     has_single = false;
-									REGISTER
-									nt_stack_size  constraint_stack_min = 0; //, constraint_stack_max=0;
-									REGISTER
-									nt_s_rel_count constraint_fp_offset_min = 0, constraint_fp_offset_max = 0,
-									               constraint_tp_dist_min = 0, constraint_tp_dist_max = 0,
-									               // note: init constraint_single_dist_max===constraint_single_dist_min such that
-									               //       only one iteration is done over the constraint_single_dist loop below
-									               //       whenever single constraint elements are not present
-									               constraint_single_dist_min = 0, constraint_single_dist_max = 0;
-									/*
-									 * for each type of detail, iterate over its min/max values and
-									 * whether it overlaps with the fp element's 'next' elements
-									 */
-									// retrieve offset details (min/max/overlap) of constraint's fp element
-									constraint_fp_offset_min = constraints_offset_and_dist[c][0][0];
-									constraint_fp_offset_max = constraints_offset_and_dist[c][0][1];
-									fp_overlaps = constraints_offset_and_dist[c][0][2];
-									// retrieve dist details relative to fp (min/max/overlap) for constraint's tp element
-									constraint_tp_dist_min = constraints_offset_and_dist[c][1][0];
-									constraint_tp_dist_max = constraints_offset_and_dist[c][1][1];
-									tp_overlaps = constraints_offset_and_dist[c][1][2];
-									// fp/tp element stack min/max size
-									constraint_stack_min = constraints_offset_and_dist[c][2][0];
-									//constraint_stack_max=constraints_offset_and_dist[c][2][1];
-									
-									if (constraints_offset_and_dist[c][3][0] &&
-									    constraints_offset_and_dist[c][3][1]) {
-										// if constraint's single details are present (i.e. non-zero) get dist details
-										// relative to fp (min/max/overlap)
-										has_single = true;
-										constraint_single_dist_min = constraints_offset_and_dist[c][3][0];
-										constraint_single_dist_max = constraints_offset_and_dist[c][3][1];
-										single_overlaps = constraints_offset_and_dist[c][3][2];
-									}
-									
-									if (!has_matching_constraint (seq, seq_len,
-									                              curr_fp_posn + curr_fp_lead,
-									                              curr_stack_size, curr_stack_idist,
-									                              constraint_fp_offset_min, constraint_fp_offset_max, fp_overlaps,
-									                              constraint_tp_dist_min, constraint_tp_dist_max, tp_overlaps,
-									                              constraint_stack_min,
-									                              constraint_single_dist_min, constraint_single_dist_max, has_single,
-									                              single_overlaps)) {
-										break;
-									}
-								}
-								
-								if (c == num_constraints) {
-									num_roi_found++;
-									// register this longer "extent" for curr_fp_posn for comparison in future iterations
-									is_fp_posn_matched[curr_fp_posn] = true;
-									curr_matched_fp_lead[curr_fp_posn] = curr_fp_lead;
-									curr_matched_fp_tp_extents[curr_fp_posn] = curr_fp_posn + curr_fp_lead +
-									                                        (curr_stack_size * 2) + curr_stack_idist - 1;
-									curr_matched_stack_size[curr_fp_posn] = curr_stack_size;
-									curr_matched_stack_idist[curr_fp_posn] = curr_stack_idist;
-									
-									// test and, if present, remove any fully-overlapping, smaller-length extents; note that in this instance
-									// testing is done across the full-length model (i.e. including tp_trail_max_span)
-									for (REGISTER nt_abs_seq_posn p = curr_fp_posn + 1;
-									     p < SAFE_MIN (seq_len - 1,
-									                   curr_matched_fp_tp_extents[curr_fp_posn] + tp_trail_max_span);
-									     p++) {
-										if (is_fp_posn_matched[p] &&
-										    curr_matched_fp_tp_extents[p] <= curr_matched_fp_tp_extents[curr_fp_posn]) {
-											is_fp_posn_matched[p] = false;
-											curr_matched_fp_tp_extents[p] = 0;
-											curr_matched_fp_lead[p] = 0;
-											curr_matched_stack_size[p] = 0;
-											curr_matched_stack_idist[p] = 0;
-										}
-									}
-								}
+						else
+							if (!add_filter_seed (&to_visit, &num_to_visit, &max_num_to_visit,
+							                      curr_fp_posn + curr_fp_lead, curr_stack_size, curr_stack_idist) ||
+							    (is_valid_stack (fp_pair_mask, tp_rev_code, seq_len, curr_fp_posn + curr_fp_lead,
+							                     curr_stack_size, curr_stack_idist) &&
+							     !add_filter_seed (&seeds, &num_seeds, &max_num_seeds,
+							                       curr_fp_posn + curr_fp_lead, curr_stack_size, curr_stack_idist))) {
+								DEBUG_NOW (REPORT_ERRORS, FILTER,
+								           "failed to allocate memory to filter segment seeds");
+								free (is_done);
+								free (is_seed_matched);
+								free (fp_pair_mask);
+								free (tp_rev_code);
+								free (to_visit);
+								free (seeds);
+								return false;
 							}
-							
-							compared++;
+					}
+				}
+			}
+			
+			stats->num_seeds += num_seeds;
+			
+			if (!num_seeds) {
+				// nothing can match from curr_fp_posn, so all triples collected are visited as is
+				for (REGISTER nt_abs_count i = 0; i < num_to_visit; i++) {
+					set_bit (is_done, ((to_visit[i].fp_posn % is_done_num_posns) * is_done_words_per_posn *
+					                   FILTER_BITSET_WORD_BITS)
+					         + ((to_visit[i].stack_size - stack_min_size) * (stack_max_idist - stack_min_idist + 1))
+					         + (to_visit[i].stack_idist - stack_min_idist));
+				}
+				
+				compared += num_to_visit;
+				continue;
+			}
+			
+			if (num_constraints) {
+				// batches are small, so only time one in FILTER_CONSTRAINT_TIME_SAMPLING of them
+				if (! (num_constraint_batches++ % FILTER_CONSTRAINT_TIME_SAMPLING)) {
+					const unsigned long long constraint_start_time_ns = get_filter_time_ns();
+					verify_filter_seeds (fp_pair_mask, tp_rev_code, seq_len, num_constraints,
+					                     constraints_offset_and_dist, seeds, &num_seeds);
+					constraint_time_ns += (get_filter_time_ns() - constraint_start_time_ns) *
+					                      FILTER_CONSTRAINT_TIME_SAMPLING;
+				}
+				
+				else {
+					verify_filter_seeds (fp_pair_mask, tp_rev_code, seq_len, num_constraints,
+					                     constraints_offset_and_dist, seeds, &num_seeds);
+				}
+			}
+			
+			for (REGISTER nt_abs_count i = 0; i < num_seeds; i++) {
+				set_bit (is_seed_matched, ((seeds[i].fp_posn % is_done_num_posns) * is_done_words_per_posn *
+				                           FILTER_BITSET_WORD_BITS)
+				         + ((seeds[i].stack_size - stack_min_size) * (stack_max_idist - stack_min_idist + 1))
+				         + (seeds[i].stack_idist - stack_min_idist));
+			}
+			
+			for (REGISTER nt_abs_count i = 0; i < num_to_visit; i++) {
+				const nt_rel_count curr_fp_lead = to_visit[i].fp_posn - curr_fp_posn;
+				const nt_stack_size curr_stack_size = to_visit[i].stack_size;
+				const nt_stack_idist curr_stack_idist = to_visit[i].stack_idist;
+				
+				// only extents registered for curr_fp_posn (in this phase) can have changed since triples were collected
+				if (is_fp_posn_matched[curr_fp_posn] &&
+				    curr_matched_fp_tp_extents[curr_fp_posn] >= curr_fp_posn + curr_fp_lead +
+				    (curr_stack_size * 2) + curr_stack_idist - 1) {
+					skipped++;
+					continue;
+				}
+				
+				const unsigned long is_done_bit = (((curr_fp_posn + curr_fp_lead) %
+				                                        is_done_num_posns) * is_done_words_per_posn * FILTER_BITSET_WORD_BITS)
+				                                  + ((curr_stack_size - stack_min_size) * (stack_max_idist - stack_min_idist + 1))
+				                                  + (curr_stack_idist - stack_min_idist);
+				                                  
+				/*
+				 * have not yet visited this position/stack size/idist; visit and mark it as done
+				 */
+				set_bit (is_done, is_done_bit);
+				
+				if (is_bit_set (is_seed_matched, is_done_bit)) {
+					num_roi_found++;
+					// register this longer "extent" for curr_fp_posn for comparison in future iterations
+					is_fp_posn_matched[curr_fp_posn] = true;
+					curr_matched_fp_lead[curr_fp_posn] = curr_fp_lead;
+					curr_matched_fp_tp_extents[curr_fp_posn] = curr_fp_posn + curr_fp_lead +
+					                                        (curr_stack_size * 2) + curr_stack_idist - 1;
+					curr_matched_stack_size[curr_fp_posn] = curr_stack_size;
+					curr_matched_stack_idist[curr_fp_posn] = curr_stack_idist;
+					
+					// test and, if present, remove any fully-overlapping, smaller-length extents; note that in this instance
+					// testing is done across the full-length model (i.e. including tp_trail_max_span)
+					for (REGISTER nt_abs_seq_posn p = curr_fp_posn + 1;
+					     p < SAFE_MIN (seq_len - 1,
+					                   curr_matched_fp_tp_extents[curr_fp_posn] + tp_trail_max_span);
+					     p++) {
+						if (is_fp_posn_matched[p] &&
+						    curr_matched_fp_tp_extents[p] <= curr_matched_fp_tp_extents[curr_fp_posn]) {
+							is_fp_posn_matched[p] = false;
+							curr_matched_fp_tp_extents[p] = 0;
+							curr_matched_fp_lead[p] = 0;
+							curr_matched_stack_size[p] = 0;
+							curr_matched_stack_idist[p] = 0;
 						}
 					}
 				}
+				
+				compared++;
 			}
 		}
 		
+		free (to_visit);
+		free (seeds);
 		free (is_done);
+		free (is_seed_matched);
+		free (fp_pair_mask);
+		free (tp_rev_code);
+		stats->compared += compared;
+		stats->skipped += skipped;
+		stats->num_roi_found += num_roi_found;
+		stats->constraint_time_ns += constraint_time_ns;
+		stats->scan_time_ns += get_filter_time_ns() - seg_start_time_ns -
+		                       constraint_time_ns;
 		/*
 		 * at this stage we have retrieved a number of staggered extents, depicted in the following as
 		 * being overlayed on the target sequence segment:
@@ -980,221 +1745,236 @@ static inline void filter_seq_segment (const uchar thread_id,
 		elapsed_time = (get_real_time() - start_time) / 10000000.0f;
 		#endif
 		REGISTER
-		nt_abs_seq_posn start_posn, end_posn;
-		
+		nt_abs_seq_posn start_posn, end_posn,
+		                roi_start_posn = 0, roi_end_posn = 0;   // pending (coalesced) ROI; none when roi_end_posn is 0
+		                
+		/*
+		 * overlapping or adjacent extents are coalesced into a single ROI (i.e. one window to search),
+		 * as long as the coalesced ROI does not exceed FILTER_MAX_ROI_SPAN
+		 */
 		for (REGISTER ushort i = 0; i < seq_len; i++) {
 			if (is_fp_posn_matched[i]) {
 				have_one_extent = true;
-				start_posn = i + 1;
+				start_posn = seq_seg_abs_posn + i + 1;
 				
 				if (i + complete_largest_model_len < seq_len) {
-					DEBUG_NOW4 (REPORT_INFO, FILTER,
-					            "thread %d found extent %03d-%03d for job '%s'", thread_id, i + 1,
-					            i + complete_largest_model_len, job_id);
-					end_posn = i + complete_largest_model_len;
+					end_posn = seq_seg_abs_posn + i + complete_largest_model_len;
 				}
 				
 				else {
-					DEBUG_NOW4 (REPORT_INFO, FILTER,
-					            "thread %d found extent %03d-%03d for job '%s'", thread_id, i + 1, seq_len,
-					            job_id);
-					end_posn = seq_len;
+					end_posn = seq_seg_abs_posn + seq_len;
 				}
 				
-				uchar s = 0, this_socket = 0;
-				FILTER_LOCK_S
+				DEBUG_NOW4 (REPORT_INFO, FILTER,
+				            "thread %d found extent %03d-%03d for job '%s'", thread_id, start_posn,
+				            end_posn, job_id);
+				            
+				if (roi_end_posn && start_posn <= roi_end_posn + 1 &&
+				    SAFE_MAX (end_posn, roi_end_posn) - roi_start_posn + 1 <= FILTER_MAX_ROI_SPAN) {
+					roi_end_posn = SAFE_MAX (end_posn, roi_end_posn);
+				}
 				
-				do {
-					if (!sockets_used[s]) {
-						sockets_used[s] = true;
-						this_socket = s;
-						break;
+				else {
+					if (roi_end_posn) {
+						filter_submit_job (batch, job_id, roi_start_posn, roi_end_posn);
+						stats->num_rois_sent++;
 					}
 					
-					else {
-						s++;
-						
-						if (s == FILTER_NUM_SOCKET_CONNECTIONS) {
-							sleep_ms (FILTER_SOCKET_CONNECT_WAIT);
-							s = 0;
-						}
-					}
-				}
-				while (1);
-				
-				FILTER_LOCK_E
-				uchar buf[FILTER_MSG_SIZE];
-				
-				/*
-				 * packing data order in (32) bytes : [NUM_RT_BYTES x job_id][4 x start_posn][4 x end_posn]
-				 */
-				for (uchar j = 0; j < 4; j++) {
-					buf[  NUM_RT_BYTES + j] = (uchar) ((start_posn >> ((3 - j) * 8)) & 0xff);
-					buf[4 + NUM_RT_BYTES + j] = (uchar) ((end_posn   >> ((3 - j) * 8)) & 0xff);
-				}
-				
-				for (uchar j = 0; j < NUM_RT_BYTES; j++) {
-					buf[j] = (uchar) (job_id[j]);
+					roi_start_posn = start_posn;
+					roi_end_posn = end_posn;
 				}
-				
-				#ifdef _WIN32
-				send (win_client_socket[this_socket], buf, FILTER_MSG_SIZE, 0);
-				#else
-				send (unix_client_socket[this_socket], buf, FILTER_MSG_SIZE, 0);
-				#endif
-				FILTER_LOCK_S
-				sockets_used[this_socket] = false;
-				FILTER_LOCK_E
 			}
 		}
 		
+		if (roi_end_posn) {
+			filter_submit_job (batch, job_id, roi_start_posn, roi_end_posn);
+			stats->num_rois_sent++;
+		}
+		
 		DEBUG_NOW3 (REPORT_INFO, FILTER, "thread %d done with job '%s' in %6.4fs",
 		            thread_id, job_id, elapsed_time);
 	}
 	
-	if (!have_one_extent) {
-		// in case not a single extent has been identified, send anyhow a 'null' search
-		// job request (i.e. a regular job message with start/end posn equal to 0)
-		uchar s = 0, this_socket = 0;
-		FILTER_LOCK_S
-		
-		do {
-			if (!sockets_used[s]) {
-				sockets_used[s] = true;
-				this_socket = s;
-				break;
-			}
-			
-			else {
-				s++;
-				
-				if (s == FILTER_NUM_SOCKET_CONNECTIONS) {
-					sleep_ms (FILTER_SOCKET_CONNECT_WAIT);
-					s = 0;
-				}
-			}
-		}
-		while (1);
-		
-		FILTER_LOCK_E
-		uchar buf[FILTER_MSG_SIZE];
-		
-		/*
-		 * packing data order in (32) bytes : [NUM_RT_BYTES x job_id][4 x start_posn][4 x end_posn]
-		 */
-		for (uchar j = 0; j < 4; j++) {
-			buf[  NUM_RT_BYTES + j] = 0;
-			buf[4 + NUM_RT_BYTES + j] = 0;
-		}
-		
-		for (uchar j = 0; j < NUM_RT_BYTES; j++) {
-			buf[j] = (uchar) (job_id[j]);
-		}
-		
-		#ifdef _WIN32
-		send (win_client_socket[this_socket], buf, FILTER_MSG_SIZE, 0);
-		#else
-		send (unix_client_socket[this_socket], buf, FILTER_MSG_SIZE, 0);
-		#endif
-		FILTER_LOCK_S
-		sockets_used[this_socket] = false;
-		FILTER_LOCK_E
-	}
+	return have_one_extent;
 }
 
-static void *filter_thread (void *arg) {
+/*
+ * get_filter_constraints:
+ *          retrieve, for each constraint in the model, the offset and dist details
+ *          relative to the given target element (see filter_seq_segment)
+ *
+ * returns: true on success, with the number of constraints set in num_constraints
+ */
+static bool get_filter_constraints (const ntp_model model,
+                                    const ntp_element target_element,
+                                    ushort *num_constraints,
+                                    int64_t constraints_offset_and_dist[MAX_CONSTRAINT_MATCHES][4][3]) {
 	bool fp_overlaps = false, tp_overlaps = false, single_overlaps = false;
 	nt_s_rel_count constraint_fp_offset_min = 0, constraint_fp_offset_max = 0,
 	               constraint_tp_dist_min = 0, constraint_tp_dist_max = 0,
 	               constraint_single_dist_min = 0, constraint_single_dist_max = 0;
-	const ntp_element target_element = ((seq_seg_arg *)arg)->el_with_largest_stack;
-	ntp_constraint this_constraint = ((seq_seg_arg *)arg)->model->first_constraint;
-	
-	// check validity of initial characters all at once; thereafter check incrementally
-	for (REGISTER nt_abs_seq_posn
-	     posn = ((seq_seg_arg *)arg)->seq_seg_extra_nt_rel_posn;
-	     posn < ((seq_seg_arg *)arg)->seq_seg_span;
-	     posn++) {
-		if (!is_valid_nt_char (((seq_seg_arg *)arg)->seq_seg[posn])) {
-			DEBUG_NOW3 (REPORT_WARNINGS, FILTER,
-			            "thread %u found illegal character (%c) at position %u",
-			            ((seq_seg_arg *)arg)->thread_id, ((seq_seg_arg *)arg)->seq_seg[posn],
-			            ((seq_seg_arg *)arg)->seq_seg_abs_posn + posn + 1);
-			return NULL;
-		}
-	}
-	
-	DEBUG_NOW5 (REPORT_INFO, FILTER,
-	            "thread %d starting on job '%s' (position %d, length %d, extra nt %d)",
-	            ((seq_seg_arg *)arg)->thread_id, ((seq_seg_arg *)arg)->job_id,
-	            ((seq_seg_arg *)arg)->seq_seg_abs_posn, ((seq_seg_arg *)arg)->seq_seg_span,
-	            ((seq_seg_arg *)arg)->seq_seg_extra_nt_rel_posn);
-	ushort num_constraints = 0;
-	int64_t constraints_offset_and_dist[MAX_CONSTRAINT_MATCHES][4][3];
+	ntp_constraint this_constraint = model->first_constraint;
+	*num_constraints = 0;
 	
 	while (this_constraint) {
 		if (get_next_constraint_offset_and_dist_by_element
 		    (&constraint_fp_offset_min, &constraint_fp_offset_max, &fp_overlaps,
 		     &constraint_tp_dist_min, &constraint_tp_dist_max, &tp_overlaps,
 		     &constraint_single_dist_min, &constraint_single_dist_max, &single_overlaps,
-		     ((seq_seg_arg *)arg)->model, ((seq_seg_arg *)arg)->model->first_element,
-		     target_element, this_constraint)) {
-			constraints_offset_and_dist[num_constraints][0][0] = constraint_fp_offset_min;
-			constraints_offset_and_dist[num_constraints][0][1] = constraint_fp_offset_max;
-			constraints_offset_and_dist[num_constraints][0][2] = fp_overlaps;
-			constraints_offset_and_dist[num_constraints][1][0] = constraint_tp_dist_min;
-			constraints_offset_and_dist[num_constraints][1][1] = constraint_tp_dist_max;
-			constraints_offset_and_dist[num_constraints][1][2] = tp_overlaps;
+		     model, model->first_element, target_element, this_constraint)) {
+			constraints_offset_and_dist[*num_constraints][0][0] = constraint_fp_offset_min;
+			constraints_offset_and_dist[*num_constraints][0][1] = constraint_fp_offset_max;
+			constraints_offset_and_dist[*num_constraints][0][2] = fp_overlaps;
+			constraints_offset_and_dist[*num_constraints][1][0] = constraint_tp_dist_min;
+			constraints_offset_and_dist[*num_constraints][1][1] = constraint_tp_dist_max;
+			constraints_offset_and_dist[*num_constraints][1][2] = tp_overlaps;
 			
 			// note: here we assume base_triple OR pseudoknot types
 			if (this_constraint->type == base_triple) {
-				constraints_offset_and_dist[num_constraints][2][0] =
+				constraints_offset_and_dist[*num_constraints][2][0] =
 				                    this_constraint->base_triple->fp_element->unpaired->min;
-				constraints_offset_and_dist[num_constraints][2][1] =
+				constraints_offset_and_dist[*num_constraints][2][1] =
 				                    this_constraint->base_triple->fp_element->unpaired->max;
 			}
 			
 			else {
-				constraints_offset_and_dist[num_constraints][2][0] =
+				constraints_offset_and_dist[*num_constraints][2][0] =
 				                    this_constraint->pseudoknot->fp_element->unpaired->min;
-				constraints_offset_and_dist[num_constraints][2][1] =
+				constraints_offset_and_dist[*num_constraints][2][1] =
 				                    this_constraint->pseudoknot->fp_element->unpaired->max;
 			}
 			
-			constraints_offset_and_dist[num_constraints][2][2] = 0;
-			constraints_offset_and_dist[num_constraints][3][0] = constraint_single_dist_min;
-			constraints_offset_and_dist[num_constraints][3][1] = constraint_single_dist_max;
-			constraints_offset_and_dist[num_constraints][3][2] = single_overlaps;
-			num_constraints++;
+			constraints_offset_and_dist[*num_constraints][2][2] = 0;
+			constraints_offset_and_dist[*num_constraints][3][0] = constraint_single_dist_min;
+			constraints_offset_and_dist[*num_constraints][3][1] = constraint_single_dist_max;
+			constraints_offset_and_dist[*num_constraints][3][2] = single_overlaps;
+			(*num_constraints)++;
 		}
 		
 		else {
-			return NULL; // TODO: error handling
+			return false;
 		}
 		
 		this_constraint = this_constraint->next;
 	}
 	
+	return true;
+}
+
+/*
+ * get_next_chunk:
+ *          take the next chunk from the front of this worker's own range or,
+ *          once that is exhausted, steal one from the back of another worker's range
+ *
+ * returns: false when no chunks remain in any range
+ */
+static bool get_next_chunk (filter_job *job, const ushort worker_id,
+                            nt_abs_count *chunk) {
+	for (REGISTER ushort w = 0; w < job->num_workers; w++) {
+		filter_chunk_range *range = &job->chunk_ranges[(worker_id + w) %
+		                                                  job->num_workers];
+		bool found = false;
+		
+		if (pthread_spin_lock (&range->lock)) {
+			DEBUG_NOW (REPORT_ERRORS, FILTER, "could not acquire chunk range spinlock");
+			return false;
+		}
+		
+		if (range->next_chunk < range->end_chunk) {
+			if (!w) {
+				*chunk = range->next_chunk++;
+			}
+			
+			else {
+				*chunk = --range->end_chunk;
+			}
+			
+			found = true;
+		}
+		
+		if (pthread_spin_unlock (&range->lock)) {
+			DEBUG_NOW (REPORT_ERRORS, FILTER, "could not release chunk range spinlock");
+			return false;
+		}
+		
+		if (found) {
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+static bool filter_chunk (filter_job *job, const ushort worker_id,
+                          filter_batch *batch, filter_thread_stats *stats,
+                          const nt_abs_count chunk) {
 	REGISTER
-	nt_abs_seq_posn curr_seq_start = ((seq_seg_arg *)arg)->seq_seg_abs_posn,
-	                curr_seq_end = ((seq_seg_arg *)arg)->seq_seg_span - 1;
-	char curr_seq[ ((seq_seg_arg *)arg)->seq_seg_span + 1];
-	g_memcpy (curr_seq, & ((seq_seg_arg *)arg)->seq_seg[curr_seq_start],
-	          (curr_seq_end - curr_seq_start + 1));
-	curr_seq[curr_seq_end - curr_seq_start + 1] = '\0';
-	filter_seq_segment (((seq_seg_arg *)arg)->thread_id,
-	                    curr_seq,
-	                    ((seq_seg_arg *)arg)->fp_lead_min_span,
-	                    ((seq_seg_arg *)arg)->fp_lead_max_span,
-	                    ((seq_seg_arg *)arg)->stack_min_size,
-	                    ((seq_seg_arg *)arg)->stack_max_size,
-	                    ((seq_seg_arg *)arg)->stack_min_idist,
-	                    ((seq_seg_arg *)arg)->stack_max_idist,
-	                    ((seq_seg_arg *)arg)->tp_trail_min_span,
-	                    ((seq_seg_arg *)arg)->tp_trail_max_span,
-	                    num_constraints,
-	                    constraints_offset_and_dist,
-	                    ((seq_seg_arg *) arg)->job_id);
+	const nt_abs_seq_posn chunk_abs_posn = chunk * job->chunk_span;
+	const nt_abs_count chunk_own_span = SAFE_MIN (job->chunk_span,
+	                                        job->seq_size - chunk_abs_posn),
+	                   chunk_seq_span = SAFE_MIN (job->chunk_span + job->chunk_overlap,
+	                                        job->seq_size - chunk_abs_posn);
+	                                        
+	for (REGISTER nt_abs_seq_posn posn = chunk_abs_posn;
+	     posn < chunk_abs_posn + chunk_seq_span; posn++) {
+		if (!is_valid_nt_char (job->seq[posn])) {
+			DEBUG_NOW3 (REPORT_WARNINGS, FILTER,
+			            "thread %u found illegal character (%c) at position %u",
+			            worker_id, job->seq[posn], posn + 1);
+			return false;
+		}
+	}
+	
+	DEBUG_NOW4 (REPORT_INFO, FILTER,
+	            "thread %d starting on job '%s' (position %d, length %d)",
+	            worker_id, job->job_id, chunk_abs_posn, chunk_seq_span);
+	char chunk_seq[chunk_seq_span + 1];
+	g_memcpy (chunk_seq, &job->seq[chunk_abs_posn], chunk_seq_span);
+	chunk_seq[chunk_seq_span] = '\0';
+	stats->num_chunks++;
+	return filter_seq_segment (worker_id,
+	                           batch,
+	                           stats,
+	                           chunk_seq,
+	                           chunk_abs_posn,
+	                           chunk_own_span,
+	                           job->fp_lead_min_span,
+	                           job->fp_lead_max_span,
+	                           job->stack_min_size,
+	                           job->stack_max_size,
+	                           job->stack_min_idist,
+	                           job->stack_max_idist,
+	                           job->tp_trail_min_span,
+	                           job->tp_trail_max_span,
+	                           job->num_constraints,
+	                           (const int64_t (*)[4][3])job->constraints_offset_and_dist,
+	                           job->job_id);
+}
+
+static void *filter_thread (void *arg) {
+	filter_worker_arg *worker = (filter_worker_arg *)arg;
+	nt_abs_count chunk;
+	filter_batch batch;
+	
+	if (!open_filter_socket (&batch)) {
+		// leave this worker's chunks to be stolen by the other workers
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER, "filter worker #%u could not connect to dispatch",
+		            worker->worker_id);
+		return NULL;
+	}
+	
+	worker->connected = true;
+	batch.rois = &worker->rois;
+	batch.stats = &worker->stats;
+	
+	while (get_next_chunk (worker->job, worker->worker_id, &chunk)) {
+		if (filter_chunk (worker->job, worker->worker_id, &batch, &worker->stats,
+		                  chunk)) {
+			worker->have_one_extent = true;
+		}
+	}
+	
+	worker->acknowledged = close_filter_socket (&batch);
 	return NULL;
 }
 
@@ -1207,48 +1987,109 @@ bool filter_seq (const char *seq_buff,
                  const nt_stack_idist stack_min_idist, const nt_stack_idist stack_max_idist,
                  const nt_rel_count tp_trail_min_span, const nt_rel_count tp_trail_max_span,
                  nt_rt_bytes job_id) {
-	uchar num_threads = (uchar) SAFE_MAX (SAFE_MIN ((ulong) floor (pow (10,
-	                                        ((log10 (seq_buff_size) / M_E) - 1))), MAX_NUM_FILTER_THREADS),
-	                                      MIN_NUM_FILTER_THREADS);
-	                                      
-	if (seq_buff_size < (fp_lead_max_span + (stack_max_size * 2) + stack_max_idist +
-	                     tp_trail_max_span) + (num_threads - 1) + num_threads) {
-		seq_seg_arg thread_args;
-		thread_args.seq_seg = &seq_buff[0];
-		thread_args.seq_seg_abs_posn = 0;
-		thread_args.fp_lead_min_span = fp_lead_min_span;
-		thread_args.fp_lead_max_span = fp_lead_max_span;
-		thread_args.stack_min_size = stack_min_size;
-		thread_args.stack_max_size = stack_max_size;
-		thread_args.stack_min_idist = stack_min_idist;
-		thread_args.stack_max_idist = stack_max_idist;
-		thread_args.tp_trail_min_span = tp_trail_min_span;
-		thread_args.tp_trail_max_span = tp_trail_max_span;
-		thread_args.thread_id = 0;
-		thread_args.seq_seg_span = (nt_abs_count) seq_buff_size;
-		thread_args.seq_seg_extra_nt_rel_posn = 0;
-		thread_args.model = model;
-		thread_args.el_with_largest_stack = el_with_largest_stack;
-		g_memcpy (thread_args.job_id, job_id, NUM_RT_BYTES);
-		filter_thread (&thread_args);
-		filter_submit_null_job (job_id); // signal end of job
-		return true;
+	filter_job job;
+	job.seq = seq_buff;
+	job.seq_size = seq_buff_size;
+	job.fp_lead_min_span = fp_lead_min_span;
+	job.fp_lead_max_span = fp_lead_max_span;
+	job.stack_min_size = stack_min_size;
+	job.stack_max_size = stack_max_size;
+	job.stack_min_idist = stack_min_idist;
+	job.stack_max_idist = stack_max_idist;
+	job.tp_trail_min_span = tp_trail_min_span;
+	job.tp_trail_max_span = tp_trail_max_span;
+	g_memcpy (job.job_id, job_id, NUM_RT_BYTES);
+	job.job_id[NUM_RT_BYTES] = '\0';
+	const unsigned long long job_start_time_ns = get_filter_time_ns();
+	
+	if (!get_filter_constraints (model, el_with_largest_stack, &job.num_constraints,
+	                             job.constraints_offset_and_dist)) {
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER,
+		            "could not retrieve constraint details for job '%s'", job.job_id);
+		return false;
+	}
+	
+	filter_cache_key *cache_key = malloc (sizeof (filter_cache_key));
+	nt_abs_seq_posn *cached_posns;
+	nt_abs_count num_cached_rois;
+	filter_job_stats job_stats;
+	g_memset (&job_stats, 0, sizeof (filter_job_stats));
+	g_memcpy (job_stats.job_id, job.job_id, NUM_RT_BYTES + 1);
+	job_stats.seq_size = seq_buff_size;
+	
+	if (!cache_key) {
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER,
+		            "could not allocate filter cache key for job '%s'", job.job_id);
+		return false;
+	}
+	
+	get_filter_cache_key (&job, cache_key);
+	
+	if (get_cached_rois (cache_key, &cached_posns, &num_cached_rois)) {
+		DEBUG_NOW2 (REPORT_INFO, FILTER,
+		            "found %u cached extents for job '%s'", num_cached_rois, job.job_id);
+		const bool submitted = submit_job_end (job_id, false, cached_posns,
+		                                       num_cached_rois);
+		job_stats.cache_hit = true;
+		job_stats.threads = calloc (1, sizeof (filter_thread_stats));
+		
+		if (job_stats.threads) {
+			job_stats.num_threads = 1;
+			job_stats.threads[0].num_rois_sent = num_cached_rois;
+		}
+		
+		job_stats.elapsed_time_ns = get_filter_time_ns() - job_start_time_ns;
+		put_filter_stats (&job_stats);
+		free (cached_posns);
+		free (cache_key);
+		return submitted;
 	}
 	
 	/*
-	 * note: extra span for each of the num_threads (excluding any trailing nts for the first (rather than, last) thread):
-	 *
-	 * any 'region of interest' returned by any thread MUST accomodate and encompass the smallest stack size of the
-	 * largest stack in the model, in addition to its maximal stack idist, and maximal leading and trailing spans
-	*/
-	ushort least_span = (ushort) (fp_lead_max_span + (stack_min_size * 2) +
-	                              stack_max_idist + tp_trail_max_span);
-	ushort extra_span = (ushort) ((seq_buff_size - (num_threads - 1) -
-	                               (least_span)) / (float)num_threads);
-	ushort thread_span = (ushort) (least_span + extra_span);
-	pthread_t thread_handles[num_threads];
-	seq_seg_arg thread_args[num_threads];
-	nt_abs_seq_posn current_abs_posn = 0;
+	 * note: any 'region of interest' returned by any chunk MUST accomodate and encompass the largest model
+	 * conformation that starts within its own span, so the overlap spans the largest model length less 1
+	 */
+	job.chunk_span = FILTER_CHUNK_SPAN;
+	job.chunk_overlap = fp_lead_max_span + (stack_max_size * 2) + stack_max_idist +
+	                    tp_trail_max_span - 1;
+	job.num_chunks = SAFE_MAX ((seq_buff_size + FILTER_CHUNK_SPAN - 1) /
+	                           FILTER_CHUNK_SPAN, 1U);
+	job.num_workers = (ushort) SAFE_MIN (SAFE_MAX ((nt_abs_count) get_num_cores(),
+	                                        MIN_NUM_FILTER_THREADS), job.num_chunks);
+	filter_chunk_range chunk_ranges[job.num_workers];
+	filter_worker_arg worker_args[job.num_workers];
+	pthread_t thread_handles[job.num_workers];
+	job.chunk_ranges = chunk_ranges;
+	
+	for (REGISTER ushort i = 0; i < job.num_workers; i++) {
+		chunk_ranges[i].next_chunk = (nt_abs_count) (((uint64_t) job.num_chunks * i) /
+		                                        job.num_workers);
+		chunk_ranges[i].end_chunk = (nt_abs_count) (((uint64_t) job.num_chunks *
+		                                        (i + 1)) / job.num_workers);
+		                                        
+		if (pthread_spin_init (&chunk_ranges[i].lock, PTHREAD_PROCESS_PRIVATE)) {
+			DEBUG_NOW (REPORT_ERRORS, FILTER, "failed to initialize chunk range spinlock");
+			
+			for (ushort j = 0; j < i; j++) {
+				pthread_spin_destroy (&chunk_ranges[j].lock);
+			}
+			
+			free (cache_key);
+			return false;
+		}
+		
+		worker_args[i].job = &job;
+		worker_args[i].worker_id = i;
+		worker_args[i].connected = false;
+		worker_args[i].acknowledged = false;
+		worker_args[i].have_one_extent = false;
+		worker_args[i].rois.posns = NULL;
+		worker_args[i].rois.num_rois = 0;
+		worker_args[i].rois.max_num_rois = 0;
+		worker_args[i].rois.overflow = false;
+		g_memset (&worker_args[i].stats, 0, sizeof (filter_thread_stats));
+	}
+	
 	#if PRIVILEGED_SCHED
 	pthread_attr_t thread_attr;
 	int thread_setup_ret_value = pthread_attr_init (&thread_attr);
@@ -1257,7 +2098,7 @@ bool filter_seq (const char *seq_buff,
 		DEBUG_NOW1 (REPORT_ERRORS, FILTER,
 		            "could not create thread attribute (error code %d)",
 		            thread_setup_ret_value);
-		return false;
+		goto filter_seq_fail;
 	}
 	
 	thread_setup_ret_value = pthread_attr_setschedpolicy (&thread_attr, SCHED_FIFO);
@@ -1267,7 +2108,7 @@ bool filter_seq (const char *seq_buff,
 		            "could not set scheduler policy (error code %d)",
 		            thread_setup_ret_value);
 		pthread_attr_destroy (&thread_attr);
-		return false;
+		goto filter_seq_fail;
 	}
 	
 	thread_setup_ret_value = pthread_attr_setinheritsched (&thread_attr,
@@ -1278,7 +2119,7 @@ bool filter_seq (const char *seq_buff,
 		            "could not set inherit scheduler attribute (error code %d)",
 		            thread_setup_ret_value);
 		pthread_attr_destroy (&thread_attr);
-		return false;
+		goto filter_seq_fail;
 	}
 	
 	struct sched_param sched_param;
@@ -1291,7 +2132,7 @@ bool filter_seq (const char *seq_buff,
 		            "could not retrieve current scheduler parameters (error code %d)",
 		            thread_setup_ret_value);
 		pthread_attr_destroy (&thread_attr);
-		return false;
+		goto filter_seq_fail;
 	}
 	
 	sched_param.sched_priority = THREAD_SCHED_PRIO;
@@ -1303,79 +2144,232 @@ bool filter_seq (const char *seq_buff,
 		            "could not set scheduler parameters (error code %d)",
 		            thread_setup_ret_value);
 		pthread_attr_destroy (&thread_attr);
-		return false;
+		goto filter_seq_fail;
 	}
 	
 	#endif
 	
-	for (REGISTER uchar i = 0; i < num_threads; i++) {
-		thread_args[i].seq_seg = &seq_buff[current_abs_posn];
-		thread_args[i].seq_seg_abs_posn = current_abs_posn;
-		thread_args[i].fp_lead_min_span = fp_lead_min_span;
-		thread_args[i].fp_lead_max_span = fp_lead_max_span;
-		thread_args[i].stack_min_size = stack_min_size;
-		thread_args[i].stack_max_size = stack_max_size;
-		thread_args[i].stack_min_idist = stack_min_idist;
-		thread_args[i].stack_max_idist = stack_max_idist;
-		thread_args[i].tp_trail_min_span = tp_trail_min_span;
-		thread_args[i].tp_trail_max_span = tp_trail_max_span;
-		thread_args[i].model = model;
-		thread_args[i].el_with_largest_stack = el_with_largest_stack;
-		thread_args[i].thread_id = i;
-		g_memcpy (thread_args[i].job_id, job_id, NUM_RT_BYTES);
-		
-		if (!i) {
-			// first thread also takes on 'delta' between (Nthreads-1)*thread_span and seq_buff_size
-			thread_args[i].seq_seg_span = (nt_abs_seq_len) (seq_buff_size - ((
-			                                        num_threads - 1) * (extra_span + 1)));
-			thread_args[i].seq_seg_extra_nt_rel_posn = 0;
-			current_abs_posn = (nt_abs_seq_len) thread_args[i].seq_seg_span -
-			                   (least_span - 1);
-		}
-		
-		else {
-			thread_args[i].seq_seg_span = thread_span;
-			thread_args[i].seq_seg_extra_nt_rel_posn = (nt_abs_seq_posn) (
-			                                        thread_args[i - 1].seq_seg_abs_posn + thread_args[i - 1].seq_seg_span -
-			                                        current_abs_posn);
-			current_abs_posn += thread_span - (least_span - 1);
-		}
-		
+	for (REGISTER ushort i = 0; i < job.num_workers; i++) {
 		#if PRIVILEGED_SCHED
-		
+	
 		if (pthread_create (&thread_handles[i], &thread_attr, filter_thread,
-		                    &thread_args[i]))
+		                    &worker_args[i]))
 		#else
-		if (pthread_create (&thread_handles[i], NULL, filter_thread, &thread_args[i]))
+		if (pthread_create (&thread_handles[i], NULL, filter_thread, &worker_args[i]))
 		#endif
 		{
 			DEBUG_NOW1 (REPORT_ERRORS, FILTER,
 			            "could not start thread #%u. joining any existing threads", i);
 			void *join_ret_value;
 			
-			for (uchar j = 0; j < i; j++) {
+			for (ushort j = 0; j < i; j++) {
 				pthread_join (thread_handles[j], &join_ret_value);
 			}
 			
 			#if PRIVILEGED_SCHED
 			pthread_attr_destroy (&thread_attr);
 			#endif
-			return false;
+			goto filter_seq_fail;
 		}
 	}
 	
 	void *join_ret_value;
+	bool have_one_extent = false, rois_overflow = false, connected = false,
+	     acknowledged = true, submitted = false;
+	nt_abs_count num_rois = 0;
 	
-	for (REGISTER uchar i = 0; i < num_threads; i++) {
+	for (REGISTER ushort i = 0; i < job.num_workers; i++) {
 		pthread_join (thread_handles[i], &join_ret_value);
+		connected |= worker_args[i].connected;
+		acknowledged &= !worker_args[i].connected || worker_args[i].acknowledged;
+		have_one_extent |= worker_args[i].have_one_extent;
+		rois_overflow |= worker_args[i].rois.overflow;
+		num_rois += worker_args[i].rois.num_rois;
+		pthread_spin_destroy (&chunk_ranges[i].lock);
 	}
 	
-	filter_submit_null_job (
-	                    job_id); // only signal end of job after all threads are finished
 	#if PRIVILEGED_SCHED
 	pthread_attr_destroy (&thread_attr);
 	#endif
-	return true;
+	
+	// ROIs not known to have been processed by dispatch could follow the end of job signal
+	if (acknowledged) {
+		submitted = submit_job_end (job_id, have_one_extent, NULL, 0);
+	}
+	
+	else {
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER,
+		            "dispatch did not acknowledge all ROIs of job '%s'; failing job", job.job_id);
+	}
+	
+	job_stats.elapsed_time_ns = get_filter_time_ns() - job_start_time_ns;
+	job_stats.threads = malloc (sizeof (filter_thread_stats) * job.num_workers);
+	
+	if (job_stats.threads) {
+		job_stats.num_threads = job.num_workers;
+		
+		for (REGISTER ushort i = 0; i < job.num_workers; i++) {
+			g_memcpy (&job_stats.threads[i], &worker_args[i].stats, sizeof (filter_thread_stats));
+		}
+	}
+	
+	put_filter_stats (&job_stats);
+	
+	if (!connected) {
+		DEBUG_NOW1 (REPORT_ERRORS, FILTER,
+		            "no filter worker could connect to dispatch for job '%s'", job.job_id);
+	}
+	
+	/*
+	 * cache the complete ROI list of this job, if not too large
+	 */
+	if (connected && acknowledged && !rois_overflow &&
+	    num_rois <= FILTER_CACHE_MAX_NUM_ROIS) {
+		nt_abs_seq_posn *posns = NULL;
+		
+		if (num_rois) {
+			posns = malloc (sizeof (nt_abs_seq_posn) * 2 * num_rois);
+		}
+		
+		if (posns || !num_rois) {
+			nt_abs_count posn_offset = 0;
+			
+			for (REGISTER ushort i = 0; i < job.num_workers; i++) {
+				if (worker_args[i].rois.num_rois) {
+					g_memcpy (posns + posn_offset, worker_args[i].rois.posns,
+					          sizeof (nt_abs_seq_posn) * 2 * worker_args[i].rois.num_rois);
+					posn_offset += worker_args[i].rois.num_rois * 2;
+				}
+			}
+			
+			put_cached_rois (cache_key, posns, num_rois);
+		}
+	}
+	
+	for (REGISTER ushort i = 0; i < job.num_workers; i++) {
+		free (worker_args[i].rois.posns);
+	}
+	
+	free (cache_key);
+	return submitted;
+filter_seq_fail:
+
+	for (REGISTER ushort i = 0; i < job.num_workers; i++) {
+		pthread_spin_destroy (&chunk_ranges[i].lock);
+		free (worker_args[i].rois.posns);
+	}
+	
+	free (cache_key);
+	return false;
+}
+
+/*
+ * get_filter_stats:
+ *          copy the stats of up to max_num_jobs most recent jobs (newest first) into stats;
+ *          returns the number of jobs copied, to be released with free_filter_stats
+ *
+ * notes:   per-thread stats are allocated outside of the spinlock; if any job is recorded
+ *          meanwhile, the ring buffer is read again
+ */
+ushort get_filter_stats (filter_job_stats *stats, const ushort max_num_jobs) {
+	ushort num_jobs;
+	unsigned long long num_puts = 0;
+	bool is_current, is_retry;
+	
+	do {
+		num_jobs = 0;
+		FILTER_LOCK_S
+		num_jobs = SAFE_MIN (max_num_jobs, filter_stats_num_jobs);
+		num_puts = filter_stats_num_puts;
+		
+		for (REGISTER ushort i = 0; i < num_jobs; i++) {
+			g_memcpy (&stats[i], &filter_stats[ (filter_stats_next + FILTER_STATS_NUM_JOBS - 1 - i) %
+			                                    FILTER_STATS_NUM_JOBS], sizeof (filter_job_stats));
+		}
+		
+		FILTER_LOCK_E
+		
+		for (REGISTER ushort i = 0; i < num_jobs; i++) {
+			stats[i].threads = NULL;
+			
+			if (stats[i].num_threads) {
+				stats[i].threads = malloc (sizeof (filter_thread_stats) * stats[i].num_threads);
+			}
+			
+			if (!stats[i].threads) {
+				stats[i].num_threads = 0;
+			}
+		}
+		
+		is_current = false;
+		is_retry = false;
+		FILTER_LOCK_S
+		is_current = num_puts == filter_stats_num_puts;
+		is_retry = !is_current;
+		
+		for (REGISTER ushort i = 0; is_current && i < num_jobs; i++) {
+			if (stats[i].threads) {
+				g_memcpy (stats[i].threads, filter_stats[ (filter_stats_next + FILTER_STATS_NUM_JOBS - 1
+				                                        - i) % FILTER_STATS_NUM_JOBS].threads,
+				          (int) (sizeof (filter_thread_stats) * stats[i].num_threads));
+			}
+		}
+		
+		FILTER_LOCK_E
+		
+		if (!is_current) {
+			free_filter_stats (stats, num_jobs);
+			num_jobs = 0;
+		}
+	}
+	while (is_retry);
+	
+	return num_jobs;
+}
+
+void free_filter_stats (filter_job_stats *stats, const ushort num_jobs) {
+	for (REGISTER ushort i = 0; i < num_jobs; i++) {
+		free (stats[i].threads);
+		stats[i].threads = NULL;
+	}
+}
+
+/*
+ * dump_filter_stats:
+ *          print a per-job, per-thread summary of the recent filter stats to f
+ */
+void dump_filter_stats (FILE *f) {
+	filter_job_stats *stats = malloc (sizeof (filter_job_stats) * FILTER_STATS_NUM_JOBS);
+	
+	if (!stats) {
+		DEBUG_NOW (REPORT_ERRORS, FILTER, "could not allocate filter stats");
+		return;
+	}
+	
+	const ushort num_jobs = get_filter_stats (stats, FILTER_STATS_NUM_JOBS);
+	
+	for (REGISTER ushort i = 0; i < num_jobs; i++) {
+		fprintf (f, "job %s: seq_size=%u cache_hit=%d elapsed=%.3fms threads=%u\n",
+		         stats[i].job_id, stats[i].seq_size, stats[i].cache_hit,
+		         (double) stats[i].elapsed_time_ns / 1e6, stats[i].num_threads);
+		         
+		for (REGISTER ushort t = 0; t < stats[i].num_threads; t++) {
+			const filter_thread_stats *ts = &stats[i].threads[t];
+			fprintf (f,
+			         "  thread %2u: chunks=%llu seeds=%llu compared=%llu skipped=%llu found=%llu sent=%llu "
+			         "scan=%.3fms constraints=%.3fms send=%.3fms\n",
+			         t, ts->num_chunks, ts->num_seeds, ts->compared, ts->skipped, ts->num_roi_found,
+			         ts->num_rois_sent, (double) ts->scan_time_ns / 1e6,
+			         (double) ts->constraint_time_ns / 1e6, (double) ts->send_time_ns / 1e6);
+		}
+		
+		if (stats[i].cache_hit) {
+			fprintf (f, "  (cached)\n");
+		}
+	}
+	
+	free_filter_stats (stats, num_jobs);
+	free (stats);
 }
 
 bool filter_seq_from_file (const char *fn,
@@ -1385,23 +2379,53 @@ bool filter_seq_from_file (const char *fn,
                            const nt_stack_size stack_min_size, const nt_stack_size stack_max_size,
                            const nt_stack_idist stack_min_idist, const nt_stack_idist stack_max_idist,
                            const nt_rel_count tp_trail_min_span, const nt_rel_count tp_trail_max_span) {
-	char *buff = NULL;
-	nt_file_size fsize;
+	fasta_reader reader;
+	nt_file_size seq_len;
+	FASTA_RECORD_STATUS status;
+	REGISTER
+	bool success = true;
+	REGISTER
+	nt_abs_count num_records = 0;
 	
-	if (!read_seq_from_fn (fn, &buff, &fsize)) {
+	if (!open_fasta (fn, &reader)) {
 		DEBUG_NOW1 (REPORT_ERRORS, FILTER, "could not read sequence from file '%s'",
 		            fn);
 		return false;
 	}
 	
-	// TODO: check file size limits
-	nt_rt_bytes rt_bytes;
-	get_real_time_bytes (&rt_bytes);
-	bool success = filter_seq (buff, (nt_abs_count) fsize, model,
-	                           el_with_largest_stack,
-	                           fp_lead_min_span, fp_lead_max_span, stack_min_size, stack_max_size,
-	                           stack_min_idist, stack_max_idist, tp_trail_min_span, tp_trail_max_span,
-	                           rt_bytes);
-	free (buff);
+	// stream (FASTA) records one at a time into filter_seq, each as a job of its own
+	while (FASTA_RECORD_READ == (status = read_next_fasta_record (&reader, &seq_len))) {
+		num_records++;
+		
+		if (!seq_len) {
+			DEBUG_NOW2 (REPORT_WARNINGS, FILTER, "skipping empty record #%u in file '%s'",
+			            num_records, fn);
+			continue;
+		}
+		
+		nt_rt_bytes rt_bytes;
+		get_real_time_bytes (&rt_bytes);
+		DEBUG_NOW4 (REPORT_INFO, FILTER, "filtering record #%u ('%.*s') in file '%s'",
+		            num_records, reader.name ? (int) SAFE_MIN (reader.name_len, 64) : 0,
+		            reader.name ? reader.name : "", fn);
+		            
+		if (!filter_seq (reader.seq, (nt_abs_count) seq_len, model,
+		                 el_with_largest_stack,
+		                 fp_lead_min_span, fp_lead_max_span, stack_min_size, stack_max_size,
+		                 stack_min_idist, stack_max_idist, tp_trail_min_span, tp_trail_max_span,
+		                 rt_bytes)) {
+			DEBUG_NOW2 (REPORT_ERRORS, FILTER, "failed to filter record #%u in file '%s'",
+			            num_records, fn);
+			success = false;
+		}
+	}
+	
+	if (FASTA_RECORD_ERROR == status) {
+		DEBUG_NOW2 (REPORT_ERRORS, FILTER, "could not read record #%u in file '%s'",
+		            num_records + 1, fn);
+		success = false;
+	}
+	
+	close_fasta (&reader);
 	return success;
 }
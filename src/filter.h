@@ -8,12 +8,51 @@
 
 #define PRIVILEGED_SCHED    false
 
-#define FILTER_MSG_SIZE     32
+// filter result (ROI list) cache: when enabled, evicted entries (and all entries at finalize_filter)
+// are spilled to disk and re-read on a later miss
+#define FILTER_CACHE_SPILL          false
+#define FILTER_CACHE_SPILL_DIR      "filter_cache"
+
+/*
+ * ROIs are sent to dispatch in batches: a (4-byte, big endian) count of the
+ * number of messages that follow, then that many FILTER_MSG_SIZE messages
+ */
+#define FILTER_MSG_SIZE             32
+#define FILTER_BATCH_HEADER_SIZE    4
+#define FILTER_BATCH_MAX_NUM_MSGS   256
+#define FILTER_BATCH_MAX_SIZE       (FILTER_BATCH_HEADER_SIZE + (FILTER_BATCH_MAX_NUM_MSGS * FILTER_MSG_SIZE))
 
 #if PRIVILEGED_SCHED
 	#define THREAD_SCHED_PRIO   50
 #endif
 
+/*
+ * filter instrumentation; statistics are kept for the FILTER_STATS_NUM_JOBS most recent jobs
+ */
+#define FILTER_STATS_NUM_JOBS           32
+
+typedef struct {
+	unsigned long long
+	num_chunks,
+	num_seeds,                       // valid stacks found in the seed phase (before constraint verification)
+	compared,                        // (position, stack size, stack idist) triples tested
+	skipped,                         // triples skipped as already visited or covered by a longer extent
+	num_roi_found,                   // triples matching both stack and constraints
+	num_rois_sent,                   // (coalesced) ROIs submitted to dispatch
+	scan_time_ns,                    // time spent scanning for stacks (excl. constraint matching)
+	constraint_time_ns,              // time spent verifying seeds against constraints (sampled)
+	send_time_ns;                    // time spent sending batches to dispatch
+} filter_thread_stats;
+
+typedef struct {
+	nt_rt_bytes job_id;
+	nt_abs_count seq_size;
+	bool cache_hit;                  // ROIs replayed from the filter result cache
+	unsigned long long elapsed_time_ns;
+	ushort num_threads;
+	filter_thread_stats *threads;    // num_threads entries
+} filter_job_stats;
+
 bool initialize_filter (const char *server, unsigned short port);
 void finalize_filter();
 
@@ -26,6 +65,10 @@ bool filter_seq (const char *seq_buff, nt_abs_count seq_buff_size,
                  nt_rel_count tp_trail_min_span, nt_rel_count tp_trail_max_span,
                  nt_rt_bytes job_id);
 
+ushort get_filter_stats (filter_job_stats *stats, ushort max_num_jobs);
+void free_filter_stats (filter_job_stats *stats, ushort num_jobs);
+void dump_filter_stats (FILE *f);
+
 bool filter_seq_from_file (const char *fn, const ntp_model model,
                            const ntp_element el_with_largest_stack,
                            nt_rel_count fp_lead_min_span, nt_rel_count fp_lead_max_span,
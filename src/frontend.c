@@ -20,7 +20,7 @@
 	#include <signal.h>
 #endif
 
-static pthread_spinlock_t fe_spinlock, fe_ws_spinlock;
+static pthread_spinlock_t fe_spinlock, fe_ws_spinlock, fe_fq_spinlock;
 
 #define FE_LOCK_S    if (pthread_spin_lock (&fe_spinlock)) { DEBUG_NOW (REPORT_ERRORS, FE, "could not acquire frontend spinlock"); } else {
 #define FE_LOCK_E    if (pthread_spin_unlock (&fe_spinlock)) { DEBUG_NOW (REPORT_ERRORS, FE, "could not release frontend spinlock"); pthread_exit (NULL); } }
@@ -28,6 +28,9 @@ static pthread_spinlock_t fe_spinlock, fe_ws_spinlock;
 #define FE_WS_LOCK_S    if (pthread_spin_lock (&fe_ws_spinlock)) { DEBUG_NOW (REPORT_ERRORS, FE, "could not acquire ws spinlock"); } else {
 #define FE_WS_LOCK_E    if (pthread_spin_unlock (&fe_ws_spinlock)) { DEBUG_NOW (REPORT_ERRORS, FE, "could not release ws spinlock"); pthread_exit (NULL); } }
 
+#define FE_FQ_LOCK_S    if (pthread_spin_lock (&fe_fq_spinlock)) { DEBUG_NOW (REPORT_ERRORS, FE, "could not acquire filter queue spinlock"); } else {
+#define FE_FQ_LOCK_E    if (pthread_spin_unlock (&fe_fq_spinlock)) { DEBUG_NOW (REPORT_ERRORS, FE, "could not release filter queue spinlock"); pthread_exit (NULL); } }
+
 static atomic_bool frontend_shutting_down = false;
 
 static bool
@@ -81,7 +84,7 @@ static struct _u_map mime_types;
 static struct _u_map redirects;
 
 // enums used for hanlding user topic/capability assignment
-enum TOPIC { SEQUENCES = 0, CSSD = 1, JOBS = 2 };
+enum TOPIC { SEQUENCES = 0, CSSD = 1, JOBS = 2, FILTERS = 3 };
 enum CAPABILITY { NEW = 0, DELETE = 1, ORDER = 2, SHOW = 3, SEARCH = 4, EDIT = 5 };
 
 /*
@@ -561,6 +564,153 @@ static inline void notify_ref_id (const int ref_id, const char *oid_string,
 	}
 }
 
+/*
+ * filter job queue: posted jobs are filtered by a pool of worker threads,
+ * such that callback_post_job can respond as soon as the job is created
+ */
+typedef struct {
+	char *seq;
+	nt_abs_count seq_len;
+	ntp_model model;
+	ntp_element el_with_largest_stack;
+	nt_rel_count fp_lead_min_span, fp_lead_max_span, tp_trail_min_span,
+	             tp_trail_max_span;
+	nt_stack_size stack_min_size, stack_max_size;
+	nt_stack_idist stack_min_idist, stack_max_idist;
+	ds_object_id_field job_id;
+	ds_int32_field ref_id;
+} fe_filter_job;
+
+static fe_filter_job *filter_q[FRONTEND_MAX_FILTER_Q_SIZE];
+static ushort filter_q_head_posn = 0, filter_q_num_items = 0;
+
+static pthread_t filter_q_threads[FRONTEND_NUM_FILTER_Q_THREADS];
+
+static void free_filter_job (fe_filter_job *job) {
+	finalize_model (job->model);
+	free (job->seq);
+	free (job);
+}
+
+static bool enq_fq (fe_filter_job *job) {
+	bool ret_val = false;
+	FE_FQ_LOCK_S
+	
+	if (filter_q_num_items < FRONTEND_MAX_FILTER_Q_SIZE) {
+		filter_q[ (filter_q_head_posn + filter_q_num_items) %
+		                               FRONTEND_MAX_FILTER_Q_SIZE] = job;
+		filter_q_num_items++;
+		ret_val = true;
+	}
+	
+	FE_FQ_LOCK_E
+	return ret_val;
+}
+
+static fe_filter_job *deq_fq() {
+	fe_filter_job *ret_val = NULL;
+	FE_FQ_LOCK_S
+	
+	if (filter_q_num_items) {
+		ret_val = filter_q[filter_q_head_posn];
+		filter_q_head_posn = (filter_q_head_posn + 1) % FRONTEND_MAX_FILTER_Q_SIZE;
+		filter_q_num_items--;
+	}
+	
+	FE_FQ_LOCK_E
+	return ret_val;
+}
+
+/*
+ * jobs that could not be filtered are flagged as failed (and done),
+ * which in turn reaches the job's owner as a datastore change notification
+ */
+static void fail_filter_job (fe_filter_job *job) {
+	if (!update_job_error (&job->job_id, job->ref_id, DS_JOB_ERROR_FAIL) ||
+	    !update_job_status (&job->job_id, job->ref_id, DS_JOB_STATUS_DONE)) {
+		DEBUG_NOW2 (REPORT_ERRORS, FE, "could not flag job '%.*s' as failed",
+		            NUM_RT_BYTES, job->job_id);
+	}
+}
+
+static void *filter_q_thread_start (void *arg) {
+	REGISTER
+	fe_filter_job *job;
+	
+	while (1) {
+		job = deq_fq();
+		
+		if (NULL != job) {
+			FE_LOCK_S
+			notify_ref_id (job->ref_id, job->job_id, DS_COL_JOBS, DS_NOTIFY_OP_UPDATE);
+			FE_LOCK_E
+			
+			if (!filter_seq (job->seq, job->seq_len, job->model,
+			                 job->el_with_largest_stack,
+			                 job->fp_lead_min_span, job->fp_lead_max_span,
+			                 job->stack_min_size, job->stack_max_size,
+			                 job->stack_min_idist, job->stack_max_idist,
+			                 job->tp_trail_min_span, job->tp_trail_max_span,
+			                 job->job_id)) {
+				DEBUG_NOW2 (REPORT_ERRORS, FE, "failed to filter job '%.*s'",
+				            NUM_RT_BYTES, job->job_id);
+				fail_filter_job (job);
+			}
+			
+			FE_LOCK_S
+			notify_ref_id (job->ref_id, job->job_id, DS_COL_JOBS, DS_NOTIFY_OP_UPDATE);
+			FE_LOCK_E
+			free_filter_job (job);
+		}
+		
+		else
+			if (frontend_shutting_down) {
+				break;
+			}
+			
+			else {
+				sleep_ms (FRONTEND_FILTER_Q_SLEEP_MS);
+			}
+	}
+	
+	pthread_exit (NULL);
+}
+
+static bool start_filter_q_threads() {
+	for (ushort i = 0; i < FRONTEND_NUM_FILTER_Q_THREADS; i++) {
+		if (pthread_create (&filter_q_threads[i], NULL, filter_q_thread_start, NULL)) {
+			DEBUG_NOW1 (REPORT_ERRORS, FE, "could not create filter queue thread #%d", i);
+			frontend_shutting_down = true;
+			
+			for (ushort j = 0; j < i; j++) {
+				pthread_join (filter_q_threads[j], NULL);
+			}
+			
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+/*
+ * waits on the filter queue threads (frontend_shutting_down must be set); jobs
+ * that were still queued are flagged as failed, so requires an active datastore
+ */
+static void finalize_filter_q_threads() {
+	REGISTER
+	fe_filter_job *job;
+	
+	for (ushort i = 0; i < FRONTEND_NUM_FILTER_Q_THREADS; i++) {
+		pthread_join (filter_q_threads[i], NULL);
+	}
+	
+	while (NULL != (job = deq_fq())) {
+		fail_filter_job (job);
+		free_filter_job (job);
+	}
+}
+
 void websocket_incoming_message_callback (const struct _u_request *request,
                                         struct _websocket_manager *websocket_manager,
                                         const struct _websocket_message *last_message,
@@ -1533,6 +1683,79 @@ int callback_get_data (const struct _u_request *request,
 	return cb_ret_val;
 }
 
+/*
+ * get_filter_stats_json:
+ *          recent filter job stats (newest first), one object per job with per-thread counters
+ */
+static json_t *get_filter_stats_json() {
+	filter_job_stats *stats = malloc (sizeof (filter_job_stats) * FILTER_STATS_NUM_JOBS);
+	
+	if (!stats) {
+		return json_null();
+	}
+	
+	const ushort num_jobs = get_filter_stats (stats, FILTER_STATS_NUM_JOBS);
+	json_t *json_jobs = json_array();
+	
+	if (!json_jobs) {
+		free_filter_stats (stats, num_jobs);
+		free (stats);
+		return json_null();
+	}
+	
+	for (REGISTER ushort i = 0; i < num_jobs; i++) {
+		json_t *json_job = json_object(), *json_threads = json_array();
+		
+		if (!json_job || !json_threads) {
+			json_decref (json_job);
+			json_decref (json_threads);
+			goto get_filter_stats_json_fail;
+		}
+		
+		for (REGISTER ushort t = 0; t < stats[i].num_threads; t++) {
+			const filter_thread_stats *ts = &stats[i].threads[t];
+			json_t *json_thread = json_object();
+			
+			if (!json_thread) {
+				json_decref (json_job);
+				json_decref (json_threads);
+				goto get_filter_stats_json_fail;
+			}
+			
+			json_object_set_new (json_thread, "chunks", json_integer (ts->num_chunks));
+			json_object_set_new (json_thread, "seeds", json_integer (ts->num_seeds));
+			json_object_set_new (json_thread, "compared", json_integer (ts->compared));
+			json_object_set_new (json_thread, "skipped", json_integer (ts->skipped));
+			json_object_set_new (json_thread, "found", json_integer (ts->num_roi_found));
+			json_object_set_new (json_thread, "sent", json_integer (ts->num_rois_sent));
+			json_object_set_new (json_thread, "scan_ns", json_integer (ts->scan_time_ns));
+			json_object_set_new (json_thread, "constraint_ns",
+			                     json_integer (ts->constraint_time_ns));
+			json_object_set_new (json_thread, "send_ns", json_integer (ts->send_time_ns));
+			json_array_append_new (json_threads, json_thread);
+		}
+		
+		json_object_set_new (json_job, FRONTEND_KEY_JOB_ID,
+		                     json_string (stats[i].job_id));
+		json_object_set_new (json_job, "seq_size", json_integer (stats[i].seq_size));
+		json_object_set_new (json_job, "cache_hit",
+		                     stats[i].cache_hit ? json_true() : json_false());
+		json_object_set_new (json_job, FRONTEND_KEY_TIME,
+		                     json_integer (stats[i].elapsed_time_ns));
+		json_object_set_new (json_job, "threads", json_threads);
+		json_array_append_new (json_jobs, json_job);
+	}
+	
+	free_filter_stats (stats, num_jobs);
+	free (stats);
+	return json_jobs;
+get_filter_stats_json_fail:
+	json_decref (json_jobs);
+	free_filter_stats (stats, num_jobs);
+	free (stats);
+	return json_null();
+}
+
 /*
  *  ulfius_add_endpoint_by_val (&frontend_instance, "GET", "/tc", NULL, 0, &callback_get_tc, NULL);
  */
@@ -1673,6 +1896,23 @@ int callback_get_tc (const struct _u_request *request,
 						break;
 				}
 				
+				break;
+				
+			case FILTERS:
+				switch (capability_int) {
+					case 	SHOW:
+						FE_WS_LOCK_S
+						if (ref_id_to_curator_status[ws_slot_int]) {
+							isCapable = true;
+						}
+						
+						FE_WS_LOCK_E
+						break;
+						
+					default:
+						break;	// filter stats are for curators only
+				}
+				
 				break;
 		}
 	}
@@ -1694,6 +1934,12 @@ int callback_get_tc (const struct _u_request *request,
 	if (isCapable) {
 		json_object_set_new (json_response, FRONTEND_KEY_STATUS,
 		                     json_string (FRONTEND_STATUS_SUCCESS));
+		                     
+		if (FILTERS == topic_int) {
+			json_object_set_new (json_response, FRONTEND_KEY_FILTER_STATS,
+			                     get_filter_stats_json());
+		}
+		
 		ulfius_set_json_body_response (response, MHD_HTTP_OK, json_response);
 	}
 	
@@ -2416,11 +2662,12 @@ int callback_post_job (const struct _u_request *request,
 	
 	if (seq_dataset->num_records > 0 && cssd_dataset->num_records > 0) {
 		//
-		// process request by starting filter
+		// process request by queueing job for filter
 		//
 		ntp_model model = NULL;
 		char *ss, *pos_var;
 		bool success = false;
+		ds_object_id_field new_job_object_id_char;
 		ss = malloc (MAX_MODEL_STRING_LEN + 1);
 		pos_var = malloc (MAX_MODEL_STRING_LEN + 1);
 		
@@ -2431,8 +2678,8 @@ int callback_post_job (const struct _u_request *request,
 			
 			if (convert_CSSD_to_model (ss, pos_var, &model, &err_msg)) {
 				if (compare_CSSD_model_strings (ss, pos_var, model)) {
-					nt_seg_size fp_lead_min_span, fp_lead_max_span, tp_trail_min_span,
-					            tp_trail_max_span;
+					nt_rel_count fp_lead_min_span, fp_lead_max_span, tp_trail_min_span,
+					             tp_trail_max_span;
 					nt_stack_size stack_min_size, stack_max_size;
 					nt_stack_idist stack_min_idist, stack_max_idist;
 					ntp_element el_with_largest_stack = NULL;
@@ -2448,24 +2695,64 @@ int callback_post_job (const struct _u_request *request,
 						                this_ref_id, &new_job_object_id)) {
 							convert_timebytes_to_dec_representation (&new_job_object_id,
 							                                        &new_job_object_id);
-							ds_object_id_field new_job_object_id_char;
 							convert_rt_bytes_to_string (&new_job_object_id, &new_job_object_id_char);
+							new_job_object_id_char[DS_OBJ_ID_LENGTH] = '\0';
 							const char *this_seq = (char *) seq_dataset->data[DS_COL_SEQUENCE_3P_UTR_IDX -
 							                                                                   1];
 							DEBUG_NOW5 (REPORT_INFO, FE,
 							            "user (reference id %d) posted new job '%.*s' (sequence '%s', cssd '%s')",
 							            this_ref_id, NUM_RT_BYTES, new_job_object_id_char, ds_seq_id, ds_cssd_id);
-							            
-							if (filter_seq (this_seq,
-							                strlen (this_seq),
-							                model,
-							                el_with_largest_stack,
-							                fp_lead_min_span, fp_lead_max_span,
-							                stack_min_size, stack_max_size,
-							                stack_min_idist, stack_max_idist,
-							                tp_trail_min_span, tp_trail_max_span,
-							                new_job_object_id_char)) {
-								success = true;
+							// job (incl. model) is owned by the filter queue from here on
+							fe_filter_job *job = malloc (sizeof (fe_filter_job));
+							
+							if (job) {
+								job->seq_len = strlen (this_seq);
+								job->seq = malloc (job->seq_len + 1);
+							}
+							
+							if (job && job->seq) {
+								g_memcpy (job->seq, this_seq, job->seq_len + 1);
+								job->model = model;
+								job->el_with_largest_stack = el_with_largest_stack;
+								job->fp_lead_min_span = fp_lead_min_span;
+								job->fp_lead_max_span = fp_lead_max_span;
+								job->stack_min_size = stack_min_size;
+								job->stack_max_size = stack_max_size;
+								job->stack_min_idist = stack_min_idist;
+								job->stack_max_idist = stack_max_idist;
+								job->tp_trail_min_span = tp_trail_min_span;
+								job->tp_trail_max_span = tp_trail_max_span;
+								g_memcpy (job->job_id, new_job_object_id_char, DS_OBJ_ID_LENGTH + 1);
+								job->ref_id = this_ref_id;
+								
+								if (enq_fq (job)) {
+									model = NULL;
+									success = true;
+								}
+								
+								else {
+									DEBUG_NOW2 (REPORT_ERRORS, FE,
+									            "filter queue is full; could not queue job '%.*s'",
+									            NUM_RT_BYTES, new_job_object_id_char);
+									free (job->seq);
+									free (job);
+								}
+							}
+							
+							else {
+								DEBUG_NOW (REPORT_ERRORS, FE,
+								           "could not allocate filter job when posting job");
+								           
+								if (job) {
+									free (job);
+								}
+							}
+							
+							if (!success) {
+								fe_filter_job failed_job;
+								g_memcpy (failed_job.job_id, new_job_object_id_char, DS_OBJ_ID_LENGTH + 1);
+								failed_job.ref_id = this_ref_id;
+								fail_filter_job (&failed_job);
 							}
 						}
 						
@@ -2477,7 +2764,9 @@ int callback_post_job (const struct _u_request *request,
 					}
 				}
 				
-				finalize_model (model);
+				if (model) {
+					finalize_model (model);
+				}
 			}
 			
 			else {
@@ -2509,6 +2798,9 @@ int callback_post_job (const struct _u_request *request,
 			// include requested seq_/cssd_id
 			json_object_set (json_response, DS_COL_JOB_SEQUENCE_ID, seq_id);
 			json_object_set (json_response, DS_COL_JOB_CSSD_ID, cssd_id);
+			// job is queued for filter; its progress is reported by websocket change notifications
+			json_object_set_new (json_response, FRONTEND_KEY_JOB_ID,
+			                     json_string (new_job_object_id_char));
 			ulfius_set_json_body_response (response, MHD_HTTP_ACCEPTED, json_response);
 		}
 		
@@ -3433,6 +3725,14 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		return false;
 	}
 	
+	if (pthread_spin_init (&fe_fq_spinlock, PTHREAD_PROCESS_PRIVATE)) {
+		DEBUG_NOW (REPORT_ERRORS, FE, "could not intialize spinlocks");
+		pthread_spin_destroy (&fe_spinlock);
+		pthread_spin_destroy (&fe_ws_spinlock);
+		finalize_utils();
+		return false;
+	}
+	
 	DEBUG_NOW (REPORT_INFO, FE, "checking access to jansson library");
 	NULL_JSON = json_object();
 	
@@ -3441,6 +3741,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
 		pthread_spin_destroy (&fe_spinlock);
 		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
                 finalize_utils();
 		return false;
 	}
@@ -3453,6 +3754,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
 		pthread_spin_destroy (&fe_spinlock);
 		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
 		json_decref (NULL_JSON);
 		json_decref (NULL_JSON);
                 finalize_utils();
@@ -3470,6 +3772,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		#endif
 		pthread_spin_destroy (&fe_spinlock);
 		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
 		json_decref (NULL_JSON);
                 finalize_utils();
 		return false;
@@ -3490,6 +3793,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
 		pthread_spin_destroy (&fe_spinlock);
 		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
 		json_decref (NULL_JSON);
                 finalize_utils();
 		return false;
@@ -3511,6 +3815,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
 		pthread_spin_destroy (&fe_spinlock);
 		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
 		json_decref (NULL_JSON);
                 finalize_utils();
 		return false;
@@ -3534,11 +3839,37 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
 		pthread_spin_destroy (&fe_spinlock);
 		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
 		json_decref (NULL_JSON);
                 finalize_utils();
 		return false;
 	}
 	
+	DEBUG_NOW (REPORT_INFO, FE, "launching filter queue threads");
+	
+	if (!start_filter_q_threads()) {
+		DEBUG_NOW (REPORT_ERRORS, FE, "failed to launch filter queue threads");
+		pthread_join (ds_deq_thread, NULL);
+		DEBUG_NOW (REPORT_INFO, FE, "finalizing datastore");
+		finalize_datastore();
+		DEBUG_NOW (REPORT_INFO, FE, "finalizing filter");
+		finalize_filter();
+		#ifdef DEBUG_ON
+		persist_debug();
+		finalize_debug();
+		#endif
+		#ifdef MULTITHREADED_ON
+		finalize_list_destruction();
+		#endif
+		DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
+		pthread_spin_destroy (&fe_spinlock);
+		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
+		json_decref (NULL_JSON);
+		finalize_utils();
+		return false;
+	}
+	
 	DEBUG_NOW (REPORT_INFO, FE, "registering signal handler");
 	#ifdef _WIN32
 	
@@ -3557,6 +3888,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_ERRORS, FE, "failed to register signal handler");
 		frontend_shutting_down = true;
 		pthread_join (ds_deq_thread, NULL);
+		finalize_filter_q_threads();
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing datastore");
 		finalize_datastore();
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing filter");
@@ -3575,6 +3907,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
 		pthread_spin_destroy (&fe_spinlock);
 		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
 		json_decref (NULL_JSON);
                 finalize_utils();
 		return false;
@@ -3587,6 +3920,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_ERRORS, FE, "could not intialize ulfius instance");
 		frontend_shutting_down = true;
 		pthread_join (ds_deq_thread, NULL);
+		finalize_filter_q_threads();
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing datastore");
 		finalize_datastore();
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing filter");
@@ -3605,6 +3939,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 		DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
 		pthread_spin_destroy (&fe_spinlock);
 		pthread_spin_destroy (&fe_ws_spinlock);
+		pthread_spin_destroy (&fe_fq_spinlock);
 		json_decref (NULL_JSON);
                 finalize_utils();
 		return false;
@@ -3791,6 +4126,9 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 	free (ud_jobs);
 	free (ud_results);
 	free (ud_hit_index);
+	frontend_shutting_down = true;
+	DEBUG_NOW (REPORT_INFO, FE, "finalizing filter queue threads");
+	finalize_filter_q_threads();
 	DEBUG_NOW (REPORT_INFO, FE, "finalizing datastore");
 	finalize_datastore();
 	DEBUG_NOW (REPORT_INFO, FE, "finalizing filter");
@@ -3810,6 +4148,7 @@ bool initialize_frontend (unsigned short frontend_port, char *backend_server,
 	DEBUG_NOW (REPORT_INFO, FE, "finalizing spinlocks");
 	pthread_spin_destroy (&fe_spinlock);
 	pthread_spin_destroy (&fe_ws_spinlock);
+	pthread_spin_destroy (&fe_fq_spinlock);
 	pthread_join (ds_deq_thread, NULL);
 	
 	/*
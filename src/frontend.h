@@ -63,6 +63,9 @@
 #define FRONTEND_AUTH_SERVER_RESPONSE_ROLE_KEY 			"role" 	    // http json response object key to app_metadata that is appended to auth0 idToken
 #define FRONTEND_AUTH_SERVER_RESPONSE_CURATOR_VALUE 		"curator"   // http json response object value in app_metadata to signal "curator" status
 #define FRONTEND_DS_NOTIFICATION_SLEEP_MS                       20
+#define FRONTEND_NUM_FILTER_Q_THREADS                           2           // # of posted jobs that are filtered concurrently
+#define FRONTEND_MAX_FILTER_Q_SIZE                              1000        // max # of posted jobs waiting for filter
+#define FRONTEND_FILTER_Q_SLEEP_MS                              20
 
 #define FRONTEND_KEY_WEBSOCKET_SLOT                             "ws_slot"
 #define FRONTEND_KEY_ACCESS_TOKEN                               "token"
@@ -83,6 +86,7 @@
 #define FRONTEND_KEY_HIT_POSITION 				"position"
 #define FRONTEND_KEY_HIT_FE 					"fe"
 #define FRONTEND_KEY_HIT_INDEX					"index"
+#define FRONTEND_KEY_FILTER_STATS				"filter_stats"
 #define FRONTEND_STATUS_SUCCESS     				"success"
 #define FRONTEND_STATUS_FAIL        				"fail"
 
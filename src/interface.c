@@ -2113,8 +2113,8 @@ bool get_model_largest_stack_el (ntp_model model, ntp_stack_size stack_size,
 static inline
 bool get_model_limits_part (nt_element *restrict el,
                             nt_element *restrict largest_stack_el,
-                            ntp_seg_size fp_lead_min_span, ntp_seg_size fp_lead_max_span,
-                            ntp_seg_size tp_trail_min_span, ntp_seg_size tp_trail_max_span,
+                            ntp_rel_count fp_lead_min_span, ntp_rel_count fp_lead_max_span,
+                            ntp_rel_count tp_trail_min_span, ntp_rel_count tp_trail_max_span,
                             bool *seen_largest_stack_el) {
 	if (el->type == unpaired) {
 		if (*seen_largest_stack_el) {
@@ -2212,10 +2212,10 @@ bool get_model_limits_part (nt_element *restrict el,
 }
 
 bool get_model_limits (ntp_model model,
-                       ntp_seg_size fp_lead_min_span, ntp_seg_size fp_lead_max_span,
+                       ntp_rel_count fp_lead_min_span, ntp_rel_count fp_lead_max_span,
                        ntp_stack_size stack_min_size, ntp_stack_size stack_max_size,
                        ntp_stack_idist stack_min_idist, ntp_stack_idist stack_max_idist,
-                       ntp_seg_size tp_trail_min_span, ntp_seg_size tp_trail_max_span,
+                       ntp_rel_count tp_trail_min_span, ntp_rel_count tp_trail_max_span,
                        ntp_element *largest_stack_el) {
 	COMMIT_DEBUG (REPORT_INFO, INTERFACE,
 	              "finding model limits in get_model_limits", true);
@@ -83,10 +83,10 @@ bool compare_CSSD_model_strings (const char *restrict ss,
                                  const char *restrict pos_var_string, ntp_model model);
 
 bool get_model_limits (ntp_model model,
-                       ntp_seg_size fp_lead_min_span, ntp_seg_size fp_lead_max_span,
+                       ntp_rel_count fp_lead_min_span, ntp_rel_count fp_lead_max_span,
                        ntp_stack_size stack_min_size, ntp_stack_size stack_max_size,
                        ntp_stack_idist stack_min_idist, ntp_stack_idist stack_max_idist,
-                       ntp_seg_size tp_trail_min_span, ntp_seg_size tp_trail_max_span,
+                       ntp_rel_count tp_trail_min_span, ntp_rel_count tp_trail_max_span,
                        ntp_element *largest_stack_el);
 
 void join_cssd (const char *ss, const char *pos_var, char **cssd);
@@ -2342,3 +2342,374 @@ bool get_next_model_partition (ntp_model model,
 	// if no new partition found (curr_size==0) return false
 	return curr_size;
 }
+
+/*
+ * private function to grow a model plan array to hold at least num_needed entries
+ */
+static inline bool grow_model_plan_array (void **array, ushort *max_entries,
+                                        const uint32_t num_needed, const size_t entry_size) {
+	if (num_needed <= *max_entries) {
+		return true;
+	}
+	
+	if (num_needed >= NO_PLAN_STEP) {
+		COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+		              "model too large to compile in grow_model_plan_array", false);
+		return false;
+	}
+	
+	REGISTER
+	uint32_t new_max_entries = *max_entries ? *max_entries : MIN_MODEL_PLAN_SIZE;
+	
+	while (new_max_entries < num_needed) {
+		new_max_entries *= 2;
+	}
+	
+	if (new_max_entries >= NO_PLAN_STEP) {
+		new_max_entries = NO_PLAN_STEP - 1;
+	}
+	
+	void *new_array = realloc (*array, entry_size * new_max_entries);
+	
+	if (!new_array) {
+		COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+		              "could not grow model plan in grow_model_plan_array", false);
+		return false;
+	}
+	
+	*array = new_array;
+	*max_entries = (ushort) new_max_entries;
+	return true;
+}
+
+/*
+ * private function to test whether el is the given element of a base triple constraint
+ */
+static inline bool is_base_triple_element (const nt_element *restrict el,
+                                        const nt_constraint_element_type element_type) {
+	return el->type == unpaired &&
+	       el->unpaired->i_constraint.reference &&
+	       el->unpaired->i_constraint.reference->type == base_triple &&
+	       el->unpaired->i_constraint.element_type == element_type;
+}
+
+/*
+ * private function to add a plan step for el, and any elements that follow it,
+ * where paired elements are followed by the steps of their fp_next elements
+ */
+static bool add_plan_steps (ntp_model_plan restrict plan, ntp_element el,
+                            const ushort containing) {
+	REGISTER
+	ushort prev_step = NO_PLAN_STEP;
+	
+	while (el) {
+		if (!grow_model_plan_array ((void **) &plan->steps, &plan->max_steps,
+		                            (uint32_t) plan->num_steps + 1, sizeof (nt_plan_step))) {
+			return false;
+		}
+		
+		const ushort this_step = plan->num_steps++;
+		REGISTER
+		nt_plan_step *restrict step = &plan->steps[this_step];
+		memset (step, 0, sizeof (nt_plan_step));
+		step->el = el;
+		step->type = el->type;
+		step->next = NO_PLAN_STEP;
+		step->fp_next = NO_PLAN_STEP;
+		step->tp_next = NO_PLAN_STEP;
+		step->containing = containing;
+		el->plan_step = this_step;
+		
+		if (prev_step != NO_PLAN_STEP) {
+			if (plan->steps[prev_step].type == unpaired) {
+				plan->steps[prev_step].next = this_step;
+			}
+			
+			else {
+				plan->steps[prev_step].tp_next = this_step;
+			}
+		}
+		
+		prev_step = this_step;
+		
+		if (el->type == unpaired) {
+			step->min = el->unpaired->min;
+			step->max = el->unpaired->max;
+			el = el->unpaired->next;
+		}
+		
+		else {
+			step->min = el->paired->min;
+			step->max = el->paired->max;
+			
+			if (el->paired->fp_next) {
+				const ushort fp_step = plan->num_steps;
+				
+				if (!add_plan_steps (plan, el->paired->fp_next, this_step)) {
+					return false;
+				}
+				
+				plan->steps[this_step].fp_next = fp_step;
+			}
+			
+			el = el->paired->tp_next;
+		}
+	}
+	
+	return true;
+}
+
+/*
+ * private function to derive the stack distances and the base triple extrusion of
+ * a paired plan step (see get_stack_distances_in_paired_element)
+ */
+static inline void set_plan_stack_distances (ntp_model_plan restrict plan,
+                                        nt_plan_step *restrict step) {
+	REGISTER
+	ntp_element fp_next = step->el->paired->fp_next, tp_next = step->el->paired->tp_next;
+	
+	if (!fp_next) {
+		return;
+	}
+	
+	step->has_stack_dists = traverse_and_count_in_paired_element (fp_next,
+	                        &step->min_stack_dist, &step->max_stack_dist);
+	                        
+	if (is_base_triple_element (fp_next, constraint_fp_element)) {
+		step->fp_extrusion = true;
+		const ntp_element tp_element = get_tp_element (fp_next);
+		
+		if (tp_element && is_base_triple_element (tp_element, constraint_tp_element)) {
+			step->in_extrusion = 1;
+			
+			if (fp_next->unpaired->next && fp_next->unpaired->next->type == paired) {
+				step->in_extrusion += fp_next->unpaired->next->paired->min;
+			}
+		}
+	}
+	
+	else
+		if (tp_next && is_base_triple_element (tp_next, constraint_tp_element)) {
+			step->tp_extrusion = true;
+			
+			if (step->containing != NO_PLAN_STEP) {
+				const nt_element *restrict containing_element = plan->steps[step->containing].el;
+				
+				if (containing_element->paired->fp_next->type == unpaired &&
+				    NULL == tp_next->unpaired->next) {
+					step->extrusion_prev_el = containing_element->paired->fp_next;
+					step->extrusion_containing_min = containing_element->paired->min;
+				}
+			}
+		}
+}
+
+/*
+ * plan-based equivalent of get_stack_distances_in_paired_element
+ */
+bool get_plan_stack_distances (const nt_model_plan *restrict plan,
+                               const nt_element *restrict el,
+                               const nt_element *restrict prev_el,
+                               nt_stack_idist *restrict min_stack_dist,
+                               nt_stack_idist *restrict max_stack_dist, short *restrict in_extrusion) {
+	const nt_plan_step *restrict step = &plan->steps[el->plan_step];
+	*min_stack_dist = step->min_stack_dist;
+	*max_stack_dist = step->max_stack_dist;
+	*in_extrusion = 0;
+	
+	if (step->fp_extrusion) {
+		*in_extrusion = step->in_extrusion;
+	}
+	
+	else
+		if (step->tp_extrusion && NULL != prev_el &&
+		    is_base_triple_element (prev_el, constraint_fp_element)) {
+			*in_extrusion = -1;
+			
+			if (prev_el == step->extrusion_prev_el) {
+				*in_extrusion -= step->extrusion_containing_min;
+			}
+		}
+		
+	return step->has_stack_dists;
+}
+
+/*
+ * private function to derive the contained paired elements of a paired plan step
+ * (see get_contained_paired_elements_by_element), and the distances of each of those
+ * to the paired step (see get_containing_paired_element_dist_by_element)
+ */
+static bool set_plan_contained (const nt_model *restrict model,
+                                ntp_model_plan restrict plan, const ushort this_step) {
+	REGISTER
+	ntp_element this_element = plan->steps[this_step].el,
+	            prev_element = this_element,
+	            this_contained_element = this_element->paired->fp_next;
+	REGISTER
+	nt_rel_count this_next_paired_element_min = 0, this_next_paired_element_max = 0;
+	const ushort first_contained = plan->num_contained;
+	REGISTER
+	ushort num_contained = 0;
+	
+	while (this_contained_element) {
+		if (this_contained_element->type == paired) {
+			if (!grow_model_plan_array ((void **) &plan->contained, &plan->max_contained,
+			                            (uint32_t) plan->num_contained + 1, sizeof (nt_plan_contained))) {
+				return false;
+			}
+			
+			REGISTER
+			nt_plan_contained *restrict contained = &plan->contained[plan->num_contained++];
+			contained->step = this_contained_element->plan_step;
+			get_nested_pair_distances (&contained->fp_dist_min, &contained->fp_dist_max,
+			                           &contained->tp_dist_min, &contained->tp_dist_max,
+			                           model, this_element, this_contained_element);
+			get_plan_stack_distances (plan, this_contained_element, prev_element,
+			                          &contained->idist_min, &contained->idist_max, &contained->in_extrusion);
+			contained->next_min = 0;
+			contained->next_max = 0;
+			REGISTER
+			nt_plan_step *restrict contained_step = &plan->steps[contained->step];
+			contained_step->is_nested = this_element->paired->max != 0;
+			contained_step->nested_fp_dist_min = contained->fp_dist_min;
+			contained_step->nested_fp_dist_max = contained->fp_dist_max;
+			contained_step->nested_tp_dist_min = contained->tp_dist_min;
+			contained_step->nested_tp_dist_max = contained->tp_dist_max;
+			
+			if (num_contained) {
+				plan->contained[first_contained + num_contained - 1].next_min =
+				                    this_next_paired_element_min;
+				plan->contained[first_contained + num_contained - 1].next_max =
+				                    this_next_paired_element_max;
+			}
+			
+			this_next_paired_element_min = 0;
+			this_next_paired_element_max = 0;
+			prev_element = this_contained_element;
+			this_contained_element = this_contained_element->paired->tp_next;
+			num_contained++;
+		}
+		
+		else {
+			this_next_paired_element_min += this_contained_element->unpaired->min;
+			this_next_paired_element_max += this_contained_element->unpaired->max;
+			prev_element = this_contained_element;
+			this_contained_element = this_contained_element->unpaired->next;
+		}
+	}
+	
+	if (num_contained) {
+		plan->contained[first_contained + num_contained - 1].next_min =
+		                    this_next_paired_element_min;
+		plan->contained[first_contained + num_contained - 1].next_max =
+		                    this_next_paired_element_max;
+	}
+	
+	plan->steps[this_step].first_contained = first_contained;
+	plan->steps[this_step].num_contained = num_contained;
+	return true;
+}
+
+/*
+ * compile the model into plan, reusing any arrays that plan already holds
+ *
+ * output:  true if compiled; false otherwise
+ *
+ * notes:   - derived values reflect the model's current element min/max values,
+ *            so the plan needs to be recompiled whenever these are changed
+ *          - sets the plan_step of each model element, so a model can only be
+ *            compiled into one plan at a time
+ */
+bool compile_model_plan (ntp_model restrict model, ntp_model_plan restrict plan) {
+	plan->num_steps = 0;
+	plan->num_contained = 0;
+	
+	if (!add_plan_steps (plan, model->first_element, NO_PLAN_STEP)) {
+		COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+		              "could not flatten model elements in compile_model_plan", false);
+		return false;
+	}
+	
+	for (REGISTER ushort s = 0; s < plan->num_steps; s++) {
+		if (plan->steps[s].type == paired) {
+			set_plan_stack_distances (plan, &plan->steps[s]);
+		}
+	}
+	
+	for (REGISTER ushort s = 0; s < plan->num_steps; s++) {
+		if (plan->steps[s].type == paired && !set_plan_contained (model, plan, s)) {
+			COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+			              "could not derive contained paired elements in compile_model_plan", false);
+			return false;
+		}
+	}
+	
+	COMMIT_DEBUG1 (REPORT_INFO, MODEL, "compiled model into plan of %u steps",
+	               plan->num_steps, false);
+	return true;
+}
+
+void finalize_model_plan (ntp_model_plan restrict plan) {
+	free (plan->steps);
+	free (plan->contained);
+	memset (plan, 0, sizeof (nt_model_plan));
+}
+
+/*
+ * get a signature of a (compiled) model, which tells models apart across model
+ * instances and processes: the type, min/max and successors of each plan step,
+ * followed by the type and elements (as plan steps) of each constraint
+ *
+ * output:  signature (to be freed), or NULL on failure
+ */
+ushort *get_model_signature (const nt_model *restrict model,
+                             const nt_model_plan *restrict plan, uint32_t *restrict sig_len) {
+	REGISTER
+	uint32_t num_constraints = 0;
+	
+	for (REGISTER ntp_constraint this_constraint = model->first_constraint;
+	     this_constraint; this_constraint = this_constraint->next) {
+		num_constraints++;
+	}
+	
+	*sig_len = (uint32_t) plan->num_steps * 6 + num_constraints * 4;
+	REGISTER
+	ushort *sig = malloc (sizeof (ushort) * (*sig_len));
+	
+	if (!sig) {
+		COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+		              "could not allocate memory for model signature in get_model_signature", false);
+		return NULL;
+	}
+	
+	REGISTER
+	uint32_t i = 0;
+	
+	for (REGISTER ushort s = 0; s < plan->num_steps; s++) {
+		sig[i++] = (ushort) plan->steps[s].type;
+		sig[i++] = plan->steps[s].min;
+		sig[i++] = plan->steps[s].max;
+		sig[i++] = plan->steps[s].next;
+		sig[i++] = plan->steps[s].fp_next;
+		sig[i++] = plan->steps[s].tp_next;
+	}
+	
+	for (REGISTER ntp_constraint this_constraint = model->first_constraint;
+	     this_constraint; this_constraint = this_constraint->next) {
+		sig[i++] = (ushort) this_constraint->type;
+		
+		if (this_constraint->type == pseudoknot) {
+			sig[i++] = this_constraint->pseudoknot->fp_element->plan_step;
+			sig[i++] = this_constraint->pseudoknot->tp_element->plan_step;
+			sig[i++] = NO_PLAN_STEP;
+		}
+		
+		else {
+			sig[i++] = this_constraint->base_triple->fp_element->plan_step;
+			sig[i++] = this_constraint->base_triple->tp_element->plan_step;
+			sig[i++] = this_constraint->base_triple->single_element->plan_step;
+		}
+	}
+	
+	return sig;
+}
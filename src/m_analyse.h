@@ -79,4 +79,17 @@ bool get_next_constraint_offsets_by_element
  ntp_constraint restrict this_constraint,
  const nt_stack_size stack_size, const nt_stack_idist stack_idist);
 
+bool compile_model_plan (ntp_model restrict model, ntp_model_plan restrict plan);
+
+void finalize_model_plan (ntp_model_plan restrict plan);
+
+ushort *get_model_signature (const nt_model *restrict model,
+                             const nt_model_plan *restrict plan, uint32_t *restrict sig_len);
+
+bool get_plan_stack_distances (const nt_model_plan *restrict plan,
+                               const nt_element *restrict el,
+                               const nt_element *restrict prev_el,
+                               nt_stack_idist *restrict min_stack_dist,
+                               nt_stack_idist *restrict max_stack_dist, short *restrict in_extrusion);
+                               
 #endif //RNA_M_ANALYSE_H
@@ -75,6 +75,7 @@ ntp_element initialize_element (const nt_element_type el_type,
 	}
 	
 	el->type = el_type;
+	el->plan_step = NO_PLAN_STEP;
 	
 	if (el_type == paired) {
 		REGISTER
@@ -953,3 +954,245 @@ void finalize_model (ntp_model restrict model) {
 		FREE_DEBUG (model, "model in finalize_model");
 	}
 }
+
+/*
+ * private function to get the constraint of model_copy that corresponds to the given constraint of model
+ */
+static inline ntp_constraint get_constraint_copy (const nt_model *restrict model,
+                                        const nt_model *restrict model_copy, const nt_constraint *restrict constraint) {
+	REGISTER
+	ntp_constraint this_constraint = model->first_constraint,
+	               this_constraint_copy = model_copy->first_constraint;
+	               
+	while (this_constraint && this_constraint != constraint) {
+		this_constraint = this_constraint->next;
+		this_constraint_copy = this_constraint_copy->next;
+	}
+	
+	return this_constraint ? this_constraint_copy : NULL;
+}
+
+/*
+ * private function to copy element (and any elements that follow it) into *element_copy;
+ * elements are linked into the copy as soon as they are allocated, such that a partial
+ * copy can be disposed of using finalize_model
+ */
+static bool copy_model_at (const nt_element *restrict element,
+                           ntp_element *restrict element_copy, ntp_element prev_element_copy,
+                           const nt_model *restrict model, const nt_model *restrict model_copy) {
+	while (element) {
+		REGISTER
+		ntp_element this_element_copy = MALLOC_DEBUG (sizeof (nt_element),
+		                                        "element in copy_model");
+		                                        
+		if (!this_element_copy) {
+			return false;
+		}
+		
+		this_element_copy->type = element->type;
+		this_element_copy->plan_step = NO_PLAN_STEP;
+		
+		if (element->type == unpaired) {
+			this_element_copy->unpaired = MALLOC_DEBUG (sizeof (nt_unpaired_element),
+			                                        "unpaired_element for element in copy_model");
+			                                        
+			if (!this_element_copy->unpaired) {
+				FREE_DEBUG (this_element_copy,
+				            "element in copy_model [failed to copy unpaired_element]");
+				return false;
+			}
+			
+			*this_element_copy->unpaired = *element->unpaired;
+			this_element_copy->unpaired->next = NULL;
+			
+			if (element->unpaired->prev_type == paired) {
+				this_element_copy->unpaired->prev_paired = prev_element_copy;
+			}
+			
+			else
+				if (element->unpaired->prev_type == unpaired) {
+					this_element_copy->unpaired->prev_unpaired = prev_element_copy;
+				}
+				
+			if (element->unpaired->i_constraint.reference) {
+				REGISTER
+				ntp_constraint constraint_copy = get_constraint_copy (model, model_copy,
+				                                        element->unpaired->i_constraint.reference);
+				this_element_copy->unpaired->i_constraint.reference = constraint_copy;
+				
+				if (constraint_copy && constraint_copy->type == pseudoknot) {
+					if (element->unpaired->i_constraint.element_type == constraint_fp_element) {
+						constraint_copy->pseudoknot->fp_element = this_element_copy;
+					}
+					
+					else {
+						constraint_copy->pseudoknot->tp_element = this_element_copy;
+					}
+				}
+				
+				else
+					if (constraint_copy && constraint_copy->type == base_triple) {
+						if (element->unpaired->i_constraint.element_type == constraint_fp_element) {
+							constraint_copy->base_triple->fp_element = this_element_copy;
+						}
+						
+						else
+							if (element->unpaired->i_constraint.element_type == constraint_tp_element) {
+								constraint_copy->base_triple->tp_element = this_element_copy;
+							}
+							
+							else {
+								constraint_copy->base_triple->single_element = this_element_copy;
+							}
+					}
+			}
+			
+			*element_copy = this_element_copy;
+			element_copy = &this_element_copy->unpaired->next;
+			prev_element_copy = this_element_copy;
+			element = element->unpaired->next;
+		}
+		
+		else {
+			this_element_copy->paired = MALLOC_DEBUG (sizeof (nt_paired_element),
+			                                        "paired_element for element in copy_model");
+			                                        
+			if (!this_element_copy->paired) {
+				FREE_DEBUG (this_element_copy,
+				            "element in copy_model [failed to copy paired_element]");
+				return false;
+			}
+			
+			*this_element_copy->paired = *element->paired;
+			this_element_copy->paired->fp_next = NULL;
+			this_element_copy->paired->tp_next = NULL;
+			*element_copy = this_element_copy;
+			return copy_model_at (element->paired->fp_next,
+			                      &this_element_copy->paired->fp_next, this_element_copy, model, model_copy) &&
+			       copy_model_at (element->paired->tp_next,
+			                      &this_element_copy->paired->tp_next, this_element_copy, model, model_copy);
+		}
+	}
+	
+	return true;
+}
+
+/*
+ * deep copy of a model, including its constraints
+ *
+ * output:  model copy, to be disposed of using finalize_model; NULL on failure
+ */
+ntp_model copy_model (const nt_model *restrict model) {
+	COMMIT_DEBUG (REPORT_INFO, MODEL, "copying model in copy_model", true);
+	REGISTER
+	ntp_model restrict model_copy = initialize_model();
+	
+	if (!model_copy) {
+		return NULL;
+	}
+	
+	REGISTER
+	ntp_constraint *last_constraint_copy = &model_copy->first_constraint;
+	
+	for (REGISTER ntp_constraint constraint = model->first_constraint; constraint;
+	     constraint = constraint->next) {
+		REGISTER
+		ntp_constraint constraint_copy = MALLOC_DEBUG (sizeof (nt_constraint),
+		                                        "constraint in copy_model");
+		                                        
+		if (!constraint_copy) {
+			COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+			              "could not copy constraint in copy_model", false);
+			finalize_model (model_copy);
+			return NULL;
+		}
+		
+		constraint_copy->type = no_constraint_type;
+		constraint_copy->next = NULL;
+		*last_constraint_copy = constraint_copy;
+		last_constraint_copy = &constraint_copy->next;
+		
+		if (constraint->type == pseudoknot) {
+			constraint_copy->pseudoknot = MALLOC_DEBUG (sizeof (nt_pseudoknot),
+			                                        "pseudoknot in copy_model");
+			                                        
+			if (constraint_copy->pseudoknot) {
+				constraint_copy->pseudoknot->fp_element = NULL;
+				constraint_copy->pseudoknot->tp_element = NULL;
+				constraint_copy->type = pseudoknot;
+			}
+		}
+		
+		else
+			if (constraint->type == base_triple) {
+				constraint_copy->base_triple = MALLOC_DEBUG (sizeof (nt_base_triple),
+				                                        "base triple in copy_model");
+				                                        
+				if (constraint_copy->base_triple) {
+					constraint_copy->base_triple->fp_element = NULL;
+					constraint_copy->base_triple->tp_element = NULL;
+					constraint_copy->base_triple->single_element = NULL;
+					constraint_copy->type = base_triple;
+				}
+			}
+			
+		if (constraint_copy->type != constraint->type) {
+			COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+			              "could not copy constraint in copy_model", false);
+			finalize_model (model_copy);
+			return NULL;
+		}
+	}
+	
+	if (!copy_model_at (model->first_element, &model_copy->first_element, NULL,
+	                    model, model_copy)) {
+		COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+		              "could not copy elements in copy_model", false);
+		finalize_model (model_copy);
+		return NULL;
+	}
+	
+	return model_copy;
+}
+
+/*
+ * private function to find the copy of target among the elements at (and following)
+ * element, given element_copy as the copy of element
+ */
+static ntp_element get_model_element_copy_at (const nt_element *restrict element,
+                                        ntp_element element_copy, const nt_element *restrict target) {
+	while (element && element_copy) {
+		if (element == target) {
+			return element_copy;
+		}
+		
+		if (element->type == unpaired) {
+			element = element->unpaired->next;
+			element_copy = element_copy->unpaired->next;
+		}
+		
+		else {
+			REGISTER
+			ntp_element target_copy = get_model_element_copy_at (element->paired->fp_next,
+			                                        element_copy->paired->fp_next, target);
+			                                        
+			if (!target_copy) {
+				target_copy = get_model_element_copy_at (element->paired->tp_next,
+				                                        element_copy->paired->tp_next, target);
+			}
+			
+			return target_copy;
+		}
+	}
+	
+	return NULL;
+}
+
+/*
+ * get the element of model_copy (see copy_model) that corresponds to the given element of model
+ */
+ntp_element get_model_element_copy (const nt_model *restrict model,
+                                    const nt_model *restrict model_copy, const nt_element *restrict element) {
+	return get_model_element_copy_at (model->first_element,
+	                                  model_copy->first_element, element);
+}
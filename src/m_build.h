@@ -27,6 +27,9 @@ ntp_constraint add_base_triple_to_model (ntp_model restrict model,
                                         ntp_element restrict prev_el_tp, nt_branch_type br_type_tp,
                                         ntp_element restrict prev_el_single, nt_branch_type br_type_single,
                                         ntp_constraint restrict new_base_triple_constraint);
+ntp_model copy_model (const nt_model *model);
+ntp_element get_model_element_copy (const nt_model *model,
+                                    const nt_model *model_copy, const nt_element *element);
 void finalize_model (ntp_model model);
 
 #endif //RNA_M_BUILD_H
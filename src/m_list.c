@@ -19,13 +19,6 @@ typedef struct {
 	uchar tag;
 } nt_search_seq_list_entry, *ntp_search_seq_list_entry;
 
-static nt_rel_count list1_elements[MAX_ELEMENT_MATCHES],
-       list2_elements[MAX_ELEMENT_MATCHES];
-static nt_rel_seq_posn  list1_chain[MAX_CHAIN_MATCHES],
-       list2_chain[MAX_CHAIN_MATCHES];
-static nt_stack_size    list1_stacks[MAX_CHAIN_MATCHES / 2],
-       list2_stacks[MAX_CHAIN_MATCHES / 2];
-
 #ifdef MULTITHREADED_ON
 	#include <pthread.h>
 	
@@ -44,8 +37,6 @@ static nt_stack_size    list1_stacks[MAX_CHAIN_MATCHES / 2],
 	static bool list_destruction_init = false;
 #endif
 
-ntp_list search_seq_list = NULL;
-
 int seq_search_list_seeker (const void *el, const void *key) {
 	const REGISTER nt_list *restrict this_list = ((ntp_search_seq_list_entry)
 	                                        el)->list;
@@ -57,7 +48,7 @@ int seq_search_list_seeker (const void *el, const void *key) {
 	return 0;
 }
 
-bool list_initialize_tagging() {
+bool list_initialize_tagging (ntp_list *search_seq_list) {
 	COMMIT_DEBUG (REPORT_INFO, LIST,
 	              "initializing search_seq_list in list_initialize_tagging", true);
 	#ifdef MULTITHREADED_ON
@@ -65,7 +56,7 @@ bool list_initialize_tagging() {
 	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
 	#endif
 	
-		if (search_seq_list) {
+		if (*search_seq_list) {
 			COMMIT_DEBUG (REPORT_ERRORS, LIST,
 			              "search_seq_list already initialized in list_initialize_tagging", false);
 			#ifdef MULTITHREADED_ON
@@ -74,10 +65,10 @@ bool list_initialize_tagging() {
 			return false;
 		}
 		
-		search_seq_list = MALLOC_DEBUG (sizeof (nt_list),
-		                                "search_seq_list in list_initialize_tagging");
-		                                
-		if (!search_seq_list) {
+		*search_seq_list = MALLOC_DEBUG (sizeof (nt_list),
+		                                 "search_seq_list in list_initialize_tagging");
+		                                 
+		if (!*search_seq_list) {
 			#ifdef MULTITHREADED_ON
 			pthread_mutex_unlock (&num_destruction_threads_mutex);
 			#endif
@@ -86,16 +77,17 @@ bool list_initialize_tagging() {
 			return NULL;
 		}
 		
-		if ((list_init (search_seq_list) != 0) ||
-		    (list_attributes_seeker (search_seq_list, &seq_search_list_seeker) != 0)) {
+		if ((list_init (*search_seq_list) != 0) ||
+		    (list_attributes_seeker (*search_seq_list, &seq_search_list_seeker) != 0)) {
 			#ifdef MULTITHREADED_ON
 			pthread_mutex_unlock (&num_destruction_threads_mutex);
 			#endif
 			COMMIT_DEBUG (REPORT_ERRORS, LIST,
 			              "cannot initialize list/set attribute seeker for search_seq_list in list_initialize_tagging",
 			              false);
-			FREE_DEBUG (search_seq_list,
+			FREE_DEBUG (*search_seq_list,
 			            "search_seq_list in list_initialize_tagging [failed to initialize list/set attribute seeker for search_seq_list in list_initialize_tagging]");
+			*search_seq_list = NULL;
 			return false;
 		}
 		
@@ -388,7 +380,7 @@ void *list_destruction_thread (void *thread_idx) {
 	pthread_exit (NULL);
 }
 
-bool list_destroy_all_tagged() {
+bool list_destroy_all_tagged (ntp_list *search_seq_list) {
 	COMMIT_DEBUG (REPORT_INFO, LIST,
 	              "destroying all elements of search_seq_list in list_destroy_all_tagged", true);
 	              
@@ -434,7 +426,7 @@ bool list_destroy_all_tagged() {
 						
 						// found empty thread slot in list_destruction_thread_active
 						// set deletion target for this thread
-						list_destruction_thread_target[t] = search_seq_list;
+						list_destruction_thread_target[t] = *search_seq_list;
 						PREPARE_THREADED_FREE_T_ALL (t);
 						uchar *t_id = malloc (sizeof (uchar));
 						*t_id = t;
@@ -457,7 +449,7 @@ bool list_destroy_all_tagged() {
 						}
 						
 						// clear search_seq_list
-						search_seq_list = NULL;
+						*search_seq_list = NULL;
 						break;
 					}
 				}
@@ -469,10 +461,10 @@ bool list_destroy_all_tagged() {
 				COMMIT_DEBUG1 (REPORT_INFO, LIST,
 				               "MAX_THREADS (%d) reached in list_destroy_all_tagged", MAX_THREADS, false);
 				// clear search_seq_list directly from main thread
-				clear_search_seq_list (&search_seq_list);
+				clear_search_seq_list (search_seq_list);
 				PREPARE_THREADED_FREE_T_ALL (MAX_THREADS);
 				FREE_TAG_ALL (MAX_THREADS);
-				search_seq_list = NULL;
+				*search_seq_list = NULL;
 			}
 			
 			if (pthread_mutex_unlock (&num_destruction_threads_mutex) == 0) {
@@ -511,8 +503,8 @@ bool list_destroy_all_tagged() {
 	return true;
 }
 #else
-bool list_destroy_all_tagged() {
-	clear_search_seq_list (&search_seq_list);
+bool list_destroy_all_tagged (ntp_list *search_seq_list) {
+	clear_search_seq_list (search_seq_list);
 	FREE_TAG_ALL();
 	return true;
 }
@@ -1184,6 +1176,14 @@ ntp_list ntp_list_concatenate (ntp_list restrict list1, ntp_list restrict list2,
 			}
 			
 			#endif
+			// scratch space is kept on the stack, given that ntp_list_concatenate
+			// may be invoked by concurrent searches
+			nt_rel_count list1_elements[MAX_ELEMENT_MATCHES],
+			             list2_elements[MAX_ELEMENT_MATCHES];
+			nt_rel_seq_posn list1_chain[MAX_CHAIN_MATCHES],
+			                list2_chain[MAX_CHAIN_MATCHES];
+			nt_stack_size list1_stacks[MAX_CHAIN_MATCHES / 2],
+			              list2_stacks[MAX_CHAIN_MATCHES / 2];
 			REGISTER
 			uchar i, list1_elements_idx, list2_elements_idx, s;
 			tmp1_linked_bp = NULL;
@@ -1753,6 +1753,47 @@ void dump_linked_bp (ntp_linked_bp linked_bp, ntp_seq seq) {
 	}
 }
 
+/*
+ * dispose of a single (safe_copy) linked_bp, including its chain of
+ * prev_linked_bps and their unpaired elements
+ */
+void dispose_linked_bp_copy_chain (ntp_linked_bp linked_bp_copy,
+                                   char *free_bp_reason_msg, char *free_list_reason_msg) {
+	REGISTER
+	ntp_linked_bp tmp_bp_copy;
+	
+	do {
+		tmp_bp_copy = linked_bp_copy;
+		
+		if (tmp_bp_copy->fp_elements) {
+			do {
+				REGISTER
+				ntp_element tmp_elements = tmp_bp_copy->fp_elements->unpaired->next;
+				FREE_DEBUG (tmp_bp_copy->fp_elements->unpaired, free_list_reason_msg);
+				FREE_DEBUG (tmp_bp_copy->fp_elements, free_list_reason_msg);
+				tmp_bp_copy->fp_elements = tmp_elements;
+			}
+			while (tmp_bp_copy->fp_elements);
+		}
+		
+		if (tmp_bp_copy->tp_elements) {
+			do {
+				REGISTER
+				ntp_element tmp_elements = tmp_bp_copy->tp_elements->unpaired->next;
+				FREE_DEBUG (tmp_bp_copy->tp_elements->unpaired, free_list_reason_msg);
+				FREE_DEBUG (tmp_bp_copy->tp_elements, free_list_reason_msg);
+				tmp_bp_copy->tp_elements = tmp_elements;
+			}
+			while (tmp_bp_copy->tp_elements);
+		}
+		
+		FREE_DEBUG ((void *) linked_bp_copy->bp, free_bp_reason_msg);
+		linked_bp_copy = linked_bp_copy->prev_linked_bp;
+		FREE_DEBUG (tmp_bp_copy, free_bp_reason_msg);
+	}
+	while (linked_bp_copy);
+}
+
 bool dispose_linked_bp_copy (nt_model *restrict model, ntp_list list,
                              char *free_bp_reason_msg, char *free_list_reason_msg
 #ifndef NO_FULL_CHECKS
@@ -1769,46 +1810,16 @@ bool dispose_linked_bp_copy (nt_model *restrict model, ntp_list list,
                     #else
 	                    ;
                     #endif
-		REGISTER
-		ntp_linked_bp restrict linked_bp_copy, tmp_bp_copy;
-		
 		while (list_iterator_hasnext (list)) {
-			linked_bp_copy = list_iterator_next (list);
+			REGISTER
+			ntp_linked_bp linked_bp_copy = list_iterator_next (list);
 			#ifndef NO_FULL_CHECKS
 			
 			if (linked_bp_copy) {
 			#endif
 			
-				do {
-					tmp_bp_copy = linked_bp_copy;
-					
-					if (tmp_bp_copy->fp_elements) {
-						do {
-							REGISTER
-							ntp_element tmp_elements = tmp_bp_copy->fp_elements->unpaired->next;
-							FREE_DEBUG (tmp_bp_copy->fp_elements->unpaired, free_list_reason_msg);
-							FREE_DEBUG (tmp_bp_copy->fp_elements, free_list_reason_msg);
-							tmp_bp_copy->fp_elements = tmp_elements;
-						}
-						while (tmp_bp_copy->fp_elements);
-					}
-					
-					if (tmp_bp_copy->tp_elements) {
-						do {
-							REGISTER
-							ntp_element tmp_elements = tmp_bp_copy->tp_elements->unpaired->next;
-							FREE_DEBUG (tmp_bp_copy->tp_elements->unpaired, free_list_reason_msg);
-							FREE_DEBUG (tmp_bp_copy->tp_elements, free_list_reason_msg);
-							tmp_bp_copy->tp_elements = tmp_elements;
-						}
-						while (tmp_bp_copy->tp_elements);
-					}
-					
-					FREE_DEBUG ((void *)linked_bp_copy->bp, free_bp_reason_msg);
-					linked_bp_copy = linked_bp_copy->prev_linked_bp;
-					FREE_DEBUG (tmp_bp_copy, free_bp_reason_msg);
-				}
-				while (linked_bp_copy);
+				dispose_linked_bp_copy_chain (linked_bp_copy, free_bp_reason_msg,
+				                              free_list_reason_msg);
 				
 				#ifndef NO_FULL_CHECKS
 			}
@@ -1830,68 +1841,3 @@ bool dispose_linked_bp_copy (nt_model *restrict model, ntp_list list,
 	return false;
 		#endif
 }
-
-void dispose_linked_bp_copy_by_FE_threshold (nt_model *restrict model,
-                                        const char *seq, ntp_list list, float FE_threshold,
-                                        char *free_bp_reason_msg, char *free_list_reason_msg) {
-	REGISTER
-	nt_hit_count list_size = list ? (nt_hit_count) list->numels : 0,
-	             current_list_idx = 0, current_num_hits = 0;
-	REGISTER
-	ntp_linked_bp restrict linked_bp_copy, tmp_bp_copy;
-	
-	while (current_list_idx < list_size) {
-		linked_bp_copy = list_get_at (list, current_list_idx);
-		float this_mfe = get_turner_mfe_estimate (linked_bp_copy, seq);
-		
-		if (current_num_hits < MAX_HITS_RETURNED &&
-		    this_mfe <= FE_threshold) {
-			/*
-			 * hit is within both FE threshold and MAX_HITS_RETURNED limits
-			 */
-			current_list_idx++;
-			current_num_hits++;
-		}
-		
-		else {
-			/*
-			 * allowed number of hits exceeded or MFE is above threshold
-			 */
-			linked_bp_copy = list_extract_at (list, current_list_idx);
-			
-			do {
-				tmp_bp_copy = linked_bp_copy;
-				
-				if (tmp_bp_copy->fp_elements) {
-					do {
-						REGISTER
-						ntp_element tmp_elements = tmp_bp_copy->fp_elements->unpaired->next;
-						FREE_DEBUG (tmp_bp_copy->fp_elements->unpaired, free_list_reason_msg);
-						FREE_DEBUG (tmp_bp_copy->fp_elements, free_list_reason_msg);
-						tmp_bp_copy->fp_elements = tmp_elements;
-					}
-					while (tmp_bp_copy->fp_elements);
-				}
-				
-				if (tmp_bp_copy->tp_elements) {
-					do {
-						REGISTER
-						ntp_element tmp_elements = tmp_bp_copy->tp_elements->unpaired->next;
-						FREE_DEBUG (tmp_bp_copy->tp_elements->unpaired, free_list_reason_msg);
-						FREE_DEBUG (tmp_bp_copy->tp_elements, free_list_reason_msg);
-						tmp_bp_copy->tp_elements = tmp_elements;
-					}
-					while (tmp_bp_copy->tp_elements);
-				}
-				
-				FREE_DEBUG ((void *) linked_bp_copy->bp, free_bp_reason_msg);
-				linked_bp_copy = linked_bp_copy->prev_linked_bp;
-				FREE_DEBUG (tmp_bp_copy, free_bp_reason_msg);
-			}
-			while (linked_bp_copy);
-			
-			// reduce list size
-			list_size--;
-		}
-	}
-}
@@ -7,15 +7,13 @@
 #include "sequence.h"
 #include "limits.h"
 
-extern ntp_list search_seq_list;
-
 #ifdef MULTITHREADED_ON
 	bool initialize_list_destruction();
 	bool wait_list_destruction();
 	void finalize_list_destruction();
 #endif
 
-bool list_initialize_tagging();
+bool list_initialize_tagging (ntp_list *search_seq_list);
 
 bool ntp_list_insert (ntp_list restrict dst, ntp_list restrict src,
                       const nt_stack_size stack_len, const uchar track_id);
@@ -41,16 +39,20 @@ ntp_linked_bp get_linked_bp_root (ntp_linked_bp restrict current_linked_bp,
 
 void dump_linked_bp (ntp_linked_bp linked_bp, ntp_seq seq);
 
-bool list_destroy_all_tagged();
+#ifdef NO_FULL_CHECKS
+	void clear_search_seq_list (ntp_list *restrict search_seq_list);
+#else
+	bool clear_search_seq_list (ntp_list *restrict search_seq_list);
+#endif
+bool list_destroy_all_tagged (ntp_list *search_seq_list);
 
+void dispose_linked_bp_copy_chain (ntp_linked_bp linked_bp_copy,
+                                   char *free_bp_reason_msg, char *free_list_reason_msg);
 bool dispose_linked_bp_copy (nt_model *restrict model, ntp_list list,
                              char *free_bp_reason_msg, char *free_list_reason_msg
 #ifndef NO_FULL_CHECKS
 	, char *failed_iteration_msg
 #endif
                             );
-void dispose_linked_bp_copy_by_FE_threshold (nt_model *restrict model,
-                                        const char *seq, ntp_list list, float FE_threshold,
-                                        char *free_bp_reason_msg, char *free_list_reason_msg);
 
 #endif //RNA_M_LIST_H
@@ -18,6 +18,11 @@
 #define MAX_MODEL_STRING_LEN          200
 #define MAX_POS_VAR                   25
 
+// the min/max (nt_element_count) of an element are bounded by the model string, not
+// by the search window, so they remain narrow under WIDE_POSITIONS
+_Static_assert (MAX_MODEL_STRING_LEN + MAX_POS_VAR <= UCHAR_MAX,
+                "element min/max must fit nt_element_count");
+
 #define MAX_BRANCHES_PER_JUNCTION     3                     // max number of branches allowed in a junction, excluding base helix
 
 #ifdef SEARCH_SEQ_DETAIL
@@ -69,7 +74,7 @@ typedef struct _nt_unpaired_element {
 			nt_element_count min, max;
 		};
 		struct {
-			uchar dist, length;
+			nt_rel_seq_len dist, length;
 			struct {
 				ntp_constraint reference;
 				nt_constraint_element_type element_type;
@@ -95,6 +100,7 @@ typedef struct _nt_paired_element {
 
 typedef struct _nt_element {
 	nt_element_type type;
+	ushort plan_step;                   // index of the element in a compiled nt_model_plan
 	union {
 		ntp_unpaired_element unpaired;
 		ntp_paired_element paired;
@@ -154,4 +160,49 @@ typedef struct {
 	nt_list stacks[MAX_STACK_LEN];
 } nt_seq_bp, *ntp_seq_bp;
 
+/*
+ * compiled model (see compile_model_plan): the model's elements flattened, 5' to 3'
+ * and depth-first, into a contiguous array of plan steps, along with the values
+ * derived for each paired element (stack distances, extrusion, containing and
+ * contained paired elements) that would otherwise be re-derived by traversing the
+ * model; derived values depend on element min/max values, so that a plan needs to
+ * be recompiled whenever these change (such as when partitioning a model)
+ */
+#define NO_PLAN_STEP                  USHRT_MAX
+#define MIN_MODEL_PLAN_SIZE           32
+
+typedef struct {
+	ushort step;
+	nt_rel_count fp_dist_min, fp_dist_max, tp_dist_min, tp_dist_max;
+	nt_stack_idist idist_min, idist_max;
+	short in_extrusion;
+	nt_rel_count next_min, next_max;    // unpaired nts up to the next contained paired element
+} nt_plan_contained;
+
+typedef struct {
+	ntp_element el;
+	nt_element_type type;
+	nt_element_count min, max;
+	ushort next, fp_next, tp_next;      // unpaired: next; paired: fp_next and tp_next
+	ushort containing;                  // innermost paired element that contains the element
+	// paired elements only
+	bool has_stack_dists;
+	nt_stack_idist min_stack_dist, max_stack_dist;
+	bool fp_extrusion, tp_extrusion;    // base triple extrusion inside/around the paired element
+	short in_extrusion;
+	const nt_element *extrusion_prev_el;
+	nt_element_count extrusion_containing_min;
+	bool is_nested;                     // contained in a paired element that is not a wrapper
+	nt_rel_count nested_fp_dist_min, nested_fp_dist_max, nested_tp_dist_min,
+	             nested_tp_dist_max;
+	ushort first_contained, num_contained;
+} nt_plan_step;
+
+typedef struct {
+	nt_plan_step *steps;
+	ushort num_steps, max_steps;
+	nt_plan_contained *contained;
+	ushort num_contained, max_contained;
+} nt_model_plan, *ntp_model_plan;
+
 #endif //RNA_M_MODEL_H
@@ -17,52 +17,70 @@
 #include "m_optimize.h"
 
 #define MAX_CONTAINMENT_ELEMENTS 10
+#define OPTIMIZE_BITSET_WORD_BITS      64                          // bits per (uint64_t) word of bitsets
+#define OPTIMIZE_BITSET_WORDS(n)       (((n) + OPTIMIZE_BITSET_WORD_BITS - 1) / OPTIMIZE_BITSET_WORD_BITS)
+
+/*
+ * worklist of the plan steps whose bps are to be re-examined (see optimize_seq_bp),
+ * either against the bps of their contained paired elements (down), or against those
+ * of their containing paired element (up); each step is queued at most once
+ */
+typedef struct {
+	ushort num_steps;
+	ushort *queue;                      // circular, of num_steps entries
+	ushort head, num_queued;
+	uint64_t *is_queued, *needs_down, *needs_up;
+	// stacks that hold bp lists of step s are stacks[first_stack[s]..first_stack[s+1]-1]
+	uint32_t *first_stack;
+	ntp_stack *stacks;
+	nt_stack_size *stack_sizes;
+} nt_seq_bp_worklist, *ntp_seq_bp_worklist;
+
+static inline bool is_bit_set (const uint64_t *bitset, const unsigned long bit) {
+	return (bitset[bit / OPTIMIZE_BITSET_WORD_BITS] >> (bit % OPTIMIZE_BITSET_WORD_BITS)) &
+	       1;
+}
+
+static inline void set_bit (uint64_t *bitset, const unsigned long bit) {
+	bitset[bit / OPTIMIZE_BITSET_WORD_BITS] |= (uint64_t) 1 << (bit %
+	                                        OPTIMIZE_BITSET_WORD_BITS);
+}
+
+static inline void clear_bit (uint64_t *bitset, const unsigned long bit) {
+	bitset[bit / OPTIMIZE_BITSET_WORD_BITS] &= ~ ((uint64_t) 1 << (bit %
+	                                        OPTIMIZE_BITSET_WORD_BITS));
+}
 
 /*
  * model/seq_bp optimization functions
  */
 static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
+                                        const nt_model_plan *restrict plan,
                                         nt_stack_size this_stack_size, nt_stack_idist this_stack_idist,
                                         ntp_bp_list_by_element restrict this_list_by_element) {
 	REGISTER
 	bool bps_removed = false;
-	ntp_element contained_paired_elements[MAX_CONTAINMENT_ELEMENTS];
-	nt_rel_count paired_elements_fp_dist_min[MAX_CONTAINMENT_ELEMENTS],
-	             paired_elements_fp_dist_max[MAX_CONTAINMENT_ELEMENTS],
-	             paired_elements_tp_dist_min[MAX_CONTAINMENT_ELEMENTS],
-	             paired_elements_tp_dist_max[MAX_CONTAINMENT_ELEMENTS],
-	             next_paired_elements_min[MAX_CONTAINMENT_ELEMENTS],
-	             next_paired_elements_max[MAX_CONTAINMENT_ELEMENTS];
-	nt_stack_idist paired_elements_idist_min[MAX_CONTAINMENT_ELEMENTS],
-	               paired_elements_idist_max[MAX_CONTAINMENT_ELEMENTS];
-	short paired_elements_in_extrusion[MAX_CONTAINMENT_ELEMENTS];
-	ushort num_contained_paired_elements = 0;
-	bool bp_matched_paired_element_set[MAX_BP_PER_STACK_IDIST];
-	uchar bp_matched_paired_element_count[MAX_BP_PER_STACK_IDIST];
+	const nt_plan_step *restrict this_step = &plan->steps[this_list_by_element->el->plan_step];
+	// contained paired elements of this element, as compiled into the plan
+	const nt_plan_contained *restrict contained = &plan->contained[this_step->first_contained];
+	const ushort num_contained_paired_elements = this_step->num_contained;
+	uint64_t bp_matched_paired_element_set[OPTIMIZE_BITSET_WORDS (MAX_BP_PER_STACK_IDIST)];
 	ntp_bp candidate_bp[MAX_CONTAINMENT_ELEMENTS][MAX_ELEMENT_MATCHES];
 	nt_stack_size
 	candidate_bp_stack_size[MAX_CONTAINMENT_ELEMENTS][MAX_ELEMENT_MATCHES];
 	
-	for (REGISTER nt_hit_count b = 0; b < this_list_by_element->stack_counts; b++) {
-		bp_matched_paired_element_set[b] = false;
-		bp_matched_paired_element_count[b] = 0;
-	}
-	
-	if (get_contained_paired_elements_by_element (contained_paired_elements,
-	                                        paired_elements_fp_dist_min, paired_elements_fp_dist_max,
-	                                        paired_elements_tp_dist_min, paired_elements_tp_dist_max,
-	                                        paired_elements_idist_min, paired_elements_idist_max,
-	                                        paired_elements_in_extrusion,
-	                                        next_paired_elements_min, next_paired_elements_max,
-	                                        &num_contained_paired_elements,
-	                                        seq_bp->model, seq_bp->model->first_element, this_list_by_element->el,
-	                                        (nt_stack_idist) (this_stack_size + 1), this_stack_idist)) {
+	memset (bp_matched_paired_element_set, 0,
+	        sizeof (uint64_t) * OPTIMIZE_BITSET_WORDS (this_list_by_element->stack_counts));
+	        
+	if (num_contained_paired_elements) {
 		for (REGISTER nt_hit_count b = 0; b < this_list_by_element->stack_counts; b++) {
 			nt_rel_count
 			candidate_bp_next_min[MAX_CONTAINMENT_ELEMENTS][MAX_ELEMENT_MATCHES],
 			                      candidate_bp_next_max[MAX_CONTAINMENT_ELEMENTS][MAX_ELEMENT_MATCHES];
 			ushort num_candidate_bps[MAX_CONTAINMENT_ELEMENTS];
 			REGISTER
+			uchar bp_matched_paired_element_count = 0;
+			REGISTER
 			ntp_bp this_bp = list_get_at (&this_list_by_element->list, b);
 			
 			for (REGISTER ushort i = 0; i < num_contained_paired_elements; i++) {
@@ -70,8 +88,8 @@ static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
 			}
 			
 			for (REGISTER ushort i = 0; i < num_contained_paired_elements; i++) {
-				if (!contained_paired_elements[i]->paired->min) {
-					bp_matched_paired_element_count[b]++;
+				if (!plan->steps[contained[i].step].min) {
+					bp_matched_paired_element_count++;
 					// skip contained pairs with min stack length of 0
 					continue;
 				}
@@ -79,15 +97,15 @@ static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
 				REGISTER
 				bool this_bp_matched_this_paired_element = false;
 				
-				for (REGISTER nt_rel_count fp_dist = paired_elements_fp_dist_min[i];
-				     fp_dist <= paired_elements_fp_dist_max[i]; fp_dist++) {
-					for (REGISTER nt_rel_count tp_dist = paired_elements_tp_dist_min[i];
-					     tp_dist <= paired_elements_tp_dist_max[i]; tp_dist++) {
-						for (REGISTER nt_rel_count idist = paired_elements_idist_min[i];
-						     idist <= paired_elements_idist_max[i]; idist++) {
+				for (REGISTER nt_rel_count fp_dist = contained[i].fp_dist_min;
+				     fp_dist <= contained[i].fp_dist_max; fp_dist++) {
+					for (REGISTER nt_rel_count tp_dist = contained[i].tp_dist_min;
+					     tp_dist <= contained[i].tp_dist_max; tp_dist++) {
+						for (REGISTER nt_rel_count idist = contained[i].idist_min;
+						     idist <= contained[i].idist_max; idist++) {
 							for (REGISTER nt_rel_count that_size = (nt_rel_count) (
-							                                        contained_paired_elements[i]->paired->min - 1);
-							     that_size < contained_paired_elements[i]->paired->max; that_size++) {
+							                                        plan->steps[contained[i].step].min - 1);
+							     that_size < plan->steps[contained[i].step].max; that_size++) {
 								list_iterator_start (&seq_bp->stacks[that_size]);
 								
 								while (list_iterator_hasnext (&seq_bp->stacks[that_size])) {
@@ -95,12 +113,12 @@ static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
 									ntp_stack that_stack = list_iterator_next (&seq_bp->stacks[that_size]);
 									
 									if (that_stack->stack_idist == idist &&
-									    that_stack->in_extrusion == paired_elements_in_extrusion[i]) {
+									    that_stack->in_extrusion == contained[i].in_extrusion) {
 										REGISTER
 										ntp_bp_list_by_element that_list_by_element = that_stack->lists;
 										
 										while (that_list_by_element) {
-											if (that_list_by_element->el == contained_paired_elements[i]) {
+											if (that_list_by_element->el == plan->steps[contained[i].step].el) {
 												if (that_list_by_element->stack_counts) {
 													list_iterator_start (&that_list_by_element->list);
 													
@@ -122,13 +140,13 @@ static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
 														    this_bp->tp_posn == (that_bp->tp_posn + (that_size + 1) + tp_dist)) {
 															if (!this_bp_matched_this_paired_element) {
 																this_bp_matched_this_paired_element = true;
-																bp_matched_paired_element_count[b]++;
+																bp_matched_paired_element_count++;
 															}
 															
 															candidate_bp[i][num_candidate_bps[i]] = that_bp;
 															candidate_bp_stack_size[i][num_candidate_bps[i]] = that_size;
-															candidate_bp_next_min[i][num_candidate_bps[i]] = next_paired_elements_min[i];
-															candidate_bp_next_max[i][num_candidate_bps[i]] = next_paired_elements_max[i];
+															candidate_bp_next_min[i][num_candidate_bps[i]] = contained[i].next_min;
+															candidate_bp_next_max[i][num_candidate_bps[i]] = contained[i].next_max;
 															num_candidate_bps[i]++;
 														}
 													}
@@ -151,7 +169,7 @@ static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
 				}
 			}
 			
-			if (bp_matched_paired_element_count[b] == num_contained_paired_elements) {
+			if (bp_matched_paired_element_count == num_contained_paired_elements) {
 				ushort candidate_idxs[MAX_CONTAINMENT_ELEMENTS];
 				REGISTER ushort i = 0;
 				
@@ -168,7 +186,7 @@ static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
 				bool fail = false;
 				
 				while (i < num_contained_paired_elements && !fail) {
-					if (!contained_paired_elements[i]->paired->min) {
+					if (!plan->steps[contained[i].step].min) {
 						i++;
                         // skip pairs with min stack size 0
 						continue;					
@@ -259,14 +277,16 @@ static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
 					}
 				}
 				
-				bp_matched_paired_element_set[b] = !fail;
+				if (!fail) {
+					set_bit (bp_matched_paired_element_set, b);
+				}
 			}
 		}
 		
 		REGISTER nt_hit_count b = 0, p = 0;
 		
 		while (b < this_list_by_element->stack_counts) {
-			if (!bp_matched_paired_element_set[p]) {
+			if (!is_bit_set (bp_matched_paired_element_set, p)) {
 				ntp_bp bad_bp = list_extract_at (&this_list_by_element->list, b);
 				FREE_DEBUG (bad_bp, NULL);              // TODO: check extracted bp
 				this_list_by_element->stack_counts--;
@@ -287,136 +307,103 @@ static inline bool optimize_seq_bp_down (ntp_seq_bp restrict seq_bp,
 	return bps_removed;
 }
 
+/*
+ * private function to remove the bps of a bp list that are not contained in any bp of
+ * the list's containing paired element (if any)
+ */
 static inline bool optimize_seq_bp_up (ntp_seq_bp restrict seq_bp,
-                                       nt_stack_size this_size) {
-	ntp_element containing_paired_element = NULL;
-	nt_rel_count paired_element_fp_dist_min = 0, paired_element_fp_dist_max = 0,
-	             paired_element_tp_dist_min = 0, paired_element_tp_dist_max = 0;
+                                       const nt_model_plan *restrict plan, nt_stack_size this_size,
+                                       ntp_stack restrict this_stack,
+                                       ntp_bp_list_by_element restrict this_list_by_element) {
 	REGISTER
 	bool bps_removed = false;
-	/*
-	 * iterate over all idist, in_extrusion stacks for this element
-	 */
-	REGISTER
-	ntp_list stacks_for_size = &seq_bp->stacks[this_size];
-	
-	for (REGISTER nt_hit_count t = 0; t < stacks_for_size->numels; t++) {
+	const nt_plan_step *restrict this_step =
+	                    &plan->steps[this_list_by_element->el->plan_step];
+	                    
+	// need containing paired element which is not a wrapper bp
+	if (this_step->is_nested) {
+		const ntp_element containing_paired_element = plan->steps[this_step->containing].el;
+		const nt_rel_count paired_element_fp_dist_min = this_step->nested_fp_dist_min,
+		                   paired_element_fp_dist_max = this_step->nested_fp_dist_max,
+		                   paired_element_tp_dist_min = this_step->nested_tp_dist_min,
+		                   paired_element_tp_dist_max = this_step->nested_tp_dist_max;
+		/*
+		 * iterate over all this stack's bps testing containment for each containing paired element;
+		 * keep bp if containment found in at least one case
+		 */
 		REGISTER
-		ntp_stack this_stack = list_get_at (stacks_for_size, t);
+		ulong this_stack_numels = this_list_by_element->list.numels;
 		REGISTER
-		ntp_bp_list_by_element this_list_by_element = this_stack->lists,
-		                       prev_list_by_element = NULL;
-		                       
-		while (this_list_by_element) {
-			if (0 >= this_stack->in_extrusion) {
-				if (optimize_seq_bp_down (seq_bp, this_size, this_stack->stack_idist,
-				                          this_list_by_element)) {
-					bps_removed = true;
-				}
-			}
+		ulong b = 0;
+		
+		while (b < this_stack_numels) {
+			ntp_bp this_bp = list_get_at (&this_list_by_element->list, b);
+			REGISTER
+			bool found_first_containing_stack = false;
 			
-			if (0 <= this_stack->in_extrusion && this_list_by_element->stack_counts) {
-				if (get_containing_paired_element_dist_by_element
-				    (&containing_paired_element,
-				     &paired_element_fp_dist_min, &paired_element_fp_dist_max,
-				     &paired_element_tp_dist_min, &paired_element_tp_dist_max,
-				     NULL, seq_bp->model, seq_bp->model->first_element, this_list_by_element->el,
-				     (nt_stack_size) (this_size + 1), this_stack->stack_idist) &&
-				    containing_paired_element) {
+			/*
+			 * for each containing element, iterate over all fp/tp distances between contained and containing paired element
+			 */
+			for (REGISTER nt_rel_count fp_dist = paired_element_fp_dist_min;
+			     fp_dist <= paired_element_fp_dist_max; fp_dist++) {
+				for (REGISTER nt_rel_count tp_dist = paired_element_tp_dist_min;
+				     tp_dist <= paired_element_tp_dist_max; tp_dist++) {
 					/*
-					 * iterate over all this stack's bps testing containment for each containing paired element;
-					 * keep bp if containment found in at least one case
+					 * start with min pos_var of containing paired element; try all
+					 * pos_vars up to max value but can stop if/when a match is found
 					 */
-					REGISTER
-					ulong this_stack_numels = this_list_by_element->list.numels;
-					REGISTER
-					ulong b = 0;
-					
-					while (b < this_stack_numels) {
-						ntp_bp this_bp = list_get_at (&this_list_by_element->list, b);
+					for (REGISTER nt_stack_size s = (nt_stack_size) (
+					                                        containing_paired_element->paired->min > 0 ?
+					                                        containing_paired_element->paired->min - 1 : 0);
+					     s < containing_paired_element->paired->max; s++) {
 						REGISTER
-						bool found_first_containing_stack = false;
+						ntp_list stacks_for_that_size = &seq_bp->stacks[s];
+						list_iterator_start (stacks_for_that_size);
 						
-						/*
-						 * for each containing element, iterate over all fp/tp distances between contained and containing paired element
-						 */
-						for (REGISTER nt_rel_count fp_dist = paired_element_fp_dist_min;
-						     fp_dist <= paired_element_fp_dist_max; fp_dist++) {
-							for (REGISTER nt_rel_count tp_dist = paired_element_tp_dist_min;
-							     tp_dist <= paired_element_tp_dist_max; tp_dist++) {
-								/*
-								 * start with min pos_var of containing paired element; try all
-								 * pos_vars up to max value but can stop if/when a match is found
-								 */
-								for (REGISTER nt_stack_size s = (nt_stack_size) (
-								                                        containing_paired_element->paired->min > 0 ?
-								                                        containing_paired_element->paired->min - 1 : 0);
-								     s < containing_paired_element->paired->max; s++) {
-									REGISTER
-									ntp_list stacks_for_that_size = &seq_bp->stacks[s];
-									list_iterator_start (stacks_for_that_size);
-									
-									while (list_iterator_hasnext (stacks_for_that_size)) {
-										REGISTER
-										ntp_stack that_stack = list_iterator_next (stacks_for_that_size);
-										REGISTER
-										ntp_bp_list_by_element that_list_by_element = that_stack->lists;
+						while (list_iterator_hasnext (stacks_for_that_size)) {
+							REGISTER
+							ntp_stack that_stack = list_iterator_next (stacks_for_that_size);
+							REGISTER
+							ntp_bp_list_by_element that_list_by_element = that_stack->lists;
+							
+							while (that_list_by_element) {
+								if (that_list_by_element->el == containing_paired_element) {
+									if (that_list_by_element->stack_counts &&
+									    that_stack->stack_idist == fp_dist + ((this_size + 1) * 2) +
+									    this_stack->stack_idist + tp_dist) {
+										list_iterator_start (&that_list_by_element->list);
 										
-										while (that_list_by_element) {
-											if (that_list_by_element->el == containing_paired_element) {
-												if (that_list_by_element->stack_counts &&
-												    that_stack->stack_idist == fp_dist + ((this_size + 1) * 2) +
-												    this_stack->stack_idist + tp_dist) {
-													list_iterator_start (&that_list_by_element->list);
-													
-													while (list_iterator_hasnext (&that_list_by_element->list)) {
-														ntp_bp that_bp = list_iterator_next (&that_list_by_element->list);
-														
-														if (that_bp->fp_posn + (s + 1) + fp_dist > this_bp->fp_posn) {
-															/*
-															 * those (that)bps are assumed to be ordered (5'->3') such
-															 * that fp_posn of bp (X+1) >= fp_posn of bp (X) fro any X,
-															 * so if that_bp's fp_posn is already > this_bp...fp_dist,
-															 * there there is no need to visit that bp or successive ones
-															 */
-															break;
-														}
-														
-														if (that_bp->fp_posn + (s + 1) + fp_dist == this_bp->fp_posn &&
-														    that_bp->tp_posn == (this_bp->tp_posn + (this_size + 1) + tp_dist)) {
-															found_first_containing_stack = true;
-															break;
-														}
-													}
-													
-													list_iterator_stop (&that_list_by_element->list);
-													
-													if (found_first_containing_stack) {
-														break;
-													}
-												}
-												
+										while (list_iterator_hasnext (&that_list_by_element->list)) {
+											ntp_bp that_bp = list_iterator_next (&that_list_by_element->list);
+											
+											if (that_bp->fp_posn + (s + 1) + fp_dist > this_bp->fp_posn) {
+												/*
+												 * those (that)bps are assumed to be ordered (5'->3') such
+												 * that fp_posn of bp (X+1) >= fp_posn of bp (X) fro any X,
+												 * so if that_bp's fp_posn is already > this_bp...fp_dist,
+												 * there there is no need to visit that bp or successive ones
+												 */
 												break;
 											}
 											
-											that_list_by_element = that_list_by_element->next;
+											if (that_bp->fp_posn + (s + 1) + fp_dist == this_bp->fp_posn &&
+											    that_bp->tp_posn == (this_bp->tp_posn + (this_size + 1) + tp_dist)) {
+												found_first_containing_stack = true;
+												break;
+											}
 										}
 										
+										list_iterator_stop (&that_list_by_element->list);
+										
 										if (found_first_containing_stack) {
 											break;
 										}
 									}
 									
-									list_iterator_stop (stacks_for_that_size);
-									
-									if (found_first_containing_stack) {
-										break;
-									}
-								}
-								
-								if (found_first_containing_stack) {
 									break;
 								}
+								
+								that_list_by_element = that_list_by_element->next;
 							}
 							
 							if (found_first_containing_stack) {
@@ -424,56 +411,262 @@ static inline bool optimize_seq_bp_up (ntp_seq_bp restrict seq_bp,
 							}
 						}
 						
-						if (!found_first_containing_stack) {
-							// remove this bp
-							ntp_bp bad_bp = list_extract_at (&this_list_by_element->list, b);
-							FREE_DEBUG (bad_bp, NULL);              // TODO: check extracted bp
-							this_list_by_element->stack_counts--;
-							this_stack_numels--;
-							bps_removed = true;
-						}
+						list_iterator_stop (stacks_for_that_size);
 						
-						else {
-							// test next bp
-							b++;
+						if (found_first_containing_stack) {
+							break;
 						}
 					}
-				}
-			}
-			
-			/*
-			 * clean up any empty list_by_element's
-			 */
-			if (!this_list_by_element->stack_counts) {
-				if (prev_list_by_element) {
-					prev_list_by_element->next = this_list_by_element->next;
-				}
-				
-				else {
-					this_stack->lists = this_list_by_element->next;
+					
+					if (found_first_containing_stack) {
+						break;
+					}
 				}
 				
-				list_destroy (&this_list_by_element->list);
-				FREE_DEBUG (this_list_by_element,
-				            "ntp_list_by_element of stack of seq_bp in optimize_seq_bp_up");
-				            
-				if (prev_list_by_element) {
-					this_list_by_element = prev_list_by_element->next;
+				if (found_first_containing_stack) {
+					break;
 				}
+			}
+			
+			if (!found_first_containing_stack) {
+				// remove this bp
+				ntp_bp bad_bp = list_extract_at (&this_list_by_element->list, b);
+				FREE_DEBUG (bad_bp, NULL);              // TODO: check extracted bp
+				this_list_by_element->stack_counts--;
+				this_stack_numels--;
+				bps_removed = true;
+			}
+			
+			else {
+				// test next bp
+				b++;
+			}
+		}
+	}
+	
+	return bps_removed;
+}
+
+/*
+ * private function to queue a plan step on the worklist, for its bps to be re-examined
+ * against its contained paired elements (down) and/or its containing paired element (up)
+ */
+static inline void add_seq_bp_worklist_step (ntp_seq_bp_worklist restrict worklist,
+                                        const ushort step, const bool down, const bool up) {
+	if (worklist->first_stack[step] == worklist->first_stack[step + 1]) {
+		// no stacks with bps for step
+		return;
+	}
+	
+	if (down) {
+		set_bit (worklist->needs_down, step);
+	}
+	
+	if (up) {
+		set_bit (worklist->needs_up, step);
+	}
+	
+	if (!is_bit_set (worklist->is_queued, step)) {
+		set_bit (worklist->is_queued, step);
+		worklist->queue[(worklist->head + worklist->num_queued++) % worklist->num_steps] = step;
+	}
+}
+
+static void finalize_seq_bp_worklist (ntp_seq_bp_worklist restrict worklist) {
+	FREE_DEBUG (worklist->queue, "queue of worklist in finalize_seq_bp_worklist");
+	FREE_DEBUG (worklist->is_queued, "bitsets of worklist in finalize_seq_bp_worklist");
+	FREE_DEBUG (worklist->first_stack, "first_stack of worklist in finalize_seq_bp_worklist");
+	
+	if (worklist->stacks) {
+		FREE_DEBUG (worklist->stacks, "stacks of worklist in finalize_seq_bp_worklist");
+	}
+	
+	if (worklist->stack_sizes) {
+		FREE_DEBUG (worklist->stack_sizes, "stack_sizes of worklist in finalize_seq_bp_worklist");
+	}
+}
+
+/*
+ * private function to set up the worklist of a seq_bp, indexing the stacks that hold
+ * bp lists of each plan step, and queueing all such steps for both down and up
+ */
+static bool initialize_seq_bp_worklist (ntp_seq_bp restrict seq_bp,
+                                        const nt_model_plan *restrict plan, ntp_seq_bp_worklist restrict worklist) {
+	REGISTER
+	uint32_t num_words = OPTIMIZE_BITSET_WORDS (plan->num_steps), num_stacks = 0;
+	memset (worklist, 0, sizeof (nt_seq_bp_worklist));
+	worklist->num_steps = plan->num_steps;
+	worklist->queue = MALLOC_DEBUG (sizeof (ushort) * plan->num_steps,
+	                                "queue of worklist in initialize_seq_bp_worklist");
+	// is_queued, needs_down and needs_up bitsets in a single block
+	worklist->is_queued = MALLOC_DEBUG (sizeof (uint64_t) * num_words * 3,
+	                                    "bitsets of worklist in initialize_seq_bp_worklist");
+	worklist->first_stack = MALLOC_DEBUG (sizeof (uint32_t) * (plan->num_steps + 1),
+	                                      "first_stack of worklist in initialize_seq_bp_worklist");
+	                                      
+	if (!worklist->queue || !worklist->is_queued || !worklist->first_stack) {
+		COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+		              "could not allocate memory for worklist in initialize_seq_bp_worklist", false);
+		              
+		if (worklist->queue) {
+			FREE_DEBUG (worklist->queue, "queue of worklist in initialize_seq_bp_worklist");
+		}
+		
+		if (worklist->is_queued) {
+			FREE_DEBUG (worklist->is_queued, "bitsets of worklist in initialize_seq_bp_worklist");
+		}
+		
+		if (worklist->first_stack) {
+			FREE_DEBUG (worklist->first_stack,
+			            "first_stack of worklist in initialize_seq_bp_worklist");
+		}
+		
+		return false;
+	}
+	
+	memset (worklist->is_queued, 0, sizeof (uint64_t) * num_words * 3);
+	memset (worklist->first_stack, 0, sizeof (uint32_t) * (plan->num_steps + 1));
+	worklist->needs_down = worklist->is_queued + num_words;
+	worklist->needs_up = worklist->needs_down + num_words;
+	
+	// count the stacks with bp lists of each step, then index them by step
+	for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+		for (REGISTER nt_hit_count t = 0; t < seq_bp->stacks[i].numels; t++) {
+			REGISTER
+			ntp_stack this_stack = list_get_at (&seq_bp->stacks[i], t);
+			
+			for (REGISTER ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+			     this_list_by_element; this_list_by_element = this_list_by_element->next) {
+				worklist->first_stack[this_list_by_element->el->plan_step + 1]++;
+				num_stacks++;
+			}
+		}
+	}
+	
+	for (REGISTER ushort s = 0; s < plan->num_steps; s++) {
+		worklist->first_stack[s + 1] += worklist->first_stack[s];
+	}
+	
+	if (num_stacks) {
+		worklist->stacks = MALLOC_DEBUG (sizeof (ntp_stack) * num_stacks,
+		                                 "stacks of worklist in initialize_seq_bp_worklist");
+		worklist->stack_sizes = MALLOC_DEBUG (sizeof (nt_stack_size) * num_stacks,
+		                                      "stack_sizes of worklist in initialize_seq_bp_worklist");
+		                                      
+		if (!worklist->stacks || !worklist->stack_sizes) {
+			COMMIT_DEBUG (REPORT_ERRORS, MODEL,
+			              "could not allocate memory for worklist stacks in initialize_seq_bp_worklist",
+			              false);
+			finalize_seq_bp_worklist (worklist);
+			return false;
+		}
+		
+		// fill in order of stack size, using first_stack of step s as its fill posn
+		for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+			for (REGISTER nt_hit_count t = 0; t < seq_bp->stacks[i].numels; t++) {
+				REGISTER
+				ntp_stack this_stack = list_get_at (&seq_bp->stacks[i], t);
 				
-				else {
-					this_list_by_element = this_stack->lists;
+				for (REGISTER ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+				     this_list_by_element; this_list_by_element = this_list_by_element->next) {
+					REGISTER
+					uint32_t this_stack_idx = worklist->first_stack[this_list_by_element->el->plan_step]++;
+					worklist->stacks[this_stack_idx] = this_stack;
+					worklist->stack_sizes[this_stack_idx] = i;
 				}
 			}
+		}
+		
+		for (REGISTER ushort s = plan->num_steps; s > 0; s--) {
+			worklist->first_stack[s] = worklist->first_stack[s - 1];
+		}
+		
+		worklist->first_stack[0] = 0;
+	}
+	
+	for (REGISTER ushort s = 0; s < plan->num_steps; s++) {
+		add_seq_bp_worklist_step (worklist, s, true, true);
+	}
+	
+	return true;
+}
+
+/*
+ * private function to re-examine the bps of a plan step taken off the worklist; when
+ * bps are removed, then the steps that these supported (its containing paired element
+ * and its contained paired elements) are queued in turn
+ */
+static void optimize_seq_bp_by_step (ntp_seq_bp restrict seq_bp,
+                                     const nt_model_plan *restrict plan, ntp_seq_bp_worklist restrict worklist,
+                                     const ushort step) {
+	const REGISTER
+	bool down = is_bit_set (worklist->needs_down, step), up = is_bit_set (worklist->needs_up,
+	                                        step);
+	REGISTER
+	bool bps_removed = false;
+	const nt_plan_step *restrict this_step = &plan->steps[step];
+	clear_bit (worklist->needs_down, step);
+	clear_bit (worklist->needs_up, step);
+	
+	for (REGISTER uint32_t t = worklist->first_stack[step]; t < worklist->first_stack[step + 1];
+	     t++) {
+		REGISTER
+		ntp_stack this_stack = worklist->stacks[t];
+		REGISTER
+		nt_stack_size this_size = worklist->stack_sizes[t];
+		REGISTER
+		ntp_bp_list_by_element this_list_by_element = this_stack->lists,
+		                       prev_list_by_element = NULL;
+		                       
+		while (this_list_by_element && this_list_by_element->el != this_step->el) {
+			prev_list_by_element = this_list_by_element;
+			this_list_by_element = this_list_by_element->next;
+		}
+		
+		if (!this_list_by_element) {
+			// list already removed
+			continue;
+		}
+		
+		if (down && 0 >= this_stack->in_extrusion &&
+		    optimize_seq_bp_down (seq_bp, plan, this_size, this_stack->stack_idist,
+		                          this_list_by_element)) {
+			bps_removed = true;
+		}
+		
+		if (up && 0 <= this_stack->in_extrusion && this_list_by_element->stack_counts &&
+		    optimize_seq_bp_up (seq_bp, plan, this_size, this_stack, this_list_by_element)) {
+			bps_removed = true;
+		}
+		
+		/*
+		 * clean up any empty list_by_element's
+		 */
+		if (!this_list_by_element->stack_counts) {
+			if (prev_list_by_element) {
+				prev_list_by_element->next = this_list_by_element->next;
+			}
 			
 			else {
-				prev_list_by_element = this_list_by_element;
-				this_list_by_element = this_list_by_element->next;
+				this_stack->lists = this_list_by_element->next;
 			}
+			
+			list_destroy (&this_list_by_element->list);
+			FREE_DEBUG (this_list_by_element,
+			            "ntp_list_by_element of stack of seq_bp in optimize_seq_bp_by_step");
 		}
 	}
 	
-	return bps_removed;
+	if (bps_removed) {
+		if (this_step->containing != NO_PLAN_STEP) {
+			add_seq_bp_worklist_step (worklist, this_step->containing, true, false);
+		}
+		
+		for (REGISTER ushort i = 0; i < this_step->num_contained; i++) {
+			add_seq_bp_worklist_step (worklist, plan->contained[this_step->first_contained + i].step,
+			                          false, true);
+		}
+	}
 }
 
 bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
@@ -492,7 +685,7 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 	                       
 	while (this_list_by_element) {
 		REGISTER nt_hit_count orig_stack_count = this_list_by_element->stack_counts;
-		ushort bp_num_constraints_passed[MAX_ELEMENT_MATCHES];
+		ushort bp_num_constraints_passed[MAX_BP_PER_STACK_IDIST];
 		
 		for (REGISTER nt_hit_count i = 0; i < orig_stack_count; i++) {
 			bp_num_constraints_passed[i] = 0;
@@ -517,11 +710,9 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 			constraint_tp_offset_max = 0;
 			constraint_single_offset_min = 0;
 			constraint_single_offset_max = 0;
-			bool bp_passed_this_constraint_set[MAX_ELEMENT_MATCHES];
-			
-			for (REGISTER nt_hit_count i = 0; i < orig_stack_count; i++) {
-				bp_passed_this_constraint_set[i] = false;
-			}
+			uint64_t bp_passed_this_constraint_set[OPTIMIZE_BITSET_WORDS (MAX_BP_PER_STACK_IDIST)];
+			memset (bp_passed_this_constraint_set, 0,
+			        sizeof (uint64_t) * OPTIMIZE_BITSET_WORDS (orig_stack_count));
 			
 			REGISTER
 			bool found_constraint;
@@ -535,7 +726,7 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 				if (!constraint_fp_offset_min) {
 					// constraint overlaps element -> automatically pass all bps that have not passed this constraint set yet
 					for (REGISTER nt_hit_count b = 0; b < orig_stack_count; b++) {
-						if (!bp_passed_this_constraint_set[b]) {
+						if (!is_bit_set (bp_passed_this_constraint_set, b)) {
 							bp_num_constraints_passed[b]++;
 						}
 					}
@@ -572,7 +763,7 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 					ntp_bp this_bp = list_get_at (&this_list_by_element->list, b);
 					
 					if (bp_num_constraints_passed[b] < num_constraints_done ||
-					    bp_passed_this_constraint_set[b]) {
+					    is_bit_set (bp_passed_this_constraint_set, b)) {
 						b++;
 						continue;
 					}
@@ -623,7 +814,7 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 											}
 											
 											if (i == this_constraint_len) {
-												bp_passed_this_constraint_set[b] = true;
+												set_bit (bp_passed_this_constraint_set, b);
 												bp_num_constraints_passed[b]++;
 												break;
 											}
@@ -637,7 +828,7 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 											}
 										}
 										
-										if (bp_passed_this_constraint_set[b]) {
+										if (is_bit_set (bp_passed_this_constraint_set, b)) {
 											break;
 										}
 										
@@ -674,7 +865,7 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 														// "left-handed base triple"
 														if ((single_nt == 'c' && fp_nt == 'g' && (tp_nt == 'c' || tp_nt == 'u')) ||
 														    (single_nt == 'u' && fp_nt == 'a' && tp_nt == 'u')) {
-															bp_passed_this_constraint_set[b] = true;
+															set_bit (bp_passed_this_constraint_set, b);
 															bp_num_constraints_passed[b]++;
 															break;
 														}
@@ -684,7 +875,7 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 														// "right-handed base triple"
 														if (((fp_nt == 'c' || fp_nt == 'u') && tp_nt == 'g' && single_nt == 'c') ||
 														    (fp_nt == 'u' && tp_nt == 'a' && single_nt == 'u')) {
-															bp_passed_this_constraint_set[b] = true;
+															set_bit (bp_passed_this_constraint_set, b);
 															bp_num_constraints_passed[b]++;
 															break;
 														}
@@ -693,7 +884,7 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 											}
 										}
 										
-										if (!bp_passed_this_constraint_set[b]) {
+										if (!is_bit_set (bp_passed_this_constraint_set, b)) {
 											one_ore_more_bps_failed_this_constraint = true;
 										}
 									}
@@ -703,17 +894,17 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 									one_ore_more_bps_failed_this_constraint = true;
 								}
 								
-								if (bp_passed_this_constraint_set[b]) {
+								if (is_bit_set (bp_passed_this_constraint_set, b)) {
 									break;
 								}
 							}
 							
-							if (bp_passed_this_constraint_set[b]) {
+							if (is_bit_set (bp_passed_this_constraint_set, b)) {
 								break;
 							}
 						}
 						
-						if (!bp_passed_this_constraint_set[b]) {
+						if (!is_bit_set (bp_passed_this_constraint_set, b)) {
 							one_ore_more_bps_failed_this_constraint = true;
 						}
 					}
@@ -795,69 +986,51 @@ bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
 	return bps_removed;
 }
 
-void optimize_seq_bp (ntp_seq_bp restrict seq_bp) {
-	REGISTER
-	bool bps_removed_this_pass;
-	REGISTER
-	ushort pass = 1;
-	
-	do {
-		bps_removed_this_pass = false;
-		
-		/*
-		 * prune search space using relative positions of bps to any constraints available
-		 */
-		if (seq_bp->model->first_constraint) {
-			for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+/*
+ * prune the bps of seq_bp that cannot be part of any hit of its model
+ *
+ * input:   plan, as compiled from the model of seq_bp (see compile_model_plan)
+ */
+void optimize_seq_bp (ntp_seq_bp restrict seq_bp,
+                      const nt_model_plan *restrict plan) {
+	/*
+	 * prune search space using relative positions of bps to any constraints available;
+	 * these only depend on the sequence, and so need to be applied only once
+	 */
+	if (seq_bp->model->first_constraint) {
+		for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+			REGISTER
+			ntp_list this_list = &seq_bp->stacks[i];
+			list_iterator_start (this_list);
+			
+			while (list_iterator_hasnext (this_list)) {
 				REGISTER
-				ntp_list this_list = &seq_bp->stacks[i];
-				list_iterator_start (this_list);
-				
-				while (list_iterator_hasnext (this_list)) {
-					REGISTER
-					ntp_stack this_stack = list_iterator_next (this_list);
-					bps_removed_this_pass = optimize_seq_bp_by_constraint (seq_bp->model,
-					                                        seq_bp->sequence, this_stack, i) || bps_removed_this_pass;
-				}
-				
-				list_iterator_stop (this_list);
+				ntp_stack this_stack = list_iterator_next (this_list);
+				optimize_seq_bp_by_constraint (seq_bp->model, seq_bp->sequence, this_stack, i);
 			}
-		}
-		
-		/*
-		 * prune search space using relative positions of nested (sub-) helices; both upwards and downwards
-		 */
-		REGISTER
-		bool bps_removed;
-		bool previous_iteration_bps_removed[MAX_STACK_LEN];
-		
-		for (REGISTER ushort i = 0; i < MAX_STACK_LEN; i++) {
-			previous_iteration_bps_removed[i] = true; // initialize so as to optimize
-		}
-		
-		do {
-			bps_removed = false; // stop only when no bps removed for all stack lengths
 			
-			for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
-				// initially, assume that no bp removals for this stack length and iteration;
-				previous_iteration_bps_removed[i] =
-				                    false;
-				                    
-				// only need to check for bps in this stack if either bps for one stack longer or shorter have changed in the previous iteration
-				if ((MAX_STACK_LEN - 1 > i && previous_iteration_bps_removed[i + 1]) ||
-				    (0 < i && previous_iteration_bps_removed[i - 1])) {
-					previous_iteration_bps_removed[i] = optimize_seq_bp_up (seq_bp, i);
-					
-					if (previous_iteration_bps_removed[i]) {
-						bps_removed = true;
-						bps_removed_this_pass = true;
-					}
-				}
-			}
+			list_iterator_stop (this_list);
 		}
-		while (bps_removed);
-		
-		pass++;
 	}
-	while (bps_removed_this_pass);
+	
+	/*
+	 * prune search space using relative positions of nested (sub-) helices; both upwards
+	 * and downwards, where only the steps whose supporting bps were removed are revisited
+	 */
+	nt_seq_bp_worklist worklist;
+	
+	if (!initialize_seq_bp_worklist (seq_bp, plan, &worklist)) {
+		return;
+	}
+	
+	while (worklist.num_queued) {
+		REGISTER
+		ushort step = worklist.queue[worklist.head];
+		worklist.head = (ushort) ((worklist.head + 1) % worklist.num_steps);
+		worklist.num_queued--;
+		clear_bit (worklist.is_queued, step);
+		optimize_seq_bp_by_step (seq_bp, plan, &worklist, step);
+	}
+	
+	finalize_seq_bp_worklist (&worklist);
 }
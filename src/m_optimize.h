@@ -7,7 +7,8 @@
 #include "sequence.h"
 #include "limits.h"
 
-void optimize_seq_bp (ntp_seq_bp restrict seq_bp);
+void optimize_seq_bp (ntp_seq_bp restrict seq_bp,
+                      const nt_model_plan *restrict plan);
 bool optimize_seq_bp_by_constraint (const nt_model *restrict model,
                                     ntp_seq restrict seq, ntp_stack restrict this_stack,
                                     const nt_stack_size this_stack_size);
@@ -8,26 +8,17 @@
 #include <stdio.h>
 #include <limits.h>
 #include <unistd.h>
-#include <math.h>
+#include <pthread.h>
 #include "util.h"
 #include "interface.h"
 #include "mfe.h"
 #include "m_seq_bp.h"
 #include "m_analyse.h"
+#include "m_build.h"
 #include "m_list.h"
 #include "m_optimize.h"
 #include "m_search.h"
 
-// distribution of fe's of any hits returned by search_seq_at - required if
-// number of hits exceeds MAX_HITS_RETURNED and filtering by FE is needed;
-// 20000 accomodates data in the ranga of -100 to 100 kcal/mol and up
-// to two decimal places in precision
-static long
-hit_fe_distr[20000];
-
-static ntp_element wrapper_constraint_elements[MAX_CONSTRAINT_MATCHES];
-static ushort last_wrapper_constraint_track_id;
-
 /*
  * static, inline replacements for memset/memcpy - silences google sanitizers
  */
@@ -211,7 +202,339 @@ static inline void copy_linked_bp_elements3 (ntp_linked_bp restrict
 	}
 }
 
-static inline bool safe_copy_linked_bp (ntp_list restrict safe_copy,
+/*
+ * private function to check whether safe_linked_bp is a copy of found_linked_bp
+ */
+static inline bool is_linked_bp_copy (ntp_linked_bp restrict safe_linked_bp,
+                                      ntp_linked_bp restrict found_linked_bp) {
+	REGISTER
+	ntp_linked_bp restrict this_linked_bp = found_linked_bp;
+	REGISTER
+	bool different_linked_bp = false;
+	
+	do {
+		if (safe_linked_bp->track_id != this_linked_bp->track_id ||
+		    safe_linked_bp->stack_len != this_linked_bp->stack_len ||
+		    safe_linked_bp->bp->fp_posn != this_linked_bp->bp->fp_posn ||
+		    safe_linked_bp->bp->tp_posn != this_linked_bp->bp->tp_posn) {
+			different_linked_bp = true;
+			break;
+		}
+		
+		if ((safe_linked_bp->fp_elements && !this_linked_bp->fp_elements) ||
+		    (!safe_linked_bp->fp_elements && this_linked_bp->fp_elements)) {
+			different_linked_bp = true;
+			break;
+		}
+		
+		else
+			if (safe_linked_bp->fp_elements) {
+				REGISTER
+				ntp_element restrict safe_fp_element = safe_linked_bp->fp_elements,
+				                     found_fp_element = this_linked_bp->fp_elements;
+				                     
+				do {
+					if (safe_fp_element->unpaired->i_constraint.reference !=
+					    found_fp_element->unpaired->i_constraint.reference ||
+					    safe_fp_element->unpaired->dist != found_fp_element->unpaired->dist ||
+					    safe_fp_element->unpaired->length != found_fp_element->unpaired->length) {
+						different_linked_bp = true;
+						break;
+					}
+					
+					safe_fp_element = safe_fp_element->unpaired->next;
+				}
+				while (safe_fp_element && found_fp_element);
+				
+				if (different_linked_bp || (safe_fp_element != found_fp_element)) {
+					different_linked_bp = true;
+					break;
+				}
+			}
+			
+		if ((safe_linked_bp->tp_elements && !this_linked_bp->tp_elements) ||
+		    (!safe_linked_bp->tp_elements && this_linked_bp->tp_elements)) {
+			different_linked_bp = true;
+			break;
+		}
+		
+		else
+			if (safe_linked_bp->tp_elements) {
+				REGISTER
+				ntp_element restrict safe_tp_element = safe_linked_bp->tp_elements,
+				                     found_tp_element = this_linked_bp->tp_elements;
+				                     
+				do {
+					if (safe_tp_element->unpaired->i_constraint.reference !=
+					    found_tp_element->unpaired->i_constraint.reference ||
+					    safe_tp_element->unpaired->dist != found_tp_element->unpaired->dist ||
+					    safe_tp_element->unpaired->length != found_tp_element->unpaired->length) {
+						different_linked_bp = true;
+						break;
+					}
+					
+					safe_tp_element = safe_tp_element->unpaired->next;
+				}
+				while (safe_tp_element && found_tp_element);
+				
+				if (different_linked_bp || (safe_tp_element != found_tp_element)) {
+					different_linked_bp = true;
+					break;
+				}
+			}
+			
+		safe_linked_bp = safe_linked_bp->prev_linked_bp;
+		this_linked_bp = this_linked_bp->prev_linked_bp;
+	}
+	while (safe_linked_bp && this_linked_bp);
+	
+	return !different_linked_bp && (safe_linked_bp == this_linked_bp);
+}
+
+/*
+ * private function to check whether safe_copy, or the heap of kept hits of context
+ * (see keep_top_hit), already holds a copy of found_linked_bp
+ */
+static inline bool is_linked_bp_in_safe_copy (const nt_search_context *restrict context,
+                                        ntp_list restrict safe_copy, ntp_linked_bp restrict found_linked_bp) {
+	for (REGISTER nt_hit_count i = 0; i < context->num_top_hits; i++) {
+		if (is_linked_bp_copy (context->top_hits[i].linked_bp, found_linked_bp)) {
+			return true;
+		}
+	}
+	
+	#ifndef NO_FULL_CHECKS
+	
+	if (!list_iterator_start (safe_copy)) {
+		return false;
+	}
+	
+	#else
+	list_iterator_start (safe_copy);
+	#endif
+	REGISTER
+	ntp_linked_bp restrict safe_linked_bp;
+	
+	while (list_iterator_hasnext (safe_copy)) {
+		safe_linked_bp = list_iterator_next (safe_copy);
+		#ifndef NO_FULL_CHECKS
+		
+		if (!safe_linked_bp) {
+			COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+			              "safe_linked_bp is NULL in is_linked_bp_in_safe_copy", false);
+			continue;
+		}
+		
+		#endif
+		
+		if (is_linked_bp_copy (safe_linked_bp, found_linked_bp)) {
+			list_iterator_stop (safe_copy);
+			return true;
+		}
+	}
+	
+	list_iterator_stop (safe_copy);
+	return false;
+}
+
+/*
+ * private function to compare two kept hits, in terms of the max-heap of a search
+ * context: true if hit a is more favourable than hit b (lower FE, or earlier hit)
+ */
+static inline bool is_top_hit_before (const nt_top_hit *restrict a,
+                                      const nt_top_hit *restrict b) {
+	return a->fe < b->fe || (a->fe == b->fe && a->hit_num < b->hit_num);
+}
+
+/*
+ * private function to restore the max-heap of kept hits, from position i downwards
+ */
+static inline void sift_down_top_hit (ntp_search_context restrict context,
+                                      nt_hit_count i) {
+	REGISTER
+	nt_top_hit *top_hits = context->top_hits;
+	const nt_top_hit this_hit = top_hits[i];
+	
+	do {
+		REGISTER
+		nt_hit_count child = 2 * i + 1;
+		
+		if (child >= context->num_top_hits) {
+			break;
+		}
+		
+		if (child + 1 < context->num_top_hits &&
+		    is_top_hit_before (&top_hits[child], &top_hits[child + 1])) {
+			child++;
+		}
+		
+		if (!is_top_hit_before (&this_hit, &top_hits[child])) {
+			break;
+		}
+		
+		top_hits[i] = top_hits[child];
+		i = child;
+	}
+	while (1);
+	
+	top_hits[i] = this_hit;
+}
+
+/*
+ * private function to bound safe_copy to the MAX_HITS_RETURNED most favourable hits
+ * (by FE), given that a new hit was just appended to its tail; once MAX_HITS_RETURNED
+ * is first exceeded, the hits kept move from safe_copy into the heap of context, after
+ * which either the new hit or the least favourable hit kept is disposed of right away,
+ * and safe_copy is only rebuilt from the heap at the end of the search (see
+ * flush_top_hits)
+ *
+ * output:  false if the new hit was disposed of; true otherwise
+ */
+static inline bool keep_top_hit (ntp_search_context restrict context,
+                                 const ntp_seq restrict seq, ntp_list restrict safe_copy) {
+	if (!context->num_top_hits) {
+		if (safe_copy->numels <= MAX_HITS_RETURNED) {
+			return true;
+		}
+		
+		list_iterator_start (safe_copy);
+		
+		for (REGISTER nt_hit_count i = 0; i < MAX_HITS_RETURNED; i++) {
+			REGISTER
+			ntp_linked_bp linked_bp = list_iterator_next (safe_copy);
+			context->top_hits[i].fe = get_turner_mfe_estimate (linked_bp, seq);
+			context->top_hits[i].hit_num = i;
+			context->top_hits[i].linked_bp = linked_bp;
+		}
+		
+		list_iterator_stop (safe_copy);
+		context->num_top_hits = MAX_HITS_RETURNED;
+		context->num_hits_found = MAX_HITS_RETURNED;
+		
+		for (REGISTER nt_hit_count i = MAX_HITS_RETURNED / 2; i > 0; i--) {
+			sift_down_top_hit (context, i - 1);
+		}
+	}
+	
+	REGISTER
+	ntp_linked_bp linked_bp = list_get_at (safe_copy, safe_copy->numels - 1);
+	// hits kept are held by the heap alone, so drop the entries of safe_copy (which,
+	// from here on, only ever holds the new hit)
+	list_destroy (safe_copy);
+	nt_top_hit new_hit;
+	new_hit.fe = get_turner_mfe_estimate (linked_bp, seq);
+	new_hit.hit_num = context->num_hits_found++;
+	new_hit.linked_bp = linked_bp;
+	
+	if (is_top_hit_before (&new_hit, &context->top_hits[0])) {
+		dispose_linked_bp_copy_chain (context->top_hits[0].linked_bp,
+		                              "evicted linked_bp of safe_copy in search_seq",
+		                              "evicted elements of linked_bp of safe_copy in search_seq");
+		context->top_hits[0] = new_hit;
+		sift_down_top_hit (context, 0);
+		return true;
+	}
+	
+	dispose_linked_bp_copy_chain (linked_bp,
+	                              "filtered out linked_bp of safe_copy in search_seq",
+	                              "filtered out elements of linked_bp of safe_copy in search_seq");
+	return false;
+}
+
+static int compare_top_hit_num (const void *a, const void *b) {
+	const nt_hit_count hit_num_a = ((const nt_top_hit *) a)->hit_num,
+	                   hit_num_b = ((const nt_top_hit *) b)->hit_num;
+	return (hit_num_a > hit_num_b) - (hit_num_a < hit_num_b);
+}
+
+/*
+ * private function to move the hits kept in the heap of context (see keep_top_hit)
+ * back to safe_copy, in the order in which they were found
+ */
+static inline void flush_top_hits (ntp_search_context restrict context,
+                                   ntp_list restrict safe_copy) {
+	if (!context->num_top_hits) {
+		return;
+	}
+	
+	qsort (context->top_hits, context->num_top_hits, sizeof (nt_top_hit),
+	       compare_top_hit_num);
+	       
+	for (REGISTER nt_hit_count i = 0; i < context->num_top_hits; i++) {
+		list_append (safe_copy, context->top_hits[i].linked_bp);
+	}
+	
+	context->num_top_hits = 0;
+}
+
+/*
+ * private function to stream a hit to the hit sink of context, along with the search
+ * time spent since the previous hit streamed
+ */
+static inline void stream_hit (ntp_search_context restrict context,
+                               const nt_linked_bp *restrict linked_bp) {
+	const float hit_time = get_elapsed_time (&context->timer);
+	
+	if (!context->hit_sink_failed &&
+	    !context->hit_sink (linked_bp, hit_time - context->last_hit_time,
+	                        context->hit_sink_arg)) {
+		COMMIT_DEBUG (REPORT_WARNINGS, SEARCH_SEQ, "hit sink aborted search in search_seq",
+		              false);
+		context->hit_sink_failed = true;
+	}
+	
+	context->last_hit_time = hit_time;
+}
+
+/*
+ * private function to stream the hit just appended to the tail of safe_copy to the hit
+ * sink of context, as long as no more than MAX_HITS_RETURNED hits are found; streamed
+ * hits are kept in safe_copy, such that any duplicates found later on are skipped;
+ * beyond MAX_HITS_RETURNED, hits are no longer streamed, but bounded by FE along with
+ * those streamed (see keep_top_hit), and any of the most favourable hits that are yet
+ * to be streamed follow at the end of the search (see sink_top_hits)
+ *
+ * output:  false if the new hit was disposed of; true otherwise
+ */
+static inline bool sink_hit (ntp_search_context restrict context,
+                             const ntp_seq restrict seq, ntp_list restrict safe_copy) {
+	if (context->num_top_hits || MAX_HITS_RETURNED < safe_copy->numels) {
+		return keep_top_hit (context, seq, safe_copy);
+	}
+	
+	stream_hit (context, list_get_at (safe_copy, safe_copy->numels - 1));
+	return true;
+}
+
+/*
+ * private function to stream the hits kept in the heap of context (see sink_hit) that
+ * were found once MAX_HITS_RETURNED was exceeded, in the order in which they were found
+ */
+static inline void sink_top_hits (ntp_search_context restrict context) {
+	qsort (context->top_hits, context->num_top_hits, sizeof (nt_top_hit),
+	       compare_top_hit_num);
+	       
+	for (REGISTER nt_hit_count i = 0; i < context->num_top_hits &&
+	     !context->hit_sink_failed; i++) {
+		// the first MAX_HITS_RETURNED hits found were streamed right away
+		if (MAX_HITS_RETURNED <= context->top_hits[i].hit_num) {
+			stream_hit (context, context->top_hits[i].linked_bp);
+		}
+	}
+}
+
+/*
+ * private function to take on the hit just appended to the tail of safe_copy, either
+ * streaming it to the hit sink of context, or bounding safe_copy by FE
+ */
+static inline bool take_hit (ntp_search_context restrict context,
+                             const ntp_seq restrict seq, ntp_list restrict safe_copy) {
+	return context->hit_sink ? sink_hit (context, seq, safe_copy) :
+	       keep_top_hit (context, seq, safe_copy);
+}
+
+static inline bool safe_copy_linked_bp (ntp_search_context restrict context,
+                                        const ntp_seq restrict seq, ntp_list restrict safe_copy,
                                         ntp_linked_bp restrict found_linked_bp,
                                         ntp_linked_bp restrict *next_linked_bp) {
 	#ifndef NO_FULL_CHECKS
@@ -257,131 +580,11 @@ static inline bool safe_copy_linked_bp (ntp_list restrict safe_copy,
 	}
 	
 	#endif
-	#ifndef NO_FULL_CHECKS
 	
-	if (
-	#endif
-	                    list_iterator_start (safe_copy)
-                    #ifndef NO_FULL_CHECKS
-	) {
-                    #else
-	                    ;
-                    #endif
-		REGISTER
-		ntp_linked_bp restrict safe_linked_bp;
-		REGISTER
-		ntp_linked_bp restrict found_linked_bp_copy = found_linked_bp;
-		
-		while (list_iterator_hasnext (safe_copy)) {
-			safe_linked_bp = list_iterator_next (safe_copy);
-			#ifndef NO_FULL_CHECKS
-			
-			if (safe_linked_bp) {
-			#endif
-				REGISTER
-				bool different_linked_bp = false;
-				
-				do {
-					if (safe_linked_bp->track_id != found_linked_bp->track_id ||
-					    safe_linked_bp->stack_len != found_linked_bp->stack_len ||
-					    safe_linked_bp->bp->fp_posn != found_linked_bp->bp->fp_posn ||
-					    safe_linked_bp->bp->tp_posn != found_linked_bp->bp->tp_posn) {
-						different_linked_bp = true;
-						break;
-					}
-					
-					if ((safe_linked_bp->fp_elements && !found_linked_bp->fp_elements) ||
-					    (!safe_linked_bp->fp_elements && found_linked_bp->fp_elements)) {
-						different_linked_bp = true;
-						break;
-					}
-					
-					else
-						if (safe_linked_bp->fp_elements) {
-							REGISTER
-							ntp_element restrict safe_fp_element = safe_linked_bp->fp_elements,
-							                     found_fp_element = found_linked_bp->fp_elements;
-							                     
-							do {
-								if (safe_fp_element->unpaired->i_constraint.reference !=
-								    found_fp_element->unpaired->i_constraint.reference ||
-								    safe_fp_element->unpaired->dist != found_fp_element->unpaired->dist ||
-								    safe_fp_element->unpaired->length != found_fp_element->unpaired->length) {
-									different_linked_bp = true;
-									break;
-								}
-								
-								safe_fp_element = safe_fp_element->unpaired->next;
-							}
-							while (safe_fp_element && found_fp_element);
-							
-							if (different_linked_bp || (safe_fp_element != found_fp_element)) {
-								different_linked_bp = true;
-								break;
-							}
-						}
-						
-					if ((safe_linked_bp->tp_elements && !found_linked_bp->tp_elements) ||
-					    (!safe_linked_bp->tp_elements && found_linked_bp->tp_elements)) {
-						different_linked_bp = true;
-						break;
-					}
-					
-					else
-						if (safe_linked_bp->tp_elements) {
-							REGISTER
-							ntp_element restrict safe_tp_element = safe_linked_bp->tp_elements,
-							                     found_tp_element = found_linked_bp->tp_elements;
-							                     
-							do {
-								if (safe_tp_element->unpaired->i_constraint.reference !=
-								    found_tp_element->unpaired->i_constraint.reference ||
-								    safe_tp_element->unpaired->dist != found_tp_element->unpaired->dist ||
-								    safe_tp_element->unpaired->length != found_tp_element->unpaired->length) {
-									different_linked_bp = true;
-									break;
-								}
-								
-								safe_tp_element = safe_tp_element->unpaired->next;
-							}
-							while (safe_tp_element && found_tp_element);
-							
-							if (different_linked_bp || (safe_tp_element != found_tp_element)) {
-								different_linked_bp = true;
-								break;
-							}
-						}
-						
-					safe_linked_bp = safe_linked_bp->prev_linked_bp;
-					found_linked_bp = found_linked_bp->prev_linked_bp;
-				}
-				while (safe_linked_bp && found_linked_bp);
-				
-				if (!different_linked_bp && (safe_linked_bp == found_linked_bp)) {
-					list_iterator_stop (safe_copy);
-					return true;
-				}
-				
-				#ifndef NO_FULL_CHECKS
-			}
-			
-			else {
-				COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-				              "safe_linked_bp is NULL in safe_copy_linked_bp", false);
-				list_iterator_stop (safe_copy);
-				return false;
-			}
-			
-				#endif
-		}
-		
-		list_iterator_stop (safe_copy);
-		found_linked_bp = found_linked_bp_copy;
-		#ifndef NO_FULL_CHECKS
+	if (is_linked_bp_in_safe_copy (context, safe_copy, found_linked_bp)) {
+		return true;
 	}
 	
-		#endif
-	
 	REGISTER
 	ntp_linked_bp linked_bp_copy = MALLOC_DEBUG (sizeof (nt_linked_bp),
 	                                        "linked_bp_copy for safe_copy of found_list in search_seq");
@@ -458,10 +661,16 @@ static inline bool safe_copy_linked_bp (ntp_list restrict safe_copy,
 	}
 	while (1);
 	
-	return true;
+	if (!take_hit (context, seq, safe_copy)) {
+		// do not link elements of subsequent copies to the disposed hit
+		*next_linked_bp = NULL;
+	}
+	
+	return !context->hit_sink_failed;
 }
 
-static inline bool satisfy_constraints (const ntp_seq restrict seq,
+static inline bool satisfy_constraints (ntp_search_context restrict context,
+                                        const ntp_seq restrict seq,
                                         const nt_constraint *restrict constraint,
                                         ntp_list satisfied_list,
                                         ntp_linked_bp found_linked_bp,
@@ -712,14 +921,15 @@ static inline bool satisfy_constraints (const ntp_seq restrict seq,
 							
 							if (satisfied) {
 								if (!constraint->next) {
-									safe_copy_linked_bp (satisfied_list, this_linked_bp, next_linked_bp);
+									safe_copy_linked_bp (context, seq, satisfied_list, this_linked_bp,
+									                     next_linked_bp);
 								}
 								
 								else {
 									ntp_linked_bp next_constraint_next_linked_bp = NULL;
 									// restart satisfiability test, for next constraint
-									return satisfy_constraints (seq, constraint->next, satisfied_list,
-									                            found_linked_bp, found_linked_bp, &next_constraint_next_linked_bp);
+									return satisfy_constraints (context, seq, constraint->next, satisfied_list,
+									                                     found_linked_bp, found_linked_bp, &next_constraint_next_linked_bp);
 								}
 							}
 						}
@@ -754,14 +964,15 @@ static inline bool satisfy_constraints (const ntp_seq restrict seq,
 								}
 								
 								if (!constraint->next) {
-									safe_copy_linked_bp (satisfied_list, this_linked_bp, next_linked_bp);
+									safe_copy_linked_bp (context, seq, satisfied_list, this_linked_bp,
+									                     next_linked_bp);
 								}
 								
 								else {
 									ntp_linked_bp next_constraint_next_linked_bp = NULL;
 									// restart satisfiability test, for next constraint
-									return satisfy_constraints (seq, constraint->next, satisfied_list,
-									                            found_linked_bp, found_linked_bp, &next_constraint_next_linked_bp);
+									return satisfy_constraints (context, seq, constraint->next, satisfied_list,
+									                                     found_linked_bp, found_linked_bp, &next_constraint_next_linked_bp);
 								}
 							}
 						}
@@ -779,256 +990,258 @@ static inline bool satisfy_constraints (const ntp_seq restrict seq,
 }
 
 /*
- * private function to advance from the current_list of base-pairs
- * to an updated_list, based on any compatible base-pairs found in
- * a filter_list
- *
- * input:   non-empty current_list of nt_linked_bp
- *          non-empty filter_list of nt_bp
- *          current_stack_len of nt_bp in current_list
- *          skip_count in between current_ and filter_list
- *          track_id for the updated_list of nt_linked_bp
- *
- * output:  updated list of nt_linked_bp
- *
- * notes:   - linked_bps in current_list and bps in filter_list are
- *            iteratively traversed (only once) and compared, such that
- *            bps in filter_list meeting the following criterion are
- *            appended to the updated_list:
- *              5' of filter nt_bp == 5' of current nt_linked_bp +
- *                                 current_stack_len +
- *                                 skip_count
- *          - the comparison procedure is terminated when either
- *            current_list or filter_list is exhausted
- *          - both current_list and filter_list are unmodified, but
- *            any previous iteration sessions are disrupted
- *          - the updated_list contains back pointers to the previous
- *            current_list linked_bps
- *          - track_id stamps all linked_bps in updated_list with a
- *            common tracking identifier
+ * private function to flatten the current_list of a paired element advance into
+ * the candidate buffer, along with the advanced pair (root) of each linked_bp;
+ * any candidates of a previous advance are discarded
  */
-static inline
-bool list_advance (const nt_list *restrict current_list,
-                   const nt_stack_size current_stack_len,
-                   const nt_rel_count match_count,
-                   const nt_rel_count skip_count,
-                   const nt_list *restrict filter_list,
-                   ntp_list *restrict updated_list,
-                   const nt_stack_size filter_stack_len,
-                   const uchar track_id,
-                   const char advanced_pair_track_id,
-                   const char containing_pair_track_id) {
-	if (!current_list || !filter_list ||
-	    !current_list->numels || !filter_list->numels) {
-		#ifdef DEBUG_ON
-	    
-		if (current_list && filter_list) {
-			COMMIT_DEBUG (REPORT_WARNINGS, LIST,
-			              "no elements found in current_list or filter_list in list_advance", false);
+static inline bool load_candidate_parents (ntp_candidate_buffer restrict
+                                        candidates, const nt_list *restrict current_list,
+                                        const char advanced_pair_track_id) {
+	candidates->num_candidates = 0;
+	candidates->num_ordered = 0;
+	candidates->num_parents = 0;
+	
+	if (!current_list || !current_list->numels) {
+		return true;
+	}
+	
+	if (current_list->numels > candidates->max_parents) {
+		REGISTER
+		uint32_t new_max_parents = candidates->max_parents ? candidates->max_parents :
+		                           MIN_CANDIDATE_BUFFER_SIZE;
+		                           
+		while (new_max_parents < current_list->numels) {
+			new_max_parents *= 2;
+		}
+		
+		ntp_linked_bp *new_parents = realloc (candidates->parents,
+		                                      sizeof (ntp_linked_bp) * new_max_parents);
+		                                      
+		if (!new_parents) {
+			return false;
+		}
+		
+		candidates->parents = new_parents;
+		ntp_linked_bp *new_roots = realloc (candidates->roots,
+		                                    sizeof (ntp_linked_bp) * new_max_parents);
+		                                    
+		if (!new_roots) {
+			return false;
+		}
+		
+		candidates->roots = new_roots;
+		candidates->max_parents = new_max_parents;
+	}
+	
+	list_iterator_start ((ntp_list) current_list);
+	
+	while (list_iterator_hasnext ((ntp_list) current_list)) {
+		REGISTER
+		ntp_linked_bp restrict current_linked_bp = list_iterator_next ((ntp_list)
+		                                        current_list);
+		candidates->parents[candidates->num_parents] = current_linked_bp;
+		candidates->roots[candidates->num_parents] = get_linked_bp_root (
+		                                        current_linked_bp, advanced_pair_track_id);
+		#ifndef NO_FULL_CHECKS
+		                                        
+		if (!candidates->roots[candidates->num_parents]) {
+			COMMIT_DEBUG1 (REPORT_ERRORS, LIST,
+			               "advanced_pair_track_id %d not found for root_linked_bp in load_candidate_parents",
+			               advanced_pair_track_id, false);
+			list_iterator_stop ((ntp_list) current_list);
+			return false;
 		}
 		
 		#endif
-		return true;
+		candidates->num_parents++;
 	}
 	
-	// iterate over current_list and filter_list starting from posn 0 respectively
-	REGISTER
-	nt_list_posn current_list_size = current_list->numels, current_list_posn = 0,
-	             filter_list_size = filter_list->numels, filter_list_posn = 0;
-	REGISTER
-	ntp_linked_bp restrict current_linked_bp = (ntp_linked_bp)list_get_at (
-	                                        current_list, 0);
-	#ifndef NO_FULL_CHECKS
-	                                        
-	if (!current_linked_bp) {
-		COMMIT_DEBUG (REPORT_ERRORS, LIST,
-		              "could not iterate current_list in list_advance", false);
-		return false;
+	list_iterator_stop ((ntp_list) current_list);
+	return true;
+}
+
+/*
+ * private function to add a candidate (filter_bp, stacked on the parent_idx'th
+ * linked_bp of the current_list) to the candidate buffer
+ */
+static inline bool add_candidate (ntp_candidate_buffer restrict candidates,
+                                  const nt_bp *restrict filter_bp, const nt_stack_size stack_len,
+                                  const uint32_t parent_idx) {
+	if (candidates->num_candidates == candidates->max_candidates) {
+		if (candidates->max_candidates > UINT32_MAX / 2) {
+			return false;
+		}
+		
+		REGISTER
+		uint32_t new_max_candidates = candidates->max_candidates ?
+		                              candidates->max_candidates * 2 : MIN_CANDIDATE_BUFFER_SIZE;
+		const nt_bp **new_bps = realloc (candidates->bps,
+		                                 sizeof (nt_bp *) * new_max_candidates);
+		                                 
+		if (!new_bps) {
+			return false;
+		}
+		
+		candidates->bps = new_bps;
+		nt_stack_size *new_stack_lens = realloc (candidates->stack_lens,
+		                                sizeof (nt_stack_size) * new_max_candidates);
+		                                
+		if (!new_stack_lens) {
+			return false;
+		}
+		
+		candidates->stack_lens = new_stack_lens;
+		uint32_t *new_idxs = realloc (candidates->parent_idxs,
+		                              sizeof (uint32_t) * new_max_candidates);
+		                              
+		if (!new_idxs) {
+			return false;
+		}
+		
+		candidates->parent_idxs = new_idxs;
+		new_idxs = realloc (candidates->order, sizeof (uint32_t) * new_max_candidates);
+		
+		if (!new_idxs) {
+			return false;
+		}
+		
+		candidates->order = new_idxs;
+		new_idxs = realloc (candidates->merged_order,
+		                    sizeof (uint32_t) * new_max_candidates);
+		                    
+		if (!new_idxs) {
+			return false;
+		}
+		
+		candidates->merged_order = new_idxs;
+		candidates->max_candidates = new_max_candidates;
 	}
 	
-	#endif
+	candidates->bps[candidates->num_candidates] = filter_bp;
+	candidates->stack_lens[candidates->num_candidates] = stack_len;
+	candidates->parent_idxs[candidates->num_candidates] = parent_idx;
+	candidates->num_candidates++;
+	return true;
+}
+
+/*
+ * private function to merge the candidates added by the latest list_advance into
+ * the candidates' list order: every new candidate is placed after any ordered
+ * candidates (from previous list_advance invocations) that are not beyond it in
+ * 5'/3' order, as encountered while scanning forward, which matches the successive
+ * list_insert_at of linked_bps into a shared updated_list
+ */
+static inline void merge_candidates (ntp_candidate_buffer restrict candidates) {
 	REGISTER
-	ntp_linked_bp restrict root_linked_bp = get_linked_bp_root (current_linked_bp,
-	                                        advanced_pair_track_id);
-	#ifndef NO_FULL_CHECKS
-	                                        
-	if (!root_linked_bp) {
-		COMMIT_DEBUG1 (REPORT_ERRORS, LIST,
-		               "advanced_pair_track_id %d not found for root_linked_bp in list_advance",
-		               advanced_pair_track_id, false);
-		return false;
+	uint32_t i = 0, j = candidates->num_ordered, k = 0;
+	const nt_bp **restrict bps = candidates->bps;
+	
+	while (i < candidates->num_ordered && j < candidates->num_candidates) {
+		const nt_bp *restrict ordered_bp = bps[candidates->order[i]];
+		
+		if (ordered_bp->fp_posn > bps[j]->fp_posn ||
+		    (ordered_bp->fp_posn == bps[j]->fp_posn &&
+		     ordered_bp->tp_posn > bps[j]->tp_posn)) {
+			candidates->merged_order[k++] = j++;
+		}
+		
+		else {
+			candidates->merged_order[k++] = candidates->order[i++];
+		}
 	}
 	
-	#endif
+	while (i < candidates->num_ordered) {
+		candidates->merged_order[k++] = candidates->order[i++];
+	}
+	
+	while (j < candidates->num_candidates) {
+		candidates->merged_order[k++] = j++;
+	}
+	
+	uint32_t *restrict merged_order = candidates->merged_order;
+	candidates->merged_order = candidates->order;
+	candidates->order = merged_order;
+	candidates->num_ordered = k;
+}
+
+/*
+ * private function to advance from the current_list of base-pairs
+ * (as flattened by load_candidate_parents) to an updated list of
+ * candidates, based on any compatible base-pairs found in a filter_list
+ *
+ * input:   non-empty filter_list of nt_bp
+ *          current_stack_len of nt_bp in current_list
+ *          skip_count in between current_ and filter_list
+ *
+ * output:  candidates, extended with the compatible filter_list bps
+ *
+ * notes:   - linked_bps in current_list and bps in filter_list are
+ *            iteratively traversed (only once) and compared, such that
+ *            bps in filter_list meeting the following criterion are
+ *            added as candidates:
+ *              5' of filter nt_bp == 5' of current nt_linked_bp +
+ *                                 current_stack_len +
+ *                                 skip_count
+ *          - the comparison procedure is terminated when either
+ *            current_list or filter_list is exhausted
+ *          - candidates refer back to the current_list linked_bps by index;
+ *            since any current linked_bp is visited at most once per filter_list,
+ *            and distinct filter_lists hold distinct bps, no (bp, parent)
+ *            candidate is ever added twice
+ *          - see list_from_candidates for materializing the candidates
+ *            into linked_bps, once all filter_lists are advanced
+ */
+static inline
+bool advance_candidates (ntp_candidate_buffer restrict candidates,
+                         const nt_stack_size current_stack_len,
+                         const nt_rel_count match_count,
+                         const nt_rel_count skip_count,
+                         const nt_bp *const *restrict filter_bps,
+                         const uint32_t filter_list_size,
+                         const nt_stack_size filter_stack_len,
+                         const char advanced_pair_track_id,
+                         const char containing_pair_track_id) {
+	// iterate over current_list and filter_list starting from posn 0 respectively
+	ntp_linked_bp *restrict roots = candidates->roots;
+	REGISTER
+	uint32_t current_list_size = candidates->num_parents, current_list_posn = 0,
+	         filter_list_posn = 0;
 	REGISTER
-	ulong updated_list_posn = 0;
+	ntp_linked_bp restrict root_linked_bp = roots[0];
 	
 	if (!root_linked_bp->bp->fp_posn) {
 		/*
 		 * current list is the wrapper list; advance all available elements in filter list
 		 */
-		REGISTER
-		ntp_bp restrict filter_bp;
-		
-		do {
-			filter_list_posn = 0;
-			
-			do {
-				filter_bp = (ntp_bp)list_get_at (filter_list, filter_list_posn++);
-				
-				if (!ntp_list_linked_bp_seeker (*updated_list, filter_bp,
-				                                current_linked_bp)) {     // not already enlisted?
-					REGISTER
-					ntp_linked_bp restrict linked_bp = MALLOC_TAG (sizeof (nt_linked_bp), track_id);
-					#ifndef NO_FULL_CHECKS
-					REGISTER
-					bool success = false;
-					
-					if (linked_bp) {
-					#endif
-						linked_bp->bp = filter_bp;
-						linked_bp->stack_len = filter_stack_len;
-						linked_bp->track_id = track_id;
-						linked_bp->fp_elements = NULL;
-						linked_bp->tp_elements = NULL;
-						linked_bp->prev_linked_bp = current_linked_bp;
-						REGISTER
-						ntp_linked_bp last_linked_bp = list_get_at (*updated_list, updated_list_posn);
-						
-						while (last_linked_bp) {
-							if (last_linked_bp->bp->fp_posn > filter_bp->fp_posn ||
-							    (last_linked_bp->bp->fp_posn == filter_bp->fp_posn &&
-							     last_linked_bp->bp->tp_posn > filter_bp->tp_posn)) {
-								break;
-							}
-							
-							updated_list_posn++;
-							last_linked_bp = list_get_at (*updated_list, updated_list_posn);
-						}
-						
-						#ifndef NO_FULL_CHECKS
-						
-						if (
-						#endif
-						                    list_insert_at (*updated_list, linked_bp, updated_list_posn)
-					                    #ifndef NO_FULL_CHECKS
-						                    >= 0) {
-							success = true;
-						}
-					}
-					
-					                    #else
-						                    ;
-					                    #endif
-					updated_list_posn++;
-					#ifndef NO_FULL_CHECKS
-					
-					if (!success) {
-						COMMIT_DEBUG (REPORT_ERRORS, LIST,
-						              "could not allocate bp/append to updated_list in list_advance", false);
-						              
-						if (!list_iterator_start (updated_list)) {
-							COMMIT_DEBUG (REPORT_ERRORS, LIST,
-							              "could not release memory for updated_list in list_advance", false);
-						}
-						
-						while (list_iterator_hasnext (updated_list)) {
-							FREE_TAG (list_iterator_next (updated_list), track_id);
-						}
-						
-						list_iterator_stop (updated_list);
-						return false;
-					}
-					
-					#endif
-				}
-			}
-			while (filter_list_posn < filter_list_size);
-			
-			current_list_posn++;
-			
-			if (current_list_posn < current_list_size) {
-				current_linked_bp = (ntp_linked_bp)list_get_at (current_list,
-				                                        current_list_posn);
-				#ifndef NO_FULL_CHECKS
-				                                        
-				if (!current_linked_bp) {
+		for (; current_list_posn < current_list_size; current_list_posn++) {
+			for (filter_list_posn = 0; filter_list_posn < filter_list_size;
+			     filter_list_posn++) {
+				if (!add_candidate (candidates, filter_bps[filter_list_posn], filter_stack_len,
+				                    current_list_posn)) {
 					COMMIT_DEBUG (REPORT_ERRORS, LIST,
-					              "could not iterate current_list in list_advance", false);
+					              "could not add candidate in advance_candidates", false);
 					return false;
 				}
-				
-				#endif
-			}
-			
-			else {
-				break;
 			}
 		}
-		while (true);
 		
 		return true;
 	}
 	
 	if (match_count && containing_pair_track_id != advanced_pair_track_id) {
-		do {
-			if (root_linked_bp->bp->tp_posn - root_linked_bp->bp->fp_posn == match_count) {
-				break;
+		while (root_linked_bp->bp->tp_posn - root_linked_bp->bp->fp_posn != match_count) {
+			if (current_list_posn < (current_list_size - 1)) {
+				root_linked_bp = roots[++current_list_posn];
 			}
 			
 			else {
-				if (current_list_posn < (current_list_size - 1)) {
-					current_list_posn++;
-					current_linked_bp = (ntp_linked_bp) list_get_at (current_list,
-					                                        current_list_posn);
-					#ifndef NO_FULL_CHECKS
-					                                        
-					if (!current_linked_bp) {
-						COMMIT_DEBUG (REPORT_ERRORS, LIST,
-						              "could not iterate current_list in list_advance", false);
-						return false;
-					}
-					
-					#endif
-					root_linked_bp = get_linked_bp_root (current_linked_bp, advanced_pair_track_id);
-					#ifndef NO_FULL_CHECKS
-					
-					if (!root_linked_bp) {
-						COMMIT_DEBUG1 (REPORT_ERRORS, LIST,
-						               "advanced_pair_track_id %d not found for root_linked_bp in list_advance",
-						               advanced_pair_track_id, false);
-						return false;
-					}
-					
-					#endif
-				}
-				
-				else {
-					return true;
-				}
+				return true;
 			}
 		}
-		while (1);
 	}
 	
-	filter_list_posn = 0;
 	REGISTER
-	ntp_bp restrict filter_bp = (ntp_bp)list_get_at (filter_list, 0);
-	#ifndef NO_FULL_CHECKS
-	
-	if (!filter_bp) {
-		COMMIT_DEBUG (REPORT_ERRORS, LIST,
-		              "could not iterate filter_list in list_advance", false);
-		return false;
-	}
-	
-	else {
-		COMMIT_DEBUG1 (REPORT_INFO, LIST,
-		               "filtering current_list with filter_list on advanced_pair_track_id %d in list_advance",
-		               advanced_pair_track_id, true);
-	}
-	
-	#endif
+	const nt_bp *restrict filter_bp = filter_bps[0];
 	REGISTER
 	nt_rel_seq_posn filter_fp_posn = filter_bp->fp_posn,
 	                root_fp_posn = root_linked_bp->bp->fp_posn + current_stack_len + match_count +
@@ -1036,17 +1249,30 @@ bool list_advance (const nt_list *restrict current_list,
 	                               
 	do {
 		if (filter_fp_posn < root_fp_posn) {
-			do {
-				filter_list_posn++;
-				filter_bp = (ntp_bp)list_get_at (filter_list, filter_list_posn);
+			// filter_list is ordered by fp_posn: skip ahead to the first filter_bp at root_fp_posn or beyond
+			REGISTER
+			uint32_t filter_list_end = filter_list_size;
+			filter_list_posn++;
+			
+			while (filter_list_posn < filter_list_end) {
+				const REGISTER
+				uint32_t mid = filter_list_posn + (filter_list_end - filter_list_posn) / 2;
+				
+				if (filter_bps[mid]->fp_posn < root_fp_posn) {
+					filter_list_posn = mid + 1;
+				}
+				
+				else {
+					filter_list_end = mid;
+				}
 			}
-			while (filter_bp && filter_bp->fp_posn < root_fp_posn);
 			
-			if (filter_bp == NULL) {
+			if (filter_list_posn == filter_list_size) {
 				return true;    // no more on filter_list -> finish
 			}
 			
 			else {
+				filter_bp = filter_bps[filter_list_posn];
 				filter_fp_posn = filter_bp->fp_posn;
 			}
 		}
@@ -1056,57 +1282,13 @@ bool list_advance (const nt_list *restrict current_list,
 				// advance current_list_posn
 				while (1) {
 					if (current_list_posn < (current_list_size - 1)) {
-						current_list_posn++;
-						current_linked_bp = (ntp_linked_bp) list_get_at (current_list,
-						                                        current_list_posn);
-						#ifndef NO_FULL_CHECKS
-						                                        
-						if (!current_linked_bp) {
-							COMMIT_DEBUG (REPORT_ERRORS, LIST, "NULL current_linked_bp in list_advance",
-							              false);
-							return false;
-						}
-						
-						#endif
-						root_linked_bp = get_linked_bp_root (current_linked_bp, advanced_pair_track_id);
-						#ifndef NO_FULL_CHECKS
-						
-						if (!root_linked_bp) {
-							COMMIT_DEBUG1 (REPORT_ERRORS, LIST,
-							               "advanced_pair_track_id %d not found for root_linked_bp in list_advance",
-							               advanced_pair_track_id, false);
-							return false;
-						}
-						
-						#endif
+						root_linked_bp = roots[++current_list_posn];
 						
 						if (match_count && containing_pair_track_id != advanced_pair_track_id) {
 							while (root_linked_bp->bp->tp_posn - root_linked_bp->bp->fp_posn !=
 							       match_count) {
 								if (current_list_posn < (current_list_size - 1)) {
-									current_list_posn++;
-									current_linked_bp = (ntp_linked_bp) list_get_at (current_list,
-									                                        current_list_posn);
-									#ifndef NO_FULL_CHECKS
-									                                        
-									if (!current_linked_bp) {
-										COMMIT_DEBUG (REPORT_ERRORS, LIST, "NULL current_linked_bp in list_advance",
-										              false);
-										return false;
-									}
-									
-									#endif
-									root_linked_bp = get_linked_bp_root (current_linked_bp, advanced_pair_track_id);
-									#ifndef NO_FULL_CHECKS
-									
-									if (!root_linked_bp) {
-										COMMIT_DEBUG1 (REPORT_ERRORS, LIST,
-										               "advanced_pair_track_id %d not found for root_linked_bp in list_advance",
-										               advanced_pair_track_id, false);
-										return false;
-									}
-									
-									#endif
+									root_linked_bp = roots[++current_list_posn];
 								}
 								
 								else {
@@ -1131,7 +1313,7 @@ bool list_advance (const nt_list *restrict current_list,
 			
 		if (filter_fp_posn == root_fp_posn) {
 			const REGISTER
-			nt_list_posn backup_filter_list_posn = filter_list_posn;
+			uint32_t backup_filter_list_posn = filter_list_posn;
 			
 			do {
 				// outer loop: iterate once over all matching current_list bps
@@ -1141,70 +1323,11 @@ bool list_advance (const nt_list *restrict current_list,
 					    // non-overlapping
 					    (filter_bp->tp_posn <= root_linked_bp->bp->tp_posn -
 					     filter_stack_len)) {              // or properly nested?
-						if (!ntp_list_linked_bp_seeker (*updated_list, filter_bp,
-						                                current_linked_bp)) {     // not already enlisted?
-							REGISTER
-							ntp_linked_bp restrict linked_bp = MALLOC_TAG (sizeof (nt_linked_bp), track_id);
-							#ifndef NO_FULL_CHECKS
-							REGISTER
-							bool success = false;
-							
-							if (linked_bp) {
-							#endif
-								linked_bp->bp = filter_bp;
-								linked_bp->stack_len = filter_stack_len;
-								linked_bp->track_id = track_id;
-								linked_bp->fp_elements = NULL;
-								linked_bp->tp_elements = NULL;
-								linked_bp->prev_linked_bp = current_linked_bp;
-								ntp_linked_bp last_linked_bp = list_get_at (*updated_list, updated_list_posn);
-								
-								while (last_linked_bp) {
-									if (last_linked_bp->bp->fp_posn > filter_bp->fp_posn ||
-									    (last_linked_bp->bp->fp_posn == filter_bp->fp_posn &&
-									     last_linked_bp->bp->tp_posn > filter_bp->tp_posn)) {
-										break;
-									}
-									
-									updated_list_posn++;
-									last_linked_bp = list_get_at (*updated_list, updated_list_posn);
-								}
-								
-								#ifndef NO_FULL_CHECKS
-								
-								if (
-								#endif
-								                    list_insert_at (*updated_list, linked_bp, updated_list_posn)
-							                    #ifndef NO_FULL_CHECKS
-								                    >= 0) {
-									success = true;
-								}
-							}
-							
-							                    #else
-								                    ;
-							                    #endif
-							updated_list_posn++;
-							#ifndef NO_FULL_CHECKS
-							
-							if (!success) {
-								COMMIT_DEBUG (REPORT_ERRORS, LIST,
-								              "could not allocate bp/append to updated_list in list_advance", false);
-								              
-								if (!list_iterator_start (updated_list)) {
-									COMMIT_DEBUG (REPORT_ERRORS, LIST,
-									              "could not release memory for updated_list in list_advance", false);
-								}
-								
-								while (list_iterator_hasnext (updated_list)) {
-									FREE_TAG (list_iterator_next (updated_list), track_id);
-								}
-								
-								list_iterator_stop (updated_list);
-								return false;
-							}
-							
-							#endif
+						if (!add_candidate (candidates, filter_bp, filter_stack_len,
+						                    current_list_posn)) {
+							COMMIT_DEBUG (REPORT_ERRORS, LIST,
+							              "could not add candidate in advance_candidates", false);
+							return false;
 						}
 					}
 					
@@ -1219,15 +1342,7 @@ bool list_advance (const nt_list *restrict current_list,
 					filter_list_posn++;
 					
 					if (filter_list_posn < filter_list_size) {
-						filter_bp = (ntp_bp) list_get_at (filter_list, filter_list_posn);
-						#ifndef NO_FULL_CHECKS
-						
-						if (!filter_bp) {
-							COMMIT_DEBUG (REPORT_ERRORS, LIST, "NULL filter_bp in list_advance", false);
-							return false;        // free updated_list here?
-						}
-						
-						#endif
+						filter_bp = filter_bps[filter_list_posn];
 						
 						if (filter_bp->fp_posn == filter_fp_posn) {
 							continue;
@@ -1240,60 +1355,17 @@ bool list_advance (const nt_list *restrict current_list,
 				
 				// reset filter_list_posn and progress current_list_posn
 				filter_list_posn = backup_filter_list_posn;
-				filter_bp = (ntp_bp) list_get_at (filter_list, filter_list_posn);
+				filter_bp = filter_bps[filter_list_posn];
 				current_list_posn++;
 				
 				if (current_list_posn < current_list_size) {
-					current_linked_bp = (ntp_linked_bp) list_get_at (current_list,
-					                                        current_list_posn);
-					#ifndef NO_FULL_CHECKS
-					                                        
-					if (!current_linked_bp) {
-						COMMIT_DEBUG (REPORT_ERRORS, LIST, "NULL current_linked_bp in list_advance",
-						              false);
-						return false;        // free updated_list here?
-					}
-					
-					#endif
-					root_linked_bp = get_linked_bp_root (current_linked_bp, advanced_pair_track_id);
-					#ifndef NO_FULL_CHECKS
-					
-					if (!root_linked_bp) {
-						COMMIT_DEBUG1 (REPORT_ERRORS, LIST,
-						               "advanced_pair_track_id %d not found for root_linked_bp in list_advance",
-						               advanced_pair_track_id, false);
-						return false;
-					}
-					
-					#endif
+					root_linked_bp = roots[current_list_posn];
 					
 					if (match_count && containing_pair_track_id != advanced_pair_track_id) {
 						while (root_linked_bp->bp->tp_posn - root_linked_bp->bp->fp_posn !=
 						       match_count) {
 							if (current_list_posn < (current_list_size - 1)) {
-								current_list_posn++;
-								current_linked_bp = (ntp_linked_bp) list_get_at (current_list,
-								                                        current_list_posn);
-								#ifndef NO_FULL_CHECKS
-								                                        
-								if (!current_linked_bp) {
-									COMMIT_DEBUG (REPORT_ERRORS, LIST, "NULL current_linked_bp in list_advance",
-									              false);
-									return false;        // free updated_list here?
-								}
-								
-								#endif
-								root_linked_bp = get_linked_bp_root (current_linked_bp, advanced_pair_track_id);
-								#ifndef NO_FULL_CHECKS
-								
-								if (!root_linked_bp) {
-									COMMIT_DEBUG1 (REPORT_ERRORS, LIST,
-									               "advanced_pair_track_id %d not found for root_linked_bp in list_advance",
-									               advanced_pair_track_id, false);
-									return false;
-								}
-								
-								#endif
+								root_linked_bp = roots[++current_list_posn];
 							}
 							
 							else {
@@ -1323,6 +1395,280 @@ bool list_advance (const nt_list *restrict current_list,
 	while (1);
 }
 
+/*
+ * advance the current_list (see load_candidate_parents) with a (flattened) filter_list,
+ * adding any compatible bps to the candidates; returns false on failure
+ */
+static inline
+bool list_advance (ntp_candidate_buffer restrict candidates,
+                   const nt_stack_size current_stack_len,
+                   const nt_rel_count match_count,
+                   const nt_rel_count skip_count,
+                   const nt_bp *const *restrict filter_bps,
+                   const uint32_t num_filter_bps,
+                   const nt_stack_size filter_stack_len,
+                   const char advanced_pair_track_id,
+                   const char containing_pair_track_id) {
+	if (!candidates->num_parents || !num_filter_bps) {
+		#ifdef DEBUG_ON
+		COMMIT_DEBUG (REPORT_WARNINGS, LIST,
+		              "no elements found in current_list or filter_list in list_advance", false);
+		#endif
+		return true;
+	}
+	
+	if (!advance_candidates (candidates, current_stack_len, match_count,
+	                         skip_count, filter_bps, num_filter_bps, filter_stack_len,
+	                         advanced_pair_track_id, containing_pair_track_id)) {
+		return false;
+	}
+	
+	merge_candidates (candidates);
+	return true;
+}
+
+/*
+ * private function to materialize the (ordered) candidates as linked_bps,
+ * appended to updated_list and stamped with track_id
+ */
+static inline bool list_from_candidates (const nt_candidate_buffer *restrict
+                                        candidates, ntp_list restrict updated_list,
+                                        const uchar track_id) {
+	for (REGISTER uint32_t i = 0; i < candidates->num_ordered; i++) {
+		const REGISTER
+		uint32_t c = candidates->order[i];
+		REGISTER
+		ntp_linked_bp restrict linked_bp = MALLOC_TAG (sizeof (nt_linked_bp), track_id);
+		
+		if (!linked_bp) {
+			COMMIT_DEBUG (REPORT_ERRORS, LIST,
+			              "could not allocate linked_bp in list_from_candidates", false);
+			return false;
+		}
+		
+		linked_bp->bp = candidates->bps[c];
+		linked_bp->stack_len = candidates->stack_lens[c];
+		linked_bp->track_id = track_id;
+		linked_bp->fp_elements = NULL;
+		linked_bp->tp_elements = NULL;
+		linked_bp->prev_linked_bp = candidates->parents[candidates->parent_idxs[c]];
+		
+		if (list_append (updated_list, linked_bp) < 0) {
+			COMMIT_DEBUG (REPORT_ERRORS, LIST,
+			              "could not append to updated_list in list_from_candidates", false);
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+/*
+ * private function to grow a filter memo array to hold at least num_needed entries
+ * of entry_size bytes
+ */
+static inline bool grow_filter_memo_array (void **array, uint32_t *max_entries,
+                                        const uint32_t num_needed, const size_t entry_size) {
+	if (num_needed <= *max_entries) {
+		return true;
+	}
+	
+	REGISTER
+	uint32_t new_max_entries = *max_entries ? *max_entries : MIN_FILTER_MEMO_SIZE;
+	
+	while (new_max_entries < num_needed) {
+		new_max_entries *= 2;
+	}
+	
+	void *new_array = realloc (*array, entry_size * new_max_entries);
+	
+	if (!new_array) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "could not grow filter memo in grow_filter_memo_array", false);
+		return false;
+	}
+	
+	*array = new_array;
+	*max_entries = new_max_entries;
+	return true;
+}
+
+static inline uint32_t get_filter_memo_slot (const nt_filter_memo *restrict memo,
+                                        const nt_element *restrict el, const nt_element *restrict prev_el,
+                                        const nt_stack_size stack_len) {
+	return (uint32_t) ((((uintptr_t) el >> 4) * 31 + ((uintptr_t) prev_el >> 4)) * 31 +
+	                   stack_len) & (memo->max_slots - 1);
+}
+
+/*
+ * private function to (re)build the hash slots of the filter memo, with room for at
+ * least twice as many slots as entries
+ */
+static inline bool rehash_filter_memo (ntp_filter_memo restrict memo) {
+	REGISTER
+	uint32_t new_max_slots = memo->max_slots ? memo->max_slots * 2 :
+	                         MIN_FILTER_MEMO_SIZE;
+	uint32_t *new_slots = realloc (memo->slots, sizeof (uint32_t) * new_max_slots);
+	
+	if (!new_slots) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "could not grow filter memo slots in rehash_filter_memo", false);
+		return false;
+	}
+	
+	memo->slots = new_slots;
+	memo->max_slots = new_max_slots;
+	g_memset (memo->slots, 0, (int) (sizeof (uint32_t) * new_max_slots));
+	
+	for (REGISTER uint32_t i = 0; i < memo->num_entries; i++) {
+		REGISTER
+		uint32_t slot = get_filter_memo_slot (memo, memo->entries[i].el,
+		                                      memo->entries[i].prev_el, memo->entries[i].stack_len);
+		                                      
+		while (memo->slots[slot]) {
+			slot = (slot + 1) & (memo->max_slots - 1);
+		}
+		
+		memo->slots[slot] = i + 1;
+	}
+	
+	return true;
+}
+
+/*
+ * private function to discard all entries of the filter memo; required whenever the
+ * model partitioning (and hence the stack distances of paired elements) changes
+ */
+static inline void reset_filter_memo (ntp_filter_memo restrict memo) {
+	memo->num_entries = 0;
+	memo->num_filter_bounds = 0;
+	memo->num_bps = 0;
+	
+	if (memo->slots) {
+		g_memset (memo->slots, 0, (int) (sizeof (uint32_t) * memo->max_slots));
+	}
+}
+
+/*
+ * private function to get the filter_lists that paired element el (following prev_el)
+ * is advanced with, for a stack_len, one for each of its stack distances; on first use,
+ * these are looked up in seq_bp and flattened into the filter memo
+ *
+ * output:  memo entry, or NULL on failure
+ */
+static inline const nt_filter_memo_entry *get_filter_memo_entry (
+                    ntp_filter_memo restrict memo, const nt_model_plan *restrict plan,
+                    ntp_seq_bp restrict seq_bp, nt_element *restrict el,
+                    nt_element *restrict prev_el, const nt_stack_size stack_len) {
+	if (memo->max_slots) {
+		REGISTER
+		uint32_t slot = get_filter_memo_slot (memo, el, prev_el, stack_len);
+		
+		while (memo->slots[slot]) {
+			const nt_filter_memo_entry *restrict entry = &memo->entries[memo->slots[slot] - 1];
+			
+			if (entry->el == el && entry->prev_el == prev_el && entry->stack_len == stack_len) {
+				return entry;
+			}
+			
+			slot = (slot + 1) & (memo->max_slots - 1);
+		}
+	}
+	
+	nt_stack_idist min_stack_dist, max_stack_dist;
+	short this_in_extrusion;
+	
+	if (!get_plan_stack_distances (plan, el, prev_el, &min_stack_dist,
+	                               &max_stack_dist, &this_in_extrusion)) {
+		return NULL;
+	}
+	
+	if (!grow_filter_memo_array ((void **) &memo->entries, &memo->max_entries,
+	                             memo->num_entries + 1, sizeof (nt_filter_memo_entry)) ||
+	    !grow_filter_memo_array ((void **) &memo->filter_bounds, &memo->max_filter_bounds,
+	                             memo->num_filter_bounds + 2 * (max_stack_dist - min_stack_dist + 1),
+	                             sizeof (uint32_t))) {
+		return NULL;
+	}
+	
+	REGISTER
+	nt_filter_memo_entry *restrict entry = &memo->entries[memo->num_entries];
+	entry->el = el;
+	entry->prev_el = prev_el;
+	entry->stack_len = stack_len;
+	entry->first_filter = memo->num_filter_bounds / 2;
+	entry->num_filters = 0;
+	ntp_list restrict stacks = &seq_bp->stacks[stack_len - 1];
+	
+	for (REGISTER nt_stack_idist this_stack_idist = min_stack_dist;
+	     this_stack_idist <= max_stack_dist; this_stack_idist++) {
+		list_iterator_start (stacks);
+		
+		while (list_iterator_hasnext (stacks)) {
+			REGISTER
+			ntp_stack this_stack = list_iterator_next (stacks);
+			
+			if (this_stack->stack_idist == this_stack_idist &&
+			    this_stack->in_extrusion == this_in_extrusion) {
+				REGISTER
+				ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+				
+				while (this_list_by_element && this_list_by_element->el != el) {
+					this_list_by_element = this_list_by_element->next;
+				}
+				
+				if (this_list_by_element) {
+					REGISTER
+					ntp_list this_list = &this_list_by_element->list;
+					
+					if (!grow_filter_memo_array ((void **) &memo->bps, &memo->max_bps,
+					                             memo->num_bps + this_list->numels, sizeof (nt_bp *))) {
+						list_iterator_stop (stacks);
+						reset_filter_memo (memo);
+						return NULL;
+					}
+					
+					memo->filter_bounds[memo->num_filter_bounds++] = memo->num_bps;
+					list_iterator_start (this_list);
+					
+					while (list_iterator_hasnext (this_list)) {
+						memo->bps[memo->num_bps++] = list_iterator_next (this_list);
+					}
+					
+					list_iterator_stop (this_list);
+					memo->filter_bounds[memo->num_filter_bounds++] = memo->num_bps;
+					entry->num_filters++;
+					break;
+				}
+			}
+		}
+		
+		list_iterator_stop (stacks);
+	}
+	
+	memo->num_entries++;
+	
+	if (memo->num_entries * 2 > memo->max_slots) {
+		if (!rehash_filter_memo (memo)) {
+			reset_filter_memo (memo);
+			return NULL;
+		}
+	}
+	
+	else {
+		REGISTER
+		uint32_t slot = get_filter_memo_slot (memo, el, prev_el, stack_len);
+		
+		while (memo->slots[slot]) {
+			slot = (slot + 1) & (memo->max_slots - 1);
+		}
+		
+		memo->slots[slot] = memo->num_entries;
+	}
+	
+	return entry;
+}
+
 static inline
 ntp_list list_null_advance (nt_list *restrict current_list,
                             const uchar track_id) {
@@ -2081,7 +2427,8 @@ static inline void free_constraint_links (nt_element *restrict el,
 		#endif
 }
 
-static inline void set_constraint_links (nt_element *restrict el,
+static inline void set_constraint_links (ntp_search_context restrict context,
+                                        nt_element *restrict el,
                                         ntp_list restrict *this_list,
                                         const nt_rel_count unpaired_cnt,
                                         nt_rel_count skip_cnt,
@@ -2237,7 +2584,7 @@ static inline void set_constraint_links (nt_element *restrict el,
 			}
 			
 			if (track_constraints) {
-				wrapper_constraint_elements[track_id] = element;
+				context->wrapper_constraint_elements[track_id] = element;
 			}
 		}
 		
@@ -2357,20 +2704,21 @@ static inline void check_bp_candidates_for_targets (ntp_list candidate_list,
 }
 #endif
 
-static inline void update_wrapper_constraint_dist (ntp_list restrict
-                                        *current_list, nt_element *restrict el, nt_rel_count unpaired_cnt,
+static inline void update_wrapper_constraint_dist (ntp_search_context restrict
+                                        context, ntp_list restrict *current_list, nt_element *restrict el,
+                                        nt_rel_count unpaired_cnt,
                                         uchar track_id, char advanced_pair_track_id,
                                         const char containing_pair_track_id,
                                         const uchar pos_var) {
 	if (*current_list && (*current_list)->numels) {
 		REGISTER
-		bool building_constraints = track_id > last_wrapper_constraint_track_id;
+		bool building_constraints = track_id > context->last_wrapper_constraint_track_id;
 		
 		if (building_constraints) {
 			// denote that we are still building (adding) constraints between wrapper bp and first 'real' bp;
 			// building_constraints will be set to false when iterating over pos_vars and therefore all
 			// constraints would have already been set (using set_constraint_links) in the very first invocation
-			last_wrapper_constraint_track_id = track_id;
+			context->last_wrapper_constraint_track_id = track_id;
 		}
 		
 		REGISTER
@@ -2414,9 +2762,9 @@ static inline void update_wrapper_constraint_dist (ntp_list restrict
 						continue;
 					}
 					
-					short delta;
+					nt_s_rel_count delta;
 					
-					if (wrapper_constraint_elements[track_id]) {
+					if (context->wrapper_constraint_elements[track_id]) {
 						/*
 						 * if this element is a constraint element, then we know both the current
 						 * pos_var value and the new one (unpaired_cnt); delta should be set to
@@ -2424,8 +2772,8 @@ static inline void update_wrapper_constraint_dist (ntp_list restrict
 						 * when subtracting it from the current distances of all 5' constraints
 						 * relative to this one
 						 */
-						delta = wrapper_constraint_elements[track_id]->unpaired->length - unpaired_cnt;
-						wrapper_constraint_elements[track_id]->unpaired->length = unpaired_cnt;
+						delta = context->wrapper_constraint_elements[track_id]->unpaired->length - unpaired_cnt;
+						context->wrapper_constraint_elements[track_id]->unpaired->length = unpaired_cnt;
 					}
 					
 					else {
@@ -2437,15 +2785,15 @@ static inline void update_wrapper_constraint_dist (ntp_list restrict
 						 */
 						
 						// TODO: assumes track_id>1 and that only 1 unpaired exists between any 2 paired elements
-						if (track_id == last_wrapper_constraint_track_id) {
-							delta = wrapper_constraint_elements[track_id - 1]->unpaired->dist -
+						if (track_id == context->last_wrapper_constraint_track_id) {
+							delta = context->wrapper_constraint_elements[track_id - 1]->unpaired->dist -
 							        unpaired_cnt;
 						}
 						
 						else {
-							delta = (short) ((wrapper_constraint_elements[track_id - 1]->unpaired->dist -
-							                  wrapper_constraint_elements[track_id + 1]->unpaired->dist - 1) -
-							                 unpaired_cnt);
+							delta = (nt_s_rel_count) ((context->wrapper_constraint_elements[track_id - 1]->unpaired->dist -
+							                           context->wrapper_constraint_elements[track_id + 1]->unpaired->dist - 1) -
+							                          unpaired_cnt);
 						}
 					}
 					
@@ -2459,7 +2807,7 @@ static inline void update_wrapper_constraint_dist (ntp_list restrict
 						
 						do {
 							track_id--;
-							prev_fp_element = wrapper_constraint_elements[track_id];
+							prev_fp_element = context->wrapper_constraint_elements[track_id];
 						}
 						while (1 < track_id && (!prev_fp_element ||
 						                        !prev_fp_element->unpaired->i_constraint.reference));
@@ -2485,7 +2833,7 @@ static inline void update_wrapper_constraint_dist (ntp_list restrict
 		 * if this el is a constraint and still building_constraints, then set_constraint_links
 		 */
 		if (building_constraints && el->unpaired->i_constraint.reference) {
-			set_constraint_links (el, current_list, unpaired_cnt, 0, track_id,
+			set_constraint_links (context, el, current_list, unpaired_cnt, 0, track_id,
 			                      advanced_pair_track_id, true);
 		}
 	}
@@ -2943,11 +3291,208 @@ static inline void list_prune_using_constraint (const nt_model *restrict model,
 	}
 }
 
+bool search_seq_at (ntp_search_context restrict context,
+                    const nt_model *restrict model,
+                    const ntp_seq restrict seq,
+                    ntp_seq_bp restrict seq_bp,
+                    nt_element *restrict el,
+                    nt_element *restrict prev_el,
+                    ntp_list restrict *current_list,
+                    nt_stack_size current_stack_len,
+                    const nt_rel_count match_cnt,
+                    const nt_rel_count skip_cnt,
+                    const uchar track_id,
+                    char advanced_pair_track_id,
+                    const char containing_pair_track_id,
+                    const uchar pos_var,
+                    nt_element *restrict continuation_element,
+                    ntp_list restrict *matched_cnts
+#ifdef SEARCH_SEQ_DETAIL
+	, const uchar indent, const nt_bp *restrict targets,
+	const nt_hit_count num_targets
+#endif
+                   );
+                   
+/*
+ * private function to check whether a search in large search mode has exceeded its
+ * budget of tagged memory (that taken by the searching thread since the search started)
+ * or time, in which case it is abandoned without hits, as other searches that exceed
+ * MAX_SEARCH_LIST_SIZE are
+ */
+static inline bool is_large_search_over_budget (const nt_search_context *restrict
+                                        context) {
+	const REGISTER
+	size_t mem_tag_size = get_mem_tag_size();
+	
+	if (mem_tag_size > context->large_search_mem_base &&
+	    context->large_search_mem < mem_tag_size - context->large_search_mem_base) {
+		COMMIT_DEBUG (REPORT_WARNINGS, SEARCH_SEQ,
+		              "large search exceeds its memory budget in search_seq", false);
+		return true;
+	}
+	
+	if (MAX_LARGE_SEARCH_TIME_S < get_elapsed_time (&context->timer)) {
+		COMMIT_DEBUG (REPORT_WARNINGS, SEARCH_SEQ,
+		              "large search exceeds its time budget in search_seq", false);
+		return true;
+	}
+	
+	return false;
+}
+
+/*
+ * private function to search, in large search mode, a current_list that exceeds
+ * MAX_SEARCH_LIST_SIZE: the current_list is split into consecutive batches of up to
+ * MAX_SEARCH_LIST_SIZE linked_bps, each of which is searched from el on its own,
+ * and the resulting lists (and matched_cnts) are concatenated
+ *
+ * notes:   - the linked_bps of the current_list are searched independently of each
+ *            other, such that batching only bounds the size of the lists of each search
+ *            step; the lists of all batches are retained until the end of the search
+ *            iteration, so the search is abandoned once it exceeds its budget (see
+ *            is_large_search_over_budget)
+ */
+static bool search_seq_at_in_batches (ntp_search_context restrict context,
+                                      const nt_model *restrict model,
+                                      const ntp_seq restrict seq,
+                                      ntp_seq_bp restrict seq_bp,
+                                      nt_element *restrict el,
+                                      nt_element *restrict prev_el,
+                                      ntp_list restrict *current_list,
+                                      nt_stack_size current_stack_len,
+                                      const nt_rel_count match_cnt,
+                                      const nt_rel_count skip_cnt,
+                                      const uchar track_id,
+                                      char advanced_pair_track_id,
+                                      const char containing_pair_track_id,
+                                      const uchar pos_var,
+                                      nt_element *restrict continuation_element,
+                                      ntp_list restrict *matched_cnts
+#ifdef SEARCH_SEQ_DETAIL
+	, const uchar indent, const nt_bp *restrict targets,
+	const nt_hit_count num_targets
+#endif
+                                     ) {
+	COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
+	               "searching current_list of size %u in batches in search_seq_at",
+	               (*current_list)->numels, false);
+	ntp_list restrict updated_list = NULL, updated_matched_cnts = NULL;
+	REGISTER
+	bool success = true;
+	list_iterator_start (*current_list);
+	
+	while (success && list_iterator_hasnext (*current_list)) {
+		ntp_list restrict batch_list = NULL, batch_matched_cnts = NULL;
+		
+		if (is_large_search_over_budget (context)) {
+			success = false;
+			break;
+		}
+		
+		if (!ntp_list_alloc_debug (&batch_list, "batch_list in search_seq_at_in_batches") ||
+		    !ntp_list_alloc_debug (&batch_matched_cnts,
+		                           "batch_matched_cnts in search_seq_at_in_batches")) {
+			COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+			              "cannot alloc batch_list or batch_matched_cnts in search_seq_at_in_batches",
+			              false);
+			              
+			if (batch_list) {
+				list_destroy (batch_list);
+				FREE_DEBUG (batch_list, "batch_list in search_seq_at_in_batches");
+			}
+			
+			success = false;
+			break;
+		}
+		
+		while (batch_list->numels < MAX_SEARCH_LIST_SIZE &&
+		       list_iterator_hasnext (*current_list)) {
+			list_append (batch_list, list_iterator_next (*current_list));
+		}
+		
+		success = search_seq_at (context, model, seq, seq_bp, el, prev_el, &batch_list,
+		                         current_stack_len, match_cnt, skip_cnt, track_id,
+		                         advanced_pair_track_id, containing_pair_track_id, pos_var,
+		                         continuation_element, &batch_matched_cnts
+		                         #ifdef SEARCH_SEQ_DETAIL
+		                         , indent, targets, num_targets
+		                         #endif
+		                        );
+		                        
+		if (success && batch_list && batch_list->numels) {
+			ntp_list previously_updated_list = updated_list;
+			updated_list = ntp_list_concatenate (updated_list, batch_list, track_id);
+			
+			if (previously_updated_list) {
+				list_destroy (previously_updated_list);
+				FREE_DEBUG (previously_updated_list,
+				            "previously updated_list in search_seq_at_in_batches");
+			}
+			
+			ntp_list previously_updated_matched_cnts = updated_matched_cnts;
+			updated_matched_cnts = ntp_count_list_concatenate (updated_matched_cnts,
+			                                        batch_matched_cnts);
+			                                        
+			if (previously_updated_matched_cnts &&
+			    previously_updated_matched_cnts != updated_matched_cnts) {
+				list_destroy (previously_updated_matched_cnts);
+				FREE_DEBUG (previously_updated_matched_cnts,
+				            "previously updated_matched_cnts in search_seq_at_in_batches");
+			}
+			
+			if (batch_matched_cnts == updated_matched_cnts) {
+				batch_matched_cnts = NULL;
+			}
+		}
+		
+		if (batch_list) {
+			list_destroy (batch_list);
+			FREE_DEBUG (batch_list, "batch_list in search_seq_at_in_batches");
+		}
+		
+		if (batch_matched_cnts) {
+			list_destroy (batch_matched_cnts);
+			FREE_DEBUG (batch_matched_cnts, "batch_matched_cnts in search_seq_at_in_batches");
+		}
+	}
+	
+	list_iterator_stop (*current_list);
+	list_destroy (*current_list);
+	FREE_DEBUG (*current_list, "current_list in search_seq_at_in_batches");
+	
+	if (*matched_cnts) {
+		list_destroy (*matched_cnts);
+		FREE_DEBUG (*matched_cnts, "matched_cnts in search_seq_at_in_batches");
+	}
+	
+	if (success && updated_list && updated_list->numels) {
+		*current_list = updated_list;
+		*matched_cnts = updated_matched_cnts;
+		return true;
+	}
+	
+	if (updated_list) {
+		list_destroy (updated_list);
+		FREE_DEBUG (updated_list, "updated_list in search_seq_at_in_batches");
+	}
+	
+	if (updated_matched_cnts) {
+		list_destroy (updated_matched_cnts);
+		FREE_DEBUG (updated_matched_cnts,
+		            "updated_matched_cnts in search_seq_at_in_batches");
+	}
+	
+	*current_list = NULL;
+	*matched_cnts = NULL;
+	return success;
+}
+
 /*
  * private recursive function to search a sequence starting from a current model
  * nt_element and list of nt_linked_bp
  *
- * input:   sequence hash
+ * input:   search context
+ *          sequence hash
  *          model nt_element el
  *          current_list of nt_linked_bp
  *          current_stack_len of bps in the current_list
@@ -2960,7 +3505,8 @@ static inline void list_prune_using_constraint (const nt_model *restrict model,
  * notes:   - traverses model elements starting from el, recursively matching
  *            nested bps against the given sequence as required
  */
-bool search_seq_at (const nt_model *restrict model,
+bool search_seq_at (ntp_search_context restrict context,
+                    const nt_model *restrict model,
                     const ntp_seq restrict seq,
                     ntp_seq_bp restrict seq_bp,
                     nt_element *restrict el,
@@ -2980,8 +3526,33 @@ bool search_seq_at (const nt_model *restrict model,
 	const nt_hit_count num_targets
 #endif
                    ) {
+	if (context->large_search) {
+		// a single search iteration may by itself exceed the budget of a large search,
+		// so the budget is checked as the search progresses; once exceeded, all further
+		// steps fail, and the search iteration is abandoned (see search_seq_iteration)
+		if (! (++context->large_search_steps % LARGE_SEARCH_CHECK_STEPS) &&
+		    !context->large_search_abandoned) {
+			context->large_search_abandoned = is_large_search_over_budget (context);
+		}
+		
+		if (context->large_search_abandoned) {
+			return false;
+		}
+	}
+	
 	if (*current_list && (MAX_SEARCH_LIST_SIZE < (*current_list)->numels)) {
-		return false;
+		if (!context->large_search) {
+			return false;
+		}
+		
+		return search_seq_at_in_batches (context, model, seq, seq_bp, el, prev_el,
+		                                 current_list, current_stack_len, match_cnt, skip_cnt, track_id,
+		                                 advanced_pair_track_id, containing_pair_track_id, pos_var,
+		                                 continuation_element, matched_cnts
+		                                 #ifdef SEARCH_SEQ_DETAIL
+		                                 , indent, targets, num_targets
+		                                 #endif
+		                                );
 	}
 	
 	if (el->type == unpaired) {
@@ -3112,7 +3683,7 @@ bool search_seq_at (const nt_model *restrict model,
 		                             !advanced_pair_track_id;
 		                             
 		if (is_wrapper_constraint) {
-			update_wrapper_constraint_dist (current_list, el, unpaired_cnt, track_id,
+			update_wrapper_constraint_dist (context, current_list, el, unpaired_cnt, track_id,
 			                                advanced_pair_track_id, containing_pair_track_id, pos_var);
 		}
 		
@@ -3127,7 +3698,7 @@ bool search_seq_at (const nt_model *restrict model,
 			if (!is_wrapper_constraint && el->unpaired->i_constraint.reference &&
 			    *current_list && (*current_list)->numels) {
 				free_constraint_links (el, current_list, advanced_pair_track_id);
-				set_constraint_links (el, current_list, unpaired_cnt, skip_cnt, track_id,
+				set_constraint_links (context, el, current_list, unpaired_cnt, skip_cnt, track_id,
 				                      advanced_pair_track_id, false);
 			}
 			
@@ -3210,7 +3781,7 @@ bool search_seq_at (const nt_model *restrict model,
 				
 				if (unpaired_next->type == unpaired ||
 				    unpaired_next->paired->min + this_pos_var > 0) {
-					success = search_seq_at (model,
+					success = search_seq_at (context, model,
 					                         seq,
 					                         seq_bp,
 					                         unpaired_next,
@@ -3243,7 +3814,7 @@ bool search_seq_at (const nt_model *restrict model,
 						FREE_DEBUG (previously_this_list, "previously this_list in search_seq_at");
 					}
 					
-					success = search_seq_at (model,
+					success = search_seq_at (context, model,
 					                         seq,
 					                         seq_bp,
 					                         // mask/skip 0-pos_var paired element, by jumping straight to its fp_next element,
@@ -3434,7 +4005,7 @@ bool search_seq_at (const nt_model *restrict model,
 			if (*current_list && ((*current_list)->numels)) {
 				if (el->unpaired->i_constraint.reference) {
 					free_constraint_links (el, current_list, advanced_pair_track_id);
-					set_constraint_links (el, current_list, unpaired_cnt, skip_cnt, track_id,
+					set_constraint_links (context, el, current_list, unpaired_cnt, skip_cnt, track_id,
 					                      advanced_pair_track_id, false);
 				}
 				
@@ -3525,10 +4096,8 @@ bool search_seq_at (const nt_model *restrict model,
 						nt_stack_idist min_stack_dist, max_stack_dist;
 						short this_in_extrusion;
 						
-						if (!get_stack_distances_in_paired_element (
-						                        model, el,
-						                        prev_el,
-						                        &min_stack_dist, &max_stack_dist, &this_in_extrusion)) {
+						if (!get_plan_stack_distances (&context->plan, el, prev_el,
+						                               &min_stack_dist, &max_stack_dist, &this_in_extrusion)) {
 							COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
 							              "cannot count stack distances in search_seq_at", false);
 							              
@@ -3658,12 +4227,11 @@ bool search_seq_at (const nt_model *restrict model,
 				}
 				
 				else {
-					nt_stack_idist min_stack_dist, max_stack_dist;
-					short this_in_extrusion;
-					
-					if (!get_stack_distances_in_paired_element (model, el,
-					                                        prev_el,
-					                                        &min_stack_dist, &max_stack_dist, &this_in_extrusion)) {
+					REGISTER
+					const nt_filter_memo_entry *restrict filter_memo_entry = get_filter_memo_entry (
+					                    &context->filter_memo, &context->plan, seq_bp, el, prev_el, el->paired->min + pos_var);
+					                    
+					if (!filter_memo_entry) {
 						COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
 						              "cannot count stack distances for list_advance in search_seq_at", false);
 						              
@@ -3714,78 +4282,82 @@ bool search_seq_at (const nt_model *restrict model,
 					                        ;
 				                        #endif
 					
-					for (REGISTER nt_stack_idist this_stack_idist = min_stack_dist;
-					     this_stack_idist <= max_stack_dist; this_stack_idist++) {
-						list_iterator_start (&seq_bp->stacks[el->paired->min + pos_var - 1]);
+					if (!load_candidate_parents (&context->candidates, *current_list,
+					                             advanced_pair_track_id)) {
+						COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+						              "could not flatten current_list for list_advance in search_seq_at", false);
+						list_destroy (advanced_list);
+						FREE_DEBUG (advanced_list, "advanced_list in search_seq_at");
 						
-						while (list_iterator_hasnext (&seq_bp->stacks[el->paired->min + pos_var - 1])) {
-							REGISTER
-							ntp_stack this_stack = list_iterator_next (&seq_bp->stacks[el->paired->min +
-							                                                        pos_var - 1]);
-							                                                        
-							if (this_stack->stack_idist == this_stack_idist &&
-							    this_stack->in_extrusion == this_in_extrusion) {
-								REGISTER
-								bool found_list_by_element = false;
-								REGISTER
-								ntp_list this_list = NULL;
-								REGISTER
-								ntp_bp_list_by_element this_list_by_element = this_stack->lists;
-								
-								while (this_list_by_element) {
-									if (this_list_by_element->el == el) {
-										this_list = &this_list_by_element->list;
-										found_list_by_element = true;
-										break;
-									}
-									
-									this_list_by_element = this_list_by_element->next;
-								}
-								
-								if (found_list_by_element) {
-									REGISTER
-									bool success = list_advance (*current_list,
-									                             current_stack_len,
-									                             match_cnt == 0 ? (nt_rel_count) 0 : (match_cnt + current_stack_len),
-									                             skip_cnt,
-									                             this_list,
-									                             &advanced_list,
-									                             el->paired->min + pos_var,
-									                             track_id,
-									                             advanced_pair_track_id,
-									                             containing_pair_track_id);
-									                             
-									if (!success) {
-										COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-										              "could not advance current_list in search_seq_at", false);
-										list_iterator_stop (&seq_bp->stacks[el->paired->min + pos_var - 1]);
-										
-										if (*current_list) {
-											list_destroy (*current_list);
-											FREE_DEBUG (*current_list, "current_list in search_seq_at");
-										}
-										
-										if (*matched_cnts) {
-											list_destroy (*matched_cnts);
-											FREE_DEBUG (*matched_cnts, "matched_cnts in search_seq_at");
-										}
-										
-										if (this_list) {
-											list_destroy (this_list);
-											FREE_DEBUG (this_list, "this_list in search_seq_at");
-										}
-										
-										*matched_cnts = NULL;
-										*current_list = NULL;
-										return false;
-									}
-									
-									break;
-								}
+						if (*current_list) {
+							list_destroy (*current_list);
+							FREE_DEBUG (*current_list, "current_list in search_seq_at");
+						}
+						
+						if (*matched_cnts) {
+							list_destroy (*matched_cnts);
+							FREE_DEBUG (*matched_cnts, "matched_cnts in search_seq_at");
+						}
+						
+						*matched_cnts = NULL;
+						*current_list = NULL;
+						return false;
+					}
+					
+					for (REGISTER uint32_t f = filter_memo_entry->first_filter;
+					     f < filter_memo_entry->first_filter + filter_memo_entry->num_filters; f++) {
+						const REGISTER
+						uint32_t first_filter_bp = context->filter_memo.filter_bounds[2 * f];
+						
+						if (!list_advance (&context->candidates,
+						                   current_stack_len,
+						                   match_cnt == 0 ? (nt_rel_count) 0 : (match_cnt + current_stack_len),
+						                   skip_cnt,
+						                   &context->filter_memo.bps[first_filter_bp],
+						                   context->filter_memo.filter_bounds[2 * f + 1] - first_filter_bp,
+						                   el->paired->min + pos_var,
+						                   advanced_pair_track_id,
+						                   containing_pair_track_id)) {
+							COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+							              "could not advance current_list in search_seq_at", false);
+							list_destroy (advanced_list);
+							FREE_DEBUG (advanced_list, "advanced_list in search_seq_at");
+							
+							if (*current_list) {
+								list_destroy (*current_list);
+								FREE_DEBUG (*current_list, "current_list in search_seq_at");
+							}
+							
+							if (*matched_cnts) {
+								list_destroy (*matched_cnts);
+								FREE_DEBUG (*matched_cnts, "matched_cnts in search_seq_at");
 							}
+							
+							*matched_cnts = NULL;
+							*current_list = NULL;
+							return false;
+						}
+					}
+					
+					if (!list_from_candidates (&context->candidates, advanced_list, track_id)) {
+						COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+						              "could not populate advanced_list in search_seq_at", false);
+						list_destroy (advanced_list);
+						FREE_DEBUG (advanced_list, "advanced_list in search_seq_at");
+						
+						if (*current_list) {
+							list_destroy (*current_list);
+							FREE_DEBUG (*current_list, "current_list in search_seq_at");
+						}
+						
+						if (*matched_cnts) {
+							list_destroy (*matched_cnts);
+							FREE_DEBUG (*matched_cnts, "matched_cnts in search_seq_at");
 						}
 						
-						list_iterator_stop (&seq_bp->stacks[el->paired->min + pos_var - 1]);
+						*matched_cnts = NULL;
+						*current_list = NULL;
+						return false;
 					}
 					
 					if (*current_list) {
@@ -4072,7 +4644,7 @@ bool search_seq_at (const nt_model *restrict model,
 			COMMIT_DEBUG_NNL (REPORT_INFO, SEARCH_SEQ, msg, false);
 			#endif
 			
-			if (search_seq_at (model,
+			if (search_seq_at (context, model,
 			                   seq,
 			                   seq_bp,
 			                   paired_fp_next,
@@ -4373,7 +4945,7 @@ bool search_seq_at (const nt_model *restrict model,
 				COMMIT_DEBUG_NNL (REPORT_INFO, SEARCH_SEQ, msg, false);
 				#endif
 				
-				if (search_seq_at (model,
+				if (search_seq_at (context, model,
 				                   seq,
 				                   seq_bp,
 				                   paired_tp_next,
@@ -4809,82 +5381,233 @@ static inline bool get_model_bp_span (ntp_element restrict el,
 }
 
 /*
- * search sequence against model
+ * allocate a search context; each concurrently running search_seq
+ * requires its own context, which may be reused across searches
  *
- * input:   sequence hash sequence_hash
- *          model model
+ * note:    tagged memory (see malloc_t) is held per thread rather than per context,
+ *          and is released by list_destroy_all_tagged for all contexts of a thread
+ *          at once; contexts used on the same thread must therefore not have hits
+ *          outstanding at the same time, and a search (or its hit sink) must not
+ *          search using another context of its thread
+ */
+ntp_search_context create_search_context() {
+	ntp_search_context context = MALLOC_DEBUG (sizeof (nt_search_context),
+	                                        "context in create_search_context");
+	                                        
+	if (!context) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "cannot allocate memory for context in create_search_context", false);
+		return NULL;
+	}
+	
+	g_memset (context, 0, sizeof (nt_search_context));
+	return context;
+}
+
+/*
+ * worker threads that the partitioned searches of this process may use, and are using
+ * (see search_seq_in_parallel)
+ */
+static ushort max_search_threads = MAX_SEARCH_PARTITION_THREADS, num_search_threads = 0;
+static pthread_mutex_t search_threads_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * cap the worker threads of the partitioned searches of this process, for instance
+ * at the cores allotted to the process when other processes share the node
+ */
+void set_max_search_threads (const ushort max_threads) {
+	pthread_mutex_lock (&search_threads_mutex);
+	max_search_threads = max_threads;
+	pthread_mutex_unlock (&search_threads_mutex);
+}
+
+/*
+ * private function to reserve worker threads for the iterations of a partitioned model,
+ * such that concurrent searches of this process jointly stay within max_search_threads
  *
- * output:  ntp_list of ntp_linked_bps matching sequence and model
+ * output:  number of threads reserved (see release_search_threads), which is 0 if
+ *          fewer than two threads are available
  */
-ntp_list search_seq (const ntp_seq restrict seq, nt_model *restrict model,
-                     float *elapsed_time
-#ifdef SEARCH_SEQ_DETAIL
-	, ntp_bp targets, nt_hit_count num_targets
-#endif
-                    ) {
-	COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ,
-	              "searching seq against model in search_seq", true);
-	*elapsed_time = 0.0f;
-	reset_timer();
-	// keep a safe_copy of hits found (see found_list) before finally invoking list destruction after each search iteration
-	ntp_list safe_copy = NULL;
-	#ifndef NO_FULL_CHECKS
+static inline ushort reserve_search_threads (const unsigned long long num_iterations) {
+	pthread_mutex_lock (&search_threads_mutex);
+	REGISTER
+	ushort num_threads = (ushort) SAFE_MIN (get_num_cores(), max_search_threads);
+	num_threads = num_threads > num_search_threads ? num_threads - num_search_threads : 0;
+	num_threads = (ushort) SAFE_MIN ((unsigned long long) num_threads, num_iterations);
 	
-	if (!seq)                   {
-		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ, "search seq is NULL in search_seq",
-		              false);
-		return NULL;
+	if (num_threads < 2) {
+		num_threads = 0;
 	}
 	
-	if (!seq_bp_cache)          {
-		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-		              "seq_bp_cache not initialized in search_seq", false);
-		return NULL;
+	num_search_threads += num_threads;
+	pthread_mutex_unlock (&search_threads_mutex);
+	return num_threads;
+}
+
+static inline void release_search_threads (const ushort num_threads) {
+	pthread_mutex_lock (&search_threads_mutex);
+	num_search_threads -= num_threads;
+	pthread_mutex_unlock (&search_threads_mutex);
+}
+
+/*
+ * private function to dispose of the model copies and search contexts of worker threads
+ */
+static void destroy_search_workers (ntp_search_workers restrict workers) {
+	for (REGISTER ushort i = 0; i < workers->num_workers; i++) {
+		destroy_search_context (workers->contexts[i]);
+		finalize_model (workers->models[i]);
 	}
 	
-	if (!strlen (seq))          {
-		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-		              "search seq has 0 length in search_seq", false);
-		return NULL;
+	free (workers->contexts);
+	free (workers->models);
+	free (workers->model_sig);
+	g_memset (workers, 0, sizeof (nt_search_workers));
+}
+
+/*
+ * private function to procure num_workers model copies and search contexts for the
+ * worker threads of a partitioned model (see search_seq_in_parallel), reusing those
+ * of previous searches of the same model (as told apart by model_sig, see
+ * get_model_signature); model is expected to be in its original, unpartitioned state
+ *
+ * output:  true if workers holds (at least) num_workers model copies and contexts,
+ *          false otherwise
+ */
+static bool get_search_workers (ntp_search_workers restrict workers,
+                                nt_model *restrict model, const ushort *restrict model_sig,
+                                const uint32_t model_sig_len, const ushort num_workers) {
+	if (!workers->model_sig || workers->model_sig_len != model_sig_len ||
+	    memcmp (workers->model_sig, model_sig, sizeof (ushort) * model_sig_len)) {
+		destroy_search_workers (workers);
+		workers->model_sig = malloc (sizeof (ushort) * model_sig_len);
+		
+		if (!workers->model_sig) {
+			return false;
+		}
+		
+		memcpy (workers->model_sig, model_sig, sizeof (ushort) * model_sig_len);
+		workers->model_sig_len = model_sig_len;
 	}
 	
-	if (!model)                 {
-		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ, "search model is NULL in search_seq",
-		              false);
-		return NULL;
+	if (workers->num_workers >= num_workers) {
+		return true;
 	}
 	
-	if (!model->first_element)  {
-		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-		              "search model has no elements in search_seq", false);
-		return NULL;
+	ntp_model *models = realloc (workers->models, sizeof (ntp_model) * num_workers);
+	
+	if (!models) {
+		return false;
 	}
 	
-	#endif
-	#ifdef MULTITHREADED_ON
+	workers->models = models;
+	ntp_search_context *contexts = realloc (workers->contexts,
+	                                        sizeof (ntp_search_context) * num_workers);
+	                                        
+	if (!contexts) {
+		return false;
+	}
 	
-	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
-	#endif
+	workers->contexts = contexts;
 	
-		if (search_seq_list) {
-			COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-			              "search_seq_list already initialized in search_seq", false);
-			#ifdef MULTITHREADED_ON
-			pthread_mutex_unlock (&num_destruction_threads_mutex);
-			#endif
-			return NULL;
+	while (workers->num_workers < num_workers) {
+		REGISTER
+		ntp_model worker_model = copy_model (model);
+		
+		if (!worker_model) {
+			return false;
 		}
 		
-		#ifdef MULTITHREADED_ON
-		pthread_mutex_unlock (&num_destruction_threads_mutex);
+		REGISTER
+		ntp_search_context worker_context = create_search_context();
+		
+		if (!worker_context) {
+			finalize_model (worker_model);
+			return false;
+		}
+		
+		workers->models[workers->num_workers] = worker_model;
+		workers->contexts[workers->num_workers++] = worker_context;
 	}
 	
-		#endif
-	REGISTER
-	nt_seq_hash seq_hash = get_seq_hash (seq);
-	/*
-	 * procure and optimize sequence bps
-	 */
+	return true;
+}
+
+void destroy_search_context (ntp_search_context context) {
+	if (context) {
+		destroy_search_workers (&context->workers);
+		
+		if (context->search_seq_list) {
+			list_destroy_all_tagged (&context->search_seq_list);
+		}
+		
+		free (context->candidates.bps);
+		free (context->candidates.stack_lens);
+		free (context->candidates.parent_idxs);
+		free (context->candidates.order);
+		free (context->candidates.merged_order);
+		free (context->candidates.parents);
+		free (context->candidates.roots);
+		finalize_model_plan (&context->plan);
+		free (context->filter_memo.entries);
+		free (context->filter_memo.slots);
+		free (context->filter_memo.filter_bounds);
+		free (context->filter_memo.bps);
+		release_seq_bp_cache_pin (&context->seq_bp_pin);
+		FREE_DEBUG (context, "context in destroy_search_context");
+	}
+}
+
+/*
+ * model partitioning: partition elements, whose pos_var is fixed to a single
+ * value per search iteration, along with their original pos_var min/max values
+ */
+typedef struct {
+	ushort num_partitions;
+	// represent a model partition by the ntp_element at which pos_var sub-models are deployed
+	ntp_element elements[MAX_MODEL_PARTITIONS];
+	// store model's original pos_var min/max values
+	nt_element_count original_min[MAX_MODEL_PARTITIONS],
+	                 original_max[MAX_MODEL_PARTITIONS];
+	// number of iterations when factoring in pos_var ranges of all partitions;
+	// if Rx is the pos_var range (i.e. sum of) of ntp_element (partition) x,
+	// and X is the set of all partitions used, then num_iterations is the
+	// product of Rx for all x element of X
+	unsigned long long num_iterations;
+} nt_model_partitioning, *ntp_model_partitioning;
+
+/*
+ * search iterations [first_iteration, end_iteration) of a partitioned model, in a worker thread
+ */
+typedef struct {
+	ntp_search_context context;
+	ntp_seq seq;
+	nt_seq_hash seq_hash;
+	ntp_model model;                    // worker's own copy of the model (see search_seq_in_parallel)
+	ntp_seq_bp seq_bp;                  // copy of seq_bp for the worker's model
+	nt_model_partitioning partitioning;
+	unsigned long long first_iteration, end_iteration;
+	ntp_list safe_copy;
+	bool success;
+	// run on the calling thread, whose tagged memory is not the worker's alone
+	bool is_inline;
+	#ifdef SEARCH_SEQ_DETAIL
+	ntp_bp targets;
+	nt_hit_count num_targets;
+	#endif
+} search_partition_worker_arg;
+
+/*
+ * private function to procure (from cache or, failing that, from the
+ * sequence itself) the optimized sequence bps for a given model, which
+ * remain pinned in the cache until pin is released; plan and model_sig
+ * are those compiled from model for this search (see search_seq)
+ */
+static bool get_search_seq_bp (const ntp_seq restrict seq,
+                               const nt_seq_hash seq_hash, nt_model *restrict model,
+                               const nt_model_plan *restrict plan, const ushort *restrict model_sig,
+                               const uint32_t model_sig_len, ntp_seq_bp *restrict seq_bp,
+                               ntp_seq_bp_cache_pin restrict pin) {
 	REGISTER
 	ntp_list *min_stack_dist, *max_stack_dist, *in_extrusion, *dist_els;
 	// TODO: error handling
@@ -4916,55 +5639,61 @@ ntp_list search_seq (const ntp_seq restrict seq, nt_model *restrict model,
 	                          max_stack_dist, in_extrusion, dist_els)) {
 		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
 		              "cannot count stack distances in search_seq", false);
-		list_destroy_all_tagged();
 		destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
-		return NULL;
+		return false;
 	}
 	
-	ntp_seq_bp seq_bp = NULL;
+	*seq_bp = NULL;
 	REGISTER
 	bool cache_success = get_seq_bp_from_cache (seq, seq_hash, model,
-	                                        min_stack_dist, max_stack_dist, in_extrusion, dist_els, &seq_bp);
+	                                        min_stack_dist, max_stack_dist, in_extrusion, dist_els, seq_bp, pin);
 	                                        
-	if (!seq_bp || !cache_success) {
+	if (!*seq_bp || !cache_success) {
 		COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
 		               "seq (hash %lu) not found in cache, build from nt and write to cache required in search_seq",
 		               seq_hash, false);
 		               
 		if (!is_seq_valid (seq)) {
 			COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ, "failed to validate seq", false);
-			list_destroy_all_tagged();
 			destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
-			return NULL;
+			release_seq_bp_cache_pin (pin);
+			return false;
 		}
 		
 		REGISTER
 		bool to_cache =
-		                    !seq_bp; // only add to cache when no seq_bp data exists (seq_bp==NULL)
+		                    !*seq_bp; // only add to cache when no seq_bp data exists (seq_bp==NULL)
 		                    
-		if (!get_seq_bp_from_seq (seq, model, min_stack_dist, max_stack_dist,
-		                          in_extrusion, dist_els, &seq_bp)) {
-			COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-			              "failed to build from nt in search_seq", false);
-			list_destroy_all_tagged();
-			destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
-			return NULL;
+		// another process (or an earlier search of the same model) may have published seq_bp
+		if (!to_cache || !get_seq_bp_from_shm_store (seq, seq_hash, model, plan, model_sig,
+		                               model_sig_len, seq_bp)) {
+			if (!get_seq_bp_from_seq (seq, model, min_stack_dist, max_stack_dist,
+			                          in_extrusion, dist_els, seq_bp)) {
+				COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+				              "failed to build from nt in search_seq", false);
+				destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
+				release_seq_bp_cache_pin (pin);
+				return false;
+			}
+			
+			optimize_seq_bp (*seq_bp, plan);
+			COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
+			               "seq (hash %lu) built from nt in search_seq", seq_hash, false);
+			               
+			if (to_cache) {
+				publish_seq_bp_to_shm_store (seq, seq_hash, *seq_bp, model_sig, model_sig_len);
+			}
 		}
 		
-		optimize_seq_bp (seq_bp);
-		COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
-		               "seq (hash %lu) built from nt in search_seq", seq_hash, false);
-		               
 		if (to_cache) {
 			REGISTER
-			nt_seq_count seq_count = add_seq_bp_to_cache (seq, seq_hash, seq_bp);
+			nt_seq_count seq_count = add_seq_bp_to_cache (seq, seq_hash, seq_bp, pin);
 			
 			if (!seq_count) {
 				COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
 				              "failed to add seq to cache in search_seq", false);
-				list_destroy_all_tagged();
 				destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
-				return NULL;
+				return false;
 			}
 			
 			COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
@@ -4972,9 +5701,65 @@ ntp_list search_seq (const ntp_seq restrict seq, nt_model *restrict model,
 		}
 	}
 	
-	/*
-	 * estimate model complexity (in search space terms) and partition model if necessary
-	 */
+	destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
+	return true;
+}
+
+/*
+ * private function to fix the pos_var of each partition element to its value
+ * in the given iteration; iterations run over all partition permutations, where
+ * each partition ranges over the respective element's pos_var values and the
+ * last partition varies fastest
+ */
+static inline void set_model_partitions (const nt_model_partitioning *restrict
+                                        partitioning, unsigned long long iteration) {
+	for (REGISTER int i = partitioning->num_partitions - 1; i >= 0; i--) {
+		REGISTER
+		unsigned long long range = partitioning->original_max[i] -
+		                           partitioning->original_min[i] + 1;
+		REGISTER
+		nt_element_count current_var = (nt_element_count) (partitioning->original_min[i] +
+		                                        iteration % range);
+		iteration /= range;
+		
+		if (partitioning->elements[i]->type == unpaired) {
+			partitioning->elements[i]->unpaired->min = current_var;
+			partitioning->elements[i]->unpaired->max = current_var;
+		}
+		
+		else {
+			partitioning->elements[i]->paired->min = current_var;
+			partitioning->elements[i]->paired->max = current_var;
+		}
+	}
+}
+
+/*
+ * private function to reset the pos_var values of partition elements to their originals
+ */
+static inline void reset_model_partitions (const nt_model_partitioning *restrict
+                                        partitioning) {
+	for (ushort i = 0; i < partitioning->num_partitions; i++) {
+		if (partitioning->elements[i]->type == unpaired) {
+			partitioning->elements[i]->unpaired->min = partitioning->original_min[i];
+			partitioning->elements[i]->unpaired->max = partitioning->original_max[i];
+		}
+		
+		else {
+			partitioning->elements[i]->paired->min = partitioning->original_min[i];
+			partitioning->elements[i]->paired->max = partitioning->original_max[i];
+		}
+	}
+}
+
+/*
+ * private function to estimate model complexity (in search space terms) and partition model if necessary
+ *
+ * output:  true if the model's search space, or that of each of its partition iterations,
+ *          is within MAX_MODEL_SIZE; the model itself is returned unmodified
+ */
+static bool partition_model (nt_model *restrict model,
+                             ntp_model_partitioning restrict partitioning) {
 	nt_model_size model_size;
 	get_model_size (model, model->first_element, &model_size);
 	COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ, "given model has size %llu", model_size,
@@ -4986,596 +5771,971 @@ ntp_list search_seq (const ntp_seq restrict seq, nt_model *restrict model,
 	// is used for this purpose and starts partitioning the
 	// original model from the largest available "pos_var" thus
 	// minimizing the overall number of sub-model iterations needed
-	ushort num_partitions = 0;
-	ntp_element
-	model_partitions[MAX_MODEL_PARTITIONS];                // represent a model partition by the ntp_element at which
-	// pos_var sub-models are deployed
-	nt_element_count
-	model_partition_original_min[MAX_MODEL_PARTITIONS];    // store model's original pos_var min/max values
-	nt_element_count model_partition_original_max[MAX_MODEL_PARTITIONS];
-	nt_element_count
-	model_partition_current_var[MAX_MODEL_PARTITIONS];     // current value within min<=pos_var<=max range for this iteration
-	// number of iterations when factoring in pos_var ranges of all partitions;
-	// if Rx is the pos_var range (i.e. sum of) of ntp_element (partition) x,
-	// and X is the set of all partitions used, then num_iterations is the
-	// product of Rx for all x element of X
-	REGISTER
-	unsigned long long num_iterations = 1;
+	partitioning->num_partitions = 0;
+	partitioning->num_iterations = 1;
 	COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ,
 	              "partitioning model in up to MAX_MODEL_PARTITIONS", false);
 	              
 	while (model_size > MAX_MODEL_SIZE &&
-	       num_partitions < MAX_MODEL_PARTITIONS - 1) {
-		if (get_next_model_partition (model, model_partitions,
-		                              (nt_element_count) (num_partitions))) {
-			model_partition_original_min[num_partitions] =
-			                    model_partitions[num_partitions]->type == unpaired ?
-			                    model_partitions[num_partitions]->unpaired->min :
-			                    model_partitions[num_partitions]->paired->min;
-			model_partition_original_max[num_partitions] =
-			                    model_partitions[num_partitions]->type == unpaired ?
-			                    model_partitions[num_partitions]->unpaired->max :
-			                    model_partitions[num_partitions]->paired->max;
-			model_partition_current_var[num_partitions] =
-			                    model_partition_original_min[num_partitions];
-			num_iterations *= model_partition_original_max[num_partitions] -
-			                  model_partition_original_min[num_partitions] + 1;
-			                  
+	       partitioning->num_partitions < MAX_MODEL_PARTITIONS - 1) {
+		REGISTER
+		ushort p = partitioning->num_partitions;
+		
+		if (get_next_model_partition (model, partitioning->elements,
+		                              (nt_element_count) (p))) {
+			partitioning->original_min[p] = partitioning->elements[p]->type == unpaired ?
+			                                partitioning->elements[p]->unpaired->min :
+			                                partitioning->elements[p]->paired->min;
+			partitioning->original_max[p] = partitioning->elements[p]->type == unpaired ?
+			                                partitioning->elements[p]->unpaired->max :
+			                                partitioning->elements[p]->paired->max;
+			partitioning->num_iterations *= partitioning->original_max[p] -
+			                                partitioning->original_min[p] + 1;
+			                                
 			/*
-			 * setup model values for the first iteration (fix the specific model element's pos_var to model_partition_current_var)
+			 * fix the specific model element's pos_var (to its min) prior to seeking the next partition
 			 */
-			if (model_partitions[num_partitions]->type == unpaired) {
-				model_partitions[num_partitions]->unpaired->min =
-				                    model_partition_current_var[num_partitions];
-				model_partitions[num_partitions]->unpaired->max =
-				                    model_partition_current_var[num_partitions];
+			if (partitioning->elements[p]->type == unpaired) {
+				partitioning->elements[p]->unpaired->max = partitioning->original_min[p];
 			}
 			
 			else {
-				model_partitions[num_partitions]->paired->min =
-				                    model_partition_current_var[num_partitions];
-				model_partitions[num_partitions]->paired->max =
-				                    model_partition_current_var[num_partitions];
+				partitioning->elements[p]->paired->max = partitioning->original_min[p];
 			}
 			
 			// after identifying the next element/partition, calculate the resulting reduction in model_size
-			model_size /= (model_partition_original_max[num_partitions] -
-			               model_partition_original_min[num_partitions] + 1);
-			num_partitions++;
+			model_size /= (partitioning->original_max[p] - partitioning->original_min[p] + 1);
+			partitioning->num_partitions++;
 		}
 		
 		else {
 			COMMIT_DEBUG1 (REPORT_ERRORS, SEARCH_SEQ,
 			               "failed to get next model for partition %d\n",
-			               num_partitions,
+			               p,
 			               false);
-			               
-			/*
-			 * could not obtain all partitions necessary - reset model pos_var values to originals
-			 */
-			for (ushort i = 0; i < num_partitions; i++) {
-				if (model_partitions[i]->type == unpaired) {
-					model_partitions[i]->unpaired->min = model_partition_original_min[i];
-					model_partitions[i]->unpaired->max = model_partition_original_max[i];
-				}
-				
-				else {
-					model_partitions[i]->paired->min = model_partition_original_min[i];
-					model_partitions[i]->paired->max = model_partition_original_max[i];
-				}
-			}
-			
 			break;
 		}
 	}
 	
+	/*
+	 * reset model pos_var values to originals; partition values are set per iteration
+	 */
+	reset_model_partitions (partitioning);
+	
 	if (MAX_MODEL_SIZE < model_size) {
 		COMMIT_DEBUG (REPORT_WARNINGS, SEARCH_SEQ,
 		              "cannot partition model without exceeding capacity limits in search_seq",
 		              false);
-		return NULL; // cannot partition model without exceeding MAX_MODEL_SIZE -> so just quit and return no hits
+		return false;
 	}
 	
-	else {
-		COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ, "partitioned model into %d sub-models",
-		               num_partitions, false);
+	COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ, "partitioned model into %d sub-models",
+	               partitioning->num_partitions, false);
+	return true;
+}
+
+/*
+ * private function to run a single search iteration, over all pos_var values of
+ * the model's first element, and to add the resulting hits to safe_copy
+ *
+ * notes:   - the context's plan is (re)compiled for partitioned models only; otherwise,
+ *            it is expected to hold the plan compiled from model by search_seq
+ *          - tagged memory of the iteration is retained in the context's search_seq_list
+ *          - on failure, safe_copy may have been disposed of (and set to NULL)
+ */
+static bool search_seq_iteration (ntp_search_context restrict context,
+                                  const ntp_seq restrict seq, const nt_seq_hash seq_hash,
+                                  nt_model *restrict model, ntp_seq_bp restrict seq_bp,
+                                  const bool is_partitioned, ntp_list *restrict safe_copy
+#ifdef SEARCH_SEQ_DETAIL
+	, ntp_bp targets, nt_hit_count num_targets
+#endif
+                                 ) {
+	if (context->large_search && is_large_search_over_budget (context)) {
+		return false;
 	}
 	
 	/*
-	 * invoke search in num_iterations; based on how many sub-model partitions are required
+	 * compile the model, as partitioned for this iteration, for search_seq_at
 	 */
-	long model_partition_iterator_idx = num_partitions -
-	                                    1;  // index (position) of where we are along partition iterator
-	                                    
-	for (ushort iter = 0; iter < num_iterations; iter++) {
-		COMMIT_DEBUG2 (REPORT_INFO, SEARCH_SEQ, "starting model iteration %d of %d",
-		               iter + 1, num_partitions, false);
-		               
-		/*
-		 * use search_seq_list in search_seq_at, ntp_list_copy, list_advance, list_prune to keep track of *initialized* lists, for eventual destruction
-		 */
-		if (!list_initialize_tagging()) {
-			COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-			              "cannot initialize list tagging in search_seq", false);
-			return NULL;
-		}
-		
-		else {
-			COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ, "initialized list tagging in search_seq",
-			              false);
+	if (is_partitioned && !compile_model_plan (model, &context->plan)) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "cannot compile model in search_seq", false);
+		return false;
+	}
+	
+	/*
+	 * use search_seq_list in search_seq_at, ntp_list_copy, list_advance, list_prune to keep track of *initialized* lists, for eventual destruction
+	 */
+	if (!list_initialize_tagging (&context->search_seq_list)) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "cannot initialize list tagging in search_seq", false);
+		return false;
+	}
+	
+	else {
+		COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ, "initialized list tagging in search_seq",
+		              false);
+	}
+	
+	/*
+	 * initialize wrapper constraint data structs
+	 */
+	for (REGISTER ushort i = 0; i < MAX_CONSTRAINT_MATCHES; i++) {
+		context->wrapper_constraint_elements[i] = NULL;
+	}
+	
+	context->last_wrapper_constraint_track_id = 0;
+	// stack distances of paired elements depend on the model partitioning of this iteration
+	reset_filter_memo (&context->filter_memo);
+	/*
+	 * prepare for invoking search
+	 */
+	COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
+	               "submitted seq (hash %lu) to search in search_seq", seq_hash, false);
+	ntp_list restrict matched_cnts = NULL, found_list = NULL;
+	#ifdef MULTITHREADED_ON
+	
+	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
+	#endif
+		#ifndef NO_FULL_CHECKS
+	
+		if (!
+		#endif
+		    ntp_list_alloc_debug (&matched_cnts, "matched_cnts in search_seq")
+	    #ifndef NO_FULL_CHECKS
+		   ) {
+			#ifdef MULTITHREADED_ON
+			pthread_mutex_unlock (&num_destruction_threads_mutex);
+			#endif
+			COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+			              "cannot alloc matched_cnts in search_seq", false);
+			list_destroy_all_tagged (&context->search_seq_list);
+			return false;
 		}
 		
-		/*
-		 * initialize wrapper constraint data structs
-		 */
-		for (REGISTER ushort i = 0; i < MAX_CONSTRAINT_MATCHES; i++) {
-			wrapper_constraint_elements[i] = NULL;
+	    #else
+		    ;
+	    #endif
+		#ifdef SEARCH_SEQ_DETAIL
+		COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ, "tracking sequence search against model",
+		              true);
+		              
+		if (num_targets) {
+			for (nt_hit_count i = 0; i < num_targets; i++) {
+				COMMIT_DEBUG3 (REPORT_INFO, SEARCH_SEQ,
+				               "target %lu set as: track_id=0, fp=%d, tp=%d", 50, i + 1, targets[i].fp_posn,
+				               targets[i].tp_posn, false);
+			}
 		}
 		
-		last_wrapper_constraint_track_id = 0;
-		/*
-		 * prepare for invoking search
-		 */
-		COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
-		               "submitted seq (hash %lu) to search in search_seq", seq_hash, false);
-		ntp_list restrict matched_cnts = NULL, found_list = NULL;
-		#ifdef MULTITHREADED_ON
+		else {
+			COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ, "no specific targets set", true);
+		}
 		
-		if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
 		#endif
-			#ifndef NO_FULL_CHECKS
+		REGISTER
+		char this_pos_var = get_element_pos_var_range (model->first_element);
+		#ifdef SEARCH_SEQ_DETAIL
+		char pos_var = this_pos_var;
+		#endif
+		nt_rel_count span = 0;
+		get_model_bp_span (model->first_element, &span, true, false);
 		
+		do {
+			ntp_list restrict this_matched_cnts = NULL;
+			#ifndef NO_FULL_CHECKS
+			
 			if (!
 			#endif
-			    ntp_list_alloc_debug (&matched_cnts, "matched_cnts in search_seq")
+			    ntp_list_alloc_debug (&this_matched_cnts, "this_matched_cnts in search_seq")
 		    #ifndef NO_FULL_CHECKS
 			   ) {
 				#ifdef MULTITHREADED_ON
 				pthread_mutex_unlock (&num_destruction_threads_mutex);
 				#endif
 				COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-				              "cannot alloc matched_cnts in search_seq", false);
-				list_destroy_all_tagged();
-				return NULL;
+				              "cannot alloc this_matched_cnts in search_seq", false);
+				              
+				if (matched_cnts) {
+					list_destroy (matched_cnts);
+					FREE_DEBUG (matched_cnts, "matched_cnts in search_seq");
+				}
+				
+				list_destroy_all_tagged (&context->search_seq_list);
+				return false;
 			}
 			
 		    #else
 			    ;
 		    #endif
+			ntp_list restrict this_list = NULL;
 			#ifdef SEARCH_SEQ_DETAIL
-			COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ, "tracking sequence search against model",
-			              true);
-			              
-			if (num_targets) {
-				for (nt_hit_count i = 0; i < num_targets; i++) {
-					COMMIT_DEBUG3 (REPORT_INFO, SEARCH_SEQ,
-					               "target %lu set as: track_id=0, fp=%d, tp=%d", 50, i + 1, targets[i].fp_posn,
-					               targets[i].tp_posn, false);
-				}
+			
+			if (!pos_var || (this_pos_var == pos_var)) {
+				COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
+				               "starting search on initial element using pos_var %d", this_pos_var, true);
 			}
 			
 			else {
-				COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ, "no specific targets set", true);
+				COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
+				               "continuing search on initial element using pos_var %d", this_pos_var, true);
 			}
 			
 			#endif
-			REGISTER
-			char this_pos_var = get_element_pos_var_range (model->first_element);
-			#ifdef SEARCH_SEQ_DETAIL
-			char pos_var = this_pos_var;
-			#endif
-			nt_rel_count span = 0;
-			get_model_bp_span (model->first_element, &span, true, false);
 			
-			do {
-				ntp_list restrict this_matched_cnts = NULL;
-				#ifndef NO_FULL_CHECKS
-				
-				if (!
-				#endif
-				    ntp_list_alloc_debug (&this_matched_cnts, "this_matched_cnts in search_seq")
-			    #ifndef NO_FULL_CHECKS
-				   ) {
-					#ifdef MULTITHREADED_ON
-					pthread_mutex_unlock (&num_destruction_threads_mutex);
-					#endif
-					COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-					              "cannot alloc this_matched_cnts in search_seq", false);
-					              
-					if (matched_cnts) {
-						list_destroy (matched_cnts);
-						FREE_DEBUG (matched_cnts, "matched_cnts in search_seq");
+			if (search_seq_at (context, model,
+			                   seq,
+			                   seq_bp,
+			                   model->first_element,
+			                   NULL,
+			                   &this_list, 0, 0, 0, 0, 0, -1, this_pos_var, NULL, &this_matched_cnts
+		                   #ifdef SEARCH_SEQ_DETAIL
+			                   , 0, targets, num_targets
+		                   #endif
+			                  )) {
+				if (this_list && this_list->numels) {
+					ntp_list previously_found_list = found_list;
+					found_list = ntp_list_concatenate (found_list, this_list, 0);
+					
+					if (previously_found_list) {
+						list_destroy (previously_found_list);
+						FREE_DEBUG (previously_found_list, "previously found_list in search_seq");
 					}
 					
-					list_destroy_all_tagged();
-					return NULL;
-				}
-				
-			    #else
-				    ;
-			    #endif
-				ntp_list restrict this_list = NULL;
-				#ifdef SEARCH_SEQ_DETAIL
-				
-				if (!pos_var || (this_pos_var == pos_var)) {
-					COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
-					               "starting search on initial element using pos_var %d", this_pos_var, true);
-				}
-				
-				else {
-					COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
-					               "continuing search on initial element using pos_var %d", this_pos_var, true);
-				}
-				
-				#endif
-				
-				if (search_seq_at (model,
-				                   seq,
-				                   seq_bp,
-				                   model->first_element,
-				                   NULL,
-				                   &this_list, 0, 0, 0, 0, 0, -1, this_pos_var, NULL, &this_matched_cnts
-			                   #ifdef SEARCH_SEQ_DETAIL
-				                   , 0, targets, num_targets
-			                   #endif
-				                  )) {
-					if (this_list && this_list->numels) {
-						ntp_list previously_found_list = found_list;
-						found_list = ntp_list_concatenate (found_list, this_list, 0);
-						
-						if (previously_found_list) {
-							list_destroy (previously_found_list);
-							FREE_DEBUG (previously_found_list, "previously found_list in search_seq");
-						}
-						
-						if (this_list) {
-							list_destroy (this_list);
-							FREE_DEBUG (this_list, "this_list in search_seq");
-							this_list = NULL;
-						}
-						
-						ntp_list previosuly_matched_cnts = matched_cnts;
-						matched_cnts = ntp_count_list_concatenate (matched_cnts, this_matched_cnts);
-						
-						if (previosuly_matched_cnts && previosuly_matched_cnts != matched_cnts) {
-							list_destroy (previosuly_matched_cnts);
-							FREE_DEBUG (previosuly_matched_cnts, "previosuly matched_cnts in search_seq");
-						}
-						
-						if (this_matched_cnts && this_matched_cnts != matched_cnts) {
-							list_destroy (this_matched_cnts);
-							FREE_DEBUG (this_matched_cnts, "this_matched_cnts in search_seq");
-						}
+					if (this_list) {
+						list_destroy (this_list);
+						FREE_DEBUG (this_list, "this_list in search_seq");
+						this_list = NULL;
 					}
 					
-					else {
-						if (this_list) {
-							list_destroy (this_list);
-							FREE_DEBUG (this_list, "this_list in search_seq");
-						}
-						
-						if (this_matched_cnts) {
-							list_destroy (this_matched_cnts);
-							FREE_DEBUG (this_matched_cnts, "this_matched_cnts in search_seq");
-						}
+					ntp_list previosuly_matched_cnts = matched_cnts;
+					matched_cnts = ntp_count_list_concatenate (matched_cnts, this_matched_cnts);
+					
+					if (previosuly_matched_cnts && previosuly_matched_cnts != matched_cnts) {
+						list_destroy (previosuly_matched_cnts);
+						FREE_DEBUG (previosuly_matched_cnts, "previosuly matched_cnts in search_seq");
+					}
+					
+					if (this_matched_cnts && this_matched_cnts != matched_cnts) {
+						list_destroy (this_matched_cnts);
+						FREE_DEBUG (this_matched_cnts, "this_matched_cnts in search_seq");
 					}
 				}
 				
 				else {
-					#ifdef MULTITHREADED_ON
-					pthread_mutex_unlock (&num_destruction_threads_mutex);
-					#endif
-					
 					if (this_list) {
 						list_destroy (this_list);
 						FREE_DEBUG (this_list, "this_list in search_seq");
 					}
 					
-					if (matched_cnts) {
-						list_destroy (matched_cnts);
-						FREE_DEBUG (matched_cnts, "matched_cnts in search_seq");
-					}
-					
 					if (this_matched_cnts) {
 						list_destroy (this_matched_cnts);
 						FREE_DEBUG (this_matched_cnts, "this_matched_cnts in search_seq");
 					}
-					
-					list_destroy_all_tagged();
-					destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
-					return NULL;
 				}
-				
-				this_pos_var--;
-			}
-			while (this_pos_var >= 0);
-			
-			if (matched_cnts) {
-				list_destroy (matched_cnts);
-				FREE_DEBUG (matched_cnts, "matched_cnts in search_seq");
-			}
-			
-			if (found_list) {
-				COMMIT_DEBUG2 (REPORT_INFO, SEARCH_SEQ,
-				               "seq search (hash %lu) returned with found_list of size %u in search_seq",
-				               seq_hash,
-				               found_list->numels, false);
 			}
 			
 			else {
-				COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
-				               "seq search (hash %lu) returned an empty found_list", seq_hash, false);
-			}
-			
-			if (found_list && list_iterator_start (found_list)) {
-				if (!safe_copy) {
-					safe_copy = MALLOC_DEBUG (sizeof (nt_list),
-					                          "safe_copy of found_list in search_seq");  // TODO: error handling
-					                          
-					if (!safe_copy || 0 != list_init (safe_copy)) {
-						list_iterator_stop (found_list);
-						COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-						              "cannot allocate or initialize safe_copy in search_seq", false);
-						              
-						if (safe_copy) {
-							FREE_DEBUG (safe_copy, "safe_copy of found_list in search_seq");
-						}
-						
-						list_destroy (found_list);
-						FREE_DEBUG (found_list, "found_list in search_seq_at");
-						destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
-						return NULL;
-					}
-				}
-				
-				REGISTER
-				bool success = true;
-				ntp_linked_bp next_linked_bp = NULL;
+				#ifdef MULTITHREADED_ON
+				pthread_mutex_unlock (&num_destruction_threads_mutex);
+				#endif
 				
-				while (list_iterator_hasnext (found_list)) {
-					REGISTER
-					ntp_linked_bp found_linked_bp = list_iterator_next (found_list);
-					
-					if (!found_linked_bp) {
-						success = false;
-						break;
-					}
-					
-					if (model->first_constraint) {
-						if (!satisfy_constraints (seq, model->first_constraint, safe_copy,
-						                          found_linked_bp, found_linked_bp, &next_linked_bp)) {
-							success = false;
-							break;
-						}
-					}
-					
-					else
-						if (!safe_copy_linked_bp (safe_copy, found_linked_bp, &next_linked_bp)) {
-							success = false;
-							break;
-						}
+				if (this_list) {
+					list_destroy (this_list);
+					FREE_DEBUG (this_list, "this_list in search_seq");
 				}
 				
-				if (success) {
-					COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ,
-					              "generated safe_copy of found_list in search_seq", false);
+				if (matched_cnts) {
+					list_destroy (matched_cnts);
+					FREE_DEBUG (matched_cnts, "matched_cnts in search_seq");
 				}
 				
-				else {
-					COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
-					              "could not copy/append element to safe_copy of found_list in search_seq",
-					              false);
-					dispose_linked_bp_copy (model,
-					                        safe_copy,
-					                        "linked_bp_copy for safe_copy of found_list in search_seq [could not copy/append element]",
-					                        "safe_copy of found_list in search_seq [could not copy/append element]"
-					                        #ifndef NO_FULL_CHECKS
-					                        , "could not iterate over to free safe_copy of found_list in search_seq"
-					                        #endif
-					                       );
+				if (this_matched_cnts) {
+					list_destroy (this_matched_cnts);
+					FREE_DEBUG (this_matched_cnts, "this_matched_cnts in search_seq");
 				}
 				
-				list_iterator_stop (found_list);
-				
-				if (found_list) {
-					list_destroy (found_list);
-					FREE_DEBUG (found_list, "found_list in search_seq_at");
-				}
+				list_destroy_all_tagged (&context->search_seq_list);
+				return false;
 			}
 			
+			this_pos_var--;
+		}
+		while (this_pos_var >= 0);
+		
+		if (matched_cnts) {
+			list_destroy (matched_cnts);
+			FREE_DEBUG (matched_cnts, "matched_cnts in search_seq");
+		}
+		
+		if (context->large_search_abandoned) {
 			#ifdef MULTITHREADED_ON
 			pthread_mutex_unlock (&num_destruction_threads_mutex);
 			#endif
-			#ifdef MULTITHREADED_ON
+			
+			if (found_list) {
+				list_destroy (found_list);
+				FREE_DEBUG (found_list, "found_list in search_seq");
+			}
+			
+			list_destroy_all_tagged (&context->search_seq_list);
+			return false;
 		}
 		
-		destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
-		return NULL;
-			#endif
+		if (found_list) {
+			COMMIT_DEBUG2 (REPORT_INFO, SEARCH_SEQ,
+			               "seq search (hash %lu) returned with found_list of size %u in search_seq",
+			               seq_hash,
+			               found_list->numels, false);
+		}
 		
-		if (1 != num_iterations) {
-			/*
-			 *  update model_partition_iterator for next iteration
-			 */
+		else {
+			COMMIT_DEBUG1 (REPORT_INFO, SEARCH_SEQ,
+			               "seq search (hash %lu) returned an empty found_list", seq_hash, false);
+		}
+		
+		if (found_list && list_iterator_start (found_list)) {
+			if (!*safe_copy) {
+				*safe_copy = MALLOC_DEBUG (sizeof (nt_list),
+				                           "safe_copy of found_list in search_seq");  // TODO: error handling
+				                           
+				if (!*safe_copy || 0 != list_init (*safe_copy)) {
+					list_iterator_stop (found_list);
+					COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+					              "cannot allocate or initialize safe_copy in search_seq", false);
+					              
+					if (*safe_copy) {
+						FREE_DEBUG (*safe_copy, "safe_copy of found_list in search_seq");
+						*safe_copy = NULL;
+					}
+					
+					list_destroy (found_list);
+					FREE_DEBUG (found_list, "found_list in search_seq_at");
+					return false;
+				}
+			}
+			
+			REGISTER
+			bool success = true;
+			ntp_linked_bp next_linked_bp = NULL;
 			
-			// starting with P1,P2,...,Pnum_partitions, iterate over all partition
-			// permutations, where each partition ranges over the respective element's
-			// pos_var values; thus, for example, pos_varMIN1 <= P1 <= pos_varMAX1, where
-			// pos_varMIN1 and pos_varMAX1 are the min/max pos_var values for the
-			// first partition's ntp_element, respectively
-			if (model_partition_current_var[model_partition_iterator_idx] <
-			    model_partition_original_max[model_partition_iterator_idx]) {
-				model_partition_current_var[model_partition_iterator_idx]++;
+			while (list_iterator_hasnext (found_list)) {
+				REGISTER
+				ntp_linked_bp found_linked_bp = list_iterator_next (found_list);
 				
-				if (model_partitions[model_partition_iterator_idx]->type == unpaired) {
-					model_partitions[model_partition_iterator_idx]->unpaired->min =
-					                    model_partition_current_var[model_partition_iterator_idx];
-					model_partitions[model_partition_iterator_idx]->unpaired->max =
-					                    model_partition_current_var[model_partition_iterator_idx];
+				if (!found_linked_bp) {
+					success = false;
+					break;
 				}
 				
-				else {
-					model_partitions[model_partition_iterator_idx]->paired->min =
-					                    model_partition_current_var[model_partition_iterator_idx];
-					model_partitions[model_partition_iterator_idx]->paired->max =
-					                    model_partition_current_var[model_partition_iterator_idx];
+				if (model->first_constraint) {
+					if (!satisfy_constraints (context, seq, model->first_constraint, *safe_copy,
+					                          found_linked_bp, found_linked_bp, &next_linked_bp)) {
+						success = false;
+						break;
+					}
 				}
 				
-				if (model_partition_iterator_idx < num_partitions - 1) {
-					model_partition_iterator_idx++;
-				}
+				else
+					if (!safe_copy_linked_bp (context, seq, *safe_copy, found_linked_bp,
+					                          &next_linked_bp)) {
+						success = false;
+						break;
+					}
+			}
+			
+			if (success) {
+				COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ,
+				              "generated safe_copy of found_list in search_seq", false);
 			}
 			
 			else {
-				while (model_partition_iterator_idx > 0) {
-					if (model_partitions[model_partition_iterator_idx]->type == unpaired) {
-						model_partitions[model_partition_iterator_idx]->unpaired->min =
-						                    model_partition_original_min[model_partition_iterator_idx];
-						model_partitions[model_partition_iterator_idx]->unpaired->max =
-						                    model_partition_original_min[model_partition_iterator_idx];
+				COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+				              "could not copy/append element to safe_copy of found_list in search_seq",
+				              false);
+				flush_top_hits (context, *safe_copy);
+				dispose_linked_bp_copy (model,
+				                        *safe_copy,
+				                        "linked_bp_copy for safe_copy of found_list in search_seq [could not copy/append element]",
+				                        "safe_copy of found_list in search_seq [could not copy/append element]"
+				                        #ifndef NO_FULL_CHECKS
+				                        , "could not iterate over to free safe_copy of found_list in search_seq"
+				                        #endif
+				                       );
+				*safe_copy = NULL;
+			}
+			
+			list_iterator_stop (found_list);
+			
+			if (found_list) {
+				list_destroy (found_list);
+				FREE_DEBUG (found_list, "found_list in search_seq_at");
+			}
+			
+			if (!success) {
+				return false;
+			}
+		}
+		
+		#ifdef MULTITHREADED_ON
+		pthread_mutex_unlock (&num_destruction_threads_mutex);
+		return true;
+	}
+	
+	return false;
+	#else
+	return true;
+	#endif
+}
+
+static void *search_partition_thread (void *arg) {
+	search_partition_worker_arg *worker = (search_partition_worker_arg *)arg;
+	worker->success = true;
+	worker->context->large_search_mem_base = get_mem_tag_size();
+	
+	for (REGISTER unsigned long long iter = worker->first_iteration;
+	     worker->success && iter < worker->end_iteration; iter++) {
+		set_model_partitions (&worker->partitioning, iter);
+		worker->success = search_seq_iteration (worker->context, worker->seq,
+		                                        worker->seq_hash, worker->model, worker->seq_bp, true, &worker->safe_copy
+		                                        #ifdef SEARCH_SEQ_DETAIL
+		                                        , worker->targets, worker->num_targets
+		                                        #endif
+		                                       );
+		// tagged memory is per thread, so release it within the worker; run inline, its
+		// lists are destroyed, but their memory is left to the calling thread to release
+		if (worker->is_inline) {
+			clear_search_seq_list (&worker->context->search_seq_list);
+		}
+		
+		else {
+			list_destroy_all_tagged (&worker->context->search_seq_list);
+		}
+	}
+	
+	if (worker->safe_copy) {
+		flush_top_hits (worker->context, worker->safe_copy);
+	}
+	
+	reset_model_partitions (&worker->partitioning);
+	return NULL;
+}
+
+/*
+ * private function to point constraint references of a (safe_copy) linked_bp,
+ * found using from_model, to the corresponding constraints of to_model
+ */
+static inline void remap_linked_bp_constraints (ntp_linked_bp restrict linked_bp,
+                                        const nt_model *restrict from_model, const nt_model *restrict to_model) {
+	for (; linked_bp; linked_bp = linked_bp->prev_linked_bp) {
+		for (uchar e = 0; e < 2; e++) {
+			for (REGISTER ntp_element el = e ? linked_bp->tp_elements :
+			                                   linked_bp->fp_elements; el; el = el->unpaired->next) {
+				REGISTER
+				ntp_constraint from_constraint = from_model->first_constraint,
+				               to_constraint = to_model->first_constraint;
+				               
+				while (from_constraint &&
+				       from_constraint != el->unpaired->i_constraint.reference) {
+					from_constraint = from_constraint->next;
+					to_constraint = to_constraint->next;
+				}
+				
+				el->unpaired->i_constraint.reference = from_constraint ? to_constraint : NULL;
+			}
+		}
+	}
+}
+
+/*
+ * private function to run the iterations of a partitioned model across a pool of worker
+ * threads, each of which uses its own search context, and its own copies of the model
+ * and seq_bp (given that partitioning modifies the model, and that seq_bp is specific
+ * to a model's elements); the threads are reserved out of max_search_threads, and the
+ * worker contexts and model copies are kept in context for searches of the same model;
+ * hits are merged into safe_copy in iteration order, skipping any duplicates, and
+ * bounded to the most favourable hits using the heap of context
+ *
+ * output:  false if the search could not be set up to run in parallel, in which
+ *          case it should be run sequentially; true otherwise, with success set
+ *          to the outcome of the search
+ */
+static bool search_seq_in_parallel (ntp_search_context restrict context,
+                                    const ntp_seq restrict seq,
+                                    const nt_seq_hash seq_hash, nt_model *restrict model,
+                                    ntp_seq_bp restrict seq_bp, const ushort *restrict model_sig,
+                                    const uint32_t model_sig_len,
+                                    const nt_model_partitioning *restrict partitioning,
+                                    ntp_list *restrict safe_copy, bool *restrict success
+#ifdef SEARCH_SEQ_DETAIL
+	, ntp_bp targets, nt_hit_count num_targets
+#endif
+                                   ) {
+	REGISTER
+	ushort num_workers = reserve_search_threads (partitioning->num_iterations);
+	
+	if (!num_workers) {
+		return false;
+	}
+	
+	if (!get_search_workers (&context->workers, model, model_sig, model_sig_len,
+	                         num_workers)) {
+		COMMIT_DEBUG (REPORT_WARNINGS, SEARCH_SEQ,
+		              "cannot set up model copies for worker threads in search_seq", false);
+		release_search_threads (num_workers);
+		return false;
+	}
+	
+	search_partition_worker_arg worker_args[num_workers];
+	pthread_t thread_handles[num_workers];
+	bool thread_started[num_workers];
+	REGISTER
+	ushort num_ready = 0;
+	
+	for (; num_ready < num_workers; num_ready++) {
+		search_partition_worker_arg *worker = &worker_args[num_ready];
+		worker->model = context->workers.models[num_ready];
+		worker->seq_bp = copy_seq_bp (seq_bp, worker->model);
+		
+		if (!worker->seq_bp) {
+			break;
+		}
+		
+		worker->context = context->workers.contexts[num_ready];
+		worker->context->num_top_hits = 0;
+		worker->context->num_hits_found = 0;
+		worker->context->hit_sink_failed = false;
+		worker->context->large_search = context->large_search;
+		// workers share the budget of a large search, and its timer
+		worker->context->large_search_mem = context->large_search_mem / num_workers;
+		worker->context->large_search_steps = 0;
+		worker->context->large_search_abandoned = false;
+		worker->context->timer = context->timer;
+		worker->partitioning = *partitioning;
+		
+		for (ushort p = 0; p < partitioning->num_partitions; p++) {
+			worker->partitioning.elements[p] = get_model_element_copy (model,
+			                                        worker->model, partitioning->elements[p]);
+		}
+		
+		worker->seq = seq;
+		worker->seq_hash = seq_hash;
+		worker->first_iteration = (partitioning->num_iterations * num_ready) /
+		                          num_workers;
+		worker->end_iteration = (partitioning->num_iterations * (num_ready + 1)) /
+		                        num_workers;
+		worker->safe_copy = NULL;
+		worker->success = false;
+		worker->is_inline = false;
+		#ifdef SEARCH_SEQ_DETAIL
+		worker->targets = targets;
+		worker->num_targets = num_targets;
+		#endif
+	}
+	
+	if (num_ready < num_workers) {
+		COMMIT_DEBUG (REPORT_WARNINGS, SEARCH_SEQ,
+		              "cannot set up seq_bp copies for worker threads in search_seq", false);
+		              
+		for (ushort i = 0; i < num_ready; i++) {
+			destroy_seq_bp (worker_args[i].seq_bp);
+		}
+		
+		release_search_threads (num_workers);
+		return false;
+	}
+	
+	COMMIT_DEBUG2 (REPORT_INFO, SEARCH_SEQ,
+	               "searching %llu model iterations across %d worker threads",
+	               partitioning->num_iterations, num_workers, false);
+	               
+	for (REGISTER ushort i = 0; i < num_workers; i++) {
+		thread_started[i] = !pthread_create (&thread_handles[i], NULL,
+		                                     search_partition_thread, &worker_args[i]);
+		                                     
+		if (!thread_started[i]) {
+			// fall back to running this worker's iterations on the calling thread
+			COMMIT_DEBUG1 (REPORT_WARNINGS, SEARCH_SEQ,
+			               "could not start worker thread #%u in search_seq", i, false);
+			worker_args[i].is_inline = true;
+			search_partition_thread (&worker_args[i]);
+		}
+	}
+	
+	*success = true;
+	
+	for (REGISTER ushort i = 0; i < num_workers; i++) {
+		if (thread_started[i]) {
+			void *join_ret_value;
+			pthread_join (thread_handles[i], &join_ret_value);
+		}
+		
+		search_partition_worker_arg *worker = &worker_args[i];
+		*success &= worker->success;
+		
+		if (*success && worker->safe_copy) {
+			if (!*safe_copy) {
+				*safe_copy = MALLOC_DEBUG (sizeof (nt_list),
+				                           "safe_copy of found_list in search_seq");
+				                           
+				if (!*safe_copy || 0 != list_init (*safe_copy)) {
+					COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+					              "cannot allocate or initialize safe_copy in search_seq", false);
+					              
+					if (*safe_copy) {
+						FREE_DEBUG (*safe_copy, "safe_copy of found_list in search_seq");
+						*safe_copy = NULL;
 					}
 					
-					else {
-						model_partitions[model_partition_iterator_idx]->paired->min =
-						                    model_partition_original_min[model_partition_iterator_idx];
-						model_partitions[model_partition_iterator_idx]->paired->max =
-						                    model_partition_original_min[model_partition_iterator_idx];
+					*success = false;
+				}
+			}
+			
+			REGISTER
+			ntp_list duplicates = NULL;
+			
+			if (*success) {
+				duplicates = MALLOC_DEBUG (sizeof (nt_list),
+				                           "duplicates of safe_copy in search_seq");
+				                           
+				if (!duplicates || 0 != list_init (duplicates)) {
+					COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+					              "cannot allocate or initialize duplicates of safe_copy in search_seq", false);
+					              
+					if (duplicates) {
+						FREE_DEBUG (duplicates, "duplicates of safe_copy in search_seq");
 					}
 					
-					model_partition_current_var[model_partition_iterator_idx] =
-					                    model_partition_original_min[model_partition_iterator_idx];
-					model_partition_iterator_idx--;
+					*success = false;
+				}
+			}
+			
+			if (*success) {
+				/*
+				 * move hits over to safe_copy, disposing of those already found by earlier iterations
+				 */
+				list_iterator_start (worker->safe_copy);
+				
+				while (list_iterator_hasnext (worker->safe_copy)) {
+					REGISTER
+					ntp_linked_bp linked_bp = list_iterator_next (worker->safe_copy);
+					remap_linked_bp_constraints (linked_bp, worker->model, model);
 					
-					if (model_partition_current_var[model_partition_iterator_idx] <
-					    model_partition_original_max[model_partition_iterator_idx]) {
-						model_partition_current_var[model_partition_iterator_idx]++;
-						
-						if (model_partitions[model_partition_iterator_idx]->type == unpaired) {
-							model_partitions[model_partition_iterator_idx]->unpaired->min =
-							                    model_partition_current_var[model_partition_iterator_idx];
-							model_partitions[model_partition_iterator_idx]->unpaired->max =
-							                    model_partition_current_var[model_partition_iterator_idx];
-						}
-						
-						else {
-							model_partitions[model_partition_iterator_idx]->paired->min =
-							                    model_partition_current_var[model_partition_iterator_idx];
-							model_partitions[model_partition_iterator_idx]->paired->max =
-							                    model_partition_current_var[model_partition_iterator_idx];
-						}
-						
-						model_partition_iterator_idx = num_partitions - 1;
-						break;
+					if (!is_linked_bp_in_safe_copy (context, *safe_copy, linked_bp)) {
+						list_append (*safe_copy, linked_bp);
+						// each worker kept its own most favourable hits, which are a superset of
+						// the most favourable hits overall; with a hit sink, hits are streamed
+						// as each worker's iterations complete
+						take_hit (context, seq, *safe_copy);
+					}
+					
+					else {
+						list_append (duplicates, linked_bp);
 					}
 				}
+				
+				list_iterator_stop (worker->safe_copy);
+				list_destroy (worker->safe_copy);
+				FREE_DEBUG (worker->safe_copy, "safe_copy of found_list in search_seq");
+				worker->safe_copy = NULL;
+				dispose_linked_bp_copy (model, duplicates,
+				                        "linked_bp_copy for safe_copy of found_list in search_seq [duplicate]",
+				                        "safe_copy of found_list in search_seq [duplicate]"
+				                        #ifndef NO_FULL_CHECKS
+				                        , "could not iterate over to free duplicates of safe_copy in search_seq"
+				                        #endif
+				                       );
+				*success = !context->hit_sink_failed;
+			}
+		}
+		
+		if (worker->safe_copy) {
+			dispose_linked_bp_copy (worker->model, worker->safe_copy,
+			                        "linked_bp_copy for safe_copy of found_list in search_seq",
+			                        "safe_copy of found_list in search_seq"
+			                        #ifndef NO_FULL_CHECKS
+			                        , "could not iterate over to free safe_copy of found_list in search_seq"
+			                        #endif
+			                       );
+		}
+		
+		destroy_seq_bp (worker->seq_bp);
+	}
+	
+	release_search_threads (num_workers);
+	return true;
+}
+
+/*
+ * search sequence against model
+ *
+ * input:   search context (see create_search_context)
+ *          sequence hash sequence_hash
+ *          model model
+ *
+ * output:  ntp_list of ntp_linked_bps matching sequence and model
+ *
+ * notes:   - tagged memory of the search is retained until
+ *            list_destroy_all_tagged is invoked on the search_seq_list
+ *            of the context, after any returned hits are disposed of
+ *          - likewise, the seq_bp that hits refer to remains pinned in the
+ *            seq_bp cache until the next search on the context, or until
+ *            the context is destroyed
+ *          - concurrent searches require distinct contexts and models,
+ *            given that model partitioning temporarily modifies the model
+ *          - tagged memory is per thread, so contexts that share a thread
+ *            share it too (see create_search_context)
+ *          - iterations of a partitioned model are run across worker
+ *            threads, where possible (see search_seq_in_parallel)
+ *          - searches that exceed MAX_SEARCH_LIST_SIZE or MAX_MODEL_SIZE return
+ *            no hits, unless large_search is set on the context, in which case
+ *            only those that exceed MAX_LARGE_SEARCH_MEM or MAX_LARGE_SEARCH_TIME_S
+ *            do
+ */
+ntp_list search_seq (ntp_search_context restrict context,
+                     const ntp_seq restrict seq, nt_model *restrict model,
+                     float *elapsed_time
+#ifdef SEARCH_SEQ_DETAIL
+	, ntp_bp targets, nt_hit_count num_targets
+#endif
+                    ) {
+	COMMIT_DEBUG (REPORT_INFO, SEARCH_SEQ,
+	              "searching seq against model in search_seq", true);
+	*elapsed_time = 0.0f;
+	start_timer (&context->timer);
+	context->num_top_hits = 0;
+	context->num_hits_found = 0;
+	context->last_hit_time = 0.0f;
+	context->hit_sink_failed = false;
+	context->large_search_mem = MAX_LARGE_SEARCH_MEM;
+	context->large_search_mem_base = get_mem_tag_size();
+	context->large_search_steps = 0;
+	context->large_search_abandoned = false;
+	// keep a safe_copy of hits found (see found_list) before finally invoking list destruction after each search iteration
+	ntp_list safe_copy = NULL;
+	#ifndef NO_FULL_CHECKS
+	
+	if (!seq)                   {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ, "search seq is NULL in search_seq",
+		              false);
+		return NULL;
+	}
+	
+	if (!seq_bp_cache)          {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "seq_bp_cache not initialized in search_seq", false);
+		return NULL;
+	}
+	
+	if (!strlen (seq))          {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "search seq has 0 length in search_seq", false);
+		return NULL;
+	}
+	
+	if (!model)                 {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ, "search model is NULL in search_seq",
+		              false);
+		return NULL;
+	}
+	
+	if (!model->first_element)  {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "search model has no elements in search_seq", false);
+		return NULL;
+	}
+	
+	#endif
+	#ifdef MULTITHREADED_ON
+	
+	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
+	#endif
+	
+		if (context->search_seq_list) {
+			COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+			              "search_seq_list already initialized in search_seq", false);
+			#ifdef MULTITHREADED_ON
+			pthread_mutex_unlock (&num_destruction_threads_mutex);
+			#endif
+			return NULL;
+		}
+		
+		#ifdef MULTITHREADED_ON
+		pthread_mutex_unlock (&num_destruction_threads_mutex);
+	}
+	
+		#endif
+	REGISTER
+	nt_seq_hash seq_hash = get_seq_hash (seq);
+	/*
+	 * procure and optimize sequence bps
+	 */
+	ntp_seq_bp seq_bp = NULL;
+	// hits of the previous search on this context, which refer to its seq_bp, have been
+	// disposed of by now (see search_seq_list above), so its seq_bp can be released
+	release_seq_bp_cache_pin (&context->seq_bp_pin);
+	/*
+	 * compile the (unpartitioned) model once for this search, for use in procuring
+	 * seq_bp, and in search_seq_at unless the model is partitioned
+	 */
+	uint32_t model_sig_len = 0;
+	ushort *model_sig = NULL;
+	
+	if (!compile_model_plan (model, &context->plan) ||
+	    ! (model_sig = get_model_signature (model, &context->plan, &model_sig_len))) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEARCH_SEQ,
+		              "cannot compile model in search_seq", false);
+		return NULL;
+	}
+	
+	if (!get_search_seq_bp (seq, seq_hash, model, &context->plan, model_sig,
+	                        model_sig_len, &seq_bp, &context->seq_bp_pin)) {
+		free (model_sig);
+		return NULL;
+	}
+	
+	nt_model_partitioning partitioning;
+	
+	if (!partition_model (model, &partitioning)) {
+		if (!context->large_search) {
+			free (model_sig);
+			return NULL; // cannot partition model without exceeding MAX_MODEL_SIZE -> so just quit and return no hits
+		}
+		
+		// in large search mode, the lists of each search step are bounded in size (see
+		// search_seq_at_in_batches), so search the model as partitioned so far
+		COMMIT_DEBUG1 (REPORT_WARNINGS, SEARCH_SEQ,
+		               "searching model in %llu iterations that exceed MAX_MODEL_SIZE in search_seq",
+		               partitioning.num_iterations, false);
+	}
+	
+	/*
+	 * invoke search in num_iterations; based on how many sub-model partitions are required
+	 */
+	bool success = true;
+	
+	if (1 == partitioning.num_iterations ||
+	    !search_seq_in_parallel (context, seq, seq_hash, model, seq_bp, model_sig,
+	                             model_sig_len, &partitioning,
+	                             &safe_copy, &success
+	                             #ifdef SEARCH_SEQ_DETAIL
+	                             , targets, num_targets
+	                             #endif
+	                            )) {
+		for (REGISTER unsigned long long iter = 0; iter < partitioning.num_iterations;
+		     iter++) {
+			COMMIT_DEBUG2 (REPORT_INFO, SEARCH_SEQ, "starting model iteration %llu of %llu",
+			               iter + 1, partitioning.num_iterations, false);
+			set_model_partitions (&partitioning, iter);
+			
+			if (!search_seq_iteration (context, seq, seq_hash, model, seq_bp,
+			                           partitioning.num_partitions > 0, &safe_copy
+			                           #ifdef SEARCH_SEQ_DETAIL
+			                           , targets, num_targets
+			                           #endif
+			                          )) {
+				success = false;
+				break;
 			}
 			
 			/*
 			 * clean-up for next search iteration
 			 */
-			if (iter < num_iterations - 1) {
-				list_destroy_all_tagged();
+			if (iter < partitioning.num_iterations - 1) {
+				list_destroy_all_tagged (&context->search_seq_list);
 				#ifdef MULTITHREADED_ON
 				
 				if (!wait_list_destruction()) {
 					COMMIT_DEBUG (REPORT_ERRORS, SCAN, "list destruction failed in search_seq",
 					              false);
-					dispose_linked_bp_copy (model, safe_copy,
-					                        "linked_bp_copy for safe_copy of found_list in search_seq",
-					                        "safe_copy of found_list in search_seq",
-					                        "could not wait for list destruction in search_seq");
-					                        
-					/*
-					 * reset model pos_var values to originals
-					 */
-					for (ushort i = 0; i < num_partitions; i++) {
-						if (model_partitions[i]->type == unpaired) {
-							model_partitions[i]->unpaired->min = model_partition_original_min[i];
-							model_partitions[i]->unpaired->max = model_partition_original_max[i];
-						}
-						
-						else {
-							model_partitions[i]->paired->min = model_partition_original_min[i];
-							model_partitions[i]->paired->max = model_partition_original_max[i];
-						}
-					}
-					
-					return NULL;
+					success = false;
+					break;
 				}
 				
 				#endif
 			}
 		}
-	}
-	
-	if (1 != num_iterations) {
+		
 		/*
 		 * reset model pos_var values to originals
 		 */
-		for (ushort i = 0; i < num_partitions; i++) {
-			if (model_partitions[i]->type == unpaired) {
-				model_partitions[i]->unpaired->min = model_partition_original_min[i];
-				model_partitions[i]->unpaired->max = model_partition_original_max[i];
-			}
-			
-			else {
-				model_partitions[i]->paired->min = model_partition_original_min[i];
-				model_partitions[i]->paired->max = model_partition_original_max[i];
-			}
-		}
+		reset_model_partitions (&partitioning);
 	}
 	
-	destroy_min_max_dist (min_stack_dist, max_stack_dist, in_extrusion, dist_els);
+	free (model_sig);
 	
-	if (safe_copy && MAX_HITS_RETURNED < safe_copy->numels) {
-		/*
-		 * get distribution of hit FEs within -100.0f and 100.0f kcal/mol
-		 * range with up to 2 decimal points precision
-		 */
-		g_memset (hit_fe_distr, 0, 20000 * sizeof (ulong));
-		list_iterator_start (safe_copy);
-		
-		while (list_iterator_hasnext (safe_copy)) {
-			ntp_linked_bp this_linked_bp = list_iterator_next (safe_copy);
-			float this_mfe = get_turner_mfe_estimate (this_linked_bp, seq);
-			// build approximate distribution of FE for hit list:
-			// to index into hit_fe_distr, this_mfe is first shifted
-			// by 100, assuming an input FE range of [-100.0f .. 100.0f],
-			// and then rounded (and shifted) by 2 decimal places
-			hit_fe_distr[ (int) (trunc (roundf ((this_mfe + 100.0f) * 100)))]++;
+	if (safe_copy) {
+		if (success && context->hit_sink) {
+			sink_top_hits (context);
 		}
 		
-		list_iterator_stop (safe_copy);
-		/*
-		 * calculate FE threshold based on FE distribution and
-		 * maximum limit of MAX_HITS_RETURNED
-		 *
-		 * anything below threshold value (note: threshold
-		 * value might correspond to distribution's first bin)
-		 * and within MAX_HITS_RETURNED will be returned
-		 */
-		REGISTER
-		float FE_threshold =
-		                    100.0f;    // initialize to accept anything below and including 100kcal/mol
-		REGISTER
-		nt_hit_count num_hits = 0;      // hit accumulator
-		
-		for (REGISTER ushort i = 0; i < 20000; i++) {
-			num_hits += hit_fe_distr[i];
-			
-			if (num_hits > MAX_HITS_RETURNED) {
-				// only set threshold when MAX_HITS_RETURNED is exceeded;
-				// use i+1 for rounding up (down in terms of less favourable, positive FE)
-				FE_threshold = ((float) (i + 1) / 100.0f) - 100.0f;
-				break;
-			}
+		flush_top_hits (context, safe_copy);
+	}
+	
+	if (!success) {
+		if (safe_copy) {
+			dispose_linked_bp_copy (model, safe_copy,
+			                        "linked_bp_copy for safe_copy of found_list in search_seq",
+			                        "safe_copy of found_list in search_seq"
+			                        #ifndef NO_FULL_CHECKS
+			                        , "could not iterate over to free safe_copy of found_list in search_seq"
+			                        #endif
+			                       );
 		}
 		
-		dispose_linked_bp_copy_by_FE_threshold (model, seq, safe_copy, FE_threshold,
-		                                        "filtered out linked_bp of safe_copy in search_seq",
-		                                        "filtered out elements of linked_bp of safe_copy in search_seq");
+		return NULL;
 	}
 	
-	*elapsed_time = get_timer();
+	*elapsed_time = get_elapsed_time (&context->timer);
 	return safe_copy;
 }
+
+/*
+ * search sequence against model, streaming hits to a hit sink
+ *
+ * input:   search context (see create_search_context)
+ *          sequence hash sequence_hash
+ *          model model
+ *          hit_sink, invoked with each new hit as soon as it is confirmed, and
+ *          hit_sink_arg, passed on to hit_sink
+ *
+ * output:  false if hit_sink aborted the search; true otherwise
+ *
+ * notes:   - the first MAX_HITS_RETURNED hits are streamed in the order found;
+ *            if more hits exist, the search goes on to select the MAX_HITS_RETURNED
+ *            most favourable hits (by FE), as search_seq does, and those not yet
+ *            streamed follow at the end of the search (streamed hits cannot be
+ *            retracted, so these come on top of the hits streamed earlier)
+ *          - streamed hits are only valid for the duration of the hit_sink call
+ */
+bool search_seq_to_sink (ntp_search_context restrict context,
+                         const ntp_seq restrict seq, nt_model *restrict model,
+                         nt_hit_sink hit_sink, void *hit_sink_arg, float *elapsed_time
+#ifdef SEARCH_SEQ_DETAIL
+	, ntp_bp targets, nt_hit_count num_targets
+#endif
+                        ) {
+	context->hit_sink = hit_sink;
+	context->hit_sink_arg = hit_sink_arg;
+	ntp_list safe_copy = search_seq (context, seq, model, elapsed_time
+	                                 #ifdef SEARCH_SEQ_DETAIL
+	                                 , targets, num_targets
+	                                 #endif
+	                                );
+	const bool success = !context->hit_sink_failed;
+	context->hit_sink = NULL;
+	context->hit_sink_arg = NULL;
+	
+	if (safe_copy) {
+		dispose_linked_bp_copy (model, safe_copy,
+		                        "linked_bp_copy for safe_copy of found_list in search_seq_to_sink",
+		                        "safe_copy of found_list in search_seq_to_sink"
+		                        #ifndef NO_FULL_CHECKS
+		                        , "could not iterate over to free safe_copy of found_list in search_seq_to_sink"
+		                        #endif
+		                       );
+	}
+	
+	return success;
+}
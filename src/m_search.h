@@ -7,17 +7,149 @@
 #include "sequence.h"
 #include "limits.h"
 #include "m_model.h"
+#include "m_seq_bp.h"
 
 #define MAX_SEARCH_LIST_SIZE 15000
+#define MIN_CANDIDATE_BUFFER_SIZE 1024   // initial # of entries in the arrays of a search context's candidate buffer
+#define MIN_FILTER_MEMO_SIZE 64           // initial # of entries (and hash slots) in a search context's filter memo
+#define MAX_SEARCH_PARTITION_THREADS 8    // default cap on the worker threads (of all searches in a process) for partitioned models
+#define MAX_LARGE_SEARCH_MEM (1ULL << 30)  // tagged memory (bytes, across worker threads) that a large search may hold
+#define MAX_LARGE_SEARCH_TIME_S 900       // search time (seconds) after which a large search is abandoned
+#define LARGE_SEARCH_CHECK_STEPS 4096     // search steps (see search_seq_at) between checks of a large search's budget
+
+/*
+ * flat (structure-of-arrays) buffer of the candidate bp chains found while advancing
+ * a current_list over a paired element (see list_advance); each candidate is a
+ * 32-bit handle into bps, stack_lens and parent_idxs, where the latter index the
+ * flattened current_list (parents), such that linked_bps are only allocated once
+ * all candidates for the paired element are known
+ */
+typedef struct {
+	const nt_bp **bps;
+	nt_stack_size *stack_lens;
+	uint32_t *parent_idxs;
+	uint32_t *order, *merged_order;     // candidate handles in (updated) list order
+	uint32_t num_candidates, num_ordered, max_candidates;
+	ntp_linked_bp *parents, *roots;     // current_list and the advanced pair (root) of its linked_bps
+	uint32_t num_parents, max_parents;
+} nt_candidate_buffer, *ntp_candidate_buffer;
+
+/*
+ * memo of the filter_lists that a paired element is advanced with (see list_advance);
+ * these only depend on the element, its stack length and its preceding element, for
+ * the model partitioning of a search iteration, and not on the current_list being
+ * advanced, so they are resolved (and flattened) once per iteration rather than for
+ * every prefix that reaches the element
+ */
+typedef struct {
+	const nt_element *el, *prev_el;
+	nt_stack_size stack_len;
+	uint32_t first_filter, num_filters;  // into filter_bounds
+} nt_filter_memo_entry;
+
+typedef struct {
+	nt_filter_memo_entry *entries;
+	uint32_t num_entries, max_entries;
+	uint32_t *slots;                    // hash of entries (entry index + 1, or 0 if free)
+	uint32_t max_slots;
+	uint32_t *filter_bounds;            // first and end bp of each filter_list, by stack distance
+	uint32_t num_filter_bounds, max_filter_bounds;
+	const nt_bp **bps;                  // fp-ordered bps of all filter_lists
+	uint32_t num_bps, max_bps;
+} nt_filter_memo, *ntp_filter_memo;
+
+/*
+ * hit kept by search_seq, keyed on its FE; hit_num (the order in which hits were
+ * found) breaks FE ties in favour of earlier hits
+ */
+typedef struct {
+	float fe;
+	nt_hit_count hit_num;
+	ntp_linked_bp linked_bp;
+} nt_top_hit;
+
+/*
+ * hit sink (see search_seq_to_sink), invoked on the searching thread with each new
+ * hit once confirmed, along with the search time spent since the previous hit;
+ * returning false aborts the search
+ */
+typedef bool (*nt_hit_sink) (const nt_linked_bp *linked_bp, float elapsed_time,
+                             void *sink_arg);
+                             
+/*
+ * worker threads' own model copies and search contexts (see search_seq_in_parallel),
+ * kept for subsequent searches of the same model, as told apart by model_sig (see
+ * get_model_signature)
+ */
+typedef struct {
+	ushort num_workers;
+	ntp_model *models;
+	struct _nt_search_context **contexts;
+	ushort *model_sig;
+	uint32_t model_sig_len;
+} nt_search_workers, *ntp_search_workers;
+
+/*
+ * per-search state, such that searches can run concurrently within one process
+ */
+typedef struct _nt_search_context {
+	// once the number of hits exceeds MAX_HITS_RETURNED, the hits kept by search_seq
+	// form a max-heap on FE, such that the least favourable hit is evicted first; they
+	// are held by the heap alone until the end of the search (see flush_top_hits)
+	nt_top_hit top_hits[MAX_HITS_RETURNED];
+	nt_hit_count num_top_hits, num_hits_found;
+	ntp_element wrapper_constraint_elements[MAX_CONSTRAINT_MATCHES];
+	ushort last_wrapper_constraint_track_id;
+	// lists initialized in the current search iteration, for eventual destruction
+	ntp_list search_seq_list;
+	nt_candidate_buffer candidates;
+	// model compiled for the partitioning of the current search iteration
+	nt_model_plan plan;
+	nt_filter_memo filter_memo;
+	nt_timer timer;
+	// when set, hits are streamed to hit_sink rather than kept in a max-heap
+	nt_hit_sink hit_sink;
+	void *hit_sink_arg;
+	float last_hit_time;
+	bool hit_sink_failed;
+	// when set, current_lists that exceed MAX_SEARCH_LIST_SIZE are searched in batches,
+	// and models that exceed MAX_MODEL_SIZE once partitioned are searched regardless,
+	// rather than abandoning such searches without hits; such searches are only
+	// abandoned once they exceed large_search_mem (tagged memory of the searching
+	// thread, beyond large_search_mem_base held when the search started) or
+	// MAX_LARGE_SEARCH_TIME_S
+	bool large_search;
+	size_t large_search_mem, large_search_mem_base;
+	// search steps taken, and whether the budget was found to be exceeded, such that
+	// a large search is abandoned within a search iteration
+	unsigned long large_search_steps;
+	bool large_search_abandoned;
+	// seq_bp of the current search, pinned in the seq_bp cache while it (or its hits) are in use
+	nt_seq_bp_cache_pin seq_bp_pin;
+	nt_search_workers workers;
+} nt_search_context, *ntp_search_context;
+
+ntp_search_context create_search_context();
+void destroy_search_context (ntp_search_context context);
+
+void set_max_search_threads (ushort max_threads);
 
 /*
  * sequence search
  */
-ntp_list search_seq (ntp_seq restrict seq, nt_model *restrict model,
+ntp_list search_seq (ntp_search_context restrict context,
+                     ntp_seq restrict seq, nt_model *restrict model,
                      float *elapsed_time
 #ifdef SEARCH_SEQ_DETAIL
 	, ntp_bp targets, nt_hit_count num_targets
 #endif
                     );
+bool search_seq_to_sink (ntp_search_context restrict context,
+                         ntp_seq restrict seq, nt_model *restrict model,
+                         nt_hit_sink hit_sink, void *hit_sink_arg, float *elapsed_time
+#ifdef SEARCH_SEQ_DETAIL
+	, ntp_bp targets, nt_hit_count num_targets
+#endif
+                        );
 
 #endif //RNA_MODEL_H
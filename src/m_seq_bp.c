@@ -3,15 +3,24 @@
 	#include <afxres.h>
 #else
 	#include <memory.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
 #endif
 
 #include <stdio.h>
 #include <limits.h>
+#include <stddef.h>
 #include <unistd.h>
 #include <math.h>
+#include <errno.h>
+#include <pthread.h>
 #include "util.h"
+#include "crc32.h"
 #include "interface.h"
 #include "mfe.h"
+#include "m_analyse.h"
+#include "m_build.h"
 #include "m_seq_bp.h"
 
 #define MAX_CONTAINMENT_ELEMENTS 10
@@ -37,392 +46,2049 @@
 /*
  * data structures
  */
-typedef struct {
-	ntp_list seq_list;
+typedef struct _nt_seq_bp_cache_entry *ntp_seq_bp_cache_entry;
+typedef struct _nt_seq_bp_cache_entry {
+	ntp_seq_bp seq_bp;
 	nt_seq_hash seq_hash;
-} nt_seq_bp_cache_entry, *ntp_seq_bp_cache_entry;
+	nt_abs_seq_len seq_len;
+	nt_seq_bp_cache_id id;
+	// estimated number of bytes taken by seq_bp (see get_seq_bp_size)
+	size_t num_bytes;
+	// number of searches that pinned seq_bp; pinned entries are never evicted
+	nt_seq_count num_pins;
+	// neighbouring entries in LRU order, from most to least recently used
+	ntp_seq_bp_cache_entry lru_prev, lru_next;
+} nt_seq_bp_cache_entry;
+
+/*
+ * model-independent bp stack index of a sequence: the (0-indexed) 5' posns of all
+ * valid stacks of a given stack length, stack distance and in/extrusion, which are
+ * found once per key (see get_seq_bp_index_posns) and then shared by the seq_bps of
+ * all models that are searched against the sequence (see get_seq_bp_from_seq)
+ *
+ * stacks are found bit-parallel: the sequence is held as one occurrence mask (bit i
+ * set if nt i is the given nt) per nt, and these give, for each pair distance d, a
+ * pair mask of the posns i whose nt pairs with nt i+d; a stack's mask is then the AND
+ * of the (shifted) pair masks of its bps, 64 candidate posns per word; pair masks
+ * are only held while the index is in use, and at most SEQ_BP_INDEX_PAIR_MASK_BUDGET
+ * bytes of them at a time, as kept indexes only need their posns
+ */
+typedef struct {
+	nt_stack_size stack_len;
+	nt_stack_idist stack_idist;
+	short in_extrusion;
+	uint32_t first_posn, num_posns;     // range of posns of the key
+} nt_seq_bp_index_key;
+
+typedef struct {
+	char *sequence;
+	nt_rel_seq_len seq_len;
+	uint32_t num_words;                 // # of 64-bit words per mask
+	uint64_t *nt_masks;                 // a, c, g and u occurrence masks
+	uint64_t **pair_masks;              // by pair distance, on first use (see get_seq_bp_pair_mask)
+	size_t pair_mask_bytes;
+	nt_seq_bp_index_key *keys;
+	uint32_t num_keys, max_keys;
+	uint32_t *slots;                    // hash of keys (key index + 1, or 0 if free)
+	uint32_t max_slots;
+	nt_rel_seq_posn *posns;
+	uint32_t num_posns, max_posns;
+	// number of searches using the index, and when it was last acquired
+	nt_seq_count num_users;
+	unsigned long long last_use;
+	// held by the search using the index (see get_seq_bp_index)
+	pthread_mutex_t mutex;
+} nt_seq_bp_index, *ntp_seq_bp_index;
+
+/*
+ * node-local shared seq_bp store: a shared memory region, mapped by all (scan worker)
+ * processes of a node, that holds the optimized seq_bps built by any of them; seq_bps
+ * are keyed on their sequence and a signature of their model (see get_model_signature),
+ * and stored in a position-independent layout (counts rather than pointers, elements by
+ * their plan step), such that other processes can rebuild them without get_seq_bp_from_seq
+ *
+ * records are published lock-free: a record's space is reserved by atomically bumping
+ * next_free, the record is written in full, and then published by a compare-and-swap
+ * of a free hash slot to the record's offset (release); readers load slots (acquire),
+ * and never see a record before it is complete. Published records are immutable and
+ * never evicted; instead, a store that is full (or stale, see SEQ_BP_SHM_MAGIC) is
+ * unlinked, and replaced by a new one (see renew_seq_bp_shm_store), while processes
+ * that still map the old store keep reading it until they renew theirs in turn
+ *
+ * within a process, searches read and publish under a read lock on the mapped store,
+ * and the store is only (re)mapped or unmapped under the write lock
+ */
+typedef struct {
+	uint64_t magic;                     // see get_seq_bp_shm_magic, once initialized (set last)
+	uint64_t size;                      // # of bytes of the store
+	uint64_t next_free;                 // offset of the next record
+	uint32_t num_slots;
+	uint32_t layout;                    // see SEQ_BP_SHM_LAYOUT
+	uint64_t num_mapped;                // # of processes that map the store
+	uint64_t slots[];                   // record offsets (0 if free), hashed on record key
+} nt_seq_bp_shm_header, *ntp_seq_bp_shm_header;
+
+/*
+ * record, followed by (each 8-byte aligned) the model signature, the sequence, and
+ * the stacks, bp lists and bps of the seq_bp, in their original order
+ */
+typedef struct {
+	uint64_t seq_hash, model_hash;
+	uint32_t seq_len, model_sig_len;
+	uint32_t num_stacks[MAX_STACK_LEN];
+	uint32_t num_lists, num_bps;
+} nt_seq_bp_shm_record, *ntp_seq_bp_shm_record;
+
+typedef struct {
+	uint32_t num_lists;
+	nt_stack_idist stack_idist;
+	short in_extrusion;
+} nt_seq_bp_shm_stack;
+
+typedef struct {
+	uint32_t num_bps;
+	nt_hit_count stack_counts;
+	ushort el_step;
+} nt_seq_bp_shm_list;
 
+#define SEQ_BP_SHM_MAGIC              0x5352485300000000LLU // "SRHS", followed by a layout id
+// version of the format of records, and of how the seq_bps they hold are built and
+// optimized; to be bumped on any such change, so as not to share stores across it
+#define SEQ_BP_SHM_VERSION            1
+#define SEQ_BP_SHM_LAYOUT             ((uint32_t) (MAX_STACK_LEN << 24 | sizeof (nt_bp) << 16 | \
+                                       sizeof (nt_seq_bp_shm_stack) << 8 | sizeof (nt_seq_bp_shm_list)))
+#define SEQ_BP_SHM_WAIT_MS            10    // interval and number of attempts to wait for a
+#define SEQ_BP_SHM_WAIT_ATTEMPTS      500   // store being initialized by another process
+#define SEQ_BP_SHM_MIN_SLOTS          64
+                                       
+#define SEQ_BP_INDEX_MASK_WORD(posn)  ((posn) >> 6)
+#define SEQ_BP_INDEX_MASK_BIT(posn)   (1LLU << ((posn) & 63))
+                                       
 /*
  * globals
  */
-static ntp_list seq_bp_cache = NULL;
+// open-addressing hash (linear probing) of cache entries, keyed on seq hash and length,
+// where the seq_bps of other models (or colliding seqs) for a key occupy further probes;
+// NULL while the cache is not initialized
+static ntp_seq_bp_cache_entry *seq_bp_cache = NULL;
+static nt_seq_count seq_bp_cache_max_slots = 0;
+static ntp_seq_bp_cache_entry seq_bp_cache_lru_head = NULL,
+                              seq_bp_cache_lru_tail = NULL;
+static nt_seq_bp_cache_id seq_bp_cache_next_id = 1;
+static size_t seq_bp_cache_budget = SEQ_BP_CACHE_BUDGET;
+static nt_seq_bp_cache_stats seq_bp_cache_stats;
+// serializes cache operations of concurrently running searches
+static pthread_mutex_t seq_bp_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+// node-local shared seq_bp store (see initialize_seq_bp_shm_store); NULL unless mapped
+static ntp_seq_bp_shm_header seq_bp_shm = NULL;
+// name and size of the mapped store, and the inode it was mapped from, which tells
+// whether the store has since been replaced under its name
+static char seq_bp_shm_name[SEQ_BP_SHM_MAX_NAME_LEN + 1];
+static size_t seq_bp_shm_size = 0;
+static ino_t seq_bp_shm_ino = 0;
+// # of times a store was mapped, which tells whether a full store was renewed already
+static unsigned long long seq_bp_shm_generation = 0;
+// guards the globals of the mapped store, and the store while mapped
+static pthread_rwlock_t seq_bp_shm_rwlock = PTHREAD_RWLOCK_INITIALIZER;
+static unsigned long long seq_bp_shm_hits = 0, seq_bp_shm_publishes = 0;
+// bp stack indexes of the most recently searched seqs (NULL if free), which outlive
+// the seq_bps of any one model; guarded by seq_bp_cache_mutex
+static ntp_seq_bp_index seq_bp_indexes[SEQ_BP_INDEX_CACHE_SIZE];
+static unsigned long long seq_bp_index_clock = 0;
 
 /*
  * cache operations
  */
-static inline int seq_hash_seeker (const void *restrict el,
-                                   const void *restrict key) {
-	const nt_seq_hash entry = ((ntp_seq_bp_cache_entry)el)->seq_hash;
+static inline nt_seq_count get_seq_bp_cache_slot (const nt_seq_hash seq_hash,
+                                        const nt_abs_seq_len seq_len) {
+	return (nt_seq_count) ((((uint64_t) seq_hash * 31 + seq_len) *
+	                        0x9E3779B97F4A7C15LLU) >> 32) & (seq_bp_cache_max_slots - 1);
+}
+
+/*
+ * private function to estimate the number of bytes allocated for seq_bp, including its
+ * sequence, stacks and bp lists (along with their list entries)
+ */
+static size_t get_seq_bp_size (ntp_seq_bp restrict seq_bp) {
+	REGISTER
+	size_t num_bytes = sizeof (nt_seq_bp) + strlen (seq_bp->sequence) + 1;
 	
-	if (entry == * (nt_seq_hash *)key) {
-		return 1;
+	for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+		list_iterator_start (&seq_bp->stacks[i]);
+		
+		while (list_iterator_hasnext (&seq_bp->stacks[i])) {
+			REGISTER
+			ntp_stack this_stack = list_iterator_next (&seq_bp->stacks[i]);
+			num_bytes += sizeof (nt_stack) + sizeof (struct list_entry_s);
+			
+			for (REGISTER ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+			     this_list_by_element; this_list_by_element = this_list_by_element->next) {
+				num_bytes += sizeof (nt_bp_list_by_element) + this_list_by_element->list.numels *
+				             (sizeof (nt_bp) + sizeof (struct list_entry_s));
+			}
+		}
+		
+		list_iterator_stop (&seq_bp->stacks[i]);
 	}
 	
-	return 0;
+	return num_bytes;
 }
 
-bool initialize_seq_bp_cache() {
-	COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-	              "initializing seq_bp_cache in initialize_seq_bp_cache", true);
-	// destroy a pre-existing seq bp cache
-	finalize_seq_bp_cache();
-	#ifdef MULTITHREADED_ON
+static inline void unlink_seq_bp_cache_entry (ntp_seq_bp_cache_entry restrict
+                                        entry) {
+	if (entry->lru_prev) {
+		entry->lru_prev->lru_next = entry->lru_next;
+	}
 	
-	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
-	#endif
-		seq_bp_cache = (ntp_list) MALLOC_DEBUG (sizeof (nt_list),
-		                                        "seq_bp_cache in initialize_seq_bp_cache");
-		                                        
+	else {
+		seq_bp_cache_lru_head = entry->lru_next;
+	}
+	
+	if (entry->lru_next) {
+		entry->lru_next->lru_prev = entry->lru_prev;
+	}
+	
+	else {
+		seq_bp_cache_lru_tail = entry->lru_prev;
+	}
+	
+	entry->lru_prev = NULL;
+	entry->lru_next = NULL;
+}
+
+/*
+ * private function to mark entry as the most recently used one and to pin its seq_bp
+ * (see release_seq_bp_cache_pin)
+ */
+static inline void pin_seq_bp_cache_entry (ntp_seq_bp_cache_entry restrict
+                                        entry, ntp_seq_bp_cache_pin restrict pin) {
+	if (seq_bp_cache_lru_head != entry) {
+		unlink_seq_bp_cache_entry (entry);
+		entry->lru_next = seq_bp_cache_lru_head;
+		
+		if (seq_bp_cache_lru_head) {
+			seq_bp_cache_lru_head->lru_prev = entry;
+		}
+		
+		else {
+			seq_bp_cache_lru_tail = entry;
+		}
+		
+		seq_bp_cache_lru_head = entry;
+	}
+	
+	entry->num_pins++;
+	pin->seq_hash = entry->seq_hash;
+	pin->seq_len = entry->seq_len;
+	pin->id = entry->id;
+}
+
+/*
+ * private function to place entry in the first free slot of its probe sequence
+ */
+static inline void insert_seq_bp_cache_entry (ntp_seq_bp_cache_entry restrict
+                                        entry) {
+	REGISTER
+	nt_seq_count slot = get_seq_bp_cache_slot (entry->seq_hash, entry->seq_len);
+	
+	while (seq_bp_cache[slot]) {
+		slot = (slot + 1) & (seq_bp_cache_max_slots - 1);
+	}
+	
+	seq_bp_cache[slot] = entry;
+}
+
+/*
+ * private function to double the number of hash slots, keeping at least twice as
+ * many slots as entries
+ */
+static bool rehash_seq_bp_cache() {
+	REGISTER
+	ntp_seq_bp_cache_entry *old_slots = seq_bp_cache;
+	const REGISTER
+	nt_seq_count old_max_slots = seq_bp_cache_max_slots;
+	REGISTER
+	ntp_seq_bp_cache_entry *new_slots = MALLOC_DEBUG (sizeof (ntp_seq_bp_cache_entry) *
+	                                        old_max_slots * 2, "slots of seq_bp_cache in rehash_seq_bp_cache");
+	                                        
+	if (!new_slots) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not allocate memory for slots of seq_bp_cache in rehash_seq_bp_cache",
+		              false);
+		return false;
+	}
+	
+	memset (new_slots, 0, sizeof (ntp_seq_bp_cache_entry) * old_max_slots * 2);
+	seq_bp_cache = new_slots;
+	seq_bp_cache_max_slots = old_max_slots * 2;
+	
+	for (REGISTER nt_seq_count i = 0; i < old_max_slots; i++) {
+		if (old_slots[i]) {
+			insert_seq_bp_cache_entry (old_slots[i]);
+		}
+	}
+	
+	FREE_DEBUG (old_slots, "slots of seq_bp_cache in rehash_seq_bp_cache");
+	return true;
+}
+
+/*
+ * private function to remove the entry at slot from the cache, destroying its seq_bp;
+ * subsequent entries of the probe sequence are shifted back into the vacated slot,
+ * such that lookups need not skip deleted slots
+ */
+static void remove_seq_bp_cache_slot (nt_seq_count slot) {
+	REGISTER
+	ntp_seq_bp_cache_entry entry = seq_bp_cache[slot];
+	const REGISTER
+	nt_seq_count mask = seq_bp_cache_max_slots - 1;
+	unlink_seq_bp_cache_entry (entry);
+	seq_bp_cache_stats.num_entries--;
+	seq_bp_cache_stats.num_bytes -= entry->num_bytes;
+	destroy_seq_bp (entry->seq_bp);
+	FREE_DEBUG (entry, "entry of seq_bp_cache in remove_seq_bp_cache_slot");
+	seq_bp_cache[slot] = NULL;
+	
+	for (REGISTER nt_seq_count next_slot = (slot + 1) & mask; seq_bp_cache[next_slot];
+	     next_slot = (next_slot + 1) & mask) {
+		const REGISTER
+		nt_seq_count home_slot = get_seq_bp_cache_slot (seq_bp_cache[next_slot]->seq_hash,
+		                         seq_bp_cache[next_slot]->seq_len);
+		                         
+		// shift back unless the entry's home slot lies in between slot and next_slot
+		if (((next_slot - home_slot) & mask) >= ((next_slot - slot) & mask)) {
+			seq_bp_cache[slot] = seq_bp_cache[next_slot];
+			seq_bp_cache[next_slot] = NULL;
+			slot = next_slot;
+		}
+	}
+}
+
+/*
+ * private function to evict the least recently used entries, other than pinned ones,
+ * until the cache fits its memory budget
+ */
+static void evict_seq_bp_cache_entries() {
+	REGISTER
+	ntp_seq_bp_cache_entry entry = seq_bp_cache_lru_tail;
+	
+	while (entry && seq_bp_cache_stats.num_bytes > seq_bp_cache_budget) {
+		REGISTER
+		ntp_seq_bp_cache_entry prev_entry = entry->lru_prev;
+		
+		if (!entry->num_pins) {
+			REGISTER
+			nt_seq_count slot = get_seq_bp_cache_slot (entry->seq_hash, entry->seq_len);
+			
+			while (seq_bp_cache[slot] != entry) {
+				slot = (slot + 1) & (seq_bp_cache_max_slots - 1);
+			}
+			
+			COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
+			               "evicting seq_bp of seq (hash %lu) in evict_seq_bp_cache_entries",
+			               entry->seq_hash, false);
+			remove_seq_bp_cache_slot (slot);
+			seq_bp_cache_stats.num_evictions++;
+		}
+		
+		entry = prev_entry;
+	}
+}
+
+/*
+ * bp stack index operations
+ */
+static inline uint32_t get_seq_bp_index_slot (const nt_seq_bp_index *restrict index,
+                                        const nt_stack_size stack_len, const nt_stack_idist stack_idist,
+                                        const short in_extrusion) {
+	return (uint32_t) (((((uint64_t) stack_len * 31 + stack_idist) * 31 + (ushort)
+	                     in_extrusion) * 0x9E3779B97F4A7C15LLU) >> 32) & (index->max_slots - 1);
+}
+
+/*
+ * private function to grow (double) one of the arrays of a bp stack index
+ */
+static bool grow_seq_bp_index_array (void **array, uint32_t *restrict max_entries,
+                                     const size_t entry_size, const uint32_t min_entries) {
+	REGISTER
+	uint32_t new_max_entries = *max_entries ? *max_entries * 2 : min_entries;
+	void *new_array = realloc (*array, entry_size * new_max_entries);
+	
+	if (!new_array) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not grow seq_bp_index in grow_seq_bp_index_array", false);
+		return false;
+	}
+	
+	*array = new_array;
+	*max_entries = new_max_entries;
+	return true;
+}
+
+/*
+ * private function to free the pair masks of an index, which are recomputed on demand
+ */
+static void free_seq_bp_pair_masks (ntp_seq_bp_index restrict index) {
+	if (index->pair_masks) {
+		for (REGISTER nt_rel_seq_len d = 0; d < index->seq_len; d++) {
+			free (index->pair_masks[d]);
+		}
+		
+		free (index->pair_masks);
+		index->pair_masks = NULL;
+	}
+	
+	index->pair_mask_bytes = 0;
+}
+
+static void destroy_seq_bp_index (ntp_seq_bp_index restrict index) {
+	pthread_mutex_destroy (&index->mutex);
+	free_seq_bp_pair_masks (index);
+	free (index->nt_masks);
+	free (index->keys);
+	free (index->slots);
+	free (index->posns);
+	FREE_DEBUG (index->sequence, "seq of seq_bp_index in destroy_seq_bp_index");
+	FREE_DEBUG (index, "seq_bp_index in destroy_seq_bp_index");
+}
+
+static ntp_seq_bp_index create_seq_bp_index (const ntp_seq restrict seq,
+                                        const nt_rel_seq_len seq_len) {
+	REGISTER
+	ntp_seq_bp_index index = MALLOC_DEBUG (sizeof (nt_seq_bp_index),
+	                                       "seq_bp_index in create_seq_bp_index");
+	                                       
+	if (!index) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not allocate memory for seq_bp_index in create_seq_bp_index", false);
+		return NULL;
+	}
+	
+	memset (index, 0, sizeof (nt_seq_bp_index));
+	index->sequence = MALLOC_DEBUG ((size_t) (sizeof (char) * (seq_len + 1)),
+	                                "seq of seq_bp_index in create_seq_bp_index");
+	                                
+	index->num_words = SEQ_BP_INDEX_MASK_WORD (seq_len - 1) + 1;
+	index->nt_masks = calloc (4 * index->num_words, sizeof (uint64_t));
+	
+	if (!index->sequence || !index->nt_masks ||
+	    pthread_mutex_init (&index->mutex, NULL)) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not initialize seq_bp_index in create_seq_bp_index", false);
+		              
+		if (index->sequence) {
+			FREE_DEBUG (index->sequence, "seq of seq_bp_index in create_seq_bp_index");
+		}
+		
+		free (index->nt_masks);
+		FREE_DEBUG (index, "seq_bp_index in create_seq_bp_index");
+		return NULL;
+	}
+	
+	strcpy (index->sequence, seq);
+	index->seq_len = seq_len;
+	
+	const char *nts = "acgu";
+	
+	for (REGISTER nt_rel_seq_len i = 0; i < seq_len; i++) {
+		REGISTER
+		const char *this_nt = strchr (nts, seq[i]);
+		
+		// nts other than a, c, g and u (and '\0') never pair
+		if (this_nt && *this_nt) {
+			index->nt_masks[(this_nt - nts) * index->num_words + SEQ_BP_INDEX_MASK_WORD (i)] |=
+			                SEQ_BP_INDEX_MASK_BIT (i);
+		}
+	}
+	
+	return index;
+}
+
+/*
+ * private function to drop a search's use of index; indexes that are not (or no
+ * longer) kept in seq_bp_indexes are destroyed once no search uses them
+ */
+static void unuse_seq_bp_index (ntp_seq_bp_index restrict index) {
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
+		REGISTER
+		bool is_kept = false;
+		
+		for (REGISTER uchar i = 0; i < SEQ_BP_INDEX_CACHE_SIZE; i++) {
+			if (seq_bp_indexes[i] == index) {
+				is_kept = true;
+				break;
+			}
+		}
+		
+		if (! (--index->num_users) && !is_kept) {
+			destroy_seq_bp_index (index);
+		}
+		
+		pthread_mutex_unlock (&seq_bp_cache_mutex);
+	}
+}
+
+/*
+ * private function to acquire the bp stack index of seq, creating it if need be; the
+ * index is returned locked, and is to be released using release_seq_bp_index
+ *
+ * while the seq_bp cache is initialized, the indexes of the SEQ_BP_INDEX_CACHE_SIZE most
+ * recently searched seqs are kept (regardless of model), otherwise indexes are private
+ */
+static ntp_seq_bp_index get_seq_bp_index (const ntp_seq restrict seq,
+                                        const nt_rel_seq_len seq_len) {
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) != 0) {
+		return NULL;
+	}
+	
+	REGISTER
+	ntp_seq_bp_index index = NULL;
+	
+	if (seq_bp_cache) {
+		for (REGISTER uchar i = 0; i < SEQ_BP_INDEX_CACHE_SIZE; i++) {
+			if (seq_bp_indexes[i] && seq_bp_indexes[i]->seq_len == seq_len &&
+			    !strcmp (seq_bp_indexes[i]->sequence, seq)) {
+				index = seq_bp_indexes[i];
+				break;
+			}
+		}
+	}
+	
+	if (!index) {
+		index = create_seq_bp_index (seq, seq_len);
+		
+		if (!index) {
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
+			return NULL;
+		}
+		
 		if (seq_bp_cache) {
-			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-			              "memory allocated for seq_bp_cache in initialize_seq_bp_cache", false);
-			              
-			if ((list_init (seq_bp_cache) < 0) ||
-			    (list_attributes_seeker (seq_bp_cache, &seq_hash_seeker) < 0)) {
-				#ifdef MULTITHREADED_ON
-				pthread_mutex_unlock (&num_destruction_threads_mutex);
-				#endif
-				COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-				              "failed to initialize seq_bp_cache/set attribute seeker in initialize_seq_bp_cache",
-				              false);
-				FREE_DEBUG (seq_bp_cache,
-				            "seq_bp_cache in initialize_seq_bp_cache [failed to initialize seq_bp_cache/set attribute seeker]");
-				return false;
+			// take a free slot, or else that of the least recently used index not in use
+			REGISTER
+			short slot = -1;
+			
+			for (REGISTER uchar i = 0; i < SEQ_BP_INDEX_CACHE_SIZE; i++) {
+				if (!seq_bp_indexes[i]) {
+					slot = i;
+					break;
+				}
+				
+				if (!seq_bp_indexes[i]->num_users &&
+				    (slot < 0 || seq_bp_indexes[i]->last_use < seq_bp_indexes[slot]->last_use)) {
+					slot = i;
+				}
 			}
 			
-			#ifdef MULTITHREADED_ON
-			pthread_mutex_unlock (&num_destruction_threads_mutex);
-			#endif
-			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-			              "seq_bp_cache initialized and attribute seeker set in initialize_seq_bp_cache",
+			if (slot >= 0) {
+				if (seq_bp_indexes[slot]) {
+					destroy_seq_bp_index (seq_bp_indexes[slot]);
+				}
+				
+				seq_bp_indexes[slot] = index;
+			}
+		}
+	}
+	
+	index->num_users++;
+	index->last_use = ++seq_bp_index_clock;
+	pthread_mutex_unlock (&seq_bp_cache_mutex);
+	
+	if (pthread_mutex_lock (&index->mutex) != 0) {
+		unuse_seq_bp_index (index);
+		return NULL;
+	}
+	
+	return index;
+}
+
+static void release_seq_bp_index (ntp_seq_bp_index restrict index) {
+	free_seq_bp_pair_masks (index);
+	pthread_mutex_unlock (&index->mutex);
+	unuse_seq_bp_index (index);
+}
+
+/*
+ * private function to get word w of a mask shifted by shift posns, such that bit i
+ * of the shifted mask is bit i+shift of mask; bits outside of mask are 0
+ */
+static inline uint64_t get_seq_bp_mask_word (const uint64_t *restrict mask,
+                                        const int32_t num_words, const int32_t w, const int32_t shift) {
+	const REGISTER
+	int32_t first_bit = w * 64 + shift,
+	        first_word = first_bit >= 0 ? first_bit / 64 : - ((63 - first_bit) / 64);
+	const REGISTER
+	uint32_t offset = (uint32_t) (first_bit - first_word * 64);
+	const REGISTER
+	uint64_t lo_word = first_word >= 0 && first_word < num_words ? mask[first_word] : 0;
+	
+	if (!offset) {
+		return lo_word;
+	}
+	
+	const REGISTER
+	uint64_t hi_word = first_word + 1 >= 0 && first_word + 1 < num_words ? mask[first_word + 1] : 0;
+	return (lo_word >> offset) | (hi_word << (64 - offset));
+}
+
+/*
+ * private function to get the pair mask of an index for a given pair distance, that
+ * is, the posns i of the sequence whose nt pairs (canonical or wobble) with nt i+d;
+ * the mask remains valid until the next call (that may free it to stay within
+ * SEQ_BP_INDEX_PAIR_MASK_BUDGET), or until the index is released
+ */
+static const uint64_t *get_seq_bp_pair_mask (ntp_seq_bp_index restrict index,
+                                        const int32_t d) {
+	if (d < 1 || d >= index->seq_len) {
+		return NULL;
+	}
+	
+	if (index->pair_masks && index->pair_masks[d]) {
+		return index->pair_masks[d];
+	}
+	
+	const size_t num_bytes = sizeof (uint64_t) * index->num_words;
+	
+	if (index->pair_mask_bytes + num_bytes > SEQ_BP_INDEX_PAIR_MASK_BUDGET) {
+		free_seq_bp_pair_masks (index);
+	}
+	
+	if (!index->pair_masks) {
+		index->pair_masks = calloc (index->seq_len, sizeof (uint64_t *));
+		
+		if (!index->pair_masks) {
+			COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+			              "could not allocate memory for pair masks of seq_bp_index in get_seq_bp_pair_mask",
 			              false);
-			return true;
+			return NULL;
+		}
+	}
+	
+	REGISTER
+	uint64_t *pair_mask = malloc (num_bytes);
+	
+	if (!pair_mask) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not allocate memory for pair mask of seq_bp_index in get_seq_bp_pair_mask",
+		              false);
+		return NULL;
+	}
+	
+	const REGISTER
+	int32_t num_words = (int32_t) index->num_words;
+	const REGISTER
+	uint64_t *a_mask = index->nt_masks, *c_mask = a_mask + num_words,
+	          *g_mask = c_mask + num_words, *u_mask = g_mask + num_words;
+	          
+	for (REGISTER int32_t w = 0; w < num_words; w++) {
+		const REGISTER
+		uint64_t a_d = get_seq_bp_mask_word (a_mask, num_words, w, d),
+		         c_d = get_seq_bp_mask_word (c_mask, num_words, w, d),
+		         g_d = get_seq_bp_mask_word (g_mask, num_words, w, d),
+		         u_d = get_seq_bp_mask_word (u_mask, num_words, w, d);
+		pair_mask[w] = (g_mask[w] & (c_d | u_d)) | (a_mask[w] & u_d) |
+		               (c_mask[w] & g_d) | (u_mask[w] & (g_d | a_d));
+	}
+	
+	index->pair_masks[d] = pair_mask;
+	index->pair_mask_bytes += num_bytes;
+	return pair_mask;
+}
+
+/*
+ * private function to add a posn to an index
+ */
+static inline bool add_seq_bp_index_posn (ntp_seq_bp_index restrict index,
+                                        const nt_rel_seq_posn posn) {
+	if (index->num_posns == index->max_posns &&
+	    !grow_seq_bp_index_array ((void **) &index->posns, &index->max_posns,
+	                              sizeof (nt_rel_seq_posn), 256)) {
+		return false;
+	}
+	
+	index->posns[index->num_posns++] = posn;
+	return true;
+}
+
+/*
+ * private function to get the (0-indexed) 5' posns of all valid stacks for a given
+ * stack length, stack distance and in/extrusion in the sequence of a (locked) index,
+ * where posns are found on first use of the key; posns remain valid until the next call
+ */
+static bool get_seq_bp_index_posns (ntp_seq_bp_index restrict index,
+                                    const nt_stack_size stack_len, const nt_stack_idist stack_idist,
+                                    const short in_extrusion, nt_rel_seq_posn **posns, uint32_t *num_posns) {
+	REGISTER
+	uint32_t slot = 0;
+	
+	if (index->max_slots) {
+		slot = get_seq_bp_index_slot (index, stack_len, stack_idist, in_extrusion);
+		
+		while (index->slots[slot]) {
+			REGISTER
+			nt_seq_bp_index_key *key = &index->keys[index->slots[slot] - 1];
+			
+			if (key->stack_len == stack_len && key->stack_idist == stack_idist &&
+			    key->in_extrusion == in_extrusion) {
+				*posns = &index->posns[key->first_posn];
+				*num_posns = key->num_posns;
+				return true;
+			}
+			
+			slot = (slot + 1) & (index->max_slots - 1);
+		}
+	}
+	
+	// keep at least twice as many slots as keys
+	if ((index->num_keys + 1) * 2 > index->max_slots) {
+		REGISTER
+		uint32_t new_max_slots = index->max_slots ? index->max_slots * 2 : 64;
+		REGISTER
+		uint32_t *new_slots = calloc (new_max_slots, sizeof (uint32_t));
+		
+		if (!new_slots) {
+			COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+			              "could not grow slots of seq_bp_index in get_seq_bp_index_posns", false);
+			return false;
+		}
+		
+		free (index->slots);
+		index->slots = new_slots;
+		index->max_slots = new_max_slots;
+		
+		for (REGISTER uint32_t i = 0; i < index->num_keys; i++) {
+			slot = get_seq_bp_index_slot (index, index->keys[i].stack_len,
+			                              index->keys[i].stack_idist, index->keys[i].in_extrusion);
+			                              
+			while (index->slots[slot]) {
+				slot = (slot + 1) & (index->max_slots - 1);
+			}
+			
+			index->slots[slot] = i + 1;
+		}
+		
+		slot = get_seq_bp_index_slot (index, stack_len, stack_idist, in_extrusion);
+		
+		while (index->slots[slot]) {
+			slot = (slot + 1) & (index->max_slots - 1);
+		}
+	}
+	
+	if (index->num_keys == index->max_keys &&
+	    !grow_seq_bp_index_array ((void **) &index->keys, &index->max_keys,
+	                              sizeof (nt_seq_bp_index_key), 64)) {
+		return false;
+	}
+	
+	const REGISTER
+	nt_rel_seq_len seq_len = index->seq_len;
+	REGISTER
+	nt_seq_bp_index_key *key = &index->keys[index->num_keys];
+	key->stack_len = stack_len;
+	key->stack_idist = stack_idist;
+	key->in_extrusion = in_extrusion;
+	key->first_posn = index->num_posns;
+	
+	/*
+	 * if in_extrusion != 0 (+ve => intrusion, -ve => extrusion) make sure seq_len covers respective 5' and 3' regions as well;
+	 * note that stack_idist *includes* any intruded nts
+	 */
+	if (seq_len + 1 > (stack_idist + ((stack_len + 1) * 2) +
+	                   (in_extrusion < 0 ? - (in_extrusion * 2) : 0))) {
+		const REGISTER
+		int32_t min_p = in_extrusion < 0 ? -in_extrusion : 0,
+		        max_p = seq_len + 1 - stack_idist - ((stack_len + 1) * 2) - min_p,  // exclusive
+		        // distance of the outermost bp (q-p), and range of bps relative to it;
+		        // add to r (intrude) when in_extrusion is +ve, subtract (extrude) when -ve
+		        pair_dist = stack_idist + ((stack_len + 1) * 2) - 1,
+		        min_r = in_extrusion < 0 ? in_extrusion : 0,
+		        max_r = stack_len + (in_extrusion < 0 ? 0 : in_extrusion);
+		        
+		for (REGISTER int32_t w = SEQ_BP_INDEX_MASK_WORD (min_p);
+		     w <= SEQ_BP_INDEX_MASK_WORD (max_p - 1); w++) {
+			REGISTER
+			uint64_t stack_mask = ~0LLU;
+			
+			for (REGISTER int32_t r = min_r; stack_mask && r <= max_r; r++) {
+				// bp of nts p+r and p+pair_dist-r, which cross over for bp_dist<0
+				const REGISTER
+				int32_t bp_dist = pair_dist - 2 * r;
+				
+				if (!bp_dist) {
+					stack_mask = 0;
+					break;
+				}
+				
+				const REGISTER
+				uint64_t *pair_mask = get_seq_bp_pair_mask (index, bp_dist > 0 ? bp_dist : -bp_dist);
+				
+				if (!pair_mask) {
+					index->num_posns = key->first_posn;
+					return false;
+				}
+				
+				stack_mask &= get_seq_bp_mask_word (pair_mask, (int32_t) index->num_words, w,
+				                                    bp_dist > 0 ? r : pair_dist - r);
+			}
+			
+			// only keep posns from min_p through to max_p-1
+			if (w == SEQ_BP_INDEX_MASK_WORD (min_p)) {
+				stack_mask &= ~ (SEQ_BP_INDEX_MASK_BIT (min_p) - 1);
+			}
+			
+			if (w == SEQ_BP_INDEX_MASK_WORD (max_p - 1)) {
+				stack_mask &= (SEQ_BP_INDEX_MASK_BIT (max_p - 1) << 1) - 1;
+			}
+			
+			while (stack_mask) {
+				if (!add_seq_bp_index_posn (index, (nt_rel_seq_posn) (w * 64 + __builtin_ctzll (
+				                                        stack_mask)))) {
+					index->num_posns = key->first_posn;
+					return false;
+				}
+				
+				stack_mask &= stack_mask - 1;
+			}
+		}
+	}
+	
+	key->num_posns = index->num_posns - key->first_posn;
+	index->slots[slot] = ++index->num_keys;
+	*posns = &index->posns[key->first_posn];
+	*num_posns = key->num_posns;
+	return true;
+}
+
+bool initialize_seq_bp_cache() {
+	COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
+	              "initializing seq_bp_cache in initialize_seq_bp_cache", true);
+	// destroy a pre-existing seq bp cache
+	finalize_seq_bp_cache();
+	
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
+		seq_bp_cache = MALLOC_DEBUG (sizeof (ntp_seq_bp_cache_entry) *
+		                             MIN_SEQ_BP_CACHE_SLOTS, "slots of seq_bp_cache in initialize_seq_bp_cache");
+		                             
+		if (seq_bp_cache) {
+			memset (seq_bp_cache, 0, sizeof (ntp_seq_bp_cache_entry) * MIN_SEQ_BP_CACHE_SLOTS);
+			memset (&seq_bp_cache_stats, 0, sizeof (nt_seq_bp_cache_stats));
+			seq_bp_cache_max_slots = MIN_SEQ_BP_CACHE_SLOTS;
+			seq_bp_cache_lru_head = NULL;
+			seq_bp_cache_lru_tail = NULL;
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
+			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
+			              "seq_bp_cache initialized in initialize_seq_bp_cache", false);
+			return true;
+		}
+		
+		else {
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
+			COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+			              "could not allocate memory for seq_bp_cache in initialize_seq_bp_cache", false);
+			return false;
+		}
+	}
+	
+	return false;
+}
+
+bool finalize_seq_bp_cache() {
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
+		if (seq_bp_cache) {
+			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
+			              "finalizing seq_bp_cache in finalize_seq_bp_cache", true);
+			COMMIT_DEBUG2 (REPORT_INFO, SEQ_BP_CACHE,
+			               "seq_bp_cache had %llu hits and %llu misses in finalize_seq_bp_cache",
+			               seq_bp_cache_stats.num_hits, seq_bp_cache_stats.num_misses, false);
+			COMMIT_DEBUG2 (REPORT_INFO, SEQ_BP_CACHE,
+			               "seq_bp_cache had %llu evictions and holds %u seq_bps in finalize_seq_bp_cache",
+			               seq_bp_cache_stats.num_evictions, seq_bp_cache_stats.num_entries, false);
+			               
+			for (REGISTER nt_seq_count i = 0; i < seq_bp_cache_max_slots; i++) {
+				if (seq_bp_cache[i]) {
+					destroy_seq_bp (seq_bp_cache[i]->seq_bp);
+					FREE_DEBUG (seq_bp_cache[i], "entry of seq_bp_cache in finalize_seq_bp_cache");
+				}
+			}
+			
+			FREE_DEBUG (seq_bp_cache, "slots of seq_bp_cache in finalize_seq_bp_cache");
+			
+			// indexes still in use are destroyed once released (see unuse_seq_bp_index)
+			for (REGISTER uchar i = 0; i < SEQ_BP_INDEX_CACHE_SIZE; i++) {
+				if (seq_bp_indexes[i]) {
+					if (!seq_bp_indexes[i]->num_users) {
+						destroy_seq_bp_index (seq_bp_indexes[i]);
+					}
+					
+					seq_bp_indexes[i] = NULL;
+				}
+			}
+			
+			seq_bp_cache = NULL;
+			seq_bp_cache_max_slots = 0;
+			seq_bp_cache_lru_head = NULL;
+			seq_bp_cache_lru_tail = NULL;
+			seq_bp_cache_stats.num_entries = 0;
+			seq_bp_cache_stats.num_bytes = 0;
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
+			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
+			              "seq_bp_cache finalized in finalize_seq_bp_cache", false);
+			return true;
+		}
+		
+		else {
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
+			return false;
+		}
+	}
+	
+	return false;
+}
+
+bool purge_seq_bp_cache_by_model (nt_model *restrict model) {
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
+		if (seq_bp_cache) {
+			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
+			              "purging seq_bp_cache in purge_seq_bp_cache_by_model", true);
+			REGISTER
+			nt_seq_count i = 0;
+			
+			while (i < seq_bp_cache_max_slots) {
+				// removal shifts a subsequent entry into slot i, so revisit it
+				if (seq_bp_cache[i] && seq_bp_cache[i]->seq_bp->model == model) {
+					remove_seq_bp_cache_slot (i);
+				}
+				
+				else {
+					i++;
+				}
+			}
+			
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
+			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
+			              "seq_bp_cache purged by model in purge_seq_bp_cache_by_model", false);
+			return true;
+		}
+		
+		else {
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
+			return false;
+		}
+	}
+	
+	return false;
+}
+
+/*
+ * set the memory budget (in bytes) of the seq_bp cache, evicting the least recently
+ * used seq_bps that are not pinned if the cache exceeds it
+ */
+bool set_seq_bp_cache_budget (const size_t budget) {
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
+		seq_bp_cache_budget = budget;
+		
+		if (seq_bp_cache) {
+			evict_seq_bp_cache_entries();
+		}
+		
+		pthread_mutex_unlock (&seq_bp_cache_mutex);
+		return true;
+	}
+	
+	return false;
+}
+
+/*
+ * get the hit/miss/eviction counters and memory use of the seq_bp cache, along
+ * with the seq_bps rebuilt from (and published to) the shared seq_bp store
+ *
+ * output:  false if the cache is not initialized; true otherwise
+ */
+bool get_seq_bp_cache_stats (ntp_seq_bp_cache_stats restrict stats) {
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
+		REGISTER
+		bool initialized = seq_bp_cache != NULL;
+		*stats = seq_bp_cache_stats;
+		stats->budget = seq_bp_cache_budget;
+		stats->num_shm_hits = __atomic_load_n (&seq_bp_shm_hits, __ATOMIC_RELAXED);
+		stats->num_shm_publishes = __atomic_load_n (&seq_bp_shm_publishes,
+		                           __ATOMIC_RELAXED);
+		pthread_mutex_unlock (&seq_bp_cache_mutex);
+		return initialized;
+	}
+	
+	return false;
+}
+
+/*
+ * release a seq_bp pinned by get_seq_bp_from_cache or add_seq_bp_to_cache, which
+ * (once no longer pinned) is accounted for anew and becomes subject to eviction;
+ * pins of seq_bps that have since been purged are ignored
+ */
+void release_seq_bp_cache_pin (ntp_seq_bp_cache_pin restrict pin) {
+	if (!pin->id) {
+		return;
+	}
+	
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
+		if (seq_bp_cache) {
+			REGISTER
+			nt_seq_count slot = get_seq_bp_cache_slot (pin->seq_hash, pin->seq_len);
+			
+			while (seq_bp_cache[slot]) {
+				REGISTER
+				ntp_seq_bp_cache_entry entry = seq_bp_cache[slot];
+				
+				if (entry->id == pin->id) {
+					if (entry->num_pins && !--entry->num_pins) {
+						// seq_bp may have been completed since cached (see get_seq_bp_from_seq)
+						REGISTER
+						size_t num_bytes = get_seq_bp_size (entry->seq_bp);
+						seq_bp_cache_stats.num_bytes += num_bytes - entry->num_bytes;
+						entry->num_bytes = num_bytes;
+						evict_seq_bp_cache_entries();
+					}
+					
+					break;
+				}
+				
+				slot = (slot + 1) & (seq_bp_cache_max_slots - 1);
+			}
+		}
+		
+		pthread_mutex_unlock (&seq_bp_cache_mutex);
+	}
+	
+	pin->id = 0;
+}
+
+ntp_bp_list_by_element create_seq_bp_stack_by_element (ntp_seq_bp restrict
+                                        seq_bp, const uchar idx,
+                                        nt_stack_idist  this_stack_idist, short this_in_extrusion,
+                                        ntp_element this_element) {
+	REGISTER
+	bool stack_already_exists = false, list_by_element_already_exists = false;
+	REGISTER
+	ntp_stack that_stack = NULL, existing_stack = NULL;
+	REGISTER
+	ntp_bp_list_by_element that_list_by_element = NULL;
+	
+	if (seq_bp->stacks[idx].numels) {
+		list_iterator_start (&seq_bp->stacks[idx]);
+		
+		while (list_iterator_hasnext (&seq_bp->stacks[idx])) {
+			that_stack = (ntp_stack)list_iterator_next (&seq_bp->stacks[idx]);
+			
+			if (that_stack->stack_idist == this_stack_idist &&
+			    that_stack->in_extrusion == this_in_extrusion) {
+				stack_already_exists = true;
+				existing_stack = that_stack;
+				that_list_by_element = that_stack->lists;
+				
+				while (that_list_by_element) {
+					if (that_list_by_element->el == this_element) {
+						list_by_element_already_exists = true;
+						break;
+					}
+					
+					that_list_by_element = that_list_by_element->next;
+				}
+				
+				if (list_by_element_already_exists) {
+					break;
+				}
+			}
+		}
+		
+		list_iterator_stop (&seq_bp->stacks[idx]);
+	}
+	
+	if (!list_by_element_already_exists) {
+		if (!stack_already_exists) {
+			that_stack = MALLOC_DEBUG (sizeof (nt_stack),
+			                           "stack of seq_bp in create_seq_bp_list");
+			                           
+			if (!that_stack || 0 > list_append (&seq_bp->stacks[idx], that_stack)) {
+				if (that_stack) {
+					FREE_DEBUG (that_stack,
+					            "stack of seq_bp in create_seq_bp_list [unable to append to seq_bp->stacks]");
+				}
+				
+				return NULL;
+			}
+			
+			that_stack->stack_idist = this_stack_idist;
+			that_stack->in_extrusion = this_in_extrusion;
+			that_stack->lists = NULL;
+		}
+		
+		else {
+			that_stack = existing_stack;
+		}
+		
+		that_list_by_element = MALLOC_DEBUG (sizeof (nt_bp_list_by_element),
+		                                     "nt_bp_list_by_element of stack of seq_bp in create_seq_bp_list");
+		                                     
+		if (!that_list_by_element || list_init (& (that_list_by_element->list)) != 0) {
+			if (that_list_by_element) {
+				FREE_DEBUG (that_list_by_element,
+				            "nt_list_by_element of stack of seq_bp in create_seq_bp_list [unable to initialize list]");
+			}
+			
+			if (!stack_already_exists) {
+				list_delete_at (&seq_bp->stacks[idx], (seq_bp->stacks[idx].numels) - 1);
+				FREE_DEBUG (that_stack,
+				            "stack of seq_bp in create_seq_bp_list [unable to allocate nt_bp_list_by_element]");
+			}
+			
+			return NULL;
+		}
+		
+		that_list_by_element->stack_counts = 0;
+		that_list_by_element->el = this_element;
+		
+		if (that_stack->lists) {
+			that_list_by_element->next = that_stack->lists;
+		}
+		
+		else {
+			that_list_by_element->next = NULL;
+		}
+		
+		that_stack->lists = that_list_by_element;
+	}
+	
+	return that_list_by_element;
+}
+
+bool initialize_seq_bp_stacks (ntp_seq_bp restrict seq_bp, const uchar idx) {
+	if (list_init (&seq_bp->stacks[idx]) != 0) {
+		return false;
+	}
+	
+	return true;
+}
+
+static inline void destroy_seq_bp_stacks (ntp_seq_bp restrict seq_bp,
+                                        const uchar idx) {
+	list_iterator_start (&seq_bp->stacks[idx]);
+	
+	while (list_iterator_hasnext (&seq_bp->stacks[idx])) {
+		// free ntp_bps
+		REGISTER ntp_stack this_stack = list_iterator_next (&seq_bp->stacks[idx]);
+		REGISTER ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+		
+		while (this_list_by_element) {
+			REGISTER nt_list *restrict this_list = &this_list_by_element->list;
+			list_iterator_start (this_list);
+			
+			while (list_iterator_hasnext (this_list)) {
+				REGISTER
+				ntp_bp restrict this_bp = (ntp_bp) list_iterator_next (this_list);
+				
+				if (this_bp) {
+					FREE_DEBUG (this_bp, NULL);
+				}
+			}
+			
+			list_iterator_stop (this_list);
+			list_destroy (this_list);
+			ntp_bp_list_by_element tmp_list_by_element = this_list_by_element;
+			this_list_by_element = this_list_by_element->next;
+			FREE_DEBUG (tmp_list_by_element,
+			            "ntp_list_by_element of stack of seq_bp in destroy_seq_bp_stacks");
+		}
+		
+		FREE_DEBUG (this_stack, "stack of seq_bp in destroy_seq_bp_stacks");
+	}
+	
+	list_iterator_stop (&seq_bp->stacks[idx]);
+	list_destroy (&seq_bp->stacks[idx]);
+}
+
+void destroy_seq_bp (ntp_seq_bp restrict seq_bp) {
+	if (seq_bp) {
+		#ifdef DEBUG_MEM
+		unsigned long s_num_entries, e_num_entries, s_alloc_size, e_alloc_size;
+		MALLOC_CP (&s_num_entries, &s_alloc_size);
+		#endif
+		
+		for (REGISTER nt_stack_size l = 0; l < MAX_STACK_LEN; l++) {
+			destroy_seq_bp_stacks (seq_bp, l);
+		}
+		
+		#ifdef DEBUG_MEM
+		char msg[100];
+		MALLOC_CP (&e_num_entries, &e_alloc_size);
+		sprintf (msg,
+		         "%lu mem entries freed (total size is %lu) for seq in destroy_seq_bp",
+		         s_num_entries - e_num_entries, s_alloc_size - e_alloc_size);
+		COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE, msg, false);
+		#endif
+		FREE_DEBUG ((void *) (seq_bp->sequence), "seq of seq_bp in destroy_seq_bp");
+		FREE_DEBUG (seq_bp, "seq_bp in destroy_seq_bp");
+	}
+}
+
+/*
+ * copy seq_bp for model_copy (see copy_model), such that a copy of the
+ * model can be searched without building its seq_bp from the sequence
+ *
+ * output:  seq_bp copy, to be disposed of using destroy_seq_bp; NULL on failure
+ */
+ntp_seq_bp copy_seq_bp (ntp_seq_bp restrict seq_bp,
+                        nt_model *restrict model_copy) {
+	REGISTER
+	ntp_seq_bp restrict seq_bp_copy = MALLOC_DEBUG (sizeof (nt_seq_bp),
+	                                        "seq_bp in copy_seq_bp");
+	                                        
+	if (!seq_bp_copy) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not allocate memory for seq_bp in copy_seq_bp", false);
+		return NULL;
+	}
+	
+	seq_bp_copy->sequence = MALLOC_DEBUG ((size_t) (sizeof (char) * (strlen (
+	                                        seq_bp->sequence) + 1)), "seq of seq_bp in copy_seq_bp");
+	                                        
+	if (!seq_bp_copy->sequence) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not allocate memory for seq of seq_bp in copy_seq_bp", false);
+		FREE_DEBUG (seq_bp_copy,
+		            "seq_bp in copy_seq_bp [failed to allocate memory for seq of seq_bp]");
+		return NULL;
+	}
+	
+	strcpy ((char *) (seq_bp_copy->sequence), seq_bp->sequence);
+	seq_bp_copy->model = model_copy;
+	
+	for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+		if (!initialize_seq_bp_stacks (seq_bp_copy, i)) {
+			COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+			              "cannot initialize seq_bp stacks in copy_seq_bp", false);
+			              
+			for (REGISTER nt_stack_size j = 0; j < i; j++) {
+				list_destroy (&seq_bp_copy->stacks[j]);
+			}
+			
+			FREE_DEBUG ((void *) (seq_bp_copy->sequence), "seq of seq_bp in copy_seq_bp");
+			FREE_DEBUG (seq_bp_copy, "seq_bp in copy_seq_bp");
+			return NULL;
+		}
+	}
+	
+	REGISTER
+	bool success = true;
+	
+	for (REGISTER nt_stack_size i = 0; success && i < MAX_STACK_LEN; i++) {
+		list_iterator_start (&seq_bp->stacks[i]);
+		
+		while (success && list_iterator_hasnext (&seq_bp->stacks[i])) {
+			REGISTER ntp_stack this_stack = list_iterator_next (&seq_bp->stacks[i]);
+			REGISTER ntp_stack this_stack_copy = MALLOC_DEBUG (sizeof (nt_stack),
+			                                     "stack of seq_bp in copy_seq_bp");
+			                                     
+			if (!this_stack_copy || 0 > list_append (&seq_bp_copy->stacks[i],
+			                                        this_stack_copy)) {
+				if (this_stack_copy) {
+					FREE_DEBUG (this_stack_copy,
+					            "stack of seq_bp in copy_seq_bp [unable to append to seq_bp->stacks]");
+				}
+				
+				success = false;
+				break;
+			}
+			
+			this_stack_copy->stack_idist = this_stack->stack_idist;
+			this_stack_copy->in_extrusion = this_stack->in_extrusion;
+			this_stack_copy->lists = NULL;
+			// keep nt_bp_list_by_element entries in their original order
+			REGISTER ntp_bp_list_by_element *last_list_by_element_copy =
+			                    &this_stack_copy->lists;
+			                    
+			for (REGISTER ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+			     this_list_by_element; this_list_by_element = this_list_by_element->next) {
+				REGISTER ntp_bp_list_by_element this_list_by_element_copy =
+				                    MALLOC_DEBUG (sizeof (nt_bp_list_by_element),
+				                                  "nt_bp_list_by_element of stack of seq_bp in copy_seq_bp");
+				                                  
+				if (!this_list_by_element_copy ||
+				    list_init (& (this_list_by_element_copy->list)) != 0) {
+					if (this_list_by_element_copy) {
+						FREE_DEBUG (this_list_by_element_copy,
+						            "nt_bp_list_by_element of stack of seq_bp in copy_seq_bp [unable to initialize list]");
+					}
+					
+					success = false;
+					break;
+				}
+				
+				this_list_by_element_copy->stack_counts = this_list_by_element->stack_counts;
+				this_list_by_element_copy->el = get_model_element_copy (seq_bp->model,
+				                                        model_copy, this_list_by_element->el);
+				this_list_by_element_copy->next = NULL;
+				*last_list_by_element_copy = this_list_by_element_copy;
+				last_list_by_element_copy = &this_list_by_element_copy->next;
+				list_iterator_start (&this_list_by_element->list);
+				
+				while (list_iterator_hasnext (&this_list_by_element->list)) {
+					REGISTER ntp_bp this_bp = list_iterator_next (&this_list_by_element->list);
+					REGISTER ntp_bp this_bp_copy = MALLOC_DEBUG (sizeof (nt_bp),
+					                               "bp of seq_bp in copy_seq_bp");
+					                               
+					if (!this_bp_copy ||
+					    0 > list_append (&this_list_by_element_copy->list, this_bp_copy)) {
+						if (this_bp_copy) {
+							FREE_DEBUG (this_bp_copy,
+							            "bp of seq_bp in copy_seq_bp [unable to append to nt_bp_list_by_element]");
+						}
+						
+						success = false;
+						break;
+					}
+					
+					*this_bp_copy = *this_bp;
+				}
+				
+				list_iterator_stop (&this_list_by_element->list);
+				
+				if (!success) {
+					break;
+				}
+			}
+		}
+		
+		list_iterator_stop (&seq_bp->stacks[i]);
+	}
+	
+	if (!success) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not copy stacks of seq_bp in copy_seq_bp", false);
+		destroy_seq_bp (seq_bp_copy);
+		return NULL;
+	}
+	
+	return seq_bp_copy;
+}
+
+static inline size_t get_shm_aligned_size (const size_t size) {
+	return (size + 7) & ~ ((size_t) 7);
+}
+
+/*
+ * private function to get the offsets of the arrays that follow a record
+ *
+ * output:  total size of the record (in bytes)
+ */
+static inline size_t get_shm_record_offsets (const nt_seq_bp_shm_record *restrict
+                                        record, size_t *restrict sig_offset, size_t *restrict seq_offset,
+                                        size_t *restrict stacks_offset, size_t *restrict lists_offset,
+                                        size_t *restrict bps_offset) {
+	REGISTER
+	uint32_t num_stacks = 0;
+	
+	for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+		num_stacks += record->num_stacks[i];
+	}
+	
+	*sig_offset = get_shm_aligned_size (sizeof (nt_seq_bp_shm_record));
+	*seq_offset = *sig_offset + get_shm_aligned_size (sizeof (ushort) *
+	              record->model_sig_len);
+	*stacks_offset = *seq_offset + get_shm_aligned_size (record->seq_len + 1);
+	*lists_offset = *stacks_offset + get_shm_aligned_size (sizeof (
+	                                        nt_seq_bp_shm_stack) * num_stacks);
+	*bps_offset = *lists_offset + get_shm_aligned_size (sizeof (nt_seq_bp_shm_list) *
+	              record->num_lists);
+	return *bps_offset + get_shm_aligned_size (sizeof (nt_bp) * record->num_bps);
+}
+
+static inline uint32_t get_seq_bp_shm_slot (const uint64_t seq_hash,
+                                        const uint64_t model_hash, const uint32_t seq_len) {
+	return (uint32_t) (((seq_hash * 31 + model_hash) * 31 + seq_len) *
+	                   0x9E3779B97F4A7C15LLU >> 32) & (seq_bp_shm->num_slots - 1);
+}
+
+static inline bool is_seq_bp_shm_record_match (const nt_seq_bp_shm_record *restrict
+                                        record, const nt_seq_bp_shm_record *restrict key,
+                                        const ushort *restrict sig, const ntp_seq restrict seq) {
+	if (record->seq_hash != key->seq_hash || record->model_hash != key->model_hash ||
+	    record->seq_len != key->seq_len || record->model_sig_len != key->model_sig_len) {
+		return false;
+	}
+	
+	size_t sig_offset, seq_offset, stacks_offset, lists_offset, bps_offset;
+	get_shm_record_offsets (record, &sig_offset, &seq_offset, &stacks_offset,
+	                        &lists_offset, &bps_offset);
+	return !memcmp ((const char *) record + sig_offset, sig,
+	                sizeof (ushort) * key->model_sig_len) &&
+	       !memcmp ((const char *) record + seq_offset, seq, key->seq_len);
+}
+
+/*
+ * private function to get the magic of stores that can be shared with this build:
+ * SEQ_BP_SHM_MAGIC, with the crc32 of SEQ_BP_SHM_VERSION and the sizes and offsets
+ * of the store's layout in its lower 32 bits, such that builds of the same source
+ * share stores, while builds that lay out or build seq_bps differently do not
+ */
+static inline uint64_t get_seq_bp_shm_magic() {
+	const uint32_t layout[] = {
+		SEQ_BP_SHM_VERSION, SEQ_BP_SHM_LAYOUT, MAX_STACK_LEN,
+		(uint32_t) sizeof (nt_seq_bp_shm_header),
+		(uint32_t) offsetof (nt_seq_bp_shm_header, slots),
+		(uint32_t) sizeof (nt_seq_bp_shm_record),
+		(uint32_t) offsetof (nt_seq_bp_shm_record, num_stacks),
+		(uint32_t) offsetof (nt_seq_bp_shm_record, num_lists),
+		(uint32_t) sizeof (nt_seq_bp_shm_stack),
+		(uint32_t) offsetof (nt_seq_bp_shm_stack, stack_idist),
+		(uint32_t) offsetof (nt_seq_bp_shm_stack, in_extrusion),
+		(uint32_t) sizeof (nt_seq_bp_shm_list),
+		(uint32_t) offsetof (nt_seq_bp_shm_list, stack_counts),
+		(uint32_t) offsetof (nt_seq_bp_shm_list, el_step),
+		(uint32_t) sizeof (nt_bp),
+		(uint32_t) offsetof (nt_bp, tp_posn)
+	};
+	return SEQ_BP_SHM_MAGIC | (uint64_t) crc32buf ((char *) layout, sizeof (layout));
+}
+
+/*
+ * get the name of the shared seq_bp store of a (dispatch) instance, such that scan
+ * workers of different instances on the same node do not share stores
+ */
+void get_seq_bp_shm_name (const ushort instance,
+                          char name[SEQ_BP_SHM_MAX_NAME_LEN + 1]) {
+	snprintf (name, SEQ_BP_SHM_MAX_NAME_LEN + 1, "%s.%u", SEQ_BP_SHM_NAME, instance);
+}
+
+/*
+ * remove the shared seq_bp store of the given name from this node; processes that
+ * map the store keep doing so, but no longer share it with processes mapping it later
+ */
+void remove_seq_bp_shm_store (const char *restrict name) {
+	if (shm_unlink (name) && errno != ENOENT) {
+		COMMIT_DEBUG1 (REPORT_WARNINGS, SEQ_BP_CACHE,
+		               "could not remove shared seq_bp store %s in remove_seq_bp_shm_store", name,
+		               false);
+	}
+}
+
+/*
+ * private function to remove the mapped store under its name, unless it was replaced
+ * (by another process) already
+ */
+static void remove_mapped_seq_bp_shm_store() {
+	int fd = shm_open (seq_bp_shm_name, O_RDONLY, 0600);
+	
+	if (0 > fd) {
+		return;
+	}
+	
+	struct stat fd_stat;
+	
+	if (!fstat (fd, &fd_stat) && fd_stat.st_ino == seq_bp_shm_ino) {
+		remove_seq_bp_shm_store (seq_bp_shm_name);
+	}
+	
+	close (fd);
+}
+
+/*
+ * private function to map the store of the given name, creating it unless another
+ * process already did (see initialize_seq_bp_shm_store)
+ *
+ * output:  true if mapped; false otherwise, in which case is_stale tells whether
+ *          the store exists, but cannot be shared (initialized by another build, or
+ *          not initialized by its creator in time)
+ */
+static bool map_seq_bp_shm_store (const char *restrict name, const size_t size,
+                                  bool *restrict is_stale) {
+	*is_stale = false;
+	REGISTER
+	bool is_creator = true;
+	int fd = shm_open (name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	
+	if (0 > fd) {
+		is_creator = false;
+		
+		if (errno != EEXIST || 0 > (fd = shm_open (name, O_RDWR, 0600))) {
+			COMMIT_DEBUG1 (REPORT_ERRORS, SEQ_BP_CACHE,
+			               "could not open shared seq_bp store %s in initialize_seq_bp_shm_store", name,
+			               false);
+			return false;
+		}
+	}
+	
+	else
+		if (0 > ftruncate (fd, (off_t) size)) {
+			COMMIT_DEBUG1 (REPORT_ERRORS, SEQ_BP_CACHE,
+			               "could not size shared seq_bp store %s in initialize_seq_bp_shm_store", name,
+			               false);
+			close (fd);
+			shm_unlink (name);
+			return false;
+		}
+		
+	// wait for the creating process to size the store
+	struct stat fd_stat;
+	REGISTER
+	ushort attempts = 0;
+	
+	while (!fstat (fd, &fd_stat) && (size_t) fd_stat.st_size < sizeof (
+	                                        nt_seq_bp_shm_header) && ++attempts < SEQ_BP_SHM_WAIT_ATTEMPTS) {
+		sleep_ms (SEQ_BP_SHM_WAIT_MS);
+	}
+	
+	if ((size_t) fd_stat.st_size < sizeof (nt_seq_bp_shm_header)) {
+		COMMIT_DEBUG1 (REPORT_ERRORS, SEQ_BP_CACHE,
+		               "shared seq_bp store %s not sized in initialize_seq_bp_shm_store", name, false);
+		close (fd);
+		*is_stale = true;
+		return false;
+	}
+	
+	void *mem = mmap (NULL, (size_t) fd_stat.st_size, PROT_READ | PROT_WRITE,
+	                  MAP_SHARED, fd, 0);
+	close (fd);
+	
+	if (MAP_FAILED == mem) {
+		COMMIT_DEBUG1 (REPORT_ERRORS, SEQ_BP_CACHE,
+		               "could not map shared seq_bp store %s in initialize_seq_bp_shm_store", name,
+		               false);
+		return false;
+	}
+	
+	REGISTER
+	ntp_seq_bp_shm_header header = mem;
+	REGISTER
+	uint64_t magic = get_seq_bp_shm_magic();
+	
+	if (is_creator) {
+		// slots take up at most 1/64th of the store; the store is zero-filled, so all slots are free
+		REGISTER
+		uint32_t num_slots = SEQ_BP_SHM_MIN_SLOTS;
+		
+		while (num_slots < UINT32_MAX / 2 &&
+		       sizeof (uint64_t) * num_slots * 2 * 64 <= (size_t) fd_stat.st_size) {
+			num_slots *= 2;
+		}
+		
+		header->size = (uint64_t) fd_stat.st_size;
+		header->num_slots = num_slots;
+		header->layout = SEQ_BP_SHM_LAYOUT;
+		header->next_free = get_shm_aligned_size (sizeof (nt_seq_bp_shm_header) +
+		                    sizeof (uint64_t) * num_slots);
+		                    
+		if (header->next_free > header->size) {
+			COMMIT_DEBUG1 (REPORT_ERRORS, SEQ_BP_CACHE,
+			               "shared seq_bp store %s is too small in initialize_seq_bp_shm_store", name,
+			               false);
+			munmap (mem, (size_t) fd_stat.st_size);
+			shm_unlink (name);
+			return false;
+		}
+		
+		__atomic_store_n (&header->magic, magic, __ATOMIC_RELEASE);
+	}
+	
+	else {
+		attempts = 0;
+		
+		while (!__atomic_load_n (&header->magic, __ATOMIC_ACQUIRE) &&
+		       ++attempts < SEQ_BP_SHM_WAIT_ATTEMPTS) {
+			sleep_ms (SEQ_BP_SHM_WAIT_MS);
+		}
+		
+		if (__atomic_load_n (&header->magic, __ATOMIC_ACQUIRE) != magic ||
+		    header->layout != SEQ_BP_SHM_LAYOUT || header->size != (uint64_t) fd_stat.st_size) {
+			COMMIT_DEBUG1 (REPORT_WARNINGS, SEQ_BP_CACHE,
+			               "shared seq_bp store %s is not initialized or incompatible in initialize_seq_bp_shm_store",
+			               name, false);
+			munmap (mem, (size_t) fd_stat.st_size);
+			*is_stale = true;
+			return false;
+		}
+	}
+	
+	__atomic_fetch_add (&header->num_mapped, 1, __ATOMIC_RELAXED);
+	seq_bp_shm = header;
+	seq_bp_shm_ino = fd_stat.st_ino;
+	seq_bp_shm_generation++;
+	return true;
+}
+
+/*
+ * private function to unmap the store, which is removed once no process maps it any
+ * longer; to be invoked holding seq_bp_shm_rwlock for writing
+ */
+static void unmap_seq_bp_shm_store() {
+	if (seq_bp_shm) {
+		if (1 == __atomic_fetch_sub (&seq_bp_shm->num_mapped, 1, __ATOMIC_ACQ_REL)) {
+			remove_mapped_seq_bp_shm_store();
+		}
+		
+		munmap (seq_bp_shm, (size_t) seq_bp_shm->size);
+		seq_bp_shm = NULL;
+	}
+}
+
+/*
+ * private function to (re)map the store of the given name, replacing any stale store
+ * of that name (see initialize_seq_bp_shm_store); to be invoked holding seq_bp_shm_rwlock
+ * for writing
+ */
+static bool open_seq_bp_shm_store (const char *restrict name, const size_t size) {
+	unmap_seq_bp_shm_store();
+	
+	if (strlen (name) > SEQ_BP_SHM_MAX_NAME_LEN) {
+		COMMIT_DEBUG1 (REPORT_ERRORS, SEQ_BP_CACHE,
+		               "shared seq_bp store name %s is too long in initialize_seq_bp_shm_store", name,
+		               false);
+		return false;
+	}
+	
+	bool is_stale;
+	
+	if (!map_seq_bp_shm_store (name, size, &is_stale)) {
+		if (!is_stale) {
+			return false;
 		}
 		
-		else {
-			#ifdef MULTITHREADED_ON
-			pthread_mutex_unlock (&num_destruction_threads_mutex);
-			#endif
-			COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-			              "could not allocate memory for seq_bp_cache in initialize_seq_bp_cache", false);
+		remove_seq_bp_shm_store (name);
+		
+		if (!map_seq_bp_shm_store (name, size, &is_stale)) {
 			return false;
 		}
-		
-		#ifdef MULTITHREADED_ON
 	}
 	
-	return false;
-		#endif
+	strcpy (seq_bp_shm_name, name);
+	seq_bp_shm_size = size;
+	COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
+	               "mapped shared seq_bp store %s in initialize_seq_bp_shm_store", name, false);
+	return true;
 }
 
-bool finalize_seq_bp_cache() {
-	#ifdef MULTITHREADED_ON
+/*
+ * map the node-local shared seq_bp store of the given name (see get_seq_bp_shm_name),
+ * creating it (with the given size, in bytes) unless another process already did;
+ * the store persists (and remains shared by processes that map it) until removed,
+ * either when replaced (see renew_seq_bp_shm_store), or once no process maps it any
+ * longer (see finalize_seq_bp_shm_store), or using remove_seq_bp_shm_store
+ *
+ * note:    a stale store of the same name is replaced by a new one
+ */
+bool initialize_seq_bp_shm_store (const char *restrict name, const size_t size) {
+	pthread_rwlock_wrlock (&seq_bp_shm_rwlock);
+	const bool success = open_seq_bp_shm_store (name, size);
+	pthread_rwlock_unlock (&seq_bp_shm_rwlock);
+	return success;
+}
 
-	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
-	#endif
+/*
+ * unmap the shared seq_bp store, which is removed once no process maps it any longer
+ */
+void finalize_seq_bp_shm_store() {
+	pthread_rwlock_wrlock (&seq_bp_shm_rwlock);
+	unmap_seq_bp_shm_store();
+	pthread_rwlock_unlock (&seq_bp_shm_rwlock);
+}
+
+/*
+ * private function to replace a full store by a new one of the same name and size,
+ * unless another thread did so since the full store was mapped (as of generation);
+ * the write lock waits for threads reading or publishing to the full store, and
+ * seq_bps rebuilt from it are copies (see get_seq_bp_from_shm_store), so these
+ * remain valid once it is unmapped
+ */
+static void renew_seq_bp_shm_store (const unsigned long long generation) {
+	pthread_rwlock_wrlock (&seq_bp_shm_rwlock);
 	
-		if (seq_bp_cache) {
-			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-			              "finalizing seq_bp_cache in finalize_seq_bp_cache", true);
-			list_iterator_start (seq_bp_cache);
-			
-			while (list_iterator_hasnext (seq_bp_cache)) {
-				REGISTER
-				ntp_seq_bp_cache_entry restrict this_cache_entry = (ntp_seq_bp_cache_entry)
-				                                        list_iterator_next (seq_bp_cache);
-				                                        
-				if (this_cache_entry) {
-					REGISTER
-					ntp_list restrict this_list = this_cache_entry->seq_list;
-					#ifdef DEBUG_MEM
-					const REGISTER
-					nt_seq_hash this_hash = this_cache_entry->seq_hash;
-					#endif
-					#ifdef DEBUG_ON
-					REGISTER
-					nt_seq_count seq_cnt = 1;
-					#endif
-					list_iterator_start (this_list);
-					
-					while (list_iterator_hasnext (this_list)) {
-						#ifdef DEBUG_ON
-						COMMIT_DEBUG2 (REPORT_INFO, SEQ_BP_CACHE,
-						               "destroying seq (hash %ld) number %u from seq_list in this_cache_entry of seq_bp_cache in finalize_seq_bp_cache",
-						               this_hash, seq_cnt, false);
-						seq_cnt++;
-						#endif
-						destroy_seq_bp ((ntp_seq_bp)list_iterator_next (this_list));
-					}
-					
-					list_iterator_stop (this_list);
-					list_destroy (this_list);
-					FREE_DEBUG (this_list,
-					            "seq_list in this_cache_entry of seq_bp_cache in finalize_seq_bp_cache");
-					FREE_DEBUG (this_cache_entry,
-					            "this_cache_entry of seq_bp_cache in finalize_seq_bp_cache");
-				}
-			}
-			
-			list_iterator_stop (seq_bp_cache);
-			list_destroy (seq_bp_cache);
-			FREE_DEBUG (seq_bp_cache, "seq_bp_cache in finalize_seq_bp_cache");
-			seq_bp_cache = NULL;
-			#ifdef MULTITHREADED_ON
-			pthread_mutex_unlock (&num_destruction_threads_mutex);
-			#endif
-			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-			              "seq_bp_cache finalized in finalize_seq_bp_cache", false);
-			return true;
-		}
+	if (seq_bp_shm && generation == seq_bp_shm_generation) {
+		char name[SEQ_BP_SHM_MAX_NAME_LEN + 1];
+		strcpy (name, seq_bp_shm_name);
+		remove_mapped_seq_bp_shm_store();
 		
-		else {
-			#ifdef MULTITHREADED_ON
-			pthread_mutex_unlock (&num_destruction_threads_mutex);
-			#endif
-			return false;
+		if (!open_seq_bp_shm_store (name, seq_bp_shm_size)) {
+			COMMIT_DEBUG1 (REPORT_WARNINGS, SEQ_BP_CACHE,
+			               "could not renew shared seq_bp store %s, continuing without", name, false);
 		}
-		
-		#ifdef MULTITHREADED_ON
 	}
 	
-	return false;
-		#endif
+	pthread_rwlock_unlock (&seq_bp_shm_rwlock);
 }
 
-bool purge_seq_bp_cache_by_model (nt_model *restrict model) {
-	#ifdef MULTITHREADED_ON
-
-	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
-	#endif
+/*
+ * private function to rebuild a seq_bp from the mapped store (see
+ * get_seq_bp_from_shm_store), holding seq_bp_shm_rwlock for reading
+ */
+static bool get_seq_bp_from_mapped_shm_store (const ntp_seq restrict seq,
+                                        const nt_seq_hash hash, nt_model *restrict model,
+                                        const nt_model_plan *restrict plan, const ushort *restrict model_sig,
+                                        const uint32_t model_sig_len, ntp_seq_bp *restrict seq_bp) {
+	*seq_bp = NULL;
 	
-		if (seq_bp_cache) {
-			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-			              "purging seq_bp_cache in purge_seq_bp_cache_by_model", true);
-			list_iterator_start (seq_bp_cache);
-			
-			while (list_iterator_hasnext (seq_bp_cache)) {
-				REGISTER
-				ntp_seq_bp_cache_entry restrict this_cache_entry = (ntp_seq_bp_cache_entry)
-				                                        list_iterator_next (seq_bp_cache);
-				                                        
-				if (this_cache_entry) {
-					REGISTER
-					ntp_list restrict this_list = this_cache_entry->seq_list;
-					REGISTER
-					unsigned int num_els = this_list->numels, this_el_idx = 0;
-					
-					while (this_el_idx < num_els) {
-						ntp_seq_bp this_seq_bp = (ntp_seq_bp)list_get_at (this_list, this_el_idx);
-						
-						if (this_seq_bp->model == model) {
-							this_seq_bp = (ntp_seq_bp)list_extract_at (this_list, this_el_idx);
-							destroy_seq_bp (this_seq_bp);
-							num_els--;
-						}
-						
-						else {
-							this_el_idx++;
-						}
-					}
-				}
-			}
-			
-			list_iterator_stop (seq_bp_cache);
-			#ifdef MULTITHREADED_ON
-			pthread_mutex_unlock (&num_destruction_threads_mutex);
-			#endif
-			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-			              "seq_bp_cache purged by model in purge_seq_bp_cache_by_model", false);
-			return true;
+	if (!seq_bp_shm) {
+		return false;
+	}
+	
+	nt_seq_bp_shm_record key;
+	key.model_sig_len = model_sig_len;
+	key.seq_hash = (uint64_t) hash;
+	key.model_hash = (uint64_t) crc32buf ((char *) model_sig,
+	                                      sizeof (ushort) * key.model_sig_len);
+	key.seq_len = (uint32_t) strlen (seq);
+	REGISTER
+	const nt_seq_bp_shm_record *restrict record = NULL;
+	REGISTER
+	uint32_t slot = get_seq_bp_shm_slot (key.seq_hash, key.model_hash, key.seq_len);
+	
+	for (REGISTER uint32_t i = 0; i < seq_bp_shm->num_slots; i++) {
+		REGISTER
+		uint64_t offset = __atomic_load_n (&seq_bp_shm->slots[slot], __ATOMIC_ACQUIRE);
+		
+		if (!offset) {
+			break;
 		}
 		
-		else {
-			#ifdef MULTITHREADED_ON
-			pthread_mutex_unlock (&num_destruction_threads_mutex);
-			#endif
-			return false;
+		if (is_seq_bp_shm_record_match ((const nt_seq_bp_shm_record *) ((
+		                                        const char *) seq_bp_shm + offset), &key, model_sig, seq)) {
+			record = (const nt_seq_bp_shm_record *) ((const char *) seq_bp_shm + offset);
+			break;
 		}
 		
-		#ifdef MULTITHREADED_ON
+		slot = (slot + 1) & (seq_bp_shm->num_slots - 1);
 	}
 	
-	return false;
-		#endif
-}
-
-ntp_bp_list_by_element create_seq_bp_stack_by_element (ntp_seq_bp restrict
-                                        seq_bp, const uchar idx,
-                                        nt_stack_idist  this_stack_idist, short this_in_extrusion,
-                                        ntp_element this_element) {
+	if (!record) {
+		return false;
+	}
+	
+	size_t sig_offset, seq_offset, stacks_offset, lists_offset, bps_offset;
+	get_shm_record_offsets (record, &sig_offset, &seq_offset, &stacks_offset,
+	                        &lists_offset, &bps_offset);
 	REGISTER
-	bool stack_already_exists = false, list_by_element_already_exists = false;
+	const nt_seq_bp_shm_stack *restrict shm_stack = (const nt_seq_bp_shm_stack *) ((
+	                                        const char *) record + stacks_offset);
 	REGISTER
-	ntp_stack that_stack = NULL, existing_stack = NULL;
+	const nt_seq_bp_shm_list *restrict shm_list = (const nt_seq_bp_shm_list *) ((
+	                                        const char *) record + lists_offset);
 	REGISTER
-	ntp_bp_list_by_element that_list_by_element = NULL;
+	const nt_bp *restrict shm_bp = (const nt_bp *) ((const char *) record + bps_offset);
+	REGISTER
+	ntp_seq_bp restrict this_seq_bp = MALLOC_DEBUG (sizeof (nt_seq_bp),
+	                                        "seq_bp in get_seq_bp_from_shm_store");
+	                                        
+	if (!this_seq_bp) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not allocate memory for seq_bp in get_seq_bp_from_shm_store", false);
+		return false;
+	}
 	
-	if (seq_bp->stacks[idx].numels) {
-		list_iterator_start (&seq_bp->stacks[idx]);
-		
-		while (list_iterator_hasnext (&seq_bp->stacks[idx])) {
-			that_stack = (ntp_stack)list_iterator_next (&seq_bp->stacks[idx]);
+	this_seq_bp->sequence = MALLOC_DEBUG ((size_t) (sizeof (char) * (key.seq_len + 1)),
+	                                      "seq of seq_bp in get_seq_bp_from_shm_store");
+	                                      
+	if (!this_seq_bp->sequence) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not allocate memory for seq of seq_bp in get_seq_bp_from_shm_store",
+		              false);
+		FREE_DEBUG (this_seq_bp,
+		            "seq_bp in get_seq_bp_from_shm_store [failed to allocate memory for seq of seq_bp]");
+		return false;
+	}
+	
+	strcpy ((char *) (this_seq_bp->sequence), seq);
+	this_seq_bp->model = model;
+	
+	for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+		if (!initialize_seq_bp_stacks (this_seq_bp, i)) {
+			COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+			              "cannot initialize seq_bp stacks in get_seq_bp_from_shm_store", false);
+			              
+			for (REGISTER nt_stack_size j = 0; j < i; j++) {
+				list_destroy (&this_seq_bp->stacks[j]);
+			}
 			
-			if (that_stack->stack_idist == this_stack_idist &&
-			    that_stack->in_extrusion == this_in_extrusion) {
-				stack_already_exists = true;
-				existing_stack = that_stack;
-				that_list_by_element = that_stack->lists;
+			FREE_DEBUG ((void *) (this_seq_bp->sequence),
+			            "seq of seq_bp in get_seq_bp_from_shm_store");
+			FREE_DEBUG (this_seq_bp, "seq_bp in get_seq_bp_from_shm_store");
+			return false;
+		}
+	}
+	
+	REGISTER
+	bool success = true;
+	
+	for (REGISTER nt_stack_size i = 0; success && i < MAX_STACK_LEN; i++) {
+		for (REGISTER uint32_t s = 0; success && s < record->num_stacks[i]; s++, shm_stack++) {
+			REGISTER ntp_stack this_stack = MALLOC_DEBUG (sizeof (nt_stack),
+			                                "stack of seq_bp in get_seq_bp_from_shm_store");
+			                                
+			if (!this_stack || 0 > list_append (&this_seq_bp->stacks[i], this_stack)) {
+				if (this_stack) {
+					FREE_DEBUG (this_stack,
+					            "stack of seq_bp in get_seq_bp_from_shm_store [unable to append to seq_bp->stacks]");
+				}
 				
-				while (that_list_by_element) {
-					if (that_list_by_element->el == this_element) {
-						list_by_element_already_exists = true;
+				success = false;
+				break;
+			}
+			
+			this_stack->stack_idist = shm_stack->stack_idist;
+			this_stack->in_extrusion = shm_stack->in_extrusion;
+			this_stack->lists = NULL;
+			REGISTER ntp_bp_list_by_element *last_list_by_element = &this_stack->lists;
+			
+			for (REGISTER uint32_t l = 0; l < shm_stack->num_lists; l++, shm_list++) {
+				REGISTER ntp_bp_list_by_element this_list_by_element = shm_list->el_step <
+				                                        plan->num_steps ? MALLOC_DEBUG (sizeof (nt_bp_list_by_element),
+				                                                "nt_bp_list_by_element of stack of seq_bp in get_seq_bp_from_shm_store") : NULL;
+				                                                
+				if (!this_list_by_element || list_init (& (this_list_by_element->list)) != 0) {
+					if (this_list_by_element) {
+						FREE_DEBUG (this_list_by_element,
+						            "nt_bp_list_by_element of stack of seq_bp in get_seq_bp_from_shm_store [unable to initialize list]");
+					}
+					
+					success = false;
+					break;
+				}
+				
+				this_list_by_element->stack_counts = shm_list->stack_counts;
+				this_list_by_element->el = plan->steps[shm_list->el_step].el;
+				this_list_by_element->next = NULL;
+				*last_list_by_element = this_list_by_element;
+				last_list_by_element = &this_list_by_element->next;
+				
+				for (REGISTER uint32_t b = 0; b < shm_list->num_bps; b++, shm_bp++) {
+					REGISTER ntp_bp this_bp = MALLOC_DEBUG (sizeof (nt_bp),
+					                                        "bp of seq_bp in get_seq_bp_from_shm_store");
+					                                        
+					if (!this_bp || 0 > list_append (&this_list_by_element->list, this_bp)) {
+						if (this_bp) {
+							FREE_DEBUG (this_bp,
+							            "bp of seq_bp in get_seq_bp_from_shm_store [unable to append to nt_bp_list_by_element]");
+						}
+						
+						success = false;
 						break;
 					}
 					
-					that_list_by_element = that_list_by_element->next;
+					*this_bp = *shm_bp;
 				}
 				
-				if (list_by_element_already_exists) {
+				if (!success) {
 					break;
 				}
 			}
 		}
-		
-		list_iterator_stop (&seq_bp->stacks[idx]);
 	}
 	
-	if (!list_by_element_already_exists) {
-		if (!stack_already_exists) {
-			that_stack = MALLOC_DEBUG (sizeof (nt_stack),
-			                           "stack of seq_bp in create_seq_bp_list");
-			                           
-			if (!that_stack || 0 > list_append (&seq_bp->stacks[idx], that_stack)) {
-				if (that_stack) {
-					FREE_DEBUG (that_stack,
-					            "stack of seq_bp in create_seq_bp_list [unable to append to seq_bp->stacks]");
-				}
-				
-				return NULL;
-			}
-			
-			that_stack->stack_idist = this_stack_idist;
-			that_stack->in_extrusion = this_in_extrusion;
-			that_stack->lists = NULL;
-		}
-		
-		else {
-			that_stack = existing_stack;
-		}
+	if (!success) {
+		COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+		              "could not rebuild stacks of seq_bp in get_seq_bp_from_shm_store", false);
+		destroy_seq_bp (this_seq_bp);
+		return false;
+	}
+	
+	__atomic_fetch_add (&seq_bp_shm_hits, 1, __ATOMIC_RELAXED);
+	COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
+	               "seq_bp of seq (hash %lu) rebuilt from shared seq_bp store in get_seq_bp_from_shm_store",
+	               hash, false);
+	*seq_bp = this_seq_bp;
+	return true;
+}
+
+/*
+ * rebuild the seq_bp of seq for model from the shared seq_bp store, if published
+ *
+ * input:   plan and model_sig (see get_model_signature), as compiled from model
+ *
+ * output:  true if found, in which case seq_bp is set (to be disposed of using
+ *          destroy_seq_bp, or cached); false otherwise
+ */
+bool get_seq_bp_from_shm_store (const ntp_seq restrict seq,
+                                const nt_seq_hash hash, nt_model *restrict model,
+                                const nt_model_plan *restrict plan, const ushort *restrict model_sig,
+                                const uint32_t model_sig_len, ntp_seq_bp *restrict seq_bp) {
+	pthread_rwlock_rdlock (&seq_bp_shm_rwlock);
+	const bool found = get_seq_bp_from_mapped_shm_store (seq, hash, model, plan,
+	                   model_sig, model_sig_len, seq_bp);
+	pthread_rwlock_unlock (&seq_bp_shm_rwlock);
+	return found;
+}
+
+/*
+ * private function to publish a seq_bp to the mapped store (see
+ * publish_seq_bp_to_shm_store), holding seq_bp_shm_rwlock for reading
+ *
+ * output:  as publish_seq_bp_to_shm_store, where is_full is set if the store is full
+ */
+static bool publish_seq_bp_to_mapped_shm_store (const ntp_seq restrict seq,
+                                        const nt_seq_hash hash, ntp_seq_bp restrict seq_bp,
+                                        const ushort *restrict model_sig, const uint32_t model_sig_len,
+                                        bool *restrict is_full) {
+	*is_full = false;
+	
+	if (!seq_bp_shm) {
+		return false;
+	}
+	
+	nt_seq_bp_shm_record key;
+	key.model_sig_len = model_sig_len;
+	key.seq_hash = (uint64_t) hash;
+	key.model_hash = (uint64_t) crc32buf ((char *) model_sig,
+	                                      sizeof (ushort) * key.model_sig_len);
+	key.seq_len = (uint32_t) strlen (seq);
+	key.num_lists = 0;
+	key.num_bps = 0;
+	
+	// count stacks, bp lists and bps to size the record
+	for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+		key.num_stacks[i] = seq_bp->stacks[i].numels;
+		list_iterator_start (&seq_bp->stacks[i]);
 		
-		that_list_by_element = MALLOC_DEBUG (sizeof (nt_bp_list_by_element),
-		                                     "nt_bp_list_by_element of stack of seq_bp in create_seq_bp_list");
-		                                     
-		if (!that_list_by_element || list_init (& (that_list_by_element->list)) != 0) {
-			if (that_list_by_element) {
-				FREE_DEBUG (that_list_by_element,
-				            "nt_list_by_element of stack of seq_bp in create_seq_bp_list [unable to initialize list]");
-			}
+		while (list_iterator_hasnext (&seq_bp->stacks[i])) {
+			REGISTER ntp_stack this_stack = list_iterator_next (&seq_bp->stacks[i]);
 			
-			if (!stack_already_exists) {
-				list_delete_at (&seq_bp->stacks[idx], (seq_bp->stacks[idx].numels) - 1);
-				FREE_DEBUG (that_stack,
-				            "stack of seq_bp in create_seq_bp_list [unable to allocate nt_bp_list_by_element]");
+			for (REGISTER ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+			     this_list_by_element; this_list_by_element = this_list_by_element->next) {
+				key.num_lists++;
+				key.num_bps += this_list_by_element->list.numels;
 			}
-			
-			return NULL;
 		}
 		
-		that_list_by_element->stack_counts = 0;
-		that_list_by_element->el = this_element;
-		
-		if (that_stack->lists) {
-			that_list_by_element->next = that_stack->lists;
-		}
-		
-		else {
-			that_list_by_element->next = NULL;
-		}
-		
-		that_stack->lists = that_list_by_element;
+		list_iterator_stop (&seq_bp->stacks[i]);
 	}
 	
-	return that_list_by_element;
-}
-
-bool initialize_seq_bp_stacks (ntp_seq_bp restrict seq_bp, const uchar idx) {
-	if (list_init (&seq_bp->stacks[idx]) != 0) {
+	size_t sig_offset, seq_offset, stacks_offset, lists_offset, bps_offset;
+	const REGISTER
+	size_t record_size = get_shm_record_offsets (&key, &sig_offset, &seq_offset,
+	                     &stacks_offset, &lists_offset, &bps_offset);
+	const REGISTER
+	uint64_t offset = __atomic_fetch_add (&seq_bp_shm->next_free, record_size,
+	                                      __ATOMIC_RELAXED);
+	                                      
+	if (offset + record_size > seq_bp_shm->size) {
+		COMMIT_DEBUG (REPORT_WARNINGS, SEQ_BP_CACHE,
+		              "shared seq_bp store is full in publish_seq_bp_to_shm_store", false);
+		*is_full = true;
 		return false;
 	}
 	
-	return true;
-}
-
-static inline void destroy_seq_bp_stacks (ntp_seq_bp restrict seq_bp,
-                                        const uchar idx) {
-	list_iterator_start (&seq_bp->stacks[idx]);
-	
-	while (list_iterator_hasnext (&seq_bp->stacks[idx])) {
-		// free ntp_bps
-		REGISTER ntp_stack this_stack = list_iterator_next (&seq_bp->stacks[idx]);
-		REGISTER ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+	// write the record in full before it is published
+	REGISTER
+	ntp_seq_bp_shm_record record = (ntp_seq_bp_shm_record) ((char *) seq_bp_shm +
+	                               offset);
+	*record = key;
+	memcpy ((char *) record + sig_offset, model_sig, sizeof (ushort) * key.model_sig_len);
+	memcpy ((char *) record + seq_offset, seq, key.seq_len + 1);
+	REGISTER
+	nt_seq_bp_shm_stack *restrict shm_stack = (nt_seq_bp_shm_stack *) ((
+	                                        char *) record + stacks_offset);
+	REGISTER
+	nt_seq_bp_shm_list *restrict shm_list = (nt_seq_bp_shm_list *) ((
+	                                        char *) record + lists_offset);
+	REGISTER
+	nt_bp *restrict shm_bp = (nt_bp *) ((char *) record + bps_offset);
+	
+	for (REGISTER nt_stack_size i = 0; i < MAX_STACK_LEN; i++) {
+		list_iterator_start (&seq_bp->stacks[i]);
 		
-		while (this_list_by_element) {
-			REGISTER nt_list *restrict this_list = &this_list_by_element->list;
-			list_iterator_start (this_list);
+		while (list_iterator_hasnext (&seq_bp->stacks[i])) {
+			REGISTER ntp_stack this_stack = list_iterator_next (&seq_bp->stacks[i]);
+			shm_stack->num_lists = 0;
+			shm_stack->stack_idist = this_stack->stack_idist;
+			shm_stack->in_extrusion = this_stack->in_extrusion;
 			
-			while (list_iterator_hasnext (this_list)) {
-				REGISTER
-				ntp_bp restrict this_bp = (ntp_bp) list_iterator_next (this_list);
+			for (REGISTER ntp_bp_list_by_element this_list_by_element = this_stack->lists;
+			     this_list_by_element; this_list_by_element = this_list_by_element->next) {
+				shm_stack->num_lists++;
+				shm_list->num_bps = this_list_by_element->list.numels;
+				shm_list->stack_counts = this_list_by_element->stack_counts;
+				shm_list->el_step = this_list_by_element->el->plan_step;
+				shm_list++;
+				list_iterator_start (&this_list_by_element->list);
 				
-				if (this_bp) {
-					FREE_DEBUG (this_bp, NULL);
+				while (list_iterator_hasnext (&this_list_by_element->list)) {
+					*shm_bp++ = * ((ntp_bp) list_iterator_next (&this_list_by_element->list));
 				}
+				
+				list_iterator_stop (&this_list_by_element->list);
 			}
 			
-			list_iterator_stop (this_list);
-			list_destroy (this_list);
-			ntp_bp_list_by_element tmp_list_by_element = this_list_by_element;
-			this_list_by_element = this_list_by_element->next;
-			FREE_DEBUG (tmp_list_by_element,
-			            "ntp_list_by_element of stack of seq_bp in destroy_seq_bp_stacks");
+			shm_stack++;
 		}
 		
-		FREE_DEBUG (this_stack, "stack of seq_bp in destroy_seq_bp_stacks");
+		list_iterator_stop (&seq_bp->stacks[i]);
 	}
 	
-	list_iterator_stop (&seq_bp->stacks[idx]);
-	list_destroy (&seq_bp->stacks[idx]);
-}
-
-void destroy_seq_bp (ntp_seq_bp restrict seq_bp) {
-	if (seq_bp) {
-		#ifdef DEBUG_MEM
-		unsigned long s_num_entries, e_num_entries, s_alloc_size, e_alloc_size;
-		MALLOC_CP (&s_num_entries, &s_alloc_size);
-		#endif
+	// publish in the first free slot, unless the seq_bp is found to be published already
+	REGISTER
+	uint32_t slot = get_seq_bp_shm_slot (key.seq_hash, key.model_hash, key.seq_len);
+	const REGISTER
+	ushort *restrict record_sig = (const ushort *) ((const char *) record + sig_offset);
+	
+	for (REGISTER uint32_t i = 0; i < seq_bp_shm->num_slots; i++) {
+		uint64_t slot_offset = 0;
 		
-		for (REGISTER nt_stack_size l = 0; l < MAX_STACK_LEN; l++) {
-			destroy_seq_bp_stacks (seq_bp, l);
+		if (__atomic_compare_exchange_n (&seq_bp_shm->slots[slot], &slot_offset, offset,
+		                                 false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {
+			__atomic_fetch_add (&seq_bp_shm_publishes, 1, __ATOMIC_RELAXED);
+			COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
+			               "published seq_bp of seq (hash %lu) to shared seq_bp store in publish_seq_bp_to_shm_store",
+			               hash, false);
+			return true;
 		}
 		
-		#ifdef DEBUG_MEM
-		char msg[100];
-		MALLOC_CP (&e_num_entries, &e_alloc_size);
-		sprintf (msg,
-		         "%lu mem entries freed (total size is %lu) for seq in destroy_seq_bp",
-		         s_num_entries - e_num_entries, s_alloc_size - e_alloc_size);
-		COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE, msg, false);
-		#endif
-		FREE_DEBUG ((void *) (seq_bp->sequence), "seq of seq_bp in destroy_seq_bp");
-		FREE_DEBUG (seq_bp, "seq_bp in destroy_seq_bp");
+		if (is_seq_bp_shm_record_match ((const nt_seq_bp_shm_record *) ((
+		                                        const char *) seq_bp_shm + slot_offset), &key, record_sig, seq)) {
+			return true;
+		}
+		
+		slot = (slot + 1) & (seq_bp_shm->num_slots - 1);
+	}
+	
+	COMMIT_DEBUG (REPORT_WARNINGS, SEQ_BP_CACHE,
+	              "no free slot in shared seq_bp store in publish_seq_bp_to_shm_store", false);
+	return false;
+}
+
+/*
+ * publish the (optimized) seq_bp of seq to the shared seq_bp store, unless the store
+ * is full or the seq_bp was already published (possibly by another process); a full
+ * store is renewed once no other thread of this process reads or publishes to it
+ *
+ * input:   model_sig (see get_model_signature), as compiled from the model of seq_bp
+ *
+ * output:  true if the seq_bp is found in the store once done; false otherwise
+ */
+bool publish_seq_bp_to_shm_store (const ntp_seq restrict seq,
+                                  const nt_seq_hash hash, ntp_seq_bp restrict seq_bp,
+                                  const ushort *restrict model_sig, const uint32_t model_sig_len) {
+	bool is_full;
+	pthread_rwlock_rdlock (&seq_bp_shm_rwlock);
+	const unsigned long long generation = seq_bp_shm_generation;
+	const bool is_published = publish_seq_bp_to_mapped_shm_store (seq, hash, seq_bp,
+	                          model_sig, model_sig_len, &is_full);
+	pthread_rwlock_unlock (&seq_bp_shm_rwlock);
+	
+	if (is_full) {
+		renew_seq_bp_shm_store (generation);
 	}
+	
+	return is_published;
 }
 
+/*
+ * look up the seq_bp of seq for model in the cache, where a seq_bp that is found is
+ * pinned until released using release_seq_bp_cache_pin
+ *
+ * output:  true if a complete seq_bp is found; false otherwise, where seq_bp is
+ *          set (and pinned) if an incomplete seq_bp is found, NULL otherwise
+ */
 bool get_seq_bp_from_cache (const ntp_seq restrict seq, const nt_seq_hash hash,
                             const nt_model *restrict model,
                             ntp_list *restrict min_stack_dist, ntp_list *restrict max_stack_dist,
                             ntp_list *restrict in_extrusion, ntp_list *restrict dist_els,
-                            REGISTER ntp_seq_bp restrict *seq_bp) {
+                            REGISTER ntp_seq_bp restrict *seq_bp,
+                            ntp_seq_bp_cache_pin restrict pin) {
 	COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
 	               "getting seq_bp of seq (hash %lu) from cache in get_seq_bp_from_cache", hash,
 	               true);
@@ -434,137 +2100,135 @@ bool get_seq_bp_from_cache (const ntp_seq restrict seq, const nt_seq_hash hash,
 		return false;
 	}
 	
-	#ifdef MULTITHREADED_ON
-	
-	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
-	#endif
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
 		const REGISTER
-		nt_seq_bp_cache_entry *restrict entry = (ntp_seq_bp_cache_entry) list_seek (
-		                                        seq_bp_cache, &hash);
-		                                        
-		if (entry) {
-			COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
-			               "entry for seq (hash %lu) found in cache in get_seq_bp_from_cache", hash,
-			               false);
+		nt_abs_seq_len seq_len = (nt_abs_seq_len) strlen (seq);
+		REGISTER
+		nt_seq_count slot = get_seq_bp_cache_slot (hash, seq_len);
+		
+		while (seq_bp_cache[slot]) {
 			REGISTER
-			ntp_list restrict this_list = entry->seq_list;
-			list_iterator_start (this_list);
+			ntp_seq_bp_cache_entry restrict entry = seq_bp_cache[slot];
+			*seq_bp = entry->seq_bp;
 			
-			while (list_iterator_hasnext (this_list)) {
-				*seq_bp = list_iterator_next (this_list);
+			if (entry->seq_hash == hash && entry->seq_len == seq_len &&
+			    (*seq_bp)->model == model && !strcmp ((*seq_bp)->sequence, seq)) {
+				REGISTER
+				bool dist_match;
+				REGISTER
+				nt_stack_size i = 0;
 				
-				if ((*seq_bp)->model == model && !strcmp ((*seq_bp)->sequence, seq)) {
-					list_iterator_stop (this_list);
-					REGISTER
-					bool dist_match;
-					REGISTER
-					nt_stack_size i = 0;
+				for (; i < MAX_STACK_LEN; i++) {
+					dist_match = true;
+					list_iterator_start (min_stack_dist[i]);
+					list_iterator_start (max_stack_dist[i]);
+					list_iterator_start (in_extrusion[i]);
+					list_iterator_start (dist_els[i]);
 					
-					for (; i < MAX_STACK_LEN; i++) {
-						dist_match = true;
-						list_iterator_start (min_stack_dist[i]);
-						list_iterator_start (max_stack_dist[i]);
-						list_iterator_start (in_extrusion[i]);
-						list_iterator_start (dist_els[i]);
+					while (list_iterator_hasnext (min_stack_dist[i])) {
+						REGISTER
+						short this_in_extrusion = * ((short *)list_iterator_next (in_extrusion[i]));
+						REGISTER
+						nt_stack_idist this_min_stack_dist = * ((ntp_stack_idist)list_iterator_next (
+						                                        min_stack_dist[i])),
+						                                     this_max_stack_dist = * ((ntp_stack_idist)list_iterator_next (
+						                                                                             max_stack_dist[i]));
+						REGISTER
+						ntp_element this_el = ((ntp_element)list_iterator_next (dist_els[i]));
 						
-						while (list_iterator_hasnext (min_stack_dist[i])) {
-							REGISTER
-							short this_in_extrusion = * ((short *)list_iterator_next (in_extrusion[i]));
-							REGISTER
-							nt_stack_idist this_min_stack_dist = * ((ntp_stack_idist)list_iterator_next (
-							                                        min_stack_dist[i])),
-							                                     this_max_stack_dist = * ((ntp_stack_idist)list_iterator_next (
-							                                                                             max_stack_dist[i]));
-							REGISTER
-							ntp_element this_el = ((ntp_element)list_iterator_next (dist_els[i]));
+						for (REGISTER nt_stack_idist this_stack_idist = this_min_stack_dist;
+						     this_stack_idist <= this_max_stack_dist; this_stack_idist++) {
+							dist_match = false;
+							list_iterator_start (& (*seq_bp)->stacks[i]);
 							
-							for (REGISTER nt_stack_idist this_stack_idist = this_min_stack_dist;
-							     this_stack_idist <= this_max_stack_dist; this_stack_idist++) {
-								dist_match = false;
-								list_iterator_start (& (*seq_bp)->stacks[i]);
+							while (list_iterator_hasnext (& (*seq_bp)->stacks[i])) {
+								REGISTER
+								ntp_stack that_stack = list_iterator_next (& (*seq_bp)->stacks[i]);
 								
-								while (list_iterator_hasnext (& (*seq_bp)->stacks[i])) {
+								if (that_stack->stack_idist == this_stack_idist &&
+								    that_stack->in_extrusion == this_in_extrusion) {
 									REGISTER
-									ntp_stack that_stack = list_iterator_next (& (*seq_bp)->stacks[i]);
+									ntp_bp_list_by_element that_bp_list_by_element = that_stack->lists;
 									
-									if (that_stack->stack_idist == this_stack_idist &&
-									    that_stack->in_extrusion == this_in_extrusion) {
-										REGISTER
-										ntp_bp_list_by_element that_bp_list_by_element = that_stack->lists;
-										
-										while (that_bp_list_by_element) {
-											if (that_bp_list_by_element->el == this_el) {
-												dist_match = true;
-												break;
-											}
-											
-											that_bp_list_by_element = that_bp_list_by_element->next;
-										}
-										
-										if (dist_match) {
+									while (that_bp_list_by_element) {
+										if (that_bp_list_by_element->el == this_el) {
+											dist_match = true;
 											break;
 										}
+										
+										that_bp_list_by_element = that_bp_list_by_element->next;
+									}
+									
+									if (dist_match) {
+										break;
 									}
-								}
-								
-								list_iterator_stop (& (*seq_bp)->stacks[i]);
-								
-								if (!dist_match) {
-									break;
 								}
 							}
-						}
-						
-						list_iterator_stop (min_stack_dist[i]);
-						list_iterator_stop (max_stack_dist[i]);
-						list_iterator_stop (in_extrusion[i]);
-						list_iterator_stop (dist_els[i]);
-						
-						if (!dist_match) {
-							break;
+							
+							list_iterator_stop (& (*seq_bp)->stacks[i]);
+							
+							if (!dist_match) {
+								break;
+							}
 						}
 					}
 					
-					if (i == MAX_STACK_LEN) {
-						COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
-						               "matching seq nt/seq_bp found in cache entry for seq (hash %lu) in get_seq_bp_from_cache",
-						               hash, false);
-					}
+					list_iterator_stop (min_stack_dist[i]);
+					list_iterator_stop (max_stack_dist[i]);
+					list_iterator_stop (in_extrusion[i]);
+					list_iterator_stop (dist_els[i]);
 					
-					else {
-						#ifdef MULTITHREADED_ON
-						pthread_mutex_unlock (&num_destruction_threads_mutex);
-						#endif
-						COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
-						               "incomplete seq_bp for seq nt found in cache entry for seq (hash %lu) in get_seq_bp_from_cache",
-						               hash, false);
-						return false;
+					if (!dist_match) {
+						break;
 					}
-					
-					#ifdef MULTITHREADED_ON
-					pthread_mutex_unlock (&num_destruction_threads_mutex);
-					#endif
-					return true;
 				}
+				
+				pin_seq_bp_cache_entry (entry, pin);
+				
+				if (i == MAX_STACK_LEN) {
+					seq_bp_cache_stats.num_hits++;
+					COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
+					               "matching seq nt/seq_bp found in cache entry for seq (hash %lu) in get_seq_bp_from_cache",
+					               hash, false);
+				}
+				
+				else {
+					seq_bp_cache_stats.num_misses++;
+					pthread_mutex_unlock (&seq_bp_cache_mutex);
+					COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
+					               "incomplete seq_bp for seq nt found in cache entry for seq (hash %lu) in get_seq_bp_from_cache",
+					               hash, false);
+					return false;
+				}
+				
+				pthread_mutex_unlock (&seq_bp_cache_mutex);
+				return true;
 			}
 			
-			list_iterator_stop (this_list);
+			slot = (slot + 1) & (seq_bp_cache_max_slots - 1);
 		}
 		
+		seq_bp_cache_stats.num_misses++;
 		COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
 		               "seq_bp for given seq nt not found in cache entry for seq (hash %lu) in get_seq_bp_from_cache",
 		               hash, false);
 		*seq_bp = NULL;
-		#ifdef MULTITHREADED_ON
-		pthread_mutex_unlock (&num_destruction_threads_mutex);
+		pthread_mutex_unlock (&seq_bp_cache_mutex);
 	}
 	
-		#endif
 	return false;
 }
 
+/*
+ * add the seq_bp of seq to the cache, pinning it until released using
+ * release_seq_bp_cache_pin; the least recently used seq_bps that are not pinned are
+ * evicted once the cache exceeds its memory budget (see set_seq_bp_cache_budget)
+ *
+ * output:  number of seq_bps cached; 0 on failure
+ */
 nt_seq_count add_seq_bp_to_cache (const ntp_seq restrict seq,
-                                  const nt_seq_hash hash, ntp_seq_bp restrict seq_bp) {
+                                  const nt_seq_hash hash, ntp_seq_bp restrict *seq_bp,
+                                  ntp_seq_bp_cache_pin restrict pin) {
 	COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
 	               "adding seq_bp of seq (hash %lu) to cache in add_seq_bp_to_cache", hash, true);
 	               
@@ -574,170 +2238,88 @@ nt_seq_count add_seq_bp_to_cache (const ntp_seq restrict seq,
 		return 0;
 	}
 	
-	#ifdef MULTITHREADED_ON
-	
-	if (pthread_mutex_lock (&num_destruction_threads_mutex) == 0) {
-	#endif
+	if (pthread_mutex_lock (&seq_bp_cache_mutex) == 0) {
+		const REGISTER
+		nt_abs_seq_len seq_len = (nt_abs_seq_len) strlen (seq);
 		// seq already in cache?
 		REGISTER
-		ntp_seq_bp restrict this_seq_bp = NULL;
-		REGISTER
-		ntp_seq_bp_cache_entry restrict seq_bp_cache_entry = (ntp_seq_bp_cache_entry)
-		                                        list_seek (seq_bp_cache, &hash);
-		REGISTER
-		ntp_list restrict this_list = NULL;
-		
-		if (seq_bp_cache_entry) {
-			COMMIT_DEBUG1 (REPORT_ERRORS, SEQ_BP_CACHE,
-			               "found seq_bp_cache_entry in seq_bp_cache for seq with hash (%lu) in add_seq_bp_to_cache",
-			               hash, false);
-			this_list = seq_bp_cache_entry->seq_list;
-			
-			if (this_list) {
-				REGISTER nt_list_posn this_list_size = this_list->numels;
-				
-				while (this_list_size) {
-					this_seq_bp = list_get_at (this_list, this_list_size - 1);
-					
-					if (this_seq_bp->model == seq_bp->model &&
-					    !strcmp (this_seq_bp->sequence, seq)) {
-						if (this_seq_bp == seq_bp) {
-							#ifdef MULTITHREADED_ON
-							pthread_mutex_unlock (&num_destruction_threads_mutex);
-							#endif
-							COMMIT_DEBUG (REPORT_WARNINGS, SEQ_BP_CACHE,
-							              "this_seq_bp in seq_list of seq_bp_cache_entry is identical to seq_bp and not replaced in add_seq_bp_to_cache",
-							              false);
-							return 1; // return positive value, given that original seq_bp is kept in place
-						}
-						
-						destroy_seq_bp (this_seq_bp);
-						
-						if (list_delete_at (this_list, this_list_size - 1) != 0) {
-							#ifdef MULTITHREADED_ON
-							pthread_mutex_unlock (&num_destruction_threads_mutex);
-							#endif
-							COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-							              "could not delete (to replace) this_seq_bp in seq_list of seq_bp_cache_entry in seq_bp_cache in add_seq_bp_to_cache",
-							              false);
-							return 0;
-						}
-						
-						if (list_insert_at (this_list, seq_bp, this_list_size - 1) < 0) {
-							COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
-							               "appended seq_bp (at position %lu) to seq_list of seq_bp_cache_entry in seq_bp_cache in add_seq_bp_to_cache",
-							               this_list_size, false);
-						}
-						
-						#ifdef MULTITHREADED_ON
-						pthread_mutex_unlock (&num_destruction_threads_mutex);
-						#endif
-						return (nt_seq_count) (list_locate (seq_bp_cache, seq_bp_cache_entry)) + 1;
-					}
-					
-					this_list_size--;
-				}
-			}
-			
-			COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
-			               "given seq not found in seq_bp_cache_entry of seq_bp_cache for seq with hash (%lu) in add_seq_bp_to_cache",
-			               hash, false);
-		}
+		nt_seq_count slot = get_seq_bp_cache_slot (hash, seq_len);
 		
-		// create new cache entry if required
-		if (!seq_bp_cache_entry) {
-			// create new seq entry and add to cache
-			seq_bp_cache_entry = MALLOC_DEBUG (sizeof (nt_seq_bp_cache_entry),
-			                                   "seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache");
-			                                   
-			if (!seq_bp_cache_entry) {
-				#ifdef MULTITHREADED_ON
-				pthread_mutex_unlock (&num_destruction_threads_mutex);
-				#endif
-				COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-				              "could not allocate memory for seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache",
-				              false);
-				return 0;
-			}
-			
-			COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-			              "allocated seq_bp_cache_entry for seq_bp_cache in add_seq_bp_to_cache", false);
-			seq_bp_cache_entry->seq_hash = hash;
-			seq_bp_cache_entry->seq_list = MALLOC_DEBUG (sizeof (nt_list),
-			                                        "seq_list in seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache");
-			this_list = seq_bp_cache_entry->seq_list;
+		while (seq_bp_cache[slot]) {
+			REGISTER
+			ntp_seq_bp_cache_entry restrict entry = seq_bp_cache[slot];
+			REGISTER
+			ntp_seq_bp restrict this_seq_bp = entry->seq_bp;
 			
-			if (this_list) {
-				if ((list_init (this_list) < 0) ||
-				    (list_append (seq_bp_cache, seq_bp_cache_entry) < 0)) {
-					#ifdef MULTITHREADED_ON
-					pthread_mutex_unlock (&num_destruction_threads_mutex);
-					#endif
-					COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-					              "could not init/append seq_list in seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache",
+			if (entry->seq_hash == hash && entry->seq_len == seq_len &&
+			    this_seq_bp->model == (*seq_bp)->model && !strcmp (this_seq_bp->sequence, seq)) {
+				if (this_seq_bp == *seq_bp) {
+					COMMIT_DEBUG (REPORT_WARNINGS, SEQ_BP_CACHE,
+					              "this_seq_bp in seq_bp_cache is identical to seq_bp and not replaced in add_seq_bp_to_cache",
 					              false);
-					FREE_DEBUG (seq_bp_cache_entry,
-					            "seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache [failed to init/append seq_list]");
-					return 0;
 				}
 				
 				else {
-					COMMIT_DEBUG (REPORT_INFO, SEQ_BP_CACHE,
-					              "allocated seq_list in seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache",
-					              false);
+					// a concurrent search has already cached seq_bp for this seq and model;
+					// keep that copy, which other searches may be using, and drop ours
+					destroy_seq_bp (*seq_bp);
+					*seq_bp = this_seq_bp;
+					COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
+					               "kept previously cached seq_bp for seq with hash (%lu) in add_seq_bp_to_cache",
+					               hash, false);
 				}
+				
+				pin_seq_bp_cache_entry (entry, pin);
+				REGISTER
+				nt_seq_count num_entries = seq_bp_cache_stats.num_entries;
+				pthread_mutex_unlock (&seq_bp_cache_mutex);
+				return num_entries;
 			}
 			
-			else {
-				#ifdef MULTITHREADED_ON
-				pthread_mutex_unlock (&num_destruction_threads_mutex);
-				#endif
-				COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-				              "could not allocate memory for seq_list in seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache",
-				              false);
-				FREE_DEBUG (seq_bp_cache_entry,
-				            "seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache [failed to allocate seq_list]");
-				return 0;
-			}
+			slot = (slot + 1) & (seq_bp_cache_max_slots - 1);
 		}
 		
-		// append nt_seq_bp to seq_list of nt_seq_bp_cache_entry
-		REGISTER int l;
+		// keep at least twice as many slots as entries
+		if ((seq_bp_cache_stats.num_entries + 1) * 2 > seq_bp_cache_max_slots &&
+		    !rehash_seq_bp_cache()) {
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
+			return 0;
+		}
 		
-		if ((list_append (this_list, seq_bp) < 0) ||
-		    ((l = list_locate (seq_bp_cache, seq_bp_cache_entry)) < 0)) {
+		REGISTER
+		ntp_seq_bp_cache_entry restrict entry = MALLOC_DEBUG (sizeof (
+		                                        nt_seq_bp_cache_entry), "entry of seq_bp_cache in add_seq_bp_to_cache");
+		                                        
+		if (!entry) {
+			pthread_mutex_unlock (&seq_bp_cache_mutex);
 			COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-			              "could not append/confirm seq_bp to seq_list in seq_bp_cache_entry of add_seq_bp_to_cache",
+			              "could not allocate memory for entry of seq_bp_cache in add_seq_bp_to_cache",
 			              false);
-			              
-			// destroy cache entry if empty
-			if (!this_list->numels) {
-				list_destroy (this_list);
-				FREE_DEBUG (this_list,
-				            "seq_list of seq_bp_cache_entry in seq_bp_cache in add_seq_bp_to_cache [failed to append bp to seq_list]");
-				FREE_DEBUG (seq_bp_cache_entry,
-				            "seq_bp_cache_entry of seq_bp_cache in add_seq_bp_to_cache [failed to append bp to seq_list]");
-				COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-				              "removed seq_bp_cache_entry from seq_bp_cache in add_seq_bp_to_cache", false);
-			}
-			
-			#ifdef MULTITHREADED_ON
-			pthread_mutex_unlock (&num_destruction_threads_mutex);
-			#endif
 			return 0;
 		}
 		
-		#ifdef MULTITHREADED_ON
-		pthread_mutex_unlock (&num_destruction_threads_mutex);
-		#endif
+		entry->seq_bp = *seq_bp;
+		entry->seq_hash = hash;
+		entry->seq_len = seq_len;
+		entry->id = seq_bp_cache_next_id++;
+		entry->num_bytes = get_seq_bp_size (*seq_bp);
+		entry->num_pins = 0;
+		entry->lru_prev = NULL;
+		entry->lru_next = NULL;
+		insert_seq_bp_cache_entry (entry);
+		pin_seq_bp_cache_entry (entry, pin);
+		seq_bp_cache_stats.num_entries++;
+		seq_bp_cache_stats.num_bytes += entry->num_bytes;
+		evict_seq_bp_cache_entries();
+		REGISTER
+		nt_seq_count num_entries = seq_bp_cache_stats.num_entries;
+		pthread_mutex_unlock (&seq_bp_cache_mutex);
 		COMMIT_DEBUG1 (REPORT_INFO, SEQ_BP_CACHE,
-		               "appended seq_bp (at position %d) to seq_list of seq_bp_cache_entry in seq_bp_cache in add_seq_bp_to_cache",
-		               l + 1, false);
-		return ((nt_seq_count) l + 1);
-		#ifdef MULTITHREADED_ON
+		               "added seq_bp of seq (hash %lu) to seq_bp_cache in add_seq_bp_to_cache",
+		               hash, false);
+		return num_entries;
 	}
 	
-		#endif
 	return 0;
 }
 
@@ -755,6 +2337,14 @@ bool get_seq_bp_from_seq (const ntp_seq restrict seq, nt_model *restrict model,
 		return false;
 	}
 	
+	if (strlen (seq) > MAX_REL_SEQ_LEN) {
+		COMMIT_DEBUG1 (REPORT_ERRORS, SEQ_BP_CACHE,
+		               "seq exceeds maximum window length (%u) in get_seq_bp_from_seq",
+		               MAX_REL_SEQ_LEN, false);
+		*seq_bp = NULL;
+		return false;
+	}
+	
 	const REGISTER
 	nt_rel_seq_len seq_len = (nt_rel_seq_len) strlen (seq);
 	
@@ -821,9 +2411,6 @@ bool get_seq_bp_from_seq (const ntp_seq restrict seq, nt_model *restrict model,
 		}
 		
 		REGISTER nt_stack_size stack_len;
-		REGISTER nt fp_nt, tp_nt;
-		REGISTER bool to_ignore;
-		REGISTER nt_rel_seq_posn p, q;
 		#ifdef DEBUG_MEM
 		unsigned long s_num_entries, e_num_entries, s_alloc_size, e_alloc_size;
 		MALLOC_CP (&s_num_entries, &s_alloc_size);
@@ -915,7 +2502,27 @@ bool get_seq_bp_from_seq (const ntp_seq restrict seq, nt_model *restrict model,
 			}
 		}
 		
-		// find all stacks of MIN_STACK_LEN<=size<=MAX_STACK_LEN
+		// get the model-independent bp stack index of seq, and from it the stacks of
+		// MIN_STACK_LEN<=size<=MAX_STACK_LEN that this model's elements refer to
+		REGISTER
+		ntp_seq_bp_index index = get_seq_bp_index (seq, seq_len);
+		
+		if (!index) {
+			COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+			              "could not get seq_bp_index in get_seq_bp_from_seq", false);
+			              
+			if (!from_cache) {
+				// seq_bp not from cache -> can destroy here
+				destroy_seq_bp (*seq_bp);
+				*seq_bp = NULL;
+			}
+			
+			#ifdef MULTITHREADED_ON
+			pthread_mutex_unlock (&num_destruction_threads_mutex);
+			#endif
+			return false;
+		}
+		
 		for (stack_len = MIN_STACK_LEN - 1; stack_len < MAX_STACK_LEN; stack_len++) {
 			if (MIN_IDIST + ((stack_len + 1) * 2) > seq_len) {
 				break;
@@ -979,11 +2586,54 @@ bool get_seq_bp_from_seq (const ntp_seq restrict seq, nt_model *restrict model,
 					ntp_bp_list_by_element new_bp_list_by_element = create_seq_bp_stack_by_element (
 					                                        *seq_bp, stack_len, this_stack_idist, this_in_extrusion, this_element
 					                                        );
-					                                        
+					nt_rel_seq_posn *posns = NULL;
+					uint32_t num_posns = 0;
+					REGISTER
+					bool success = new_bp_list_by_element && get_seq_bp_index_posns (index, stack_len,
+					               this_stack_idist, this_in_extrusion, &posns, &num_posns);
+					               
 					if (!new_bp_list_by_element) {
 						COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
 						              "could not create new_bp_list_by_element in get_seq_bp_from_seq", false);
-						              
+					}
+					
+					else
+						if (success && num_posns > MAX_BP_PER_STACK_IDIST) {
+							COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+							              "MAX_BP_PER_STACK_IDIST exceeded for bp of seq_bp in get_seq_bp_from_seq",
+							              false);
+							success = false;
+						}
+						
+					
+					for (REGISTER uint32_t i = 0; success && i < num_posns; i++) {
+						REGISTER
+						ntp_bp bp = MALLOC_DEBUG (sizeof (nt_bp), NULL);
+						
+						if (bp) {
+							const REGISTER
+							nt_rel_seq_posn q = (nt_rel_seq_posn) (posns[i] + this_stack_idist +
+							                                       ((stack_len + 1) * 2) - 1);
+							bp->fp_posn = (nt_rel_seq_posn) (posns[i] + 1);     // 1-indexed
+							bp->tp_posn = (nt_rel_seq_posn) (q - stack_len + 1); // 1-indexed
+							
+							if (list_append (&new_bp_list_by_element->list, bp) < 0) {
+								FREE_DEBUG (bp, NULL);
+								bp = NULL;
+							}
+						}
+						
+						if (!bp) {
+							COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
+							              "could not allocate memory for bp/append to list of seq_bp in get_seq_bp_from_seq",
+							              false);
+							success = false;
+						}
+					}
+					
+					if (!success) {
+						release_seq_bp_index (index);
+						
 						if (!from_cache) {
 							// seq_bp not from cache -> can destroy here
 							destroy_seq_bp (*seq_bp);
@@ -1000,95 +2650,7 @@ bool get_seq_bp_from_seq (const ntp_seq restrict seq, nt_model *restrict model,
 						return false;
 					}
 					
-					REGISTER nt_hit_count hit_count = 0;
-					
-					/*
-					 * if this_in_extrusion != 0 (+ve => intrusion, -ve => extrusion) make sure seq_len covers respective 5' and 3' regions as well;
-					 * note that this_stack_idist *includes* any intruded nts
-					 */
-					if (seq_len + 1 > (this_stack_idist + ((stack_len + 1) * 2) +
-					                   (this_in_extrusion < 0 ? - (this_in_extrusion * 2) : 0))) {
-						for (p = (nt_rel_seq_posn) (this_in_extrusion < 0 ? -this_in_extrusion : 0);
-						     p < seq_len + 1 - this_stack_idist - ((stack_len + 1) * 2) -
-						     (this_in_extrusion < 0 ? -this_in_extrusion : 0); p++) {
-							for (q = (nt_rel_seq_posn) (p + this_stack_idist + ((stack_len + 1) * 2) - 1);
-							     q < SAFE_MIN (seq_len, p + this_stack_idist + ((stack_len + 1) * 2)); q++) {
-								to_ignore = 0;
-								
-								// depending on whether this_in_extrusion is +ve or -ve;
-								// add to r (intrude) when +ve
-								// subtract from r (extrude) when -ve
-								for (REGISTER short r = (short) (this_in_extrusion < 0 ? this_in_extrusion : 0);
-								     r <= stack_len + (this_in_extrusion < 0 ? 0 : this_in_extrusion); r++) {
-									fp_nt = seq[p + r];
-									tp_nt = seq[q - r];
-									
-									if (! ((fp_nt == 'g' && (tp_nt == 'c' || tp_nt == 'u')) ||
-									       (fp_nt == 'a' && tp_nt == 'u') ||
-									       (tp_nt == 'g' && (fp_nt == 'c' || fp_nt == 'u')) ||
-									       (tp_nt == 'a' && fp_nt == 'u'))) {
-										to_ignore = 1;
-										break;
-									}
-								}
-								
-								if (!to_ignore) {
-									hit_count++;
-									
-									if (MAX_BP_PER_STACK_IDIST >= hit_count) {
-										REGISTER
-										bool success = false;
-										REGISTER
-										ntp_bp bp = MALLOC_DEBUG (sizeof (nt_bp), NULL);
-										
-										if (bp) {
-											bp->fp_posn = (nt_rel_seq_posn) (p + 1);         // 1-indexed
-											bp->tp_posn = (nt_rel_seq_posn) (q - stack_len + 1); // 1-indexed
-											
-											//                                            if (list_append (&new_stack->list, bp)>=0)
-											if (list_append (&new_bp_list_by_element->list, bp) >= 0) {
-												success = true;
-											}
-										}
-										
-										if (!success) {
-											COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-											              "could not allocate memory for bp/append to list of seq_bp in get_seq_bp_from_seq",
-											              false);
-											              
-											if (bp) {
-												FREE_DEBUG (bp, NULL);
-											}
-											
-											if (!from_cache) {
-												// seq_bp not from cache -> can destroy here
-												destroy_seq_bp (*seq_bp);
-												*seq_bp = NULL;
-											}
-											
-											#ifdef MULTITHREADED_ON
-											pthread_mutex_unlock (&num_destruction_threads_mutex);
-											#endif
-											list_iterator_stop (min_stack_dist[stack_len]);
-											list_iterator_stop (max_stack_dist[stack_len]);
-											list_iterator_stop (in_extrusion[stack_len]);
-											list_iterator_stop (dist_els[stack_len]);
-											return false;
-										}
-									}
-									
-									else {
-										COMMIT_DEBUG (REPORT_ERRORS, SEQ_BP_CACHE,
-										              "MAX_BP_PER_STACK_IDIST exceeded for bp of seq_bp in get_seq_bp_from_seq",
-										              false);
-										return false;
-									}
-								}
-							}
-						}
-					}
-					
-					new_bp_list_by_element->stack_counts += hit_count;
+					new_bp_list_by_element->stack_counts += (nt_hit_count) num_posns;
 				}
 			}
 			
@@ -1098,6 +2660,8 @@ bool get_seq_bp_from_seq (const ntp_seq restrict seq, nt_model *restrict model,
 			list_iterator_stop (dist_els[stack_len]);
 		}
 		
+		release_seq_bp_index (index);
+		
 		#ifdef DEBUG_MEM
 		MALLOC_CP (&e_num_entries, &e_alloc_size);
 		COMMIT_DEBUG2 (REPORT_INFO, SEQ_BP_CACHE,
@@ -8,8 +8,44 @@
 #include "limits.h"
 #include "m_model.h"
 
+#ifndef SEQ_BP_CACHE_BUDGET
+	#define SEQ_BP_CACHE_BUDGET (256LLU * 1024 * 1024) // default memory budget (in bytes) of the seq_bp cache
+#endif
+#define MIN_SEQ_BP_CACHE_SLOTS 64                       // initial # of hash slots of the seq_bp cache
+#define SEQ_BP_INDEX_CACHE_SIZE 16                      // # of seqs whose (model-independent) bp stack index is kept
+#ifndef SEQ_BP_INDEX_PAIR_MASK_BUDGET
+	#define SEQ_BP_INDEX_PAIR_MASK_BUDGET (64LLU * 1024 * 1024) // max bytes of pair masks held by an index while in use
+#endif
+#define SEQ_BP_SHM_NAME "/srhs_seq_bp"                  // prefix of node-local shared seq_bp stores (see get_seq_bp_shm_name)
+#define SEQ_BP_SHM_MAX_NAME_LEN 31
+#ifndef SEQ_BP_SHM_SIZE
+	#define SEQ_BP_SHM_SIZE (1024LLU * 1024 * 1024)   // size (in bytes) of the shared seq_bp store, once created
+#endif
+
+typedef uint64_t nt_seq_bp_cache_id;
+
+/*
+ * pin on a cached seq_bp, which keeps the seq_bp from being evicted while a search
+ * (or its hits) still refer to it; id is 0 when no seq_bp is pinned
+ */
+typedef struct {
+	nt_seq_hash seq_hash;
+	nt_abs_seq_len seq_len;
+	nt_seq_bp_cache_id id;
+} nt_seq_bp_cache_pin, *ntp_seq_bp_cache_pin;
+
+typedef struct {
+	unsigned long long num_hits, num_misses, num_evictions;
+	unsigned long long num_shm_hits, num_shm_publishes;
+	nt_seq_count num_entries;
+	size_t num_bytes, budget;
+} nt_seq_bp_cache_stats, *ntp_seq_bp_cache_stats;
+
 bool initialize_seq_bp_cache();
 bool purge_seq_bp_cache_by_model (nt_model *restrict model);
+bool set_seq_bp_cache_budget (const size_t budget);
+bool get_seq_bp_cache_stats (ntp_seq_bp_cache_stats restrict stats);
+void release_seq_bp_cache_pin (ntp_seq_bp_cache_pin restrict pin);
 ntp_bp_list_by_element create_seq_bp_stack_by_element (ntp_seq_bp restrict
                                         seq_bp, const uchar idx, nt_stack_idist  this_stack_idist,
                                         short this_in_extrusion, ntp_element this_element);
@@ -18,15 +54,32 @@ bool get_seq_bp_from_cache (const ntp_seq restrict seq, const nt_seq_hash hash,
                             const nt_model *restrict model,
                             ntp_list *restrict min_stack_dist, ntp_list *restrict max_stack_dist,
                             ntp_list *restrict in_extrusion, ntp_list *restrict dist_els,
-                            REGISTER ntp_seq_bp restrict *seq_bp);
+                            REGISTER ntp_seq_bp restrict *seq_bp,
+                            ntp_seq_bp_cache_pin restrict pin);
 bool get_seq_bp_from_seq (const ntp_seq restrict seq, nt_model *restrict model,
                           ntp_list *restrict min_stack_dist, ntp_list *restrict max_stack_dist,
                           ntp_list *restrict in_extrusion, ntp_list *restrict dist_els,
                           ntp_seq_bp *restrict seq_bp);
 nt_seq_count add_seq_bp_to_cache (const ntp_seq restrict seq,
-                                  const nt_seq_hash hash, ntp_seq_bp restrict seq_bp);
+                                  const nt_seq_hash hash, ntp_seq_bp restrict *seq_bp,
+                                  ntp_seq_bp_cache_pin restrict pin);
 bool finalize_seq_bp_cache();
 
+void get_seq_bp_shm_name (const ushort instance,
+                          char name[SEQ_BP_SHM_MAX_NAME_LEN + 1]);
+void remove_seq_bp_shm_store (const char *restrict name);
+bool initialize_seq_bp_shm_store (const char *restrict name, const size_t size);
+void finalize_seq_bp_shm_store();
+bool get_seq_bp_from_shm_store (const ntp_seq restrict seq,
+                                const nt_seq_hash hash, nt_model *restrict model,
+                                const nt_model_plan *restrict plan, const ushort *restrict model_sig,
+                                const uint32_t model_sig_len, ntp_seq_bp *restrict seq_bp);
+bool publish_seq_bp_to_shm_store (const ntp_seq restrict seq,
+                                  const nt_seq_hash hash, ntp_seq_bp restrict seq_bp,
+                                  const ushort *restrict model_sig, const uint32_t model_sig_len);
+                                  
 void destroy_seq_bp (ntp_seq_bp restrict seq_bp);
+ntp_seq_bp copy_seq_bp (ntp_seq_bp restrict seq_bp,
+                        nt_model *restrict model_copy);
 
 #endif //RNA_M_SEQ_BP_H
@@ -1199,7 +1199,8 @@ static inline float score_constraint_fe (ntp_linked_bp linked_bp,
 	short last_element_found_idx = -1, this_element_idx = 0;
 	ntp_constraint last_constraint_found = NULL;
 	bool first_constraint_element_found = false;
-	uchar first_element_idx = 0, first_element_length = 0;
+	nt_rel_seq_posn first_element_idx = 0;
+	nt_rel_seq_len first_element_length = 0;
 	nt_rel_seq_posn cp1_fp_idx = 0, cp1_tp_idx = 0, cp2_fp_idx = 0,
 	                cp2_tp_idx = 0;    // constraint seq indices (0-indexed positions) 1 and 2
 	float cum_constraint_fe = 0.0f;
@@ -1222,14 +1223,14 @@ static inline float score_constraint_fe (ntp_linked_bp linked_bp,
 							last_constraint_found = this_fp_element->unpaired->i_constraint.reference;
 							
 							if (this_linked_bp->bp->fp_posn) {
-								first_element_idx = (uchar) (this_linked_bp->bp->fp_posn +
-								                             this_linked_bp->stack_len - 1 + this_fp_element->unpaired->dist);
+								first_element_idx = (nt_rel_seq_posn) (this_linked_bp->bp->fp_posn +
+								                                       this_linked_bp->stack_len - 1 + this_fp_element->unpaired->dist);
 							}
 							
 							else {
 								// use next_linked_bp if this_linked_bp is a wrapper
-								first_element_idx = (uchar) (next_linked_bp->bp->fp_posn - 2 -
-								                             this_fp_element->unpaired->dist);
+								first_element_idx = (nt_rel_seq_posn) (next_linked_bp->bp->fp_posn - 2 -
+								                                       this_fp_element->unpaired->dist);
 							}
 							
 							first_element_length = this_fp_element->unpaired->length;
@@ -1314,8 +1315,8 @@ static inline float score_constraint_fe (ntp_linked_bp linked_bp,
 						if (this_element_idx > last_element_found_idx) {
 							last_constraint_found = this_tp_element->unpaired->i_constraint.reference;
 							// note: can safely assume that tp_elements never apply to wrapper bps
-							first_element_idx = (uchar) (this_linked_bp->bp->tp_posn +
-							                             this_linked_bp->stack_len - 1 + this_tp_element->unpaired->dist);
+							first_element_idx = (nt_rel_seq_posn) (this_linked_bp->bp->tp_posn +
+							                                       this_linked_bp->stack_len - 1 + this_tp_element->unpaired->dist);
 							first_element_length = this_tp_element->unpaired->length;
 							last_element_found_idx = this_element_idx;
 							first_constraint_element_found = true;
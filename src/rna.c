@@ -81,6 +81,7 @@ typedef enum {
 	SI_SERVER,                 // server name or IP where scheduler interface is located
 	MPI_PORT_NAME,             // MPI port_name used for intercommunication between dispatch (allocate) and scan worker job
 	SCHED_JOB_ID,              // the (system) scheduler's assigned job id for a given scan worker running on a worker node
+	SEQ_BP_STORE,              // name of the shared seq_bp store of the scan workers on a worker node (see get_seq_bp_shm_name)
 	#endif
 	RNA_BIN_FILENAME,          // (optional) name of scanner binary file if used by distribute/dispatch
 	
@@ -216,6 +217,10 @@ static inline void get_option_string (int opt, char *strn) {
 		case SCHED_JOB_ID       :
 			sprintf (strn, "%s (--%s)", SCHED_JOB_ID_ARG_LONG, SCHED_JOB_ID_ARG_LONG);
 			break;
+			
+		case SEQ_BP_STORE       :
+			sprintf (strn, "%s (--%s)", SEQ_BP_STORE_ARG_LONG, SEQ_BP_STORE_ARG_LONG);
+			break;
 			#endif
 			
 		case RNA_BIN_FILENAME   :
@@ -548,8 +553,8 @@ static int filter (const char *server, unsigned short port,
 		DEBUG_NOW (REPORT_INFO, MAIN, "comparing input cssd to generated model");
 		
 		if (compare_CSSD_model_strings (ss, pos_var, model)) {
-			nt_seg_size fp_lead_min_span, fp_lead_max_span, tp_trail_min_span,
-			            tp_trail_max_span;
+			nt_rel_count fp_lead_min_span, fp_lead_max_span, tp_trail_min_span,
+			             tp_trail_max_span;
 			nt_stack_size stack_min_size, stack_max_size;
 			nt_stack_idist stack_min_idist, stack_max_idist;
 			ntp_element el_with_largest_stack = NULL;
@@ -568,6 +573,7 @@ static int filter (const char *server, unsigned short port,
 				                      stack_min_size, stack_max_size,
 				                      stack_min_idist, stack_max_idist,
 				                      tp_trail_min_span, tp_trail_max_span);
+				dump_filter_stats (stdout);
 			}
 			
 			else {
@@ -1015,6 +1021,289 @@ static inline void finish_hit_string (unsigned short hit_len) {
 	}
 }
 
+/*
+ * hits of a scan, streamed by scan_worker to dispatch (see send_scan_hit); each hit
+ * is held back in last_hit until the length of the next hit, which terminates it,
+ * is known
+ */
+typedef struct {
+	MPI_Comm intercomm;
+	ds_int32_field ref_id;
+	const char *job_id;
+	nt_abs_seq_posn start_posn;
+	const char *seq_strn;
+	uchar last_hit[DS_JOB_RESULT_HIT_FIELD_LENGTH];
+	int last_hit_len;
+	bool first_hit;
+} nt_scan_hit_stream;
+
+/*
+ * send_scan_hit:
+ *          hit sink for search_seq_to_sink, which converts the given hit to its
+ *          hit string and sends the previous hit of the stream to dispatch
+ *
+ * args:    hit linked_bp, search time since the previous hit,
+ *          stream of hits (nt_scan_hit_stream)
+ *
+ * returns: false if the hit could not be converted or sent, which aborts the
+ *          search; true otherwise
+ */
+static bool send_scan_hit (const nt_linked_bp *hit_linked_bp, float elapsed_time,
+                           void *stream_arg) {
+	nt_scan_hit_stream *stream = (nt_scan_hit_stream *) stream_arg;
+	bool no_err = true;
+	// first store job_id, search time, posn, mfe (S_HIT_DATA_LENGTH-1 chars off DS_JOB_RESULT_HIT_FIELD_LENGTH)
+	uchar hit_data[DS_JOB_RESULT_HIT_FIELD_LENGTH];
+	unsigned short hit_len = 0;
+	nt_abs_seq_posn fp_start = UINT_MAX, bp_fp_start = 0;
+	// default all position symbols to SS_NEUTRAL_HAIRPIN_RESIDUE
+	g_memset (hit, SS_NEUTRAL_HAIRPIN_RESIDUE, DS_JOB_RESULT_HIT_FIELD_LENGTH);
+	ntp_linked_bp linked_bp = (ntp_linked_bp) hit_linked_bp,
+	              next_linked_bp = NULL,
+	              mfe_linked_bp = linked_bp;
+	              
+	if (!linked_bp) {
+		DEBUG_NOW (REPORT_ERRORS, SCAN, "found NULL linked_bp");
+		return false;
+	}
+	
+	// cap search time reports (since the previous hit) at ~15mins
+	if (1000.0f <= elapsed_time) {
+		elapsed_time = 999.0f;
+	}
+	
+	// find most fp position wrt sequence origin
+	while (linked_bp) {
+		if (linked_bp->bp->fp_posn < fp_start) {
+			if (linked_bp->bp->fp_posn) {
+				fp_start = linked_bp->bp->fp_posn;
+			}
+			
+			else {
+				// if this is a wrapper bp, then keep track
+				// of the (real, bp) 5' position and set fp_start
+				// to the relevant  5' position upstream
+				bp_fp_start = fp_start;
+				nt_rel_seq_posn bp_fp_offset = 0;
+				ntp_element this_element = linked_bp->fp_elements;
+				
+				while (this_element) {
+					if (bp_fp_offset < this_element->unpaired->dist +
+					    this_element->unpaired->length) {
+						bp_fp_offset = this_element->unpaired->dist + this_element->unpaired->length;
+					}
+					
+					this_element = this_element->unpaired->next;
+				}
+				
+				fp_start -= bp_fp_offset;
+			}
+		}
+		
+		linked_bp = linked_bp->prev_linked_bp;
+	}
+	
+	linked_bp = mfe_linked_bp;
+	void *PK_refs[strlen (S_OPEN_PK)];
+	unsigned short num_PKs = 0;
+	
+	do {
+		if (DS_JOB_RESULT_HIT_FIELD_LENGTH - (S_HIT_DATA_LENGTH - 1) <
+		    linked_bp->bp->tp_posn + linked_bp->stack_len - 1) {
+			no_err = false;
+			break;
+		}
+		
+		for (uchar l = 0; l < linked_bp->stack_len; l++) {
+			hit[linked_bp->bp->fp_posn + l - fp_start] = (uchar) SS_NEUTRAL_OPEN_TERM;
+			hit[linked_bp->bp->tp_posn + l - fp_start] = (uchar) SS_NEUTRAL_CLOSE_TERM;
+		}
+		
+		// calculate hit length
+		if (linked_bp->bp->tp_posn &&  // wrapper bps does not influence hit length
+		    hit_len < linked_bp->bp->tp_posn + linked_bp->stack_len - fp_start) {
+			hit_len = (unsigned short) (linked_bp->bp->tp_posn + linked_bp->stack_len -
+			                            fp_start);
+		}
+		
+		uchar el_dist = 0;     // cumulative distance between fp/tp closing bps
+		
+		for (uchar el_it = 0; el_it < 2; el_it++) {
+			if ((el_it == 0 && linked_bp->fp_elements) || (el_it == 1 &&
+			                                        linked_bp->tp_elements)) {
+				REGISTER
+				ntp_element this_element = el_it ? linked_bp->tp_elements :
+				                           linked_bp->fp_elements;
+				                           
+				do {
+					uchar this_symbol = SS_NEUTRAL_HAIRPIN_RESIDUE;
+					
+					if (this_element->unpaired->i_constraint.reference->type ==
+					    pseudoknot) {
+						// for PKs, do not use "neutral" symbols, but use all available (S_)
+						// symbols to provide representational clarity to the user;
+						// keep track of i_constraint.references to map to the appropriate symbol
+						unsigned short this_pk_idx = 0;
+						
+						while (this_pk_idx < num_PKs) {
+							if (PK_refs[this_pk_idx] == this_element->unpaired->i_constraint.reference) {
+								break;
+							}
+							
+							this_pk_idx++;
+						}
+						
+						// new PK reference -> store for future reference
+						if (this_pk_idx == num_PKs) {
+							num_PKs++;
+							PK_refs[this_pk_idx] = this_element->unpaired->i_constraint.reference;
+						}
+						
+						if (this_element->unpaired->i_constraint.element_type ==
+						    constraint_fp_element) {
+							this_symbol = S_OPEN_PK[this_pk_idx];
+						}
+						
+						else {
+							this_symbol = S_CLOSE_PK[this_pk_idx];
+						}
+					}
+					
+					else
+						if (this_element->unpaired->i_constraint.reference->type ==
+						    base_triple) {
+							if (this_element->unpaired->i_constraint.element_type == constraint_fp_element
+							    ||
+							    this_element->unpaired->i_constraint.element_type == constraint_tp_element) {
+								this_symbol = SS_NEUTRAL_BT_PAIR;
+							}
+							
+							else {
+								this_symbol = SS_NEUTRAL_BT_SINGLE;
+							}
+						}
+						
+					if (!next_linked_bp ||
+					    this_element->unpaired->next_linked_bp == next_linked_bp) {
+						if (el_it && DS_JOB_RESULT_HIT_FIELD_LENGTH - (S_HIT_DATA_LENGTH - 1) <
+						    linked_bp->bp->tp_posn + linked_bp->stack_len - 1 +
+						    this_element->unpaired->dist - el_dist + this_element->unpaired->length) {
+							no_err = false;
+							break;
+						}
+						
+						for (uchar l = 0; l < this_element->unpaired->length; l++) {
+							if (el_it) {
+								hit[linked_bp->bp->tp_posn + linked_bp->stack_len - fp_start +
+								                           this_element->unpaired->dist + l] =
+								                        this_symbol;
+							}
+							
+							else {
+								if (linked_bp->bp->fp_posn) {
+									hit[linked_bp->bp->fp_posn + linked_bp->stack_len - fp_start +
+									                           this_element->unpaired->dist + l] =
+									                        this_symbol;
+								}
+								
+								else {
+									hit[bp_fp_start - fp_start - this_element->unpaired->dist - l - 1] =
+									                    this_symbol;
+								}
+							}
+						}
+						
+						if (el_it &&
+						    (hit_len < linked_bp->bp->tp_posn + linked_bp->stack_len - fp_start +
+						     this_element->unpaired->dist + this_element->unpaired->length)) {
+							hit_len = (ushort) (linked_bp->bp->tp_posn + linked_bp->stack_len - fp_start
+							                    +
+							                    this_element->unpaired->dist + this_element->unpaired->length);
+						}
+					}
+					
+					this_element = this_element->unpaired->next;
+				}
+				while (this_element);
+			}
+			
+			if (!no_err) {
+				break;
+			}
+		}
+		
+		next_linked_bp = linked_bp;
+		linked_bp = linked_bp->prev_linked_bp;
+		
+		if (!linked_bp) {
+			break;
+		}
+	}
+	while (no_err);
+	
+	if (no_err) {
+		hit[hit_len] = '\0';
+		finish_hit_string (hit_len);
+		float this_mfe = get_turner_mfe_estimate (mfe_linked_bp, stream->seq_strn);
+		
+		if (STACK_MFE_FAILED == this_mfe) {
+			return false;
+		}
+		
+		sprintf ((char *) hit_data, "%019"PRId32"%c%s%c%09.5f%c%011d%c%+09.5f%c",
+		         stream->ref_id, S_HIT_SEPARATOR,
+		         stream->job_id, S_HIT_SEPARATOR,
+		         elapsed_time, S_HIT_SEPARATOR,
+		         stream->start_posn + fp_start - 1, S_HIT_SEPARATOR,
+		         this_mfe, S_HIT_SEPARATOR);
+	}
+	
+	else {
+		// error
+		sprintf ((char *) hit_data, "%019"PRId32"%c%s%c%09.5f%c%011d%c%+09.5f%c",
+		         stream->ref_id, S_HIT_SEPARATOR,
+		         stream->job_id, S_HIT_SEPARATOR,
+		         elapsed_time, S_HIT_SEPARATOR,
+		         0, S_HIT_SEPARATOR,
+		         0.0f, S_HIT_SEPARATOR);
+		hit_len = 0;
+		hit[0] = 0;
+	}
+	
+	if (0 < stream->last_hit_len) {
+		if (stream->first_hit) {
+			stream->first_hit = false;
+			// precede the first hit with a WORKER_STATUS_HAS_RESULT control message
+			uchar w_msg[WORKER_MSG_SZ];
+			w_msg[0] = WORKER_STATUS_HAS_RESULT;
+			w_msg[1] = (uchar) stream->last_hit_len;
+			
+			// block on send - should not do any further processing before current result set is received by dispatch
+			if (MPI_SUCCESS != MPI_Send (w_msg, WORKER_MSG_SZ, WORKER_MSG_MPI_TYPE, 0, 0,
+			                             stream->intercomm)) {
+				DEBUG_NOW (REPORT_ERRORS, SCAN, "cannot send message to dispatch");
+				return false;
+			}
+		}
+		
+		// send previous hit terminated by length of the current hit
+		stream->last_hit[stream->last_hit_len - 1] = (uchar) (hit_len + (S_HIT_DATA_LENGTH - 1));
+		
+		if (MPI_SUCCESS != MPI_Send (stream->last_hit, stream->last_hit_len,
+		                             WORKER_MSG_PAYLOAD_TYPE, 0, 0, stream->intercomm)) {
+			DEBUG_NOW (REPORT_ERRORS, SCAN, "cannot send message to dispatch");
+			return false;
+		}
+	}
+	
+	// loose trailing \0 in hit_data
+	stream->last_hit_len = hit_len + (S_HIT_DATA_LENGTH - 1);
+	g_memcpy (stream->last_hit, hit_data, S_HIT_DATA_LENGTH - 2);
+	g_memcpy (&stream->last_hit[S_HIT_DATA_LENGTH - 2], hit, hit_len);
+	// a hit that could not be converted ends the stream, with an (empty) error hit
+	return no_err;
+}
+
 /*
  * scan_worker:
  *          launch an rna scan worker as an MPI job,
@@ -1022,12 +1311,14 @@ static inline void finish_hit_string (unsigned short hit_len) {
  *          secondary structure and positional variables
  *
  * args:    assigned MPI job id, MPI port name (from ompi-server),
+ *          name of the shared seq_bp store (if any, see get_seq_bp_shm_name),
 *           secondary structure and positional variables,
  *          sequence string
  *
  * returns: EXEC_SUCCESS/EXEC_FAILURE
  */
-static int scan_worker (const char *sched_job_id, char *mpi_port_name) {
+static int scan_worker (const char *sched_job_id, char *mpi_port_name,
+                        const char *seq_bp_shm_name) {
 	char *ss_strn, *pos_var_strn, *seq_strn;
 	int ret_val = EXIT_SUCCESS;
 
@@ -1100,8 +1391,24 @@ static int scan_worker (const char *sched_job_id, char *mpi_port_name) {
 	}
 	
 	#endif
-	
-	if (initialize_seq_bp_cache()) {
+	ntp_search_context search_context = NULL;
+	
+	if (initialize_seq_bp_cache() && (search_context = create_search_context())) {
+		// scan jobs should complete with hits, even if their searches are large (within
+		// MAX_LARGE_SEARCH_MEM and MAX_LARGE_SEARCH_TIME_S)
+		search_context->large_search = true;
+		// scan workers are scheduled one per core, alongside other scan workers on the
+		// node, so keep the threads of partitioned searches to the cores allotted
+		set_max_search_threads (get_num_available_cores());
+		
+		// share the seq_bps built by this worker with other workers of the same dispatch
+		// instance on the same node
+		if (strlen (seq_bp_shm_name) &&
+		    !initialize_seq_bp_shm_store (seq_bp_shm_name, SEQ_BP_SHM_SIZE)) {
+			DEBUG_NOW (REPORT_WARNINGS, SCAN,
+			           "could not map shared seq_bp store, continuing without");
+		}
+		
 		unsigned short d_msg[DISPATCH_MSG_SZ];
 		d_msg[0] = 10;
 		// MPI message handling flag/request
@@ -1226,282 +1533,23 @@ static int scan_worker (const char *sched_job_id, char *mpi_port_name) {
 						else {
 							if (compare_CSSD_model_strings (ss_strn, pos_var_strn, model)) {
 								float elapsed_time = 0;
-								// execute this query
-								REGISTER ntp_list found_list = search_seq (seq_strn, model, &elapsed_time
-								                                        #ifdef SEARCH_SEQ_DETAIL
-								                                        , NULL, 0
-								                                        #endif
-								                                          );
-								int   last_hit_len = 0;
-								uchar last_hit[DS_JOB_RESULT_HIT_FIELD_LENGTH];
-								bool  first_hit = true;
-								
-								if (found_list && list_size (found_list) &&
-								    list_iterator_start (found_list)) {
-									// distribute time cost evenly across number of found hits
-									elapsed_time = elapsed_time / list_size (found_list);
-									
-									// cap (averaged per hit) search time reports at ~15mins
-									if (1000.0f <= elapsed_time) {
-										elapsed_time = 999.0f;
-									}
-									
-									bool no_err = true;
-									// first store job_id, search time, posn, mfe (S_HIT_DATA_LENGTH-1 chars off DS_JOB_RESULT_HIT_FIELD_LENGTH)
-									uchar hit_data[DS_JOB_RESULT_HIT_FIELD_LENGTH];
-									
-									while (no_err && list_iterator_hasnext (found_list)) {
-										unsigned short hit_len = 0;
-										nt_abs_seq_posn fp_start = UINT_MAX, bp_fp_start = 0;
-										// default all position symbols to SS_NEUTRAL_HAIRPIN_RESIDUE
-										g_memset (hit, SS_NEUTRAL_HAIRPIN_RESIDUE, DS_JOB_RESULT_HIT_FIELD_LENGTH);
-										ntp_linked_bp linked_bp = (ntp_linked_bp) list_iterator_next (found_list),
-										              next_linked_bp = NULL,
-										              mfe_linked_bp = linked_bp;
-										              
-										if (!linked_bp) {
-											DEBUG_NOW (REPORT_ERRORS, SCAN, "found NULL linked_bp");
-											no_err = false;
-											continue;
-										}
-										
-										// find most fp position wrt sequence origin
-										while (linked_bp) {
-											if (linked_bp->bp->fp_posn < fp_start) {
-												if (linked_bp->bp->fp_posn) {
-													fp_start = linked_bp->bp->fp_posn;
-												}
-												
-												else {
-													// if this is a wrapper bp, then keep track
-													// of the (real, bp) 5' position and set fp_start
-													// to the relevant  5' position upstream
-													bp_fp_start = fp_start;
-													nt_rel_seq_posn bp_fp_offset = 0;
-													ntp_element this_element = linked_bp->fp_elements;
-													
-													while (this_element) {
-														if (bp_fp_offset < this_element->unpaired->dist +
-														    this_element->unpaired->length) {
-															bp_fp_offset = this_element->unpaired->dist + this_element->unpaired->length;
-														}
-														
-														this_element = this_element->unpaired->next;
-													}
-													
-													fp_start -= bp_fp_offset;
-												}
-											}
-											
-											linked_bp = linked_bp->prev_linked_bp;
-										}
-										
-										linked_bp = mfe_linked_bp;
-										void *PK_refs[strlen (S_OPEN_PK)];
-										unsigned short num_PKs = 0;
-										
-										do {
-											if (DS_JOB_RESULT_HIT_FIELD_LENGTH - (S_HIT_DATA_LENGTH - 1) <
-											    linked_bp->bp->tp_posn + linked_bp->stack_len - 1) {
-												no_err = false;
-												break;
-											}
-											
-											for (uchar l = 0; l < linked_bp->stack_len; l++) {
-												hit[linked_bp->bp->fp_posn + l - fp_start] = (uchar) SS_NEUTRAL_OPEN_TERM;
-												hit[linked_bp->bp->tp_posn + l - fp_start] = (uchar) SS_NEUTRAL_CLOSE_TERM;
-											}
-											
-											// calculate hit length
-											if (linked_bp->bp->tp_posn &&  // wrapper bps does not influence hit length
-											    hit_len < linked_bp->bp->tp_posn + linked_bp->stack_len - fp_start) {
-												hit_len = (unsigned short) (linked_bp->bp->tp_posn + linked_bp->stack_len -
-												                            fp_start);
-											}
-											
-											uchar el_dist = 0;     // cumulative distance between fp/tp closing bps
-											
-											for (uchar el_it = 0; el_it < 2; el_it++) {
-												if ((el_it == 0 && linked_bp->fp_elements) || (el_it == 1 &&
-												                                        linked_bp->tp_elements)) {
-													REGISTER
-													ntp_element this_element = el_it ? linked_bp->tp_elements :
-													                           linked_bp->fp_elements;
-													                           
-													do {
-														uchar this_symbol = SS_NEUTRAL_HAIRPIN_RESIDUE;
-														
-														if (this_element->unpaired->i_constraint.reference->type ==
-														    pseudoknot) {
-															// for PKs, do not use "neutral" symbols, but use all available (S_)
-															// symbols to provide representational clarity to the user;
-															// keep track of i_constraint.references to map to the appropriate symbol
-															unsigned short this_pk_idx = 0;
-															
-															while (this_pk_idx < num_PKs) {
-																if (PK_refs[this_pk_idx] == this_element->unpaired->i_constraint.reference) {
-																	break;
-																}
-																
-																this_pk_idx++;
-															}
-															
-															// new PK reference -> store for future reference
-															if (this_pk_idx == num_PKs) {
-																num_PKs++;
-																PK_refs[this_pk_idx] = this_element->unpaired->i_constraint.reference;
-															}
-															
-															if (this_element->unpaired->i_constraint.element_type ==
-															    constraint_fp_element) {
-																this_symbol = S_OPEN_PK[this_pk_idx];
-															}
-															
-															else {
-																this_symbol = S_CLOSE_PK[this_pk_idx];
-															}
-														}
-														
-														else
-															if (this_element->unpaired->i_constraint.reference->type ==
-															    base_triple) {
-																if (this_element->unpaired->i_constraint.element_type == constraint_fp_element
-																    ||
-																    this_element->unpaired->i_constraint.element_type == constraint_tp_element) {
-																	this_symbol = SS_NEUTRAL_BT_PAIR;
-																}
-																
-																else {
-																	this_symbol = SS_NEUTRAL_BT_SINGLE;
-																}
-															}
-															
-														if (!next_linked_bp ||
-														    this_element->unpaired->next_linked_bp == next_linked_bp) {
-															if (el_it && DS_JOB_RESULT_HIT_FIELD_LENGTH - (S_HIT_DATA_LENGTH - 1) <
-															    linked_bp->bp->tp_posn + linked_bp->stack_len - 1 +
-															    this_element->unpaired->dist - el_dist + this_element->unpaired->length) {
-																no_err = false;
-																break;
-															}
-															
-															for (uchar l = 0; l < this_element->unpaired->length; l++) {
-																if (el_it) {
-																	hit[linked_bp->bp->tp_posn + linked_bp->stack_len - fp_start +
-																	                           this_element->unpaired->dist + l] =
-																	                        this_symbol;
-																}
-																
-																else {
-																	if (linked_bp->bp->fp_posn) {
-																		hit[linked_bp->bp->fp_posn + linked_bp->stack_len - fp_start +
-																		                           this_element->unpaired->dist + l] =
-																		                        this_symbol;
-																	}
-																	
-																	else {
-																		hit[bp_fp_start - fp_start - this_element->unpaired->dist - l - 1] =
-																		                    this_symbol;
-																	}
-																}
-															}
-															
-															if (el_it &&
-															    (hit_len < linked_bp->bp->tp_posn + linked_bp->stack_len - fp_start +
-															     this_element->unpaired->dist + this_element->unpaired->length)) {
-																hit_len = (ushort) (linked_bp->bp->tp_posn + linked_bp->stack_len - fp_start
-																                    +
-																                    this_element->unpaired->dist + this_element->unpaired->length);
-															}
-														}
-														
-														this_element = this_element->unpaired->next;
-													}
-													while (this_element);
-												}
-												
-												if (!no_err) {
-													break;
-												}
-											}
-											
-											next_linked_bp = linked_bp;
-											linked_bp = linked_bp->prev_linked_bp;
-											
-											if (!linked_bp) {
-												break;
-											}
-										}
-										while (no_err);
-										
-										if (no_err) {
-											hit[hit_len] = '\0';
-											finish_hit_string (hit_len);
-											float this_mfe = get_turner_mfe_estimate (mfe_linked_bp, seq_strn);
-											
-											if (STACK_MFE_FAILED == this_mfe) {
-												no_err = false;
-												break;
-											}
-											
-											sprintf ((char *) hit_data, "%019"PRId32"%c%s%c%09.5f%c%011d%c%+09.5f%c",
-											         ref_id, S_HIT_SEPARATOR,
-											         job_id, S_HIT_SEPARATOR,
-											         elapsed_time, S_HIT_SEPARATOR,
-											         start_posn + fp_start - 1, S_HIT_SEPARATOR,
-											         this_mfe, S_HIT_SEPARATOR);
-										}
-										
-										else {
-											// error
-											sprintf ((char *) hit_data, "%019"PRId32"%c%s%c%09.5f%c%011d%c%+09.5f%c",
-											         ref_id, S_HIT_SEPARATOR,
-											         job_id, S_HIT_SEPARATOR,
-											         elapsed_time, S_HIT_SEPARATOR,
-											         0, S_HIT_SEPARATOR,
-											         0.0f, S_HIT_SEPARATOR);
-											hit_len = 0;
-											hit[0] = 0;
-										}
-										
-										if (0 < last_hit_len) {
-											if (first_hit) {
-												first_hit = false;
-												// precede the first hit with a WORKER_STATUS_HAS_RESULT control message
-												uchar w_msg[WORKER_MSG_SZ];
-												w_msg[0] = WORKER_STATUS_HAS_RESULT;
-												w_msg[1] = (uchar) last_hit_len;
-												
-												// block on send - should not do any further processing before current result set is received by dispatch
-												if (MPI_SUCCESS != MPI_Send (w_msg, WORKER_MSG_SZ, WORKER_MSG_MPI_TYPE, 0, 0,
-												                             intercomm)) {
-													DEBUG_NOW (REPORT_ERRORS, SCAN, "cannot send message to dispatch");
-													no_err = false;
-													break;
-												}
-											}
-											
-											// send previous hit terminated by length of the current hit
-											last_hit[last_hit_len - 1] = (uchar) (hit_len + (S_HIT_DATA_LENGTH - 1));
-											
-											if (MPI_SUCCESS != MPI_Send (last_hit, last_hit_len, WORKER_MSG_PAYLOAD_TYPE,
-											                             0, 0, intercomm)) {
-												DEBUG_NOW (REPORT_ERRORS, SCAN, "cannot send message to dispatch");
-												no_err = false;
-												break;
-											}
-										}
-										
-										// loose trailing \0 in hit_data
-										last_hit_len = hit_len + (S_HIT_DATA_LENGTH - 1);
-										g_memcpy (last_hit, hit_data, S_HIT_DATA_LENGTH - 2);
-										g_memcpy (&last_hit[S_HIT_DATA_LENGTH - 2], hit, hit_len);
-									}
-									
-									list_iterator_stop (found_list);
-								}
-								
-								else {
+								nt_scan_hit_stream stream;
+								stream.intercomm = intercomm;
+								stream.ref_id = ref_id;
+								stream.job_id = job_id;
+								stream.start_posn = start_posn;
+								stream.seq_strn = seq_strn;
+								stream.last_hit_len = 0;
+								stream.first_hit = true;
+								// execute this query, sending each hit to dispatch as soon as it is found
+								search_seq_to_sink (search_context, seq_strn, model, send_scan_hit, &stream,
+								                    &elapsed_time
+								                    #ifdef SEARCH_SEQ_DETAIL
+								                    , NULL, 0
+								                    #endif
+								                   );
+								                   
+								if (!stream.last_hit_len) {
 									// no results found - send back result control message + 0-length hit data
 									uchar w_msg[WORKER_MSG_SZ],
 									      hit_data[S_HIT_DATA_LENGTH];
@@ -1531,12 +1579,12 @@ static int scan_worker (const char *sched_job_id, char *mpi_port_name) {
 									}
 								}
 								
-								if (found_list && list_size (found_list)) {
-									if (first_hit) {
+								else {
+									if (stream.first_hit) {
 										// precede the first hit with a WORKER_STATUS_HAS_RESULT control message
 										uchar w_msg[WORKER_MSG_SZ];
 										w_msg[0] = WORKER_STATUS_HAS_RESULT;
-										w_msg[1] = (uchar) last_hit_len;
+										w_msg[1] = (uchar) stream.last_hit_len;
 										
 										// block on send - should not do any further processing before current result set is received by dispatch
 										if (MPI_SUCCESS != MPI_Send (w_msg, WORKER_MSG_SZ, WORKER_MSG_MPI_TYPE, 0, 0,
@@ -1547,22 +1595,13 @@ static int scan_worker (const char *sched_job_id, char *mpi_port_name) {
 									}
 									
 									// flush last hit read + 0
-									last_hit[last_hit_len - 1] = 0;
+									stream.last_hit[stream.last_hit_len - 1] = 0;
 									
-									if (MPI_SUCCESS != MPI_Send (last_hit, last_hit_len, WORKER_MSG_PAYLOAD_TYPE,
-									                             0, 0, intercomm)) {
+									if (MPI_SUCCESS != MPI_Send (stream.last_hit, stream.last_hit_len,
+									                             WORKER_MSG_PAYLOAD_TYPE, 0, 0, intercomm)) {
 										DEBUG_NOW (REPORT_ERRORS, SCAN, "cannot send message to dispatch");
 										break;
 									}
-									
-									dispose_linked_bp_copy (model,
-									                        found_list,
-									                        "linked_bp_copy for safe_copy of found_list in validate_test",
-									                        "safe_copy of found_list in validate_test"
-									                        #ifndef NO_FULL_CHECKS
-									                        , "could not iterate over to free safe_copy of found_list in validate_test"
-									                        #endif
-									                       );
 								}
 							}
 							
@@ -1577,7 +1616,7 @@ static int scan_worker (const char *sched_job_id, char *mpi_port_name) {
 						free (ss_strn);
 						free (pos_var_strn);
 						free (seq_strn);
-						list_destroy_all_tagged();
+						list_destroy_all_tagged (&search_context->search_seq_list);
 					}
 				}
 				
@@ -1627,7 +1666,9 @@ static int scan_worker (const char *sched_job_id, char *mpi_port_name) {
 		}
 		
 		// scan iteration complete
+		destroy_search_context (search_context);
 		finalize_seq_bp_cache();
+		finalize_seq_bp_shm_store();
 		#ifdef MULTITHREADED_ON
 		
 		if (!wait_list_destruction()) {
@@ -1638,7 +1679,9 @@ static int scan_worker (const char *sched_job_id, char *mpi_port_name) {
 	}
 	
 	else {
-		DEBUG_NOW (REPORT_ERRORS, SCAN, "could not initialize sequence bp cache");
+		DEBUG_NOW (REPORT_ERRORS, SCAN,
+		           "could not initialize sequence bp cache or search context");
+		finalize_seq_bp_cache();
 		ret_val = EXIT_FAILURE;
 	}
 	
@@ -1795,6 +1838,7 @@ int main (int argc, char **argv) {
 		{ SI_PORT_ARG_LONG,         ko_required_argument,   SI_PORT },
 		{ MPI_PORT_NAME_ARG_LONG,   ko_required_argument,   MPI_PORT_NAME },
 		{ SCHED_JOB_ID_ARG_LONG,    ko_required_argument,   SCHED_JOB_ID },
+		{ SEQ_BP_STORE_ARG_LONG,    ko_required_argument,   SEQ_BP_STORE },
 		#endif
 		{ RNA_BIN_FILENAME_ARG_LONG, ko_required_argument,    RNA_BIN_FILENAME },
 		{ DS_SERVER_ARG_LONG,       ko_required_argument,   DS_SERVER },
@@ -1840,6 +1884,7 @@ int main (int argc, char **argv) {
 	        si_server[HOST_NAME_MAX + 1],
 	        mpi_port_name[1000 + 1],
 	        sched_job_id[JS_JOBSCHED_MAX_FULL_JOB_ID_LEN + 1],
+	        seq_bp_shm_name[SEQ_BP_SHM_MAX_NAME_LEN + 1],
 	        #endif
 	        RNA_bin_fn[MAX_FILENAME_LENGTH + 1],
 	        ds_server[HOST_NAME_MAX + 1],
@@ -1879,6 +1924,7 @@ int main (int argc, char **argv) {
 	si_server[0] = '\0';
 	mpi_port_name[0] = '\0';
 	sched_job_id[0] = '\0';
+	seq_bp_shm_name[0] = '\0';
 	#endif
 	RNA_bin_fn[0] = '\0';
 	ds_server[0] = '\0';
@@ -2210,6 +2256,21 @@ int main (int argc, char **argv) {
 						break;
 					}
 					
+				case SEQ_BP_STORE:
+					if (strlen (seq_bp_shm_name) > 0 || strlen (opt.arg) > SEQ_BP_SHM_MAX_NAME_LEN) {
+						get_option_string (SEQ_BP_STORE, option);
+						DEBUG_NOW2 (REPORT_ERRORS, MAIN, "%s: duplicate or invalid '%s'", argv[0],
+						            option);
+						err = true;
+						break;
+					}
+					
+					else {
+						strcpy (seq_bp_shm_name, opt.arg);
+						done = true;
+						break;
+					}
+					
 					#endif
 					
 				case RNA_BIN_FILENAME:
@@ -2665,10 +2726,12 @@ int main (int argc, char **argv) {
 					}
 					
 					else {
-						// scan mode: either ss, pos_var (possibly empty), and seq_nt; or, sched_job_id and mpi_port_name
+						// scan mode: either ss, pos_var (possibly empty), and seq_nt; or, sched_job_id and mpi_port_name,
+						// and (optionally) seq_bp_shm_name
 						// TODO: this way, another argument, and not pos_var, may be supplied and treated as empty pos_var - need FIX
 						if (! ((strlen (ss) && strlen (seq_strn) && num_opts == 4) ||
-						       (strlen (sched_job_id) && strlen (mpi_port_name) && num_opts == 3))) {
+						       (strlen (sched_job_id) && strlen (mpi_port_name) &&
+						        num_opts == 3 + (strlen (seq_bp_shm_name) ? 1 : 0)))) {
 							DEBUG_NOW1 (REPORT_ERRORS, MAIN, "%s: incorrect number of arguments supplied",
 							            argv[0]);
 							break;
@@ -2690,7 +2753,7 @@ int main (int argc, char **argv) {
 						}
 						
 						else {
-							return scan_worker (sched_job_id, mpi_port_name) ?
+							return scan_worker (sched_job_id, mpi_port_name, seq_bp_shm_name) ?
 							       EXEC_SUCCESS : EXEC_FAILURE;
 						}
 					};
@@ -10,6 +10,7 @@
 #if JS_JOBSCHED_TYPE!=JS_NONE
 	#define MPI_PORT_NAME_ARG_LONG      "mpi-port-name"
 	#define SCHED_JOB_ID_ARG_LONG       "sched-job-id"
+	#define SEQ_BP_STORE_ARG_LONG       "seq-bp-store"
 #endif
 
 #endif //RNA_RNA_H
@@ -3,6 +3,15 @@
 #include "m_model.h"
 #include "interface.h"
 
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
 nt_seq_hash get_seq_hash (const char *sequence) {
 	if (!sequence || strlen (sequence) == 0) {
 		COMMIT_DEBUG (REPORT_WARNINGS, SEQ,
@@ -166,3 +175,205 @@ bool read_seq_from_fn (const char *fn, char **buff, nt_file_size *fsize) {
 	fclose (f);
 	return true;
 }
+
+bool open_fasta (const char *fn, fasta_reader *reader) {
+	memset (reader, 0, sizeof (fasta_reader));
+	
+	if (!fn || strlen (fn) == 0) {
+		DEBUG_NOW (REPORT_ERRORS, UTILS, "invalid sequence filename");
+		return false;
+	}
+	
+	#ifdef _WIN32
+	reader->file = CreateFile (fn, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+	                           FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	                           
+	if (reader->file == INVALID_HANDLE_VALUE) {
+		DEBUG_NOW1 (REPORT_ERRORS, UTILS, "could not open sequence file '%s'", fn);
+		return false;
+	}
+	
+	LARGE_INTEGER file_size;
+	
+	if (!GetFileSizeEx (reader->file, &file_size)) {
+		DEBUG_NOW1 (REPORT_ERRORS, UTILS, "could not get size of sequence file '%s'",
+		            fn);
+		CloseHandle (reader->file);
+		return false;
+	}
+	
+	reader->size = (nt_file_size) file_size.QuadPart;
+	
+	if (reader->size) {
+		reader->mapping = CreateFileMapping (reader->file, NULL, PAGE_READONLY, 0, 0,
+		                                     NULL);
+		                                     
+		if (reader->mapping) {
+			reader->data = MapViewOfFile (reader->mapping, FILE_MAP_READ, 0, 0, 0);
+		}
+		
+		if (!reader->data) {
+			DEBUG_NOW1 (REPORT_ERRORS, UTILS, "could not map sequence file '%s'", fn);
+			
+			if (reader->mapping) {
+				CloseHandle (reader->mapping);
+			}
+			
+			CloseHandle (reader->file);
+			return false;
+		}
+	}
+	
+	#else
+	reader->fd = open (fn, O_RDONLY);
+	
+	if (reader->fd < 0) {
+		DEBUG_NOW1 (REPORT_ERRORS, UTILS, "could not open sequence file '%s'", fn);
+		return false;
+	}
+	
+	struct stat file_stat;
+	
+	if (fstat (reader->fd, &file_stat)) {
+		DEBUG_NOW1 (REPORT_ERRORS, UTILS, "could not get size of sequence file '%s'",
+		            fn);
+		close (reader->fd);
+		return false;
+	}
+	
+	reader->size = (nt_file_size) file_stat.st_size;
+	
+	if (reader->size) {
+		void *data = mmap (NULL, (size_t) reader->size, PROT_READ, MAP_PRIVATE,
+		                   reader->fd, 0);
+		                   
+		if (data == MAP_FAILED) {
+			DEBUG_NOW1 (REPORT_ERRORS, UTILS, "could not map sequence file '%s'", fn);
+			close (reader->fd);
+			return false;
+		}
+		
+		madvise (data, (size_t) reader->size, MADV_SEQUENTIAL);
+		reader->data = (const char *) data;
+	}
+	
+	#endif
+	return true;
+}
+
+/*
+ * read_next_fasta_record:
+ *          read the sequence of the next record into reader->seq (null-terminated),
+ *          skipping whitespace; reader->name is set to the record's header (if any)
+ *
+ * returns: FASTA_RECORD_READ if a record was read, FASTA_RECORD_NONE when no records
+ *          remain, or FASTA_RECORD_ERROR if the next record could not be read
+ */
+FASTA_RECORD_STATUS read_next_fasta_record (fasta_reader *reader,
+                                        nt_file_size *seq_len) {
+	REGISTER
+	nt_file_size posn = reader->posn, record_start;
+	
+	// skip any leading whitespace
+	while (posn < reader->size && isspace ((uchar) reader->data[posn])) {
+		posn++;
+	}
+	
+	if (posn >= reader->size) {
+		return FASTA_RECORD_NONE;
+	}
+	
+	reader->name = NULL;
+	reader->name_len = 0;
+	
+	if (FASTA_HEADER_CHAR == reader->data[posn]) {
+		posn++;
+		reader->name = reader->data + posn;
+		
+		while (posn < reader->size && reader->data[posn] != '\n' &&
+		       reader->data[posn] != '\r') {
+			posn++;
+		}
+		
+		reader->name_len = (reader->data + posn) - reader->name;
+	}
+	
+	record_start = posn;
+	
+	while (posn < reader->size && FASTA_HEADER_CHAR != reader->data[posn]) {
+		posn++;
+	}
+	
+	// the record's residues cannot exceed its size in the file
+	if (posn - record_start > MAX_FILE_SIZE_BYTES) {
+		DEBUG_NOW1 (REPORT_ERRORS, UTILS,
+		            "sequence record exceeds size limit (%llu)", MAX_FILE_SIZE_BYTES);
+		return FASTA_RECORD_ERROR;
+	}
+	
+	if (reader->seq_buff_size < posn - record_start + 1) {
+		nt_file_size new_buff_size = SAFE_MAX (reader->seq_buff_size * 2,
+		                                       SAFE_MAX (posn - record_start + 1, FASTA_MIN_BUFF_SIZE));
+		char *new_seq = realloc (reader->seq, (size_t) new_buff_size);
+		
+		if (!new_seq) {
+			DEBUG_NOW (REPORT_ERRORS, UTILS,
+			           "could not allocate memory for sequence record");
+			return FASTA_RECORD_ERROR;
+		}
+		
+		reader->seq = new_seq;
+		reader->seq_buff_size = new_buff_size;
+	}
+	
+	*seq_len = 0;
+	
+	for (REGISTER nt_file_size i = record_start; i < posn; i++) {
+		REGISTER
+		char c = reader->data[i];
+		
+		if (!isspace ((uchar) c)) {
+			c = (char) tolower ((uchar) c);
+			reader->seq[ (*seq_len)++] = (c == 't') ? 'u' : c;
+		}
+	}
+	
+	reader->seq[*seq_len] = '\0';
+	#ifndef _WIN32
+	// pages of this record (copied to reader->seq) and preceding records are no longer needed
+	const long page_size = sysconf (_SC_PAGESIZE);
+	const nt_file_size done_start = (reader->posn / page_size) * page_size,
+	                   done_end = (posn / page_size) * page_size;
+	                   
+	if (done_end > done_start) {
+		madvise ((void *) (reader->data + done_start), (size_t) (done_end - done_start),
+		         MADV_DONTNEED);
+	}
+	
+	#endif
+	reader->posn = posn;
+	return FASTA_RECORD_READ;
+}
+
+void close_fasta (fasta_reader *reader) {
+	#ifdef _WIN32
+	
+	if (reader->data) {
+		UnmapViewOfFile (reader->data);
+		CloseHandle (reader->mapping);
+	}
+	
+	CloseHandle (reader->file);
+	#else
+	
+	if (reader->data) {
+		munmap ((void *) reader->data, (size_t) reader->size);
+	}
+	
+	close (reader->fd);
+	#endif
+	free (reader->seq);
+	reader->seq = NULL;
+	reader->seq_buff_size = 0;
+	reader->data = NULL;
+}
@@ -16,4 +16,37 @@ bool is_valid_sequence (const char *restrict sequence,
                         char *restrict *err);	// frontend equivalent of is_seq_valid
 bool read_seq_from_fn (const char *fn, char **buff, nt_file_size *fsize);
 
+/*
+ * memory-mapped (multi-record) FASTA reader; records are read one at a time into a buffer
+ * that is reused across records, so memory use is bounded by the largest record. files
+ * without any '>' header line are read as a single (unnamed) record
+ */
+#define FASTA_HEADER_CHAR       '>'
+#define FASTA_MIN_BUFF_SIZE     4096
+
+typedef struct {
+	const char *data;                   // mapped file contents
+	nt_file_size size, posn;            // file size, and offset of next record
+	#ifdef _WIN32
+	void *file, *mapping;
+	#else
+	int fd;
+	#endif
+	char *seq;                          // current record sequence (lowercase, t replaced by u)
+	nt_file_size seq_buff_size;
+	const char *name;                   // current record name (not null-terminated); NULL if none
+	nt_file_size name_len;
+} fasta_reader;
+
+typedef enum {
+	FASTA_RECORD_ERROR = -1,
+	FASTA_RECORD_NONE = 0,              // no records remain
+	FASTA_RECORD_READ = 1
+} FASTA_RECORD_STATUS;
+
+bool open_fasta (const char *fn, fasta_reader *reader);
+FASTA_RECORD_STATUS read_next_fasta_record (fasta_reader *reader,
+                                        nt_file_size *seq_len);
+void close_fasta (fasta_reader *reader);
+
 #endif //RNA_SEQUENCE_H
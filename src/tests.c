@@ -24,8 +24,17 @@
 float validate_test (ushort test_id, const char *seq, ntp_model model,
                      ntp_bp results, ushort num_results, bool dump) {
 	DEBUG_NOW1 (REPORT_INFO, TESTS, "starting test #%d", test_id);
+	ntp_search_context search_context = create_search_context();
+	
+	if (!search_context) {
+		DEBUG_NOW1 (REPORT_ERRORS, TESTS, "test #%d failed (cannot create search context)",
+		            test_id);
+		return 0.0f;
+	}
+	
 	float elapsed_time;
-	REGISTER ntp_list found_list = search_seq (seq, model, &elapsed_time
+	REGISTER ntp_list found_list = search_seq (search_context, seq, model,
+	                                        &elapsed_time
 	                                        #ifdef SEARCH_SEQ_DETAIL
 	                                        , results, num_results
 	                                        #endif
@@ -116,7 +125,8 @@ float validate_test (ushort test_id, const char *seq, ntp_model model,
 		elapsed_time = 0.0f;
 	}
 	
-	list_destroy_all_tagged();
+	list_destroy_all_tagged (&search_context->search_seq_list);
+	destroy_search_context (search_context);
 	return elapsed_time;
 }
 
@@ -1,3 +1,6 @@
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE // sched_getaffinity
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -10,6 +13,11 @@
 #else
 	#include <unistd.h> // usleep
 #endif
+#ifndef WIN32
+	#include <unistd.h> // sysconf
+	#include <sched.h>  // sched_getaffinity
+#endif
+#include <limits.h>
 #include <pthread.h>
 
 /*
@@ -81,28 +89,39 @@ ntp_list debug_mem_traces = NULL;
 #endif
 #endif
 
+#define MEM_TAG_CHUNK_SIZE  65536     // bytes per (regular) chunk of a tag's arena
+#define MEM_TAG_ALIGNMENT   16        // alignment of (and granularity for) tagged allocations
+
+typedef struct _nt_mem_tag_chunk {
+	struct _nt_mem_tag_chunk *next;
+	size_t size, used;
+	_Alignas (MEM_TAG_ALIGNMENT) char mem[];
+} nt_mem_tag_chunk, *ntp_mem_tag_chunk;
+
 typedef struct {
-	uchar tag;
-	nt_list list;
-} nt_tagged_mem_entry, *ntp_tagged_mem_entry;
+	ntp_mem_tag_chunk chunks;           // current chunk first
+	void *last_mem;                     // most recent allocation, which free_t may return to the arena
+	size_t last_size;
+} nt_mem_tag_arena, *ntp_mem_tag_arena;
 
-ntp_list mem_tag_list = NULL;
+// tagged memory is tracked per thread (one arena per tag), such that concurrent
+// searches (see search_seq) can each release their own allocations
+__thread ntp_mem_tag_arena mem_tag_arenas = NULL;
+// bytes held by the chunks of the arenas of this thread (see get_mem_tag_size)
+static __thread size_t mem_tag_size = 0;
 
 #ifdef _WIN32
 	#include <winnt.h>
 	#include <afxres.h>
-	
-	LARGE_INTEGER StartingTime, EndingTime, ElapsedMicroseconds;
-	LARGE_INTEGER Frequency;
 #else
 	#define _XOPEN_SOURCE 700   // POSIX 2008
 	
 	#include <unistd.h>
 	#include <time.h>
-	
-	struct timespec start, finish;
 #endif
 
+static nt_timer process_timer;
+
 /*
  * convenience data structures for translating
  * timebytes to/from decimal representation
@@ -229,6 +248,40 @@ void finalize_utils() {
 	is_mutex_init = false;
 }
 
+/*
+ * get_num_cores:
+ *          number of processors currently online; at least 1
+ */
+ushort get_num_cores() {
+	#ifdef WIN32
+	SYSTEM_INFO sys_info;
+	GetSystemInfo (&sys_info);
+	return (ushort) SAFE_MAX (sys_info.dwNumberOfProcessors, 1);
+	#else
+	long num_cores = sysconf (_SC_NPROCESSORS_ONLN);
+	return (ushort) SAFE_MAX (SAFE_MIN (num_cores, (long) USHRT_MAX), 1L);
+	#endif
+}
+
+/*
+ * get_num_available_cores:
+ *          number of processors that this process may run on, such as those allotted
+ *          to it by a job scheduler (see sched_getaffinity); at least 1
+ */
+ushort get_num_available_cores() {
+	#if defined(WIN32) || !defined(CPU_COUNT)
+	return get_num_cores();
+	#else
+	cpu_set_t cpu_set;
+	
+	if (sched_getaffinity (0, sizeof (cpu_set), &cpu_set)) {
+		return get_num_cores();
+	}
+	
+	return (ushort) SAFE_MAX (SAFE_MIN (CPU_COUNT (&cpu_set), (int) USHRT_MAX), 1);
+	#endif
+}
+
 // credit f/sleep_ms: https://stackoverflow.com/questions/1157209/is-there-an-alternative-sleep-function-in-c-to-milliseconds
 void sleep_ms (int milliseconds) {
 	#ifdef WIN32
@@ -243,38 +296,50 @@ void sleep_ms (int milliseconds) {
 	#endif
 }
 
-void reset_timer() {
+void start_timer (ntp_timer timer) {
 	#ifdef _WIN32
-	QueryPerformanceFrequency (&Frequency);
-	QueryPerformanceCounter (&StartingTime);
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency (&frequency);
+	QueryPerformanceCounter (&counter);
+	timer->frequency = frequency.QuadPart;
+	timer->start = counter.QuadPart;
 	#else
-	clock_gettime (CLOCK_REALTIME, &start);
+	clock_gettime (CLOCK_REALTIME, &timer->start);
 	#endif
 }
 
-float get_timer() {
+float get_elapsed_time (const nt_timer *timer) {
 	#ifdef _WIN32
-	QueryPerformanceCounter (&EndingTime);
-	ElapsedMicroseconds.QuadPart = EndingTime.QuadPart - StartingTime.QuadPart;
-	ElapsedMicroseconds.QuadPart *= 1000000;
-	ElapsedMicroseconds.QuadPart /= Frequency.QuadPart;
-	return ElapsedMicroseconds.QuadPart / 1000000.0f;
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter (&counter);
+	long long elapsed_microseconds = ((counter.QuadPart - timer->start) * 1000000) /
+	                                 timer->frequency;
+	return elapsed_microseconds / 1000000.0f;
 	#else
+	struct timespec finish;
 	clock_gettime (CLOCK_REALTIME, &finish);
 	
-	if ((finish.tv_nsec - start.tv_nsec) < 0) {
-		return (finish.tv_sec - start.tv_sec - 1) + (1000000000.0f - start.tv_nsec +
-		                                        finish.tv_nsec) / 1000000000.0f;
+	if ((finish.tv_nsec - timer->start.tv_nsec) < 0) {
+		return (finish.tv_sec - timer->start.tv_sec - 1) + (1000000000.0f -
+		                                        timer->start.tv_nsec + finish.tv_nsec) / 1000000000.0f;
 	}
 	
 	else {
-		return (finish.tv_sec - start.tv_sec) + (finish.tv_nsec - start.tv_nsec) /
-		       1000000000.0f;
+		return (finish.tv_sec - timer->start.tv_sec) + (finish.tv_nsec -
+		                                        timer->start.tv_nsec) / 1000000000.0f;
 	}
 	
 	#endif
 }
 
+void reset_timer() {
+	start_timer (&process_timer);
+}
+
+float get_timer() {
+	return get_elapsed_time (&process_timer);
+}
+
 /*
  * commit_d_now:
  *          log a message for a given topic and reporting_level to stdout
@@ -999,25 +1064,6 @@ void flush_mem_d() {
 #endif
 #endif
 
-int tagged_mem_entry_seeker (const void *mem_tag_list_el, const void *mem_tag) {
-	ntp_tagged_mem_entry tagged_mem_entry = (ntp_tagged_mem_entry)mem_tag_list_el;
-	
-	if (tagged_mem_entry->tag == * (uchar *)mem_tag) {
-		return 1;
-	}
-	
-	return 0;
-}
-
-int tagged_mem_entry_list_seeker (const void *mem_tag_list_el,
-                                  const void *mem) {
-	if (mem_tag_list_el == mem) {
-		return 1;
-	}
-	
-	return 0;
-}
-
 #ifdef MULTITHREADED_ON
 inline ulong get_malloc_t_flag() {
 	return malloc_t_flag;
@@ -1028,253 +1074,142 @@ inline void clear_malloc_t_flag() {
 }
 #endif
 
-void *malloc_t (size_t alloc_size, uchar alloc_tag) {
-	#ifdef MULTITHREADED_ON
+/*
+ * private function to round an allocation size up to MEM_TAG_ALIGNMENT
+ */
+static inline size_t get_mem_tag_aligned_size (const size_t alloc_size) {
+	return (alloc_size + MEM_TAG_ALIGNMENT - 1) & ~ ((size_t) MEM_TAG_ALIGNMENT - 1);
+}
 
-	if (pthread_mutex_lock (&mem_tag_list_mutex) == 0) {
+/*
+ * private function to add a chunk, with room for at least alloc_size bytes, to the
+ * arena of alloc_tag; regular chunks become the arena's current (head) chunk, whereas
+ * oversized chunks (for a single large allocation) are kept behind the current chunk
+ */
+static inline ntp_mem_tag_chunk add_mem_tag_chunk (ntp_mem_tag_arena arena,
+                                        const size_t alloc_size, const uchar alloc_tag) {
+	const size_t chunk_size = alloc_size > MEM_TAG_CHUNK_SIZE / 4 ? alloc_size :
+	                          MEM_TAG_CHUNK_SIZE;
+	#ifdef DEBUG_MEM
+	char msg[MAX_MSG_LEN];
+	sprintf (msg, "chunk in mem_tag_arena with tag %u in malloc_t", alloc_tag);
+	ntp_mem_tag_chunk chunk = MALLOC_DEBUG (sizeof (nt_mem_tag_chunk) + chunk_size,
+	                                        msg);
+	#else
+	ntp_mem_tag_chunk chunk = MALLOC_DEBUG (sizeof (nt_mem_tag_chunk) + chunk_size,
+	                                        NULL);
 	#endif
+	                                        
+	if (!chunk) {
+		DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
+		            "failed to allocate chunk for mem_tag_arena with tag %u", alloc_tag);
+		return NULL;
+	}
 	
-		if (!mem_tag_list) {
-			mem_tag_list = MALLOC_DEBUG (sizeof (nt_list), "mem_tag_list in malloc_t");
-			
-			if (mem_tag_list && (list_init (mem_tag_list) >= 0)) {
-				COMMIT_DEBUG (REPORT_INFO, MEM_TAG,
-				              "allocated and initialized mem_tag_list in malloc_t", true);
-				              
-				if (!list_attributes_seeker (mem_tag_list, &tagged_mem_entry_seeker)) {
-					COMMIT_DEBUG (REPORT_INFO, MEM_TAG,
-					              "tagged_mem_entry_seeker for mem_tag_list successfully set in malloc_t", false);
-				}
-				
-				else {
-					#ifdef MULTITHREADED_ON
-					pthread_mutex_unlock (&mem_tag_list_mutex);
-					#endif
-					DEBUG_NOW (REPORT_ERRORS, MEM_TAG,
-					           "could not set tagged_mem_entry_seeker for mem_tag_list");
-					return NULL;
-				}
-			}
-			
-			else {
-				#ifdef MULTITHREADED_ON
-				pthread_mutex_unlock (&mem_tag_list_mutex);
-				#endif
-				DEBUG_NOW (REPORT_ERRORS, MEM_TAG,
-				           "could not allocate or initialize mem_tag_list");
-				return NULL;
-			}
-		}
-		
-		ntp_tagged_mem_entry tagged_mem_entry = (ntp_tagged_mem_entry) list_seek (
-		                                        mem_tag_list, &alloc_tag);
-		#ifdef DEBUG_MEM
-		char msg[MAX_MSG_LEN];
-		#endif
-		bool revert = false;
-		
-		if (!tagged_mem_entry) {
-			#ifdef DEBUG_MEM
-			sprintf (msg, "tagged_mem_entry of mem_tag_list with tag %u in malloc_t",
-			         alloc_tag);
-			tagged_mem_entry = MALLOC_DEBUG (sizeof (nt_tagged_mem_entry), msg);
-			#else
-			tagged_mem_entry = MALLOC_DEBUG (sizeof (nt_tagged_mem_entry), NULL);
-			#endif
-			
-			if (tagged_mem_entry && (list_init (&tagged_mem_entry->list) >= 0) &&
-			    (list_append (mem_tag_list, tagged_mem_entry) >= 0)) {
-				tagged_mem_entry->tag = alloc_tag;
-				COMMIT_DEBUG1 (REPORT_INFO, MEM_TAG,
-				               "allocated/initialized/appended tagged_mem_entry and list with tag %u in malloc_t",
-				               alloc_tag,
-				               false);
-				               
-				if (!list_attributes_seeker (&tagged_mem_entry->list,
-				                             &tagged_mem_entry_list_seeker)) {
-					COMMIT_DEBUG1 (REPORT_INFO, MEM_TAG,
-					               "tagged_mem_entry_list_seeker for tagged_mem_entry with tag %u in mem_tag_list successfully set in malloc_t",
-					               alloc_tag,
-					               false);
-				}
-				
-				else {
-					DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
-					            "could not set tagged_mem_entry_list_seeker for tagged_mem_entry with tag %u in mem_tag_list",
-					            alloc_tag);
-					#ifdef DEBUG_MEM
-					sprintf (msg,
-					         "tagged_mem_entry of mem_tag_list with tag %u in malloc_t [failed to set tagged_mem_entry_list_seeker]",
-					         alloc_tag);
-					FREE_DEBUG (tagged_mem_entry, msg);
-					#else
-					FREE_DEBUG (tagged_mem_entry, NULL);
-					#endif
-					#ifdef MULTITHREADED_ON
-					pthread_mutex_unlock (&mem_tag_list_mutex);
-					#endif
-					return NULL;
-				}
-				
-				revert = true;
-			}
-			
-			else {
-				if (tagged_mem_entry) {
-					#ifdef DEBUG_MEM
-					sprintf (msg,
-					         "tagged_mem_entry of mem_tag_list with tag %u in malloc_t [failed to initialize/append]",
-					         alloc_tag);
-					FREE_DEBUG (tagged_mem_entry, msg);
-					#else
-					FREE_DEBUG (tagged_mem_entry, NULL);
-					#endif
-				}
-				
-				#ifdef MULTITHREADED_ON
-				pthread_mutex_unlock (&mem_tag_list_mutex);
-				#endif
-				DEBUG_NOW (REPORT_ERRORS, MEM_TAG,
-				           "could not allocate/initialize/append tagged_mem_entry and list");
-				return NULL;
-			}
-		}
-		
-		#ifdef DEBUG_MEM
-		sprintf (msg, "mem in tagged_mem_entry of mem_tag_list with tag %u in malloc_t",
-		         alloc_tag);
-		void *mem = MALLOC_DEBUG (alloc_size, msg);
-		#else
-		void *mem = MALLOC_DEBUG (alloc_size, NULL);
-		#endif
-		
-		if (!mem) {
-			#ifndef DEBUG_MEM
-			DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
-			            "failed to allocate requested mem for tagged_mem_entry list with tag %u",
-			            alloc_tag);
-			#endif
-		}
-		
-		else
-			if (list_append (&tagged_mem_entry->list, mem) < 0) {
-				DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
-				            "failed to append mem to tagged_mem_entry list with tag %u",
-				            alloc_tag);
-				#ifdef DEBUG_MEM
-				sprintf (msg,
-				         "tagged_mem_entry with tag %u in malloc_t [failed to append mem to tagged_mem_entry list]",
-				         alloc_tag);
-				FREE_DEBUG (mem, msg);
-				#else
-				FREE_DEBUG (mem, NULL);
-				#endif
-				
-				if (revert) {
-					list_destroy (&tagged_mem_entry->list);
-					#ifdef DEBUG_MEM
-					sprintf (msg, "tagged_mem_entry of mem_tag_list with tag %u",
-					         alloc_tag);
-					FREE_DEBUG (tagged_mem_entry, msg);
-					#else
-					FREE_DEBUG (tagged_mem_entry, NULL);
-					#endif
-				}
-				
-				#ifdef MULTITHREADED_ON
-				pthread_mutex_unlock (&mem_tag_list_mutex);
-				#endif
-				return NULL;
-			}
-			
-			else {
-				COMMIT_DEBUG1 (REPORT_INFO, MEM_TAG,
-				               "successfully appended mem to tagged_mem_entry list with tag %u in malloc_t",
-				               alloc_tag, false);
-			}
-			
-		#ifdef MULTITHREADED_ON
-		pthread_mutex_unlock (&mem_tag_list_mutex);
-		// indicate successful malloc_t
-		malloc_t_flag++;
-		#endif
-		return mem;
-		#ifdef MULTITHREADED_ON
+	chunk->size = chunk_size;
+	chunk->used = 0;
+	mem_tag_size += sizeof (nt_mem_tag_chunk) + chunk_size;
+	
+	if (chunk_size == MEM_TAG_CHUNK_SIZE || !arena->chunks) {
+		chunk->next = arena->chunks;
+		arena->chunks = chunk;
 	}
 	
 	else {
-		DEBUG_NOW (REPORT_ERRORS, MEM_TAG, "cannot acquire lock on mem_tag_list_mutex");
-		return NULL;
+		chunk->next = arena->chunks->next;
+		arena->chunks->next = chunk;
 	}
 	
-		#endif
+	COMMIT_DEBUG1 (REPORT_INFO, MEM_TAG,
+	               "added chunk to mem_tag_arena with tag %u in malloc_t", alloc_tag, false);
+	return chunk;
 }
 
-bool free_t (void *mem, uchar alloc_tag) {
+/*
+ * tagged memory: each tag is backed by a (per-thread) arena of chunks, such that
+ * allocation mostly amounts to bumping the used size of the arena's current chunk,
+ * and that free_t_all releases all tagged memory chunk by chunk
+ */
+void *malloc_t (size_t alloc_size, uchar alloc_tag) {
+	// arenas are per thread, so no lock is taken (other than for handing them over to
+	// a destruction thread, see prepare_threaded_free_t_all)
+	if (!mem_tag_arenas) {
+		mem_tag_arenas = MALLOC_DEBUG (sizeof (nt_mem_tag_arena) * (UCHAR_MAX + 1),
+		                               "mem_tag_arenas in malloc_t");
+		                               
+		if (!mem_tag_arenas) {
+			DEBUG_NOW (REPORT_ERRORS, MEM_TAG, "could not allocate mem_tag_arenas");
+			return NULL;
+		}
+		
+		memset (mem_tag_arenas, 0, sizeof (nt_mem_tag_arena) * (UCHAR_MAX + 1));
+		COMMIT_DEBUG (REPORT_INFO, MEM_TAG, "allocated mem_tag_arenas in malloc_t",
+		              true);
+	}
+	
+	REGISTER
+	ntp_mem_tag_arena arena = &mem_tag_arenas[alloc_tag];
+	const REGISTER
+	size_t aligned_size = get_mem_tag_aligned_size (alloc_size);
+	REGISTER
+	ntp_mem_tag_chunk chunk = arena->chunks;
+	
+	if (!chunk || chunk->size - chunk->used < aligned_size) {
+		chunk = add_mem_tag_chunk (arena, aligned_size, alloc_tag);
+		
+		if (!chunk) {
+			return NULL;
+		}
+	}
+	
+	void *mem = &chunk->mem[chunk->used];
+	chunk->used += aligned_size;
+	arena->last_mem = mem;
+	arena->last_size = aligned_size;
 	#ifdef MULTITHREADED_ON
-
-	if (pthread_mutex_lock (&mem_tag_list_mutex) == 0) {
+	// indicate successful malloc_t
+	__atomic_fetch_add (&malloc_t_flag, 1, __ATOMIC_RELAXED);
 	#endif
-	
-		if (mem_tag_list) {
-			ntp_tagged_mem_entry tagged_mem_entry = (ntp_tagged_mem_entry) list_seek (
-			                                        mem_tag_list, &alloc_tag);
-			                                        
-			if (tagged_mem_entry) {
-				int l = list_locate (&tagged_mem_entry->list, mem);
-				
-				if (l >= 0) {
-					if (!list_delete_at (&tagged_mem_entry->list, (unsigned int) l)) {
-						COMMIT_DEBUG1 (REPORT_INFO, MEM_TAG,
-						               "delisted memory element in tagged_mem_entry with tag %u of mem_tag_list in free_t",
-						               alloc_tag, false);
-					}
-					
-					else {
-						#ifdef MULTITHREADED_ON
-						pthread_mutex_unlock (&mem_tag_list_mutex);
-						#endif
-						DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
-						            "could not delist memory element in tagged_mem_entry with tag %u of mem_tag_list",
-						            alloc_tag);
-						return false;
-					}
-					
-					#ifdef DEBUG_MEM
-					char msg[MAX_MSG_LEN];
-					sprintf (msg, "mem in tagged_mem_entry of mem_tag_list with tag %u in free_t",
-					         alloc_tag);
-					FREE_DEBUG (mem, msg);
-					#else
-					FREE_DEBUG (mem, NULL);
-					#endif
-					#ifdef MULTITHREADED_ON
-					pthread_mutex_unlock (&mem_tag_list_mutex);
-					#endif
-					return true;
+	return mem;
+}
+
+/*
+ * get the size (in bytes) of the tagged memory currently held by the calling thread,
+ * including any memory released by free_t that free_t_all has yet to reclaim
+ */
+size_t get_mem_tag_size() {
+	return mem_tag_size;
+}
+
+/*
+ * release tagged memory: only the most recent allocation of a tag is returned to
+ * its arena right away; any other memory is reclaimed by free_t_all
+ */
+bool free_t (void *mem, uchar alloc_tag) {
+	if (mem_tag_arenas) {
+		REGISTER
+		ntp_mem_tag_arena arena = &mem_tag_arenas[alloc_tag];
+		
+		for (REGISTER ntp_mem_tag_chunk chunk = arena->chunks; chunk; chunk = chunk->next) {
+			if ((char *) mem >= chunk->mem && (char *) mem < &chunk->mem[chunk->used]) {
+				if (mem == arena->last_mem && (char *) mem + arena->last_size ==
+				    &chunk->mem[chunk->used]) {
+					chunk->used -= arena->last_size;
+					arena->last_mem = NULL;
+					COMMIT_DEBUG1 (REPORT_INFO, MEM_TAG,
+					               "returned memory element to mem_tag_arena with tag %u in free_t",
+					               alloc_tag, false);
 				}
-			}
-			
-			else {
-				DEBUG_NOW2 (REPORT_ERRORS, MEM_TAG,
-				            "could not find memory element %p with tag %u", mem, alloc_tag);
+				
+				return true;
 			}
 		}
 		
-		#ifdef MULTITHREADED_ON
-		pthread_mutex_unlock (&mem_tag_list_mutex);
-		#endif
-		return false;
-		#ifdef MULTITHREADED_ON
-	}
-	
-	else {
-		DEBUG_NOW (REPORT_ERRORS, MEM_TAG,
-		           "cannot acquire lock on mem_tag_list_mutex");
-		return false;
+		DEBUG_NOW2 (REPORT_ERRORS, MEM_TAG,
+		            "could not find memory element %p with tag %u", mem, alloc_tag);
 	}
 	
-		#endif
+	return false;
 }
 
 #ifdef MULTITHREADED_ON
@@ -1296,14 +1231,15 @@ bool prepare_threaded_free_t_all (ulong slot) {
 			return false;
 		}
 		
-		if (!mem_tag_list) {
+		if (!mem_tag_arenas) {
 			pthread_mutex_unlock (&mem_tag_list_mutex);
-			DEBUG_NOW (REPORT_ERRORS, MEM_TAG, "mem_tag_list is NULL");
+			DEBUG_NOW (REPORT_ERRORS, MEM_TAG, "mem_tag_arenas is NULL");
 			return false;
 		}
 		
-		mem_tag_list_destruction_target[slot] = mem_tag_list;
-		mem_tag_list = NULL;
+		mem_tag_list_destruction_target[slot] = mem_tag_arenas;
+		mem_tag_arenas = NULL;
+		mem_tag_size = 0;
 		pthread_mutex_unlock (&mem_tag_list_mutex);
 		return true;
 	}
@@ -1323,98 +1259,81 @@ bool prepare_threaded_free_t_all (ulong slot) {
 #endif
 {
 	#ifdef MULTITHREADED_ON
-
-	if (pthread_mutex_lock (&mem_tag_list_mutex) == 0) {
-		if (slot > MAX_THREADS) {
-			pthread_mutex_unlock (&mem_tag_list_mutex);
-			DEBUG_NOW2 (REPORT_ERRORS, MEM_TAG,
-			            "slot (%lu) exceeds MAX_THREADS+1 (%d)", slot, MAX_THREADS + 1);
-			return false;
-		}
-		
-		if (mem_tag_list_destruction_target[slot] == NULL) {
-			DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
-			            "slot (%lu) for mem_tag_list_destruction_target is NULL", slot);
-			pthread_mutex_unlock (&mem_tag_list_mutex);
-			return false;
-		}
-		
-		if (mem_tag_list) {
-			DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
-			            "mem_tag_list is not NULL (%p)", mem_tag_list);
-			pthread_mutex_unlock (&mem_tag_list_mutex);
-			return false;
-		}
-		
-		mem_tag_list = mem_tag_list_destruction_target[slot];
-		mem_tag_list_destruction_target[slot] = NULL;
+	
+	// take over the arenas handed over to slot (see prepare_threaded_free_t_all),
+	// which this thread then releases without holding the lock
+	if (pthread_mutex_lock (&mem_tag_list_mutex) != 0) {
+		DEBUG_NOW (REPORT_ERRORS, MEM_TAG,
+		           "cannot acquire lock on mem_tag_list_mutex");
+		return false;
+	}
+	
+	if (slot > MAX_THREADS) {
+		pthread_mutex_unlock (&mem_tag_list_mutex);
+		DEBUG_NOW2 (REPORT_ERRORS, MEM_TAG,
+		            "slot (%lu) exceeds MAX_THREADS+1 (%d)", slot, MAX_THREADS + 1);
+		return false;
+	}
+	
+	if (mem_tag_list_destruction_target[slot] == NULL) {
+		DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
+		            "slot (%lu) for mem_tag_list_destruction_target is NULL", slot);
+		pthread_mutex_unlock (&mem_tag_list_mutex);
+		return false;
+	}
+	
+	if (mem_tag_arenas) {
+		DEBUG_NOW1 (REPORT_ERRORS, MEM_TAG,
+		            "mem_tag_arenas is not NULL (%p)", mem_tag_arenas);
+		pthread_mutex_unlock (&mem_tag_list_mutex);
+		return false;
+	}
+	
+	mem_tag_arenas = mem_tag_list_destruction_target[slot];
+	mem_tag_list_destruction_target[slot] = NULL;
+	pthread_mutex_unlock (&mem_tag_list_mutex);
 	#endif
-		
-		if (mem_tag_list && list_iterator_start (mem_tag_list)) {
-			while (list_iterator_hasnext (mem_tag_list)) {
-				ntp_tagged_mem_entry tagged_mem_entry = (ntp_tagged_mem_entry)
-				                                        list_iterator_next (mem_tag_list);
-				                                        
-				if (tagged_mem_entry) {
-					if (list_iterator_start (&tagged_mem_entry->list)) {
-						ulong cnt = 0;
-						#ifdef DEBUG_MEM
-						uchar tag = tagged_mem_entry->tag;
-						#endif
-						
-						while (list_iterator_hasnext (&tagged_mem_entry->list)) {
-							#ifdef DEBUG_MEM
-							char msg[MAX_MSG_LEN];
-							sprintf (msg,
-							         "mem in tagged_mem_entry of mem_tag_list with tag %u in free_t_all", tag);
-							FREE_DEBUG (list_iterator_next (&tagged_mem_entry->list), msg);
-							#else
-							void *p = list_iterator_next (&tagged_mem_entry->list);
-							FREE_DEBUG (p, NULL);
-							#endif
-							cnt++;
-						}
-						
-						list_iterator_stop (&tagged_mem_entry->list);
-						list_destroy (&tagged_mem_entry->list);
-						FREE_DEBUG (tagged_mem_entry, "tagged_mem_entry of mem_tag_list in free_t_all");
-						COMMIT_DEBUG2 (REPORT_INFO, MEM_TAG,
-						               "freed %llu memory elements in tagged_mem_entry with tag %u of mem_tag_list in free_t_all",
-						               cnt, tag, false);
-					}
-				}
-			}
+	
+	if (mem_tag_arenas) {
+		for (REGISTER ushort tag = 0; tag <= UCHAR_MAX; tag++) {
+			REGISTER
+			ntp_mem_tag_chunk chunk = mem_tag_arenas[tag].chunks;
+			ulong cnt = 0;
 			
-			list_iterator_stop (mem_tag_list);
-			list_destroy (mem_tag_list);
-			FREE_DEBUG (mem_tag_list, "mem_tag_list in free_t_all");
-			mem_tag_list = NULL;
-		}
-		
-		else {
-			if (!mem_tag_list) {
-				DEBUG_NOW (REPORT_WARNINGS, MEM_TAG,
-				           "mem_tag_list not initialized");
+			while (chunk) {
+				REGISTER
+				ntp_mem_tag_chunk next_chunk = chunk->next;
+				#ifdef DEBUG_MEM
+				char msg[MAX_MSG_LEN];
+				sprintf (msg, "chunk in mem_tag_arena with tag %u in free_t_all", tag);
+				FREE_DEBUG (chunk, msg);
+				#else
+				FREE_DEBUG (chunk, NULL);
+				#endif
+				chunk = next_chunk;
+				cnt++;
 			}
 			
-			else {
-				DEBUG_NOW (REPORT_WARNINGS, MEM_TAG,
-				           "cannot iterate on mem_tag_list");
+			if (cnt) {
+				COMMIT_DEBUG2 (REPORT_INFO, MEM_TAG,
+				               "freed %lu chunks in mem_tag_arena with tag %u in free_t_all",
+				               cnt, tag, false);
 			}
 		}
 		
-		#ifdef MULTITHREADED_ON
-		pthread_mutex_unlock (&mem_tag_list_mutex);
-		return true;
+		FREE_DEBUG (mem_tag_arenas, "mem_tag_arenas in free_t_all");
+		mem_tag_arenas = NULL;
+		mem_tag_size = 0;
 	}
 	
 	else {
-		DEBUG_NOW (REPORT_ERRORS, MEM_TAG,
-		           "cannot acquire lock on mem_tag_list_mutex");
-		return false;
+		DEBUG_NOW (REPORT_WARNINGS, MEM_TAG,
+		           "mem_tag_arenas not initialized");
 	}
 	
-		#endif
+	#ifdef MULTITHREADED_ON
+	return true;
+	#endif
 }
 
 void GET_SUBSTRING (const char *string, const short position,
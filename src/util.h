@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <ctype.h>
+#include <time.h>
 #include "simclist.h"
 
 #define EXEC_SUCCESS    0
@@ -47,6 +48,13 @@ void finalize_utils();
 
 #define MAX_FILE_SIZE_BYTES 1000000000LLU
 
+/* when defined, in-window sequence positions, lengths and stack
+ * distances (nt_rel_seq_posn, nt_rel_seq_len, nt_stack_idist, ...)
+ * are 16-bit wide, lifting the 255 nt search window ceiling at the
+ * cost of larger bp lists; not set by default
+ */
+//#define WIDE_POSITIONS
+
 /*
  * number of bytes (x2) required to convert real-time clock info to bytes,
  * equals DS_OBJ_ID_LENGTH in datastore.h for handling object IDs
@@ -57,18 +65,27 @@ typedef uint16_t       	     ushort;
 typedef uint32_t             nt_abs_seq_len, nt_abs_count, nt_abs_seq_posn,
         *ntp_abs_count, nt_seq_count, nt_list_posn, nt_hit_count;
 typedef uint64_t             nt_model_size;
-typedef uint8_t              nt_rel_seq_len, nt_rel_count, nt_rel_seq_posn,
-        *ntp_rel_count, uchar,
-        nt_stack_size, *ntp_stack_size, nt_element_count, nt_stack_idist,
-        *ntp_stack_idist, nt_seg_size, *ntp_seg_size;
-typedef int16_t              nt_s_rel_count, nt_s_stack_size, nt_s_stack_idist;
+typedef uint8_t              uchar, nt_stack_size, *ntp_stack_size,
+        nt_element_count;
+typedef int16_t              nt_s_stack_size;
+#ifdef WIDE_POSITIONS
+	typedef uint16_t         nt_rel_seq_len, nt_rel_count, nt_rel_seq_posn,
+	        *ntp_rel_count, nt_stack_idist, *ntp_stack_idist;
+	typedef int32_t          nt_s_rel_count, nt_s_stack_idist;
+	#define MAX_STACK_DIST   USHRT_MAX
+#else
+	typedef uint8_t          nt_rel_seq_len, nt_rel_count, nt_rel_seq_posn,
+	        *ntp_rel_count, nt_stack_idist, *ntp_stack_idist;
+	typedef int16_t          nt_s_rel_count, nt_s_stack_idist;
+	#define MAX_STACK_DIST   UCHAR_MAX
+#endif
+#define MAX_REL_SEQ_LEN      MAX_STACK_DIST     // longest search window addressable by in-window positions
 
 typedef int64_t              nt_file_size, nt_q_size, nt_int;
 typedef char                 nt;
 typedef const char          *ntp_seq;
 typedef FILE                *ntp_file;
 typedef char                 nt_rt_bytes[NUM_RT_BYTES + 1];
-#define MAX_STACK_DIST       UCHAR_MAX
 
 /*
  * DEBUG customization
@@ -242,6 +259,7 @@ static inline void  FREE_D (void *mem, const char *free_reason) {
 
 void *malloc_t (size_t alloc_size, uchar alloc_tag);
 bool  free_t (void *mem, uchar alloc_tag);
+size_t get_mem_tag_size();
 
 #define MALLOC_TAG(s, t) malloc_t ((s), (t))
 #define FREE_TAG(s, t) free_t ((s), (t))
@@ -271,7 +289,25 @@ void convert_rt_bytes_to_string (nt_rt_bytes *rt_bytes,
 void convert_string_to_rt_bytes (nt_rt_bytes *new_rt_char,
                                  nt_rt_bytes *rt_bytes);
 unsigned long long get_total_system_memory();
+ushort get_num_cores();
+ushort get_num_available_cores();
 void sleep_ms (int milliseconds);
+
+/*
+ * wall-clock timer; reset_timer/get_timer operate on a single
+ * process-wide instance, while start_timer/get_elapsed_time
+ * allow for concurrent timing using caller-owned instances
+ */
+typedef struct {
+	#ifdef _WIN32
+	long long start, frequency;
+	#else
+	struct timespec start;
+	#endif
+} nt_timer, *ntp_timer;
+
+void start_timer (ntp_timer timer);
+float get_elapsed_time (const nt_timer *timer);
 void reset_timer();
 float get_timer();
 